@@ -2,6 +2,8 @@ set(FILE_LIST
 src/C4Config.cpp
 src/C4Group.cpp
 src/C4Group.h
+src/C4GroupCache.cpp
+src/C4GroupCache.h
 src/C4InputValidation.cpp
 src/C4InputValidation.h
 src/C4Update.cpp
@@ -9,6 +9,8 @@ src/C4AudioSystem.h
 src/C4AudioSystemNone.h
 src/C4Aul.cpp
 src/C4Aul.h
+src/C4AulCodeCache.cpp
+src/C4AulCodeCache.h
 src/C4AulExec.cpp
 src/C4AulLink.cpp
 src/C4AulParse.cpp
@@ -39,6 +41,8 @@ src/C4Def.cpp
 src/C4Def.h
 src/C4DefGraphics.cpp
 src/C4DefGraphics.h
+src/C4DefPreload.cpp
+src/C4DefPreload.h
 src/C4DelegatedIterable.h
 src/C4DeletionTrackable.h
 src/C4DevmodeDlg.cpp
@@ -101,6 +105,8 @@ src/C4GraphicsSystem.cpp
 src/C4GraphicsSystem.h
 src/C4Group.cpp
 src/C4Group.h
+src/C4GroupCache.cpp
+src/C4GroupCache.h
 src/C4GroupSet.cpp
 src/C4GroupSet.h
 src/C4Gui.cpp
@@ -22,5 +22,7 @@ src/StdFile.h
 src/StdGzCompressedFile.cpp
 src/StdGzCompressedFile.h
 src/StdHelpers.h
+src/StdMappedFile.cpp
+src/StdMappedFile.h
 src/StdSha1.h
 )
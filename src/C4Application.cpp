@@ -119,6 +119,7 @@ void C4Application::DoInit()
 	C4Group_SetMaker(Config.General.Name);
 	C4Group_SetProcessCallback(&ProcessCallback);
 	C4Group_SetTempPath(Config.General.TempPath);
+	C4Group_SetCache(Config.AtExePath(C4CFN_GroupCache), static_cast<size_t>(std::max<int32_t>(Config.General.GroupCacheSize, 0)) * 1024 * 1024);
 	C4Group_SetSortList(C4CFN_FLS);
 
 	// Open log
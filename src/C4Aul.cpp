@@ -468,19 +468,58 @@ void C4AulScriptEngine::Clear()
 	GlobalConsts.SetNameList(&GlobalConstNames);
 	GlobalNamed.Reset();
 	GlobalNamed.SetNameList(&GlobalNamedNames);
+	ClearCallCaches();
 }
 
 void C4AulScriptEngine::UnLink()
 {
 	// unlink scripts
 	C4AulScript::UnLink();
-	// clear string table ("hold" strings only)
-	Strings.Clear();
+	// function lookups may change
+	ClearCallCaches();
+	// hold strings are released after relinking: temporary scripts keep their code, so they may still refer to them
 	// Do not clear global variables and constants, because they are registered by the
 	// preparser. Note that keeping those fields means that you cannot delete a global
 	// variable or constant at runtime by removing it from the script.
 }
 
+void C4AulScriptEngine::ReleaseUnusedStrings()
+{
+	std::unordered_set<const C4String *> StillUsed;
+	CollectStrings(StillUsed);
+	Strings.ReleaseHold(StillUsed);
+}
+
+void C4AulScriptEngine::CacheCall(C4AulBCC *pSite, C4Def *pDef, C4AulFunc *pFunc)
+{
+	// get cache of this call site
+	if (!pSite->CallCache || pSite->CallCache > CallCaches.size() || CallCaches[pSite->CallCache - 1].pSite != pSite)
+	{
+		// call sites of temporary scripts never give their caches back, so start over at some point
+		if (CallCaches.size() >= MaxCallCaches)
+			CallCaches.clear();
+		CallCaches.push_back({pSite});
+		pSite->CallCache = static_cast<std::uint16_t>(CallCaches.size());
+	}
+	C4AulCallCache &Cache = CallCaches[pSite->CallCache - 1];
+	// use a free entry or replace the oldest one
+	std::size_t i;
+	if (Cache.iCount < C4AulCallCache::Size)
+		i = Cache.iCount++;
+	else
+	{
+		i = Cache.iNext;
+		Cache.iNext = (Cache.iNext + 1) % C4AulCallCache::Size;
+	}
+	Cache.Defs[i] = pDef;
+	Cache.Funcs[i] = pFunc;
+}
+
+void C4AulScriptEngine::ClearCallCaches()
+{
+	CallCaches.clear();
+}
+
 void C4AulScriptEngine::RegisterGlobalConstant(const char *szName, const C4Value &rValue)
 {
 	// Register name and set value.
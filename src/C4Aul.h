@@ -33,6 +33,8 @@
 
 #include <cstdint>
 #include <list>
+#include <string_view>
+#include <unordered_set>
 #include <vector>
 
 // class predefs
@@ -41,6 +43,7 @@ class C4AulFunc;
 class C4AulScriptFunc;
 class C4AulScript;
 class C4AulScriptEngine;
+class C4AulCodeCache;
 
 struct C4AulContext;
 struct C4AulBCC;
@@ -122,7 +125,7 @@ struct C4AulParSet
 
 // byte code chunk type
 // some special script functions defined hard-coded to reduce the exec context
-enum C4AulBCCType
+enum C4AulBCCType : std::uint8_t
 {
 	AB_DEREF,        // deref the current value
 	AB_MAPA_R,       // map access via .
@@ -221,6 +224,13 @@ enum C4AulBCCType
 	AB_ERR,              // parse error at this position
 	AB_EOFN,             // end of function
 	AB_EOF,              // end of file
+
+	// superinstructions, put in place of the first chunk of a sequence after parsing
+	// the following chunks are kept, so jumps into the sequence and the slow path still find them
+	AB_VARN_CMP_CONDN,   // AB_VARN_V, AB_INT, comparison, AB_CONDN
+	AB_VARN_STEP,        // AB_VARN_R, ++/--, AB_STACK -1
+	AB_VARN_ADDINT,      // AB_VARN_R, AB_INT, +=/-=, AB_STACK -1
+	AB_INT_OP,           // AB_INT, arithmetic operator
 };
 
 // ** a definition of an operator
@@ -241,11 +251,30 @@ struct C4ScriptOpDef
 extern C4ScriptOpDef C4ScriptOpMap[];
 
 // byte code chunk
+// kept at 16 bytes on 64 bit platforms, so the interpreter gets four chunks per cache line
 struct C4AulBCC
 {
 	C4AulBCCType bccType; // chunk type
+	std::uint16_t CallCache; // object calls: index + 1 of the call site's entry in C4AulScriptEngine::CallCaches (0: none)
+	std::uint32_t SPos; // offset + 1 of the chunk's source in the script text of the function's pOrgScript (0: none)
 	std::intptr_t bccX;
-	const char *SPos;
+
+	const char *GetSPos(const char *szScript) const { return SPos ? szScript + (SPos - 1) : nullptr; }
+	static std::uint32_t ToSPos(const char *szScript, const char *szPos) { return szPos ? static_cast<std::uint32_t>(szPos - szScript + 1) : 0; }
+};
+
+static_assert(sizeof(C4AulBCC) == 8 + sizeof(std::intptr_t));
+
+// inline cache of an object call site: functions found for the last definitions called at it
+struct C4AulCallCache
+{
+	static constexpr std::size_t Size = 4; // number of definitions remembered per call site
+
+	const C4AulBCC *pSite; // call site this cache belongs to; validates C4AulBCC::CallCache
+	C4Def *Defs[Size]; // call target definitions...
+	C4AulFunc *Funcs[Size]; // ...and the functions found for them (nullptr: no such function)
+	std::uint8_t iCount; // number of used entries
+	std::uint8_t iNext; // entry to be replaced next if all are used
 };
 
 // call context
@@ -268,7 +297,8 @@ struct C4AulScriptContext : public C4AulContext
 	bool TemporaryScript;
 	C4ValueList NumVars;
 	C4AulBCC *CPos;
-	time_t tTime; // initialized only by profiler if active
+	std::uint64_t tTime; // profiler: start time in nanoseconds; initialized only by profiler if active
+	std::size_t iProfileNode, iProfileParent; // profiler: call tree node of this function and of its caller
 
 	size_t ParCnt() const { return Vars - Pars; }
 	void dump(std::string Dump = "");
@@ -281,6 +311,7 @@ class C4AulFunc
 	friend class C4AulScriptEngine;
 	friend class C4AulFuncMap;
 	friend class C4AulParseState;
+	friend class C4AulCodeCache;
 
 public:
 	C4AulFunc(C4AulScript *pOwner, const char *pName, bool bAtEnd = true);
@@ -309,6 +340,11 @@ public:
 	virtual C4Value Exec(C4Object *pObj = nullptr, const C4AulParSet &pPars = C4AulParSet{}, bool fPassErrors = false, bool nonStrict3WarnConversionOnly = false, bool convertNilToIntBool = true); // execute func (engine call)
 	virtual void UnLink() { OverloadedBy = NextSNFunc = nullptr; }
 
+	// typed direct call for engine functions that take scalar parameters only, skipping the generic parameter conversion
+	// returns false without calling the function if any parameter isn't nil or of the exact type expected
+	using FastCallFunc = bool (*)(C4AulFunc *pFunc, C4AulContext *pCallerCtx, const C4Value pPars[], C4Value &rResult);
+	FastCallFunc FastCall{nullptr};
+
 	C4AulFunc *GetLocalSFunc(const char *szIdtf); // find script function in own scope
 
 	C4AulFunc *FindSameNameFunc(C4Def *pScope); // Find a function of the same name for given scope
@@ -364,7 +400,7 @@ public:
 
 	std::string GetFullName(); // get a fully classified name (C4ID::Name) for debug output
 
-	time_t tProfileTime; // internally set by profiler
+	std::uint64_t tProfileTime; // internally set by profiler (nanoseconds)
 
 	bool HasStrictNil() const noexcept;
 
@@ -411,24 +447,54 @@ private:
 	struct Entry
 	{
 		C4AulScriptFunc *pFunc;
-		time_t tProfileTime;
+		std::uint64_t tProfileTime;
 
 		bool operator<(const Entry &e2) const { return tProfileTime < e2.tProfileTime; }
 	};
 
+	// call tree entry, summed up per function
+	struct CallEntry
+	{
+		C4AulFunc *pFunc;
+		std::uint64_t iCalls, tInclusive, tExclusive;
+
+		bool operator<(const CallEntry &e2) const { return tExclusive < e2.tExclusive; }
+	};
+
+	// object search entry
+	struct SearchEntry
+	{
+		C4AulScriptFunc *pFunc;
+		int iLine;
+		uint32_t iCalls, iCandidates, iMatches;
+
+		bool operator<(const SearchEntry &e2) const { return iCandidates < e2.iCandidates; }
+	};
+
 	// items
 	std::vector<Entry> Times;
+	std::vector<SearchEntry> Searches;
+	std::vector<CallEntry> Calls;
+	std::string Stacks; // folded call stacks with exclusive time, one per line
+	std::uint64_t iCallCacheHits{0}, iCallCacheMisses{0};
 	std::shared_ptr<spdlog::logger> logger;
 
 public:
 	C4AulProfiler(std::shared_ptr<spdlog::logger> logger) : logger{std::move(logger)} {}
 
-	void CollectEntry(C4AulScriptFunc *pFunc, time_t tProfileTime);
+	void CollectEntry(C4AulScriptFunc *pFunc, std::uint64_t tProfileTime);
+	void CollectCallEntry(C4AulFunc *pFunc, std::uint64_t iCalls, std::uint64_t tInclusive, std::uint64_t tExclusive);
+	void CollectStack(std::string_view stack, std::uint64_t tExclusive);
+	void CollectSearchEntry(C4AulScriptFunc *pFunc, int iLine, uint32_t iCalls, uint32_t iCandidates, uint32_t iMatches);
+	void CollectCallCacheStats(std::uint64_t iHits, std::uint64_t iMisses);
 	void Show();
 
 	static void Abort();
 	static void StartProfiling(C4AulScript *pScript);
 	static void StopProfiling();
+	static bool IsProfiling();
+
+	static std::string GetFuncName(C4AulFunc *pFunc); // name for stacks and tables
 };
 
 C4LOGGERCONFIG_NAME_TYPE(C4AulProfiler);
@@ -480,11 +546,12 @@ protected:
 	C4AulFunc *GetOverloadedFunc(C4AulFunc *ByFunc);
 	C4AulFunc *GetFunc(const char *pIdtf); // get local function by name
 
-	void AddBCC(C4AulBCCType eType, std::intptr_t = 0, const char *SPos = nullptr); // add byte code chunk and advance
+	void AddBCC(C4AulBCCType eType, std::intptr_t = 0, std::uint32_t SPos = 0); // add byte code chunk and advance; SPos as in C4AulBCC
 	bool Preparse(); // preparse script; return if successful
-	void ParseFn(C4AulScriptFunc *Fn, bool fExprOnly = false); // parse single script function
+	void LinkOverload(C4AulScriptFunc *Fn); // find the function overloaded by a script function before its code is set
+	void ParseFn(C4AulScriptFunc *Fn, bool fExprOnly = false, C4AulCodeCache *pCache = nullptr); // parse single script function; the cache records the lookups the code depends on
 
-	bool Parse(); // parse preparsed script; return if successful
+	bool Parse(C4AulCodeCache *pCache = nullptr); // parse preparsed script, reusing cached byte code if possible; return if successful
 	void ParseDescs(); // parse function descs
 
 	bool ResolveIncludes(C4DefList *rDefs); // resolve includes
@@ -492,6 +559,7 @@ protected:
 	bool IncludesResolved;
 	void AppendTo(C4AulScript &Scr, bool bHighPrio); // append to given script
 	void UnLink(); // reset to unlinked state
+	void CollectStrings(std::unordered_set<const C4String *> &Strings) const; // add the strings referred to by the byte code of this script and its children
 	virtual void AfterLink(); // called after linking is completed; presearch common funcs here & search same-named funcs
 	virtual bool ReloadScript(const char *szPath); // reload given script
 
@@ -533,6 +601,7 @@ public:
 	friend class C4AulScriptFunc;
 	friend class C4AulScriptEngine;
 	friend class C4AulParseState;
+	friend class C4AulCodeCache;
 };
 
 // holds all C4AulScripts
@@ -559,6 +628,16 @@ public:
 	C4ValueMapNames GlobalConstNames;
 	C4ValueMapData GlobalConsts;
 
+	// object call inline caches
+	// pointers in here are only compared, so a cache left behind by a freed call site or definition is harmless until its address is reused;
+	// thus all caches are dropped when scripts are unlinked or definitions are removed
+	std::vector<C4AulCallCache> CallCaches;
+	std::uint64_t CallCacheHits{0}, CallCacheMisses{0};
+	static constexpr std::size_t MaxCallCaches = 65535; // index + 1 must fit into C4AulBCC::CallCache
+
+	// scripts taken from the byte code cache or parsed while it was enabled
+	std::uint64_t CodeCacheHits{0}, CodeCacheMisses{0};
+
 	C4AulScriptEngine();
 	~C4AulScriptEngine();
 	void Clear(); // clear data
@@ -589,7 +668,30 @@ public:
 	bool GetGlobalConstant(const char *szName, C4Value *pTargetValue); // check if a constant exists; assign value to pTargetValue if not nullptr
 
 	bool DenumerateVariablePointers();
-	void UnLink(); // called when a script is being reloaded (clears string table)
+	void UnLink(); // called when a script is being reloaded
+	void ReleaseUnusedStrings(); // release hold strings that are not used by any byte code anymore
+
+	// look up the function cached at an object call site for the given target definition
+	bool GetCachedCall(const C4AulBCC *pSite, const C4Def *pDef, C4AulFunc *&pFunc)
+	{
+		if (pSite->CallCache && pSite->CallCache <= CallCaches.size())
+		{
+			const C4AulCallCache &Cache = CallCaches[pSite->CallCache - 1];
+			if (Cache.pSite == pSite)
+				for (std::size_t i = 0; i < Cache.iCount; ++i)
+					if (Cache.Defs[i] == pDef)
+					{
+						pFunc = Cache.Funcs[i];
+						++CallCacheHits;
+						return true;
+					}
+		}
+		++CallCacheMisses;
+		return false;
+	}
+
+	void CacheCall(C4AulBCC *pSite, C4Def *pDef, C4AulFunc *pFunc); // remember the function found at an object call site
+	void ClearCallCaches(); // forget all cached object call functions
 	// Compile scenario script data (without strings and constants)
 	void CompileFunc(StdCompiler *pComp);
 
@@ -0,0 +1,520 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4AulCodeCache.h>
+
+#include <C4Config.h>
+#include <C4Def.h>
+#include <C4Log.h>
+#include <C4Version.h>
+#include <C4Wrappers.h>
+#include <StdAdaptors.h>
+#include <StdCompiler.h>
+
+#include <algorithm>
+#include <format>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
+namespace
+{
+	bool RefersToFunc(C4AulBCCType eType)
+	{
+		return eType == AB_FUNC || eType == AB_CALL || eType == AB_CALLFS || eType == AB_CALLGLOBAL;
+	}
+
+	bool RefersToString(C4AulBCCType eType)
+	{
+		return eType == AB_STRING || eType == AB_MAPA_R || eType == AB_MAPA_V;
+	}
+}
+
+void C4AulCodeCache::Lookup::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(Type);
+	pComp->Value(Func);
+	pComp->Value(Name);
+	pComp->Value(Arg);
+	pComp->Value(Index);
+	pComp->Value(Alias);
+	pComp->Value(Result);
+}
+
+void C4AulCodeCache::Chunk::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(Type);
+	pComp->Value(X);
+	pComp->Value(SPos);
+}
+
+void C4AulCodeCache::String::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(Data);
+	pComp->Value(Hold);
+}
+
+void C4AulCodeCache::Entry::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Raw(Hash.data(), Hash.size());
+	pComp->Value(LastUse);
+	pComp->Value(mkSTLContainerAdapt(Lookups));
+	pComp->Value(mkSTLContainerAdapt(FuncOffsets));
+	pComp->Value(mkSTLContainerAdapt(Code));
+	pComp->Value(mkSTLContainerAdapt(Strings));
+}
+
+void C4AulCodeCache::CompileFunc(StdCompiler *pComp)
+{
+	std::uint32_t version{FormatVersion};
+	pComp->Value(version);
+	if (version != FormatVersion) pComp->excCorrupt("script code cache has format version {}, expected {}", version, FormatVersion);
+	pComp->Value(Generation);
+	pComp->Value(mkSTLContainerAdapt(Entries));
+}
+
+void C4AulCodeCache::CalcKey(C4AulScript &script, const std::vector<C4AulScriptFunc *> &funcs, Key &result) const
+{
+	StdSha1 sha1;
+	const auto addValue = [&sha1](const auto value) { sha1.Update(&value, sizeof(value)); };
+	const auto addString = [&sha1, &addValue](const std::string_view string)
+	{
+		addValue(static_cast<std::uint32_t>(string.size()));
+		sha1.Update(string.data(), string.size());
+	};
+	const auto addScript = [&addValue, &addString](const C4AulScript &script)
+	{
+		addValue(script.Strict);
+		addString({script.Script.getData() ? script.Script.getData() : "", script.Script.getLength()});
+	};
+
+	// engine and code generation settings
+	addString(C4VERSION);
+	addValue(FormatVersion);
+	addValue(AB_INT_OP);
+	addValue(Config.Developer.OptimizeScripts);
+	addValue(static_cast<C4AulScriptStrict>(Config.Developer.OptimizeScriptsStrictness));
+
+	addScript(script);
+	addValue(script.Def != nullptr);
+
+	// parsed functions, which may come from appended or included scripts
+	std::vector<const C4AulScript *> orgScripts;
+	for (const C4AulScriptFunc *const Fn : funcs)
+	{
+		addString(Fn->Name);
+		addValue(Fn->Owner == script.Engine);
+		addValue(Fn->Access);
+		const auto org = std::ranges::find(orgScripts, Fn->pOrgScript);
+		addValue(static_cast<std::uint32_t>(org - orgScripts.begin()));
+		if (org == orgScripts.end())
+		{
+			orgScripts.push_back(Fn->pOrgScript);
+			addScript(*Fn->pOrgScript);
+		}
+		addValue(static_cast<std::int64_t>(Fn->Script - Fn->pOrgScript->Script.getData()));
+	}
+
+	sha1.GetHash(result.data());
+}
+
+std::vector<C4AulScriptFunc *> C4AulCodeCache::GetCodeFuncs(C4AulScript &script)
+{
+	// same selection as in C4AulScript::Parse
+	std::vector<C4AulScriptFunc *> funcs;
+	for (C4AulFunc *f = script.Func0; f; f = f->Next)
+	{
+		C4AulScriptFunc *Fn;
+		if (!(Fn = f->SFunc()))
+		{
+			if (f->LinkedTo) Fn = f->LinkedTo->SFunc();
+			if (Fn) if (Fn->Owner != script.Engine) Fn = nullptr;
+		}
+		if (Fn) funcs.push_back(Fn);
+	}
+	return funcs;
+}
+
+C4AulFunc *C4AulCodeCache::FindFunc(C4AulScript &script, const LookupType type, const char *const szName, const std::int64_t iArg)
+{
+	switch (type)
+	{
+	case LookupType::Func:
+		switch (iArg)
+		{
+		case 0: return script.GetFuncRecursive(szName);
+		case 1: return script.Owner ? script.Owner->GetFuncRecursive(szName) : nullptr;
+		case 2: return script.Engine->GetFuncRecursive(szName);
+		default: return nullptr;
+		}
+
+	case LookupType::DefFunc:
+	{
+		C4Def *const pDef{C4Id2Def(static_cast<C4ID>(iArg))};
+		return pDef ? pDef->Script.GetSFunc(szName) : nullptr;
+	}
+
+	case LookupType::GlobalFunc:
+		return script.Engine->GetFunc(szName, script.Engine, nullptr);
+
+	case LookupType::FirstFunc:
+		return script.Engine->GetFirstFunc(szName);
+
+	default:
+		return nullptr;
+	}
+}
+
+bool C4AulCodeCache::FuncTakesRef(C4AulScriptEngine &engine, const C4AulFunc *const pFunc, const std::int32_t iPar)
+{
+	// the call may end up in any function with the same name
+	for (const C4AulFunc *pFunc2 = pFunc; pFunc2; pFunc2 = engine.GetNextSNFunc(pFunc2))
+	{
+		auto *const pF = const_cast<C4AulFunc *>(pFunc2);
+		if (pF->GetParCount() > iPar && pF->GetParType()[iPar] == C4V_pC4Value) return true;
+	}
+	return false;
+}
+
+std::int32_t C4AulCodeCache::FindVar(C4AulScript &script, const LookupType type, const char *const szName)
+{
+	switch (type)
+	{
+	case LookupType::Local: return script.LocalNamed.GetItemNr(szName);
+	case LookupType::Global: return script.Engine->GlobalNamedNames.GetItemNr(szName);
+	default: return -1;
+	}
+}
+
+std::string C4AulCodeCache::DescribeFunc(C4AulFunc *const pFunc, C4AulScript *const pCaller)
+{
+	if (!pFunc) return {};
+	// parameters decide the number of parameters parsed and whether they are passed as references
+	std::string result{std::format("{}:", pFunc->GetParCount())};
+	if (const C4V_Type *const pTypes{pFunc->GetParType()})
+		for (int i = 0; i < pFunc->GetParCount(); ++i) result += std::format("{},", std::to_underlying(pTypes[i]));
+	// the access check fails parsing, but is not done for all lookups
+	const C4AulScriptFunc *const pSFunc{pFunc->SFunc()};
+	result += pSFunc && pSFunc->Access < pCaller->GetAllowedAccess(pFunc, pCaller) ? ":denied" : ":allowed";
+	return result;
+}
+
+std::string C4AulCodeCache::DescribeConstant(C4AulScriptEngine &engine, const char *const szName)
+{
+	C4Value value;
+	if (!engine.GetGlobalConstant(szName, &value)) return {};
+	return std::format("{}:{}", std::to_underlying(value.GetType()), value.GetDataString());
+}
+
+void C4AulCodeCache::Init(C4AulScriptEngine &engine, const char *const szFilename)
+{
+	Engine = &engine;
+	Filename = szFilename;
+
+	StdBuf buf;
+	if (buf.LoadFromFile(szFilename))
+	{
+		try
+		{
+			CompileFromBuf<StdCompilerBinRead>(*this, buf);
+		}
+		catch (const StdCompiler::Exception &)
+		{
+			// damaged or outdated: start over
+			Generation = 0;
+			Entries.clear();
+		}
+	}
+
+	++Generation;
+	EntryIndices.clear();
+	for (std::size_t i = 0; i < Entries.size(); ++i)
+		EntryIndices.insert_or_assign(Entries[i].Hash, i);
+}
+
+bool C4AulCodeCache::Load(C4AulScript &script)
+{
+	Current = nullptr;
+	// temporary scripts are parsed on their own
+	if (script.Temporary) return false;
+
+	const auto funcs = GetCodeFuncs(script);
+	Current = &script;
+	CalcKey(script, funcs, CurrentHash);
+	CurrentCacheable = true;
+	Recorded.clear();
+	RecordedFuncs.clear();
+	ParsedFuncs.clear();
+
+	const auto it = EntryIndices.find(CurrentHash);
+	if (it == EntryIndices.end() || !LoadEntry(script, funcs, Entries[it->second]))
+	{
+		++Engine->CodeCacheMisses;
+		return false;
+	}
+	Entries[it->second].LastUse = Generation;
+	++Engine->CodeCacheHits;
+	return true;
+}
+
+bool C4AulCodeCache::LoadEntry(C4AulScript &script, const std::vector<C4AulScriptFunc *> &funcs, const Entry &entry)
+{
+	// the cache file might be damaged, so check everything that is turned into a pointer
+	if (funcs.size() != entry.FuncOffsets.size() || entry.Code.empty()) return false;
+	const auto size = entry.Code.size();
+	for (std::size_t i = 0; i < funcs.size(); ++i)
+		if (entry.FuncOffsets[i] < 0 || static_cast<std::size_t>(entry.FuncOffsets[i]) >= size || (i && entry.FuncOffsets[i] < entry.FuncOffsets[i - 1]))
+			return false;
+	if (entry.Code.back().Type != AB_EOF) return false;
+
+	// repeat the lookups of the parser in the order it did them, linking overloads on the way like ParseFn
+	std::vector<C4AulFunc *> found(entry.Lookups.size(), nullptr);
+	std::size_t linked = 0;
+	for (std::size_t i = 0; i < entry.Lookups.size(); ++i)
+	{
+		const Lookup &lookup = entry.Lookups[i];
+		// each function starts with its overload lookup, followed by the lookups while parsing it
+		if (lookup.Type == std::to_underlying(LookupType::Overloaded) ? static_cast<std::size_t>(lookup.Func) != linked++ : static_cast<std::size_t>(lookup.Func) + 1 != linked) return false;
+		if (lookup.Func < 0 || static_cast<std::size_t>(lookup.Func) >= funcs.size()) return false;
+		C4AulScriptFunc *const Fn{funcs[lookup.Func]};
+		const char *const szName{lookup.Name.c_str()};
+
+		std::string result;
+		switch (const auto type = static_cast<LookupType>(lookup.Type))
+		{
+		case LookupType::Overloaded:
+			script.LinkOverload(Fn);
+			found[i] = Fn->OwnerOverloaded;
+			result = DescribeFunc(found[i], Fn->pOrgScript);
+			break;
+
+		case LookupType::Func: case LookupType::DefFunc: case LookupType::GlobalFunc: case LookupType::FirstFunc:
+			found[i] = FindFunc(script, type, szName, lookup.Arg);
+			result = DescribeFunc(found[i], Fn->pOrgScript);
+			break;
+
+		case LookupType::TakesRef:
+		{
+			const C4AulFunc *pFunc{nullptr};
+			if (lookup.Arg >= 0 && static_cast<std::size_t>(lookup.Arg) < i) pFunc = found[lookup.Arg];
+			else if (lookup.Arg < 0 && static_cast<std::size_t>(-lookup.Arg - 1) < funcs.size()) pFunc = funcs[-lookup.Arg - 1];
+			if (!pFunc) return false;
+			result = FuncTakesRef(*Engine, pFunc, lookup.Index) ? "1" : "0";
+			break;
+		}
+
+		case LookupType::Local: case LookupType::Global:
+			result = std::to_string(FindVar(script, type, szName));
+			break;
+
+		case LookupType::Constant:
+			result = DescribeConstant(*Engine, szName);
+			break;
+
+		default:
+			return false;
+		}
+
+		if (result != lookup.Result) return false;
+		// code refers to the first lookup that found a function, so all others must still find the same one
+		if (lookup.Alias >= 0 && (static_cast<std::size_t>(lookup.Alias) >= i || found[lookup.Alias] != found[i])) return false;
+	}
+	if (linked != funcs.size()) return false;
+
+	std::vector<C4String *> strings(entry.Strings.size(), nullptr);
+	auto code = std::make_unique<C4AulBCC[]>(size);
+	std::size_t func = 0;
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		const Chunk &chunk = entry.Code[i];
+		if (chunk.Type < 0 || chunk.Type > AB_INT_OP) return false;
+		while (func + 1 < funcs.size() && static_cast<std::size_t>(entry.FuncOffsets[func + 1]) <= i) ++func;
+
+		C4AulBCC &bcc = code[i];
+		bcc.bccType = static_cast<C4AulBCCType>(chunk.Type);
+		bcc.CallCache = 0;
+		if (RefersToFunc(bcc.bccType))
+		{
+			if (chunk.X < 0 || chunk.X >= static_cast<std::int64_t>(found.size()) || !found[chunk.X]) return false;
+			bcc.bccX = reinterpret_cast<std::intptr_t>(found[chunk.X]);
+		}
+		else if (RefersToString(bcc.bccType))
+		{
+			if (chunk.X < 0 || chunk.X >= static_cast<std::int64_t>(strings.size())) return false;
+			C4String *&string = strings[chunk.X];
+			if (!string)
+			{
+				string = Engine->Strings.RegString(entry.Strings[chunk.X].Data.c_str());
+				if (entry.Strings[chunk.X].Hold) string->Hold = true;
+			}
+			bcc.bccX = reinterpret_cast<std::intptr_t>(string);
+		}
+		else
+			bcc.bccX = static_cast<std::intptr_t>(chunk.X);
+
+		bcc.SPos = 0;
+		if (chunk.SPos >= 0)
+		{
+			if (funcs.empty()) return false;
+			const StdStrBuf &text = funcs[func]->pOrgScript->Script;
+			if (static_cast<std::size_t>(chunk.SPos) > text.getLength()) return false;
+			bcc.SPos = static_cast<std::uint32_t>(chunk.SPos) + 1;
+		}
+	}
+
+	// everything fine: replace the code as C4AulScript::Parse would
+	delete[] script.Code;
+	script.Code = code.release();
+	script.CodeSize = script.CodeBufSize = static_cast<int>(size);
+	script.CPos = script.Code + size;
+	for (std::size_t i = 0; i < funcs.size(); ++i)
+		funcs[i]->Code = script.Code + entry.FuncOffsets[i];
+	return true;
+}
+
+void C4AulCodeCache::BeginFunc(C4AulScriptFunc &func)
+{
+	if (!Current) return;
+	ParsedFuncs.push_back(&func);
+	// the overloaded function was just linked by ParseFn
+	RecordFunc(LookupType::Overloaded, func.Name, 0, func.OwnerOverloaded);
+}
+
+void C4AulCodeCache::Record(const LookupType type, const char *const szName, const std::int64_t iArg, const std::int32_t iIndex, C4AulFunc *const pFunc, std::string result)
+{
+	if (!Current || ParsedFuncs.empty()) return;
+	std::int32_t iAlias{-1};
+	if (pFunc)
+	{
+		const auto it = std::ranges::find(RecordedFuncs, pFunc);
+		if (it != RecordedFuncs.end()) iAlias = static_cast<std::int32_t>(it - RecordedFuncs.begin());
+	}
+	Recorded.push_back({std::to_underlying(type), static_cast<std::int32_t>(ParsedFuncs.size() - 1), szName ? szName : "", iArg, iIndex, iAlias, std::move(result)});
+	RecordedFuncs.push_back(pFunc);
+}
+
+void C4AulCodeCache::RecordFunc(const LookupType type, const char *const szName, const std::int64_t iArg, C4AulFunc *const pFunc)
+{
+	if (!Current || ParsedFuncs.empty()) return;
+	Record(type, szName, iArg, 0, pFunc, DescribeFunc(pFunc, ParsedFuncs.back()->pOrgScript));
+}
+
+void C4AulCodeCache::RecordTakesRef(const C4AulFunc *const pFunc, const std::int32_t iPar, const bool fResult)
+{
+	if (!Current || ParsedFuncs.empty()) return;
+	// refer to the function by the lookup that found it or as one of the parsed functions
+	std::int64_t iArg;
+	if (const auto it = std::ranges::find(RecordedFuncs, pFunc); it != RecordedFuncs.end())
+		iArg = it - RecordedFuncs.begin();
+	else if (const auto it = std::ranges::find(ParsedFuncs, pFunc); it != ParsedFuncs.end())
+		iArg = -(it - ParsedFuncs.begin()) - 1;
+	else
+	{
+		CurrentCacheable = false;
+		return;
+	}
+	Record(LookupType::TakesRef, nullptr, iArg, iPar, nullptr, fResult ? "1" : "0");
+}
+
+void C4AulCodeCache::RecordVar(const LookupType type, const char *const szName, const std::int32_t iResult)
+{
+	Record(type, szName, 0, 0, nullptr, std::to_string(iResult));
+}
+
+void C4AulCodeCache::RecordConstant(const char *const szName)
+{
+	if (!Current) return;
+	Record(LookupType::Constant, szName, 0, 0, nullptr, DescribeConstant(*Engine, szName));
+}
+
+void C4AulCodeCache::Store(C4AulScript &script, const bool cacheable)
+{
+	if (Current != &script) return;
+	Current = nullptr;
+	if (!cacheable || !CurrentCacheable) return;
+
+	const auto funcs = GetCodeFuncs(script);
+	if (funcs != ParsedFuncs) return;
+
+	Entry entry;
+	entry.Hash = CurrentHash;
+	entry.LastUse = Generation;
+	for (const C4AulScriptFunc *const Fn : funcs)
+		entry.FuncOffsets.push_back(static_cast<std::int32_t>(Fn->Code - script.Code));
+
+	std::unordered_map<const C4String *, std::size_t> stringIndices;
+	std::size_t func = 0;
+	for (std::size_t i = 0; i < static_cast<std::size_t>(script.CodeSize); ++i)
+	{
+		const C4AulBCC &bcc = script.Code[i];
+		while (func + 1 < funcs.size() && static_cast<std::size_t>(entry.FuncOffsets[func + 1]) <= i) ++func;
+
+		Chunk chunk{static_cast<std::int32_t>(bcc.bccType), static_cast<std::int64_t>(bcc.bccX), -1};
+		if (RefersToFunc(bcc.bccType))
+		{
+			// every function in the code was found by a recorded lookup
+			const auto found = std::ranges::find(RecordedFuncs, reinterpret_cast<const C4AulFunc *>(bcc.bccX));
+			if (!bcc.bccX || found == RecordedFuncs.end()) return;
+			chunk.X = found - RecordedFuncs.begin();
+		}
+		else if (RefersToString(bcc.bccType))
+		{
+			const auto *const string = reinterpret_cast<const C4String *>(bcc.bccX);
+			if (!string) return;
+			const auto [found, added] = stringIndices.try_emplace(string, entry.Strings.size());
+			if (added) entry.Strings.push_back({std::string{string->GetView()}, string->Hold});
+			chunk.X = static_cast<std::int64_t>(found->second);
+		}
+
+		if (bcc.SPos)
+		{
+			if (funcs.empty()) return;
+			const StdStrBuf &text = funcs[func]->pOrgScript->Script;
+			if (bcc.SPos - 1 > text.getLength()) return;
+			chunk.SPos = static_cast<std::int32_t>(bcc.SPos - 1);
+		}
+
+		entry.Code.push_back(chunk);
+	}
+	entry.Lookups = std::move(Recorded);
+
+	const auto [it, added] = EntryIndices.try_emplace(entry.Hash, Entries.size());
+	if (added)
+		Entries.push_back(std::move(entry));
+	else
+		Entries[it->second] = std::move(entry);
+	for (const auto &[string, index] : stringIndices)
+		StoredStrings.push_back({it->second, index, string});
+	Changed = true;
+}
+
+void C4AulCodeCache::Save()
+{
+	if (!Changed) return;
+	// strings shared by literals and constants may have been held by later scripts
+	for (const auto &[entry, index, string] : StoredStrings)
+		Entries[entry].Strings[index].Hold = string->Hold;
+
+	// drop the least recently used scripts, e.g. of scenarios that were not played for long
+	if (Entries.size() > MaxEntries)
+	{
+		std::ranges::stable_sort(Entries, std::ranges::greater{}, &Entry::LastUse);
+		Entries.resize(MaxEntries);
+	}
+
+	if (!DecompileToBuf<StdCompilerBinWrite>(*this).SaveToFile(Filename.c_str()))
+		LogNTr(spdlog::level::warn, "Could not save script code cache to {}", Filename);
+}
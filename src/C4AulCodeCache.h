@@ -0,0 +1,154 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// on-disk cache of the byte code of scripts, so unchanged scripts are not parsed again on every start
+
+#pragma once
+
+#include "C4Aul.h"
+#include "StdSha1.h"
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+class StdCompiler;
+
+// Each script is cached on its own, keyed by a hash over its text, the texts of all functions appended or included into it,
+// their strictness and the engine version. Everything else the parser takes from other scripts (functions, variables, constants)
+// is recorded as a list of lookups; cached code is only taken if all of them still give the same results.
+// Function pointers in the code refer to the lookup that found them and strings are stored by content, so cached code
+// is still valid after other scripts changed, were loaded in a different order or belong to another scenario.
+class C4AulCodeCache
+{
+public:
+	static constexpr std::uint32_t FormatVersion = 2; // increase whenever the byte code generated for the same script changes
+	static constexpr std::size_t MaxEntries = 4096; // the least recently used scripts are dropped beyond this
+
+	using Key = std::array<std::uint8_t, StdSha1::DigestLength>;
+
+	// lookups of the parser outside of the parsed function
+	enum class LookupType : std::int32_t
+	{
+		Func, // function by name in the script (Arg 0), its owner (1) or the engine (2), including global functions
+		DefFunc, // script function of the definition with ID Arg
+		GlobalFunc, // global function (->global call)
+		FirstFunc, // any function with the name (object call)
+		TakesRef, // whether the function found by lookup Arg or any same-named one takes a reference as parameter Index
+		Overloaded, // function overloaded by the parsed function
+		Local, // local variable index
+		Global, // global variable index
+		Constant, // value of a global constant
+	};
+
+	struct Lookup
+	{
+		std::int32_t Type;
+		std::int32_t Func; // index of the parsed function
+		std::string Name;
+		std::int64_t Arg;
+		std::int32_t Index;
+		std::int32_t Alias; // index of the first lookup that found the same function; -1 for none
+		std::string Result; // description of everything the parser uses from the result
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	struct Chunk
+	{
+		std::int32_t Type;
+		std::int64_t X; // lookup or string index for chunks referring to functions or strings
+		std::int32_t SPos; // offset into the script of the function; -1 for none
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	struct String
+	{
+		std::string Data;
+		bool Hold; // string literal, which has to stay in the string table
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	struct Entry
+	{
+		Key Hash{};
+		std::uint32_t LastUse{0}; // generation of the last start that stored or loaded the entry
+		std::vector<Lookup> Lookups;
+		std::vector<std::int32_t> FuncOffsets; // code position of each parsed function
+		std::vector<Chunk> Code;
+		std::vector<String> Strings;
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+private:
+	std::uint32_t Generation{0};
+	std::vector<Entry> Entries;
+
+	// not stored
+	C4AulScriptEngine *Engine{nullptr};
+	std::string Filename;
+	bool Changed{false}; // whether any script was stored
+	std::map<Key, std::size_t> EntryIndices;
+	struct StoredString
+	{
+		std::size_t Entry, Index;
+		const C4String *Str;
+	};
+	std::vector<StoredString> StoredStrings; // strings of entries stored in this run
+
+	// script that is currently parsed
+	C4AulScript *Current{nullptr};
+	Key CurrentHash{};
+	bool CurrentCacheable{false}; // false if the parser used a function that was not found by a recorded lookup
+	std::vector<Lookup> Recorded;
+	std::vector<C4AulFunc *> RecordedFuncs; // result of each function lookup
+	std::vector<C4AulScriptFunc *> ParsedFuncs;
+
+	void CalcKey(C4AulScript &script, const std::vector<C4AulScriptFunc *> &funcs, Key &result) const;
+	bool LoadEntry(C4AulScript &script, const std::vector<C4AulScriptFunc *> &funcs, const Entry &entry);
+	void Record(LookupType type, const char *szName, std::int64_t iArg, std::int32_t iIndex, C4AulFunc *pFunc, std::string result);
+	static std::vector<C4AulScriptFunc *> GetCodeFuncs(C4AulScript &script);
+
+public:
+	C4AulCodeCache() = default;
+	C4AulCodeCache(const C4AulCodeCache &) = delete;
+	C4AulCodeCache &operator=(const C4AulCodeCache &) = delete;
+
+	void Init(C4AulScriptEngine &engine, const char *szFilename); // load the cache file
+	bool Load(C4AulScript &script); // put the cached byte code into the script; return false if it must be parsed
+	void Store(C4AulScript &script, bool cacheable); // remember the freshly parsed byte code of the script
+	void Save(); // write the cache file if any script was stored
+
+	// lookups done by the parser, which are repeated the same way when cached code is loaded
+	static C4AulFunc *FindFunc(C4AulScript &script, LookupType type, const char *szName, std::int64_t iArg);
+	static bool FuncTakesRef(C4AulScriptEngine &engine, const C4AulFunc *pFunc, std::int32_t iPar);
+	static std::int32_t FindVar(C4AulScript &script, LookupType type, const char *szName);
+	static std::string DescribeFunc(C4AulFunc *pFunc, C4AulScript *pCaller);
+	static std::string DescribeConstant(C4AulScriptEngine &engine, const char *szName);
+
+	// record the lookups of the parser for the stored entry
+	void BeginFunc(C4AulScriptFunc &func);
+	void RecordFunc(LookupType type, const char *szName, std::int64_t iArg, C4AulFunc *pFunc);
+	void RecordTakesRef(const C4AulFunc *pFunc, std::int32_t iPar, bool fResult);
+	void RecordVar(LookupType type, const char *szName, std::int32_t iResult);
+	void RecordConstant(const char *szName);
+
+	void CompileFunc(StdCompiler *pComp);
+};
@@ -26,7 +26,21 @@
 #include <C4ValueHash.h>
 #include <C4Wrappers.h>
 
+#include <chrono>
 #include <format>
+#include <unordered_map>
+#include <utility>
+
+// where the compiler supports it, every chunk type that simply continues with the next chunk jumps to that chunk's label directly
+// instead of going back through the switch, so each one gets its own branch prediction (threaded code)
+#if defined(__GNUC__)
+#define C4AUL_COMPUTED_GOTO
+#define C4AUL_OP(type) case type: Op_##type
+#define C4AUL_NEXT do { ++pCPos; goto *DispatchTable[pCPos->bccType]; } while (false)
+#else
+#define C4AUL_OP(type) case type
+#define C4AUL_NEXT break
+#endif
 
 C4AulExecError::C4AulExecError(C4Object *pObj, const std::string_view error)
 	: cObj(pObj)
@@ -102,11 +116,19 @@ void C4AulScriptContext::dump(std::string Dump)
 	if (!fDirectExec && Func->Owner)
 		Dump += std::format(" ({}:{})",
 			Func->pOrgScript->ScriptName,
-			SGetLine(Func->pOrgScript->GetScript(), CPos ? CPos->SPos : Func->Script));
+			SGetLine(Func->pOrgScript->GetScript(), CPos && CPos->SPos ? CPos->GetSPos(Func->pOrgScript->GetScript()) : Func->Script));
 	// Log it
 	DebugLog(Dump);
 }
 
+// S= and ne: strings are interned, nil equals the empty string
+static bool StringsEqual(const C4String *pStr1, const C4String *pStr2)
+{
+	if (pStr1 == pStr2) return true;
+	if (pStr1 && pStr2) return false;
+	return !(pStr1 ? pStr1 : pStr2)->Data.getLength();
+}
+
 class C4AulExec
 {
 public:
@@ -123,9 +145,21 @@ private:
 	std::shared_ptr<spdlog::logger> traceLogger;
 	int iTraceStart;
 	bool fProfiling;
-	time_t tDirectExecStart, tDirectExecTotal; // profiler time for DirectExec
+	std::uint64_t tDirectExecStart, tDirectExecTotal; // profiler time for DirectExec
 	C4AulScript *pProfiledScript;
 
+	// profiler call tree; node 0 is the root
+	struct ProfileNode
+	{
+		C4AulFunc *pFunc;
+		std::size_t iParent;
+		std::uint64_t iCalls{0}, tInclusive{0}, tChildren{0}; // times in nanoseconds
+		std::unordered_map<C4AulFunc *, std::size_t> Children;
+	};
+	std::vector<ProfileNode> ProfileNodes;
+	std::size_t iProfileNode; // node of the function currently executed
+	std::uint32_t iProfileRun{0}; // counts profiler starts, so calls can tell whether their node is still valid
+
 public:
 	C4Value Exec(C4AulScriptFunc *pSFunc, C4Object *pObj, const C4Value pPars[], bool fPassErrors, bool fTemporaryScript = false);
 	C4Value Exec(C4AulBCC *pCPos, bool fPassErrors);
@@ -133,9 +167,45 @@ public:
 	void StartTrace();
 	void StartProfiling(C4AulScript *pScript); // resets profling times and starts recording the times
 	void StopProfiling(); // stop the profiler and displays results
-	void AbortProfiling() { fProfiling = false; }
-	inline void StartDirectExec() { if (fProfiling) tDirectExecStart = timeGetTime(); }
-	inline void StopDirectExec() { if (fProfiling) tDirectExecTotal += timeGetTime() - tDirectExecStart; }
+	void AbortProfiling() { fProfiling = false; ProfileNodes.clear(); }
+	bool IsProfiling() const { return fProfiling; }
+	inline void StartDirectExec() { if (fProfiling) tDirectExecStart = ProfilerTime(); }
+	inline void StopDirectExec() { if (fProfiling) tDirectExecTotal += ProfilerTime() - tDirectExecStart; }
+
+private:
+	static std::uint64_t ProfilerTime()
+	{
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	// find or add a call tree node for a function called in the current node and make it current; returns the new node
+	std::size_t EnterProfileNode(C4AulFunc *pFunc)
+	{
+		auto &children = ProfileNodes[iProfileNode].Children;
+		std::size_t iNode;
+		if (const auto it = children.find(pFunc); it != children.end())
+			iNode = it->second;
+		else
+		{
+			iNode = ProfileNodes.size();
+			children.emplace(pFunc, iNode);
+			ProfileNodes.push_back({pFunc, iProfileNode});
+		}
+		++ProfileNodes[iNode].iCalls;
+		iProfileNode = iNode;
+		return iNode;
+	}
+
+	// add time spent since tStart to a call tree node and return to its caller
+	void LeaveProfileNode(std::size_t iNode, std::size_t iParent, std::uint64_t tStart)
+	{
+		const std::uint64_t dt{ProfilerTime() - tStart};
+		ProfileNodes[iNode].tInclusive += dt;
+		ProfileNodes[iParent].tChildren += dt;
+		iProfileNode = iParent;
+	}
+
+	void CollectProfileNodes(C4AulProfiler &rProfiler);
 
 private:
 	void PushContext(const C4AulScriptContext &rContext)
@@ -151,7 +221,13 @@ private:
 			pCurCtx->dump(std::move(buf));
 		}
 		// Profiler: Safe time to measure difference afterwards
-		if (fProfiling) pCurCtx->tTime = timeGetTime();
+		if (fProfiling)
+		{
+			pCurCtx->iProfileParent = iProfileNode;
+			// temporary functions are gone when the results are shown
+			pCurCtx->iProfileNode = EnterProfileNode(pCurCtx->TemporaryScript ? nullptr : pCurCtx->Func);
+			pCurCtx->tTime = ProfilerTime();
+		}
 	}
 
 	void PopContext()
@@ -161,9 +237,9 @@ private:
 		// Profiler adding up times
 		if (fProfiling)
 		{
-			time_t dt = timeGetTime() - pCurCtx->tTime;
-			if (dt && pCurCtx->Func)
-				pCurCtx->Func->tProfileTime += dt;
+			if (pCurCtx->Func)
+				pCurCtx->Func->tProfileTime += ProfilerTime() - pCurCtx->tTime;
+			LeaveProfileNode(pCurCtx->iProfileNode, pCurCtx->iProfileParent, pCurCtx->tTime);
 		}
 		// Trace done?
 		if (iTraceStart >= 0)
@@ -209,6 +285,12 @@ private:
 		(++pCurVal)->Set(rVal);
 	}
 
+	void PushValue(C4Value &&rVal)
+	{
+		CheckOverflow(1);
+		(++pCurVal)->Set(std::move(rVal));
+	}
+
 	void PushValueRef(C4Value &rVal)
 	{
 		CheckOverflow(1);
@@ -370,52 +452,157 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 
 	try
 	{
+#ifdef C4AUL_COMPUTED_GOTO
+		// labels of the chunk types in the order of C4AulBCCType
+		static void *const DispatchTable[] =
+		{
+			&&Op_AB_DEREF,
+			&&Op_AB_MAPA_R,
+			&&Op_AB_MAPA_V,
+			&&Op_AB_ARRAYA_R,
+			&&Op_AB_ARRAYA_V,
+			&&Op_AB_ARRAY_APPEND,
+			&&Op_AB_VARN_R,
+			&&Op_AB_VARN_V,
+			&&Op_AB_PARN_R,
+			&&Op_AB_PARN_V,
+			&&Op_AB_LOCALN_R,
+			&&Op_AB_LOCALN_V,
+			&&Op_AB_GLOBALN_R,
+			&&Op_AB_GLOBALN_V,
+			&&Op_AB_VAR_R,
+			&&Op_AB_VAR_V,
+			&&Op_AB_PAR_R,
+			&&Op_AB_PAR_V,
+			&&Op_AB_FUNC,
+			&&Op_AB_Inc1,
+			&&Op_AB_Dec1,
+			&&Op_AB_BitNot,
+			&&Op_AB_Not,
+			&&Op_AB_Neg,
+			&&Op_AB_Inc1_Postfix,
+			&&Op_AB_Dec1_Postfix,
+			&&Op_AB_Pow,
+			&&Op_AB_Div,
+			&&Op_AB_Mul,
+			&&Op_AB_Mod,
+			&&Op_AB_Sub,
+			&&Op_AB_Sum,
+			&&Op_AB_LeftShift,
+			&&Op_AB_RightShift,
+			&&Op_AB_LessThan,
+			&&Op_AB_LessThanEqual,
+			&&Op_AB_GreaterThan,
+			&&Op_AB_GreaterThanEqual,
+			&&Op_AB_Concat,
+			&&Op_AB_EqualIdent,
+			&&Op_AB_Equal,
+			&&Op_AB_NotEqualIdent,
+			&&Op_AB_NotEqual,
+			&&Op_AB_SEqual,
+			&&Op_AB_SNEqual,
+			&&Op_AB_BitAnd,
+			&&Op_AB_BitXOr,
+			&&Op_AB_BitOr,
+			&&Op_AB_And,
+			&&Op_AB_Or,
+			&&Op_AB_NilCoalescing,
+			&&Op_AB_PowIt,
+			&&Op_AB_MulIt,
+			&&Op_AB_DivIt,
+			&&Op_AB_ModIt,
+			&&Op_AB_Inc,
+			&&Op_AB_Dec,
+			&&Op_AB_LeftShiftIt,
+			&&Op_AB_RightShiftIt,
+			&&Op_AB_ConcatIt,
+			&&Op_AB_AndIt,
+			&&Op_AB_OrIt,
+			&&Op_AB_XOrIt,
+			&&Op_AB_NilCoalescingIt,
+			&&Op_AB_Set,
+			&&Op_AB_CALLGLOBAL,
+			&&Op_AB_CALL,
+			&&Op_AB_CALLFS,
+			&&Op_AB_CALLNS,
+			&&Op_AB_STACK,
+			&&Op_AB_NIL,
+			&&Op_AB_INT,
+			&&Op_AB_BOOL,
+			&&Op_AB_STRING,
+			&&Op_AB_C4ID,
+			&&Op_AB_ARRAY,
+			&&Op_AB_MAP,
+			&&Op_AB_IVARN,
+			&&Op_AB_JUMP,
+			&&Op_AB_JUMPAND,
+			&&Op_AB_JUMPOR,
+			&&Op_AB_JUMPNIL,
+			&&Op_AB_JUMPNOTNIL,
+			&&Op_AB_CONDN,
+			&&Op_AB_FOREACH_NEXT,
+			&&Op_AB_FOREACH_MAP_NEXT,
+			&&Op_AB_RETURN,
+			&&Op_AB_ERR,
+			&&Op_AB_EOFN,
+			&&Op_AB_NilCoalescing, // AB_EOF is never executed
+			&&Op_AB_VARN_CMP_CONDN,
+			&&Op_AB_VARN_STEP,
+			&&Op_AB_VARN_ADDINT,
+			&&Op_AB_INT_OP,
+		};
+		static_assert(std::size(DispatchTable) == AB_INT_OP + 1);
+#endif
+
 		for (;;)
 		{
 			bool fJump = false;
+#ifdef C4AUL_COMPUTED_GOTO
+			goto *DispatchTable[pCPos->bccType];
+#endif
 			switch (pCPos->bccType)
 			{
-			case AB_NIL:
+			C4AUL_OP(AB_NIL):
 				PushValue(C4VNull);
-				break;
+				C4AUL_NEXT;
 
-			case AB_INT:
+			C4AUL_OP(AB_INT):
 				PushValue(C4VInt(static_cast<C4ValueInt>(pCPos->bccX)));
-				break;
+				C4AUL_NEXT;
 
-			case AB_BOOL:
+			C4AUL_OP(AB_BOOL):
 				PushValue(C4VBool(!!pCPos->bccX));
-				break;
+				C4AUL_NEXT;
 
-			case AB_STRING:
+			C4AUL_OP(AB_STRING):
 				PushString(reinterpret_cast<C4String *>(pCPos->bccX));
-				break;
+				C4AUL_NEXT;
 
-			case AB_C4ID:
+			C4AUL_OP(AB_C4ID):
 				PushValue(C4VID(static_cast<C4ID>(pCPos->bccX)));
-				break;
+				C4AUL_NEXT;
 
-			case AB_EOFN:
+			C4AUL_OP(AB_EOFN):
 				throw C4AulExecError(pCurCtx->Obj, "function didn't return");
 
-			case AB_ERR:
+			C4AUL_OP(AB_ERR):
 				throw C4AulExecError(pCurCtx->Obj, "syntax error: see previous parser error for details.");
 
-			case AB_PARN_R:
+			C4AUL_OP(AB_PARN_R):
 				PushValueRef(pCurCtx->Pars[pCPos->bccX]);
-				break;
-			case AB_PARN_V:
+				C4AUL_NEXT;
+			C4AUL_OP(AB_PARN_V):
 				PushValue(pCurCtx->Pars[pCPos->bccX]);
-				break;
+				C4AUL_NEXT;
 
-			case AB_VARN_R:
+			C4AUL_OP(AB_VARN_R):
 				PushValueRef(pCurCtx->Vars[pCPos->bccX]);
-				break;
-			case AB_VARN_V:
+				C4AUL_NEXT;
+			C4AUL_OP(AB_VARN_V):
 				PushValue(pCurCtx->Vars[pCPos->bccX]);
-				break;
+				C4AUL_NEXT;
 
-			case AB_LOCALN_R: case AB_LOCALN_V:
+			C4AUL_OP(AB_LOCALN_R): C4AUL_OP(AB_LOCALN_V):
 				if (!pCurCtx->Obj)
 					throw C4AulExecError(pCurCtx->Obj, "can't access local variables in a definition call!");
 				if (pCurCtx->Func->Owner->Def != pCurCtx->Obj->Def)
@@ -438,66 +625,66 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 					PushValueRef(*pCurCtx->Obj->LocalNamed.GetItem(pCPos->bccX));
 				else
 					PushValue(*pCurCtx->Obj->LocalNamed.GetItem(pCPos->bccX));
-				break;
+				C4AUL_NEXT;
 
-			case AB_GLOBALN_R:
+			C4AUL_OP(AB_GLOBALN_R):
 				PushValueRef(*Game.ScriptEngine.GlobalNamed.GetItem(pCPos->bccX));
-				break;
-			case AB_GLOBALN_V:
+				C4AUL_NEXT;
+			C4AUL_OP(AB_GLOBALN_V):
 				PushValue(*Game.ScriptEngine.GlobalNamed.GetItem(pCPos->bccX));
-				break;
+				C4AUL_NEXT;
 			// prefix
-			case AB_Inc1: // ++
+			C4AUL_OP(AB_Inc1): // ++
 				CheckOpPar<C4V_Int, false>(pCPos->bccX);
 				++pCurVal->GetData().Int;
 				pCurVal->HintType(C4V_Int);
-				break;
-			case AB_Dec1: // --
+				C4AUL_NEXT;
+			C4AUL_OP(AB_Dec1): // --
 				CheckOpPar<C4V_Int, false>(pCPos->bccX);
 				--pCurVal->GetData().Int;
 				pCurVal->HintType(C4V_Int);
-				break;
-			case AB_BitNot: // ~
+				C4AUL_NEXT;
+			C4AUL_OP(AB_BitNot): // ~
 				CheckOpPar<C4V_Any, false>(pCPos->bccX);
 				pCurVal->SetInt(~pCurVal->_getInt());
-				break;
-			case AB_Not: // !
+				C4AUL_NEXT;
+			C4AUL_OP(AB_Not): // !
 				CheckOpPar(pCPos->bccX);
 				pCurVal->SetBool(!pCurVal->_getRaw());
-				break;
-			case AB_Neg: // -
+				C4AUL_NEXT;
+			C4AUL_OP(AB_Neg): // -
 				CheckOpPar<C4V_Any, false>(pCPos->bccX);
 				pCurVal->SetInt(-pCurVal->_getInt());
-				break;
+				C4AUL_NEXT;
 			// postfix (whithout second statement)
-			case AB_Inc1_Postfix: // ++
+			C4AUL_OP(AB_Inc1_Postfix): // ++
 			{
 				CheckOpPar<C4V_Int, false>(pCPos->bccX);
 				auto &orig = pCurVal->GetRefVal();
 				pCurVal->SetInt(orig._getInt());
 				++orig.GetData().Int;
 				orig.HintType(C4V_Int);
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_Dec1_Postfix: // --
+			C4AUL_OP(AB_Dec1_Postfix): // --
 			{
 				CheckOpPar<C4V_Int, false>(pCPos->bccX);
 				auto &orig = pCurVal->GetRefVal();
 				pCurVal->SetInt(orig._getInt());
 				--orig.GetData().Int;
 				orig.HintType(C4V_Int);
-				break;
+				C4AUL_NEXT;
 			}
 			// postfix
-			case AB_Pow: // **
+			C4AUL_OP(AB_Pow): // **
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(Pow(pPar1->_getInt(), pPar2->_getInt()));
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_Div: // /
+			C4AUL_OP(AB_Div): // /
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -506,17 +693,17 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				else
 					pPar1->Set0();
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_Mul: // *
+			C4AUL_OP(AB_Mul): // *
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() * pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_Mod: // %
+			C4AUL_OP(AB_Mod): // %
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -525,74 +712,74 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				else
 					pPar1->Set0();
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_Sub: // -
+			C4AUL_OP(AB_Sub): // -
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() - pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_Sum: // +
+			C4AUL_OP(AB_Sum): // +
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() + pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_LeftShift: // <<
+			C4AUL_OP(AB_LeftShift): // <<
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() << pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_RightShift: // >>
+			C4AUL_OP(AB_RightShift): // >>
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() >> pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_LessThan: // <
+			C4AUL_OP(AB_LessThan): // <
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() < pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_LessThanEqual: // <=
+			C4AUL_OP(AB_LessThanEqual): // <=
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() <= pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_GreaterThan: // >
+			C4AUL_OP(AB_GreaterThan): // >
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() > pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_GreaterThanEqual: // >=
+			C4AUL_OP(AB_GreaterThanEqual): // >=
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() >= pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_Concat: // ..
-			case AB_ConcatIt: // ..=
+			C4AUL_OP(AB_Concat): // ..
+			C4AUL_OP(AB_ConcatIt): // ..=
 			{
 				const auto operatorName = C4ScriptOpMap[pCPos->bccX].Identifier;
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
@@ -649,204 +836,202 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 						}
 
 						par1String->Append(*par2String);
-						pPar1->SetString(new C4String(std::move(*par1String), &pCurCtx->Func->Owner->GetEngine()->Strings));
+						pPar1->SetString(pCurCtx->Func->Owner->GetEngine()->Strings.RegString(std::move(*par1String)));
 						PopValue();
 						break;
 					}
 				}
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_EqualIdent: // old ==
+			C4AUL_OP(AB_EqualIdent): // old ==
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->Equals(*pPar2, C4AulScriptStrict::NONSTRICT));
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_Equal: // new ==
+			C4AUL_OP(AB_Equal): // new ==
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->Equals(*pPar2, pCurCtx->Func->pOrgScript->Strict));
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_NotEqualIdent: // old !=
+			C4AUL_OP(AB_NotEqualIdent): // old !=
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(!pPar1->Equals(*pPar2, C4AulScriptStrict::NONSTRICT));
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_NotEqual: // new !=
+			C4AUL_OP(AB_NotEqual): // new !=
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(!pPar1->Equals(*pPar2, pCurCtx->Func->pOrgScript->Strict));
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_SEqual: // S=, eq
+			C4AUL_OP(AB_SEqual): // S=, eq
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
-				pPar1->SetBool(SEqual(pPar1->_getStr() ? pPar1->_getStr()->Data.getData() : "",
-					pPar2->_getStr() ? pPar2->_getStr()->Data.getData() : ""));
+				pPar1->SetBool(StringsEqual(pPar1->_getStr(), pPar2->_getStr()));
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_SNEqual: // ne
+			C4AUL_OP(AB_SNEqual): // ne
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
-				pPar1->SetBool(!SEqual(pPar1->_getStr() ? pPar1->_getStr()->Data.getData() : "",
-					pPar2->_getStr() ? pPar2->_getStr()->Data.getData() : ""));
+				pPar1->SetBool(!StringsEqual(pPar1->_getStr(), pPar2->_getStr()));
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_BitAnd: // &
+			C4AUL_OP(AB_BitAnd): // &
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() & pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_BitXOr: // ^
+			C4AUL_OP(AB_BitXOr): // ^
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() ^ pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_BitOr: // |
+			C4AUL_OP(AB_BitOr): // |
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() | pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_And: // &&
+			C4AUL_OP(AB_And): // &&
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getRaw() && pPar2->_getRaw());
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_Or: // ||
+			C4AUL_OP(AB_Or): // ||
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getRaw() || pPar2->_getRaw());
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
 
-			case AB_PowIt: // **=
+			C4AUL_OP(AB_PowIt): // **=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int = Pow(pPar1->GetData().Int, pPar2->_getInt());
 				pPar1->HintType(C4V_Int);
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_MulIt: // *=
+			C4AUL_OP(AB_MulIt): // *=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int *= pPar2->_getInt();
 				pCurVal->HintType(C4V_Int);
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_DivIt: // /=
+			C4AUL_OP(AB_DivIt): // /=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int = pPar2->_getInt() ? pPar1->GetData().Int / pPar2->_getInt() : 0;
 				pPar1->HintType(C4V_Int);
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_ModIt: // %=
+			C4AUL_OP(AB_ModIt): // %=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int = pPar2->_getInt() ? pPar1->GetData().Int % pPar2->_getInt() : 0;
 				pPar1->HintType(C4V_Int);
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_Inc: // +=
+			C4AUL_OP(AB_Inc): // +=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int += pPar2->_getInt();
 				pPar1->HintType(C4V_Int);
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_Dec: // -=
+			C4AUL_OP(AB_Dec): // -=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int -= pPar2->_getInt();
 				pPar1->HintType(C4V_Int);
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_LeftShiftIt: // <<=
+			C4AUL_OP(AB_LeftShiftIt): // <<=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int <<= pPar2->_getInt();
 				pPar1->HintType(C4V_Int);
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_RightShiftIt: // >>=
+			C4AUL_OP(AB_RightShiftIt): // >>=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int >>= pPar2->_getInt();
 				pPar1->HintType(C4V_Int);
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_AndIt: // &=
+			C4AUL_OP(AB_AndIt): // &=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int &= pPar2->_getInt();
 				pPar1->HintType(C4V_Int);
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_OrIt: // |=
+			C4AUL_OP(AB_OrIt): // |=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int |= pPar2->_getInt();
 				pPar1->HintType(C4V_Int);
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_XOrIt: // ^=
+			C4AUL_OP(AB_XOrIt): // ^=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->GetData().Int ^= pPar2->_getInt();
 				pPar1->HintType(C4V_Int);
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_NilCoalescingIt:
+			C4AUL_OP(AB_NilCoalescingIt):
 			{
 				if (pCurVal[0].GetType() != C4V_Any)
 				{
@@ -855,15 +1040,15 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				}
 				break;
 			}
-			case AB_Set: // =
+			C4AUL_OP(AB_Set): // =
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				*pPar1 = *pPar2;
 				PopValue();
-				break;
+				C4AUL_NEXT;
 			}
-			case AB_ARRAY:
+			C4AUL_OP(AB_ARRAY):
 			{
 				// Create array
 				C4ValueArray *pArray = new C4ValueArray(pCPos->bccX);
@@ -881,10 +1066,10 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				else
 					PushArray(pArray);
 
-				break;
+				C4AUL_NEXT;
 			}
 
-			case AB_MAP:
+			C4AUL_OP(AB_MAP):
 			{
 				C4ValueHash *map = new C4ValueHash;
 				for (int i = 0; i < pCPos->bccX; ++i)
@@ -900,10 +1085,10 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				else
 					PushMap(map);
 
-				break;
+				C4AUL_NEXT;
 			}
 
-			case AB_ARRAYA_R: case AB_ARRAYA_V:
+			C4AUL_OP(AB_ARRAYA_R): C4AUL_OP(AB_ARRAYA_V):
 			{
 				C4Value &Container = pCurVal[-1].GetRefVal();
 				C4Value &Index = pCurVal[0];
@@ -940,7 +1125,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 					{
 						StdStrBuf result;
 						result.AppendChar(str.getData()[index]);
-						pCurVal[-1].SetString(new C4String(std::move(result), &pCurCtx->Func->Owner->GetEngine()->Strings));
+						pCurVal[-1].SetString(pCurCtx->Func->Owner->GetEngine()->Strings.RegString(std::move(result)));
 					}
 					PopValue();
 					break;
@@ -949,7 +1134,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 					throw C4AulExecError(pCurCtx->Obj, std::format("indexed access: can't access {} by index!", Container.GetTypeName()));
 			}
 
-			case AB_MAPA_R: case AB_MAPA_V:
+			C4AUL_OP(AB_MAPA_R): C4AUL_OP(AB_MAPA_V):
 			{
 				C4Value &Map = pCurVal->GetRefVal();
 				if (Map.GetType() == C4V_Any)
@@ -965,10 +1150,10 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				C4Value key(reinterpret_cast<C4String *>(pCPos->bccX));
 				Map.GetContainerElement(&key, *pCurVal, pCurCtx, pCPos->bccType == AB_MAPA_V);
 
-				break;
+				C4AUL_NEXT;
 			}
 
-			case AB_ARRAY_APPEND:
+			C4AUL_OP(AB_ARRAY_APPEND):
 			{
 				C4Value &Array = pCurVal[0].GetRefVal();
 				// Typcheck
@@ -978,25 +1163,25 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				C4Value index = C4VInt(Array._getArray()->GetSize());
 				Array.GetContainerElement(&index, pCurVal[0], pCurCtx);
 
-				break;
+				C4AUL_NEXT;
 			}
 
-			case AB_DEREF:
+			C4AUL_OP(AB_DEREF):
 				pCurVal[0].Deref();
 
-			case AB_STACK:
+			C4AUL_OP(AB_STACK):
 				if (pCPos->bccX < 0)
 					PopValues(-pCPos->bccX);
 				else
 					PushNullVals(pCPos->bccX);
-				break;
+				C4AUL_NEXT;
 
-			case AB_JUMP:
+			C4AUL_OP(AB_JUMP):
 				fJump = true;
 				pCPos += pCPos->bccX;
 				break;
 
-			case AB_JUMPAND:
+			C4AUL_OP(AB_JUMPAND):
 				if (!pCurVal[0])
 				{
 					fJump = true;
@@ -1008,7 +1193,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				}
 				break;
 
-			case AB_JUMPOR:
+			C4AUL_OP(AB_JUMPOR):
 				if (pCurVal[0])
 				{
 					fJump = true;
@@ -1020,7 +1205,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				}
 				break;
 
-			case AB_JUMPNIL:
+			C4AUL_OP(AB_JUMPNIL):
 				if (pCurVal[0].GetType() == C4V_Any)
 				{
 					pCurVal[0].Deref();
@@ -1029,7 +1214,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				}
 				break;
 
-			case AB_JUMPNOTNIL:
+			C4AUL_OP(AB_JUMPNOTNIL):
 				if (pCurVal[0].GetType() != C4V_Any)
 				{
 					fJump = true;
@@ -1041,7 +1226,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				}
 				break;
 
-			case AB_CONDN:
+			C4AUL_OP(AB_CONDN):
 				if (!pCurVal[0])
 				{
 					fJump = true;
@@ -1050,7 +1235,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 
-			case AB_RETURN:
+			C4AUL_OP(AB_RETURN):
 			{
 				// Resolve reference
 				if (!pCurCtx->Func->SFunc()->bReturnRef)
@@ -1069,7 +1254,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				if (!pReturn)
 				{
 					// Get return value and stop executing.
-					C4Value rVal = *pCurVal;
+					C4Value rVal{std::move(*pCurVal)};
 					PopValuesUntil(pCurCtx->Pars - 1);
 					PopContext();
 					return rVal;
@@ -1077,7 +1262,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 
 				// Save return value
 				if (pCurVal != pReturn)
-					pReturn->Set(*pCurVal);
+					pReturn->Set(std::move(*pCurVal));
 
 				// Pop context
 				PopContext();
@@ -1092,7 +1277,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				break;
 			}
 
-			case AB_FUNC:
+			C4AUL_OP(AB_FUNC):
 			{
 				// Get function call data
 				C4AulFunc *pFunc = reinterpret_cast<C4AulFunc *>(pCPos->bccX);
@@ -1114,7 +1299,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				break;
 			}
 
-			case AB_VAR_R: case AB_VAR_V:
+			C4AUL_OP(AB_VAR_R): C4AUL_OP(AB_VAR_V):
 				if (!pCurVal->ConvertTo(C4V_Int))
 					throw C4AulExecError(pCurCtx->Obj, std::format("Var: index of type {}, int expected!", pCurVal->GetTypeName()));
 				// Push reference to variable on the stack
@@ -1122,9 +1307,9 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 					pCurVal->SetRef(&pCurCtx->NumVars.GetItem(pCurVal->_getInt()));
 				else
 					pCurVal->Set(pCurCtx->NumVars.GetItem(pCurVal->_getInt()));
-				break;
+				C4AUL_NEXT;
 
-			case AB_PAR_R: case AB_PAR_V:
+			C4AUL_OP(AB_PAR_R): C4AUL_OP(AB_PAR_V):
 				if (!pCurVal->ConvertTo(C4V_Int))
 					throw C4AulExecError(pCurCtx->Obj, std::format("Par: index of type {}, int expected!", pCurVal->GetTypeName()));
 				// Push reference to parameter on the stack
@@ -1137,9 +1322,9 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				}
 				else
 					pCurVal->Set0();
-				break;
+				C4AUL_NEXT;
 
-			case AB_FOREACH_NEXT:
+			C4AUL_OP(AB_FOREACH_NEXT):
 			{
 				// This should always hold
 				assert(pCurVal->ConvertTo(C4V_Int));
@@ -1166,14 +1351,14 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				break;
 			}
 
-			case AB_FOREACH_MAP_NEXT:
+			C4AUL_OP(AB_FOREACH_MAP_NEXT):
 			{
 				// This should always hold
 				assert(pCurVal[-1].ConvertTo(C4V_Int));
-				using Iterator = C4ValueHash::Iterator;
-				auto iterator = reinterpret_cast<Iterator *>(pCurVal[0]._getRef());
+				// the position is kept as the sequence number of the next entry, so the stack slot owns nothing that break or return would have to release
+				const auto seq = static_cast<std::uintptr_t>(pCurVal[0]._getRaw());
 				// Check map the first time only
-				if (!iterator)
+				if (!seq)
 				{
 					if (!pCurVal[-2].ConvertTo(C4V_Map))
 						throw C4AulExecError(pCurCtx->Obj, std::format("for: map expected, but got {}!", pCurVal[-1].GetTypeName()));
@@ -1181,41 +1366,36 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 						throw C4AulExecError(pCurCtx->Obj, std::format("for: map expected, but got nil!"));
 				}
 				C4ValueHash *map = pCurVal[-2]._getMap();
-				if (!iterator)
-				{
-					iterator = new Iterator (map->begin());
-					pCurVal[0].SetInt(1);
-					pCurVal[0].GetData().Ref = reinterpret_cast<C4Value *>(iterator);
-				}
+				C4ValueHash::Iterator iterator{seq ? C4ValueHash::Iterator{map, seq} : map->begin()};
 				// No more entries?
-				if (*iterator == map->end())
-				{
-					delete iterator;
+				if (iterator.IsEnd())
 					break;
-				}
 				// Get next
-				pCurCtx->Vars[pCPos->bccX] = (**iterator).first;
-				pCurCtx->Vars[pCurVal[-1]._getInt()] = (**iterator).second;
+				const auto &[key, value] = *iterator;
+				pCurCtx->Vars[pCPos->bccX] = key;
+				pCurCtx->Vars[pCurVal[-1]._getInt()] = value;
 
-				++(*iterator);
+				++iterator;
+				pCurVal[0].SetInt(0);
+				pCurVal[0].GetData().Raw = static_cast<std::intptr_t>(iterator.GetSeq());
 				// Jump over next instruction
 				pCPos += 2;
 				fJump = true;
 				break;
 			}
 
-			case AB_IVARN:
+			C4AUL_OP(AB_IVARN):
 				pCurCtx->Vars[pCPos->bccX] = pCurVal[0];
 				PopValue();
-				break;
+				C4AUL_NEXT;
 
-			case AB_CALLNS:
+			C4AUL_OP(AB_CALLNS):
 				// Ignore. TODO: Fix this.
-				break;
+				C4AUL_NEXT;
 
-			case AB_CALL:
-			case AB_CALLFS:
-			case AB_CALLGLOBAL:
+			C4AUL_OP(AB_CALL):
+			C4AUL_OP(AB_CALLFS):
+			C4AUL_OP(AB_CALLGLOBAL):
 			{
 				const auto isGlobal = pCPos->bccType == AB_CALLGLOBAL;
 				C4Value *pPars = pCurVal - C4AUL_MAX_Par + 1;
@@ -1250,21 +1430,39 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 							std::format("Object call: Invalid target type {}, expected object or id!", pTargetVal->GetTypeName()));
 				}
 
-				// Resolve overloads
-				C4AulFunc *pFunc = reinterpret_cast<C4AulFunc *>(pCPos->bccX);
-				while (pFunc->OverloadedBy)
-					pFunc = pFunc->OverloadedBy;
-
-				if (!isGlobal)
+				// Resolve overloads and search function for given context, unless the call site knows it already
+				C4AulFunc *pFunc;
+				if (isGlobal || !Game.ScriptEngine.GetCachedCall(pCPos, pDestDef, pFunc))
 				{
-					// Search function for given context
-					pFunc = pFunc->FindSameNameFunc(pDestDef);
-					if (!pFunc && pCPos->bccType == AB_CALLFS)
+					pFunc = reinterpret_cast<C4AulFunc *>(pCPos->bccX);
+					while (pFunc->OverloadedBy)
+						pFunc = pFunc->OverloadedBy;
+
+					if (!isGlobal)
+						pFunc = pFunc->FindSameNameFunc(pDestDef);
+
+					if (pFunc)
 					{
-						PopValuesUntil(pTargetVal);
-						pTargetVal->Set0();
-						break;
+						if (C4AulScriptFunc *sfunc = pFunc->SFunc(); sfunc)
+						{
+							C4AulScript *script = sfunc->pOrgScript;
+							if (sfunc->Access < script->GetAllowedAccess(pFunc, sfunc->pOrgScript))
+							{
+								throw C4AulExecError(pCurCtx->Obj, std::format("Insufficient access level for function \"{}\"!", +pFunc->Name));
+							}
+						}
 					}
+
+					// Remember result for the next call with this target definition
+					if (!isGlobal && (pFunc || pCPos->bccType == AB_CALLFS))
+						Game.ScriptEngine.CacheCall(pCPos, pDestDef, pFunc);
+				}
+
+				if (!pFunc && pCPos->bccType == AB_CALLFS)
+				{
+					PopValuesUntil(pTargetVal);
+					pTargetVal->Set0();
+					break;
 				}
 
 				// Function not found?
@@ -1278,14 +1476,6 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 						throw C4AulExecError(pCurCtx->Obj,
 							std::format("Definition call: No function \"{}\" in definition \"{}\"!", szFuncName, pDestDef->Name.getData()));
 				}
-				else if (C4AulScriptFunc *sfunc = pFunc->SFunc(); sfunc)
-				{
-					C4AulScript *script = sfunc->pOrgScript;
-					if (sfunc->Access < script->GetAllowedAccess(pFunc, sfunc->pOrgScript))
-					{
-						throw C4AulExecError(pCurCtx->Obj, std::format("Insufficient access level for function \"{}\"!", +pFunc->Name));
-					}
-				}
 
 				// Save function back (optimization)
 				pCPos->bccX = reinterpret_cast<std::intptr_t>(pFunc);
@@ -1305,8 +1495,103 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				break;
 			}
 
+			// superinstructions: take a shortcut for plain ints, otherwise execute the first chunk and continue with the original sequence
+			C4AUL_OP(AB_VARN_CMP_CONDN):
+			{
+				C4Value &var = pCurCtx->Vars[pCPos->bccX];
+				if (var.IsRef() || var.GetType() != C4V_Int)
+				{
+					PushValue(var);
+					break;
+				}
+				const C4ValueInt iLeft{var._getInt()}, iRight{static_cast<C4ValueInt>(pCPos[1].bccX)};
+				bool fCond{false};
+				switch (pCPos[2].bccType)
+				{
+				case AB_LessThan: fCond = iLeft < iRight; break;
+				case AB_LessThanEqual: fCond = iLeft <= iRight; break;
+				case AB_GreaterThan: fCond = iLeft > iRight; break;
+				case AB_GreaterThanEqual: fCond = iLeft >= iRight; break;
+				default: assert(false);
+				}
+				// continue at AB_CONDN
+				pCPos += 3;
+				if (!fCond)
+				{
+					fJump = true;
+					pCPos += pCPos->bccX;
+				}
+				break;
+			}
+
+			C4AUL_OP(AB_VARN_STEP):
+			{
+				C4Value &var = pCurCtx->Vars[pCPos->bccX];
+				if (var.IsRef() || var.GetType() != C4V_Int)
+				{
+					PushValueRef(var);
+					break;
+				}
+				if (pCPos[1].bccType == AB_Inc1 || pCPos[1].bccType == AB_Inc1_Postfix)
+					++var.GetData().Int;
+				else
+					--var.GetData().Int;
+				// skip the pop of the result
+				pCPos += 2;
+				C4AUL_NEXT;
+			}
+
+			C4AUL_OP(AB_VARN_ADDINT):
+			{
+				C4Value &var = pCurCtx->Vars[pCPos->bccX];
+				if (var.IsRef() || var.GetType() != C4V_Int)
+				{
+					PushValueRef(var);
+					break;
+				}
+				if (pCPos[2].bccType == AB_Inc)
+					var.GetData().Int += static_cast<C4ValueInt>(pCPos[1].bccX);
+				else
+					var.GetData().Int -= static_cast<C4ValueInt>(pCPos[1].bccX);
+				// skip the pop of the result
+				pCPos += 3;
+				C4AUL_NEXT;
+			}
+
+			C4AUL_OP(AB_INT_OP):
+			{
+				if (pCurVal->IsRef() || pCurVal->GetType() != C4V_Int)
+				{
+					PushValue(C4VInt(static_cast<C4ValueInt>(pCPos->bccX)));
+					break;
+				}
+				const C4ValueInt iLeft{pCurVal->_getInt()}, iRight{static_cast<C4ValueInt>(pCPos->bccX)};
+				switch (pCPos[1].bccType)
+				{
+				case AB_Div:
+					if (iRight)
+						pCurVal->SetInt(iLeft / iRight);
+					else
+						pCurVal->Set0();
+					break;
+				case AB_Mul: pCurVal->SetInt(iLeft * iRight); break;
+				case AB_Mod:
+					if (iRight)
+						pCurVal->SetInt(iLeft % iRight);
+					else
+						pCurVal->Set0();
+					break;
+				case AB_Sub: pCurVal->SetInt(iLeft - iRight); break;
+				case AB_Sum: pCurVal->SetInt(iLeft + iRight); break;
+				default: assert(false);
+				}
+				// skip the operator
+				++pCPos;
+				C4AUL_NEXT;
+			}
+
 			default:
-			case AB_NilCoalescing:
+			C4AUL_OP(AB_NilCoalescing):
 				assert(false);
 			}
 
@@ -1319,14 +1604,20 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 	{
 		// Save current position
 		pOldCtx->CPos = pCPos;
-		// Pass?
+		// Pass? An outer execution unwinds the stack; without one, it is unwound here
 		if (fPassErrors)
-			throw;
-		// Show
-		e.show();
-		// Trace
-		for (C4AulScriptContext *pCtx = pCurCtx; pCtx >= Contexts; pCtx--)
-			pCtx->dump(" by: ");
+		{
+			if (pOldCtx > Contexts)
+				throw;
+		}
+		else
+		{
+			// Show
+			e.show();
+			// Trace
+			for (C4AulScriptContext *pCtx = pCurCtx; pCtx >= Contexts; pCtx--)
+				pCtx->dump(" by: ");
+		}
 		// Unwind stack
 		C4Value *pUntil = nullptr;
 		while (pCurCtx >= pOldCtx)
@@ -1336,6 +1627,8 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 		}
 		if (pUntil)
 			PopValuesUntil(pUntil);
+		if (fPassErrors)
+			throw;
 	}
 
 	// Return nothing
@@ -1429,6 +1722,28 @@ C4AulBCC *C4AulExec::Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4
 		pDef = pCurCtx->Def;
 	}
 
+#ifndef DEBUGREC_SCRIPT
+	// Engine function with parameters of the expected types: skip conversion, call records and profiler nodes
+	if (pFunc->FastCall && !fProfiling)
+	{
+		const bool fPushResult{pReturn > pCurVal};
+		if (fPushResult) CheckOverflow(1);
+
+		C4AulContext CallCtx;
+		CallCtx.Obj = pObj;
+		CallCtx.Def = pDef;
+		CallCtx.Caller = pCurCtx;
+
+		if (pFunc->FastCall(pFunc, &CallCtx, pPars, fPushResult ? pCurVal[1] : *pReturn))
+		{
+			if (fPushResult) ++pCurVal;
+			// Remove parameters from stack
+			PopValuesUntil(pReturn);
+			return nullptr;
+		}
+	}
+#endif
+
 	// Script function?
 	C4AulScriptFunc *pSFunc = pFunc->SFunc();
 
@@ -1503,6 +1818,19 @@ C4AulBCC *C4AulExec::Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4
 			AddDbgRec(RCT_AulFunc, callText.c_str(), callText.size() + 1);
 		}
 #endif
+		// Profiler: engine functions get their own node
+		// the function may start or stop the profiler itself, so only leave the node if it is still there
+		const bool fProfileCall{fProfiling};
+		const std::uint32_t iCallProfileRun{iProfileRun};
+		std::size_t iProfileParent{}, iCallProfileNode{};
+		std::uint64_t tCallStart{};
+		if (fProfileCall)
+		{
+			iProfileParent = iProfileNode;
+			iCallProfileNode = EnterProfileNode(pFunc);
+			tCallStart = ProfilerTime();
+		}
+
 		// Execute
 #ifndef NDEBUG
 		C4AulScriptContext *pCtx = pCurCtx;
@@ -1515,6 +1843,9 @@ C4AulBCC *C4AulExec::Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4
 		assert(pCtx == pCurCtx);
 #endif
 
+		if (fProfileCall && fProfiling && iCallProfileRun == iProfileRun)
+			LeaveProfileNode(iCallProfileNode, iProfileParent, tCallStart);
+
 		// Remove parameters from stack
 		PopValuesUntil(pReturn);
 
@@ -1542,14 +1873,25 @@ void C4AulExec::StartProfiling(C4AulScript *pProfiledScript)
 	// stop previous profiler run
 	if (fProfiling) AbortProfiling();
 	fProfiling = true;
+	++iProfileRun;
 	// resets profling times and starts recording the times
 	this->pProfiledScript = pProfiledScript;
-	time_t tNow = timeGetTime();
+	const std::uint64_t tNow{ProfilerTime()};
 	tDirectExecStart = tNow; // in case profiling is started from DirectExec
 	tDirectExecTotal = 0;
 	pProfiledScript->ResetProfilerTimes();
+	Game.FindObjectPlans.ResetProfilerStats();
+	Game.ScriptEngine.CallCacheHits = Game.ScriptEngine.CallCacheMisses = 0;
+	// new call tree, starting with the functions currently running
+	ProfileNodes.clear();
+	ProfileNodes.push_back({nullptr, 0});
+	iProfileNode = 0;
 	for (C4AulScriptContext *pCtx = Contexts; pCtx <= pCurCtx; ++pCtx)
+	{
+		pCtx->iProfileParent = iProfileNode;
+		pCtx->iProfileNode = EnterProfileNode(pCtx->TemporaryScript ? nullptr : pCtx->Func);
 		pCtx->tTime = tNow;
+	}
 }
 
 void C4AulExec::StopProfiling()
@@ -1561,9 +1903,49 @@ void C4AulExec::StopProfiling()
 	C4AulProfiler Profiler{Application.LogSystem.CreateLogger(Config.Logging.AulProfiler)};
 	Profiler.CollectEntry(nullptr, tDirectExecTotal);
 	pProfiledScript->CollectProfilerTimes(Profiler);
+	Game.FindObjectPlans.CollectProfilerStats(Profiler);
+	Profiler.CollectCallCacheStats(Game.ScriptEngine.CallCacheHits, Game.ScriptEngine.CallCacheMisses);
+	CollectProfileNodes(Profiler);
+	ProfileNodes.clear();
 	Profiler.Show();
 }
 
+void C4AulExec::CollectProfileNodes(C4AulProfiler &rProfiler)
+{
+	// sum up nodes per function; recursive calls only count once for inclusive time
+	struct Sum { std::uint64_t iCalls{0}, tInclusive{0}, tExclusive{0}; };
+	std::unordered_map<C4AulFunc *, Sum> sums;
+	std::unordered_map<C4AulFunc *, int> active;
+	std::string stack;
+	const auto collect = [&](const auto &self, const std::size_t iNode) -> void
+	{
+		const ProfileNode &node = ProfileNodes[iNode];
+		const std::size_t stackLength{stack.size()};
+		const std::uint64_t tExclusive{node.tInclusive > node.tChildren ? node.tInclusive - node.tChildren : 0};
+		if (iNode)
+		{
+			Sum &sum = sums[node.pFunc];
+			sum.iCalls += node.iCalls;
+			sum.tExclusive += tExclusive;
+			if (!active[node.pFunc]++)
+				sum.tInclusive += node.tInclusive;
+			if (!stack.empty()) stack += ';';
+			stack += C4AulProfiler::GetFuncName(node.pFunc);
+			if (tExclusive)
+				rProfiler.CollectStack(stack, tExclusive);
+		}
+		for (const auto &[pFunc, iChild] : node.Children)
+			self(self, iChild);
+		if (iNode)
+			--active[node.pFunc];
+		stack.resize(stackLength);
+	};
+	if (!ProfileNodes.empty())
+		collect(collect, 0);
+	for (const auto &[pFunc, sum] : sums)
+		rProfiler.CollectCallEntry(pFunc, sum.iCalls, sum.tInclusive, sum.tExclusive);
+}
+
 void C4AulProfiler::StartProfiling(C4AulScript *pScript)
 {
 	AulExec.StartProfiling(pScript);
@@ -1579,7 +1961,21 @@ void C4AulProfiler::Abort()
 	AulExec.AbortProfiling();
 }
 
-void C4AulProfiler::CollectEntry(C4AulScriptFunc *pFunc, time_t tProfileTime)
+bool C4AulProfiler::IsProfiling()
+{
+	return AulExec.IsProfiling();
+}
+
+std::string C4AulProfiler::GetFuncName(C4AulFunc *pFunc)
+{
+	if (!pFunc)
+		return "Direct exec";
+	if (C4AulScriptFunc *pSFunc = pFunc->SFunc(); pSFunc)
+		return pSFunc->GetFullName();
+	return std::format("engine {}", pFunc->Name);
+}
+
+void C4AulProfiler::CollectEntry(C4AulScriptFunc *pFunc, std::uint64_t tProfileTime)
 {
 	// zero entries are not collected to have a cleaner list
 	if (!tProfileTime) return;
@@ -1590,6 +1986,27 @@ void C4AulProfiler::CollectEntry(C4AulScriptFunc *pFunc, time_t tProfileTime)
 	Times.push_back(e);
 }
 
+void C4AulProfiler::CollectCallEntry(C4AulFunc *pFunc, std::uint64_t iCalls, std::uint64_t tInclusive, std::uint64_t tExclusive)
+{
+	Calls.push_back({pFunc, iCalls, tInclusive, tExclusive});
+}
+
+void C4AulProfiler::CollectStack(std::string_view stack, std::uint64_t tExclusive)
+{
+	Stacks += std::format("{} {}\n", stack, tExclusive);
+}
+
+void C4AulProfiler::CollectSearchEntry(C4AulScriptFunc *pFunc, int iLine, uint32_t iCalls, uint32_t iCandidates, uint32_t iMatches)
+{
+	Searches.push_back({pFunc, iLine, iCalls, iCandidates, iMatches});
+}
+
+void C4AulProfiler::CollectCallCacheStats(std::uint64_t iHits, std::uint64_t iMisses)
+{
+	iCallCacheHits = iHits;
+	iCallCacheMisses = iMisses;
+}
+
 void C4AulProfiler::Show()
 {
 	// sort by time
@@ -1601,9 +2018,41 @@ void C4AulProfiler::Show()
 	for (EntryList::iterator i = Times.begin(); i != Times.end(); ++i)
 	{
 		Entry &e = (*i);
-		logger->info("{:05}ms\t{}", e.tProfileTime, e.pFunc ? (e.pFunc->GetFullName().c_str()) : "Direct exec");
+		logger->info("{:10.3f}ms\t{}", e.tProfileTime / 1e6, e.pFunc ? (e.pFunc->GetFullName().c_str()) : "Direct exec");
 	}
 	logger->info("==============================");
+	// all functions including engine functions by exclusive time
+	if (!Calls.empty())
+	{
+		std::sort(Calls.rbegin(), Calls.rend());
+		logger->info("Calls (calls/inclusive/exclusive):");
+		logger->info("==============================");
+		for (const CallEntry &e : Calls)
+			logger->info("{}\t{:10.3f}ms\t{:10.3f}ms\t{}", e.iCalls, e.tInclusive / 1e6, e.tExclusive / 1e6, GetFuncName(e.pFunc));
+		logger->info("==============================");
+	}
+	// call stacks in folded format for flame graphs
+	if (!Stacks.empty())
+	{
+		const char *const filename{Config.AtExePath(C4CFN_ScriptProfile)};
+		if (StdStrBuf{Stacks.c_str(), Stacks.size(), false}.SaveToFile(filename))
+			logger->info("Call stacks (nanoseconds) saved to {}", filename);
+		else
+			logger->error("Could not save call stacks to {}", filename);
+	}
+	// object searches by number of checked objects
+	if (!Searches.empty())
+	{
+		std::sort(Searches.rbegin(), Searches.rend());
+		logger->info("Object searches (calls/checked/found):");
+		logger->info("==============================");
+		for (const SearchEntry &e : Searches)
+			logger->info("{}\t{}\t{}\t{}:{}", e.iCalls, e.iCandidates, e.iMatches, e.pFunc->GetFullName(), e.iLine);
+		logger->info("==============================");
+	}
+	// object call site cache efficiency
+	if (const std::uint64_t iCalls{iCallCacheHits + iCallCacheMisses}; iCalls)
+		logger->info("Object call cache: {} hits, {} misses ({}% hit rate)", iCallCacheHits, iCallCacheMisses, iCallCacheHits * 100 / iCalls);
 	// done!
 }
 
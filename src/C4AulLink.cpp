@@ -19,7 +19,10 @@
 
 #include <C4Include.h>
 #include <C4Aul.h>
+#include <C4AulCodeCache.h>
 
+#include <C4Components.h>
+#include <C4Config.h>
 #include <C4Def.h>
 #include <C4Game.h>
 #include <C4Log.h>
@@ -189,6 +192,25 @@ void C4AulScript::UnLink()
 	if (State > ASS_PREPARSED) State = ASS_PREPARSED;
 }
 
+void C4AulScript::CollectStrings(std::unordered_set<const C4String *> &Strings) const
+{
+	// unlinked scripts have no code, but keep their old size
+	if (Code)
+	{
+		for (int i = 0; i < CodeSize; ++i)
+			switch (Code[i].bccType)
+			{
+			case AB_STRING: case AB_MAPA_R: case AB_MAPA_V:
+				Strings.insert(reinterpret_cast<const C4String *>(Code[i].bccX));
+				break;
+			default:
+				break;
+			}
+	}
+
+	for (const C4AulScript *s = Child0; s; s = s->Next) s->CollectStrings(Strings);
+}
+
 void C4AulScriptFunc::UnLink()
 {
 	OwnerOverloaded = nullptr;
@@ -268,8 +290,12 @@ void C4AulScriptEngine::Link(C4DefList *rDefs)
 		// parse script funcs descs
 		ParseDescs();
 
-		// parse the scripts to byte code
-		Parse();
+		// parse the scripts to byte code, taking the byte code of unchanged scripts from the last start
+		C4AulCodeCache CodeCache;
+		const bool fCache = Config.Developer.CacheScripts;
+		if (fCache) CodeCache.Init(*this, Config.AtExePath(C4CFN_ScriptCodeCache));
+		Parse(fCache ? &CodeCache : nullptr);
+		if (fCache) CodeCache.Save();
 
 		// engine is always parsed (for global funcs)
 		State = ASS_PARSED;
@@ -315,15 +341,24 @@ void C4AulScriptEngine::ReLink(C4DefList *rDefs)
 	// unlink scripts
 	UnLink();
 
+	// cached search conditions point into the old code
+	Game.FindObjectPlans.Clear();
+
+	// the profiler call tree refers to the old functions
+	C4AulProfiler::Abort();
+
 	// unlink defs
 	if (rDefs) rDefs->ResetIncludeDependencies();
 
-	// clear string table
+	// unlink scenario script
 	Game.Script.UnLink();
 
 	// re-link
 	Link(rDefs);
 
+	// only now that the new code holds its strings, the remaining ones can go
+	ReleaseUnusedStrings();
+
 	// update effect pointers
 	Game.Objects.UpdateScriptPointers();
 
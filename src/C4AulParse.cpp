@@ -19,12 +19,15 @@
 
 #include <C4Include.h>
 #include <C4Aul.h>
+#include <C4AulCodeCache.h>
 
 #include <C4Def.h>
 #include <C4Game.h>
 #include <C4Wrappers.h>
 
 #include <cinttypes>
+#include <limits>
+#include <optional>
 
 #define DEBUG_BYTECODE_DUMP 0
 
@@ -130,6 +133,7 @@ public:
 		Done(false),
 		Type(Type),
 		fJump(false),
+		iJumpTarget(0),
 		iStack(0),
 		pLoopStack(nullptr) {}
 
@@ -187,11 +191,21 @@ public:
 
 	void SetNoRef(); // Switches the bytecode to generate a value instead of a reference
 
+	// lookups in other scripts and the engine; recorded for the code cache, which repeats them before taking cached code
+	C4AulCodeCache *pCache{nullptr};
+	C4AulFunc *LookupFunc(C4AulCodeCache::LookupType eType, const char *szName, std::int64_t iArg = 0);
+	bool LookupTakesRef(C4AulFunc *pFunc, std::int32_t iPar);
+	std::int32_t LookupVar(C4AulCodeCache::LookupType eType, const char *szName);
+	bool LookupConstant(const char *szName, C4Value *pValue);
+
 private:
 	bool fJump;
+	size_t iJumpTarget; // position of the last chunk that was added as a jump target
 	std::intptr_t iStack;
 
 	void AddBCC(C4AulBCCType eType, std::intptr_t X = 0);
+	bool FoldConstant(C4AulBCCType eType); // replace an operator on constant operands by its result
+	bool IsOptimized() const;
 
 	size_t JumpHere(); // Get position for a later jump to next instruction added
 	void SetJumpHere(size_t iJumpOp); // Use the next inserted instruction as jump target for the given jump operation
@@ -775,9 +789,7 @@ C4AulTokenType C4AulParseState::GetNextToken(char *pToken, std::intptr_t *pInt,
 				// no string expected?
 				if (HoldStrings == Discard) return ATT_STRING;
 				// reg string (if not already done so)
-				C4String *pString;
-				if (!(pString = a->Engine->Strings.FindString(StrBuff)))
-					pString = a->Engine->Strings.RegString(StrBuff);
+				C4String *pString = a->Engine->Strings.RegString(StrBuff);
 				if (HoldStrings == Hold) pString->Hold = 1;
 				// return pointer on string object
 				*pInt = reinterpret_cast<std::intptr_t>(pString);
@@ -916,11 +928,16 @@ static const char *GetTTName(C4AulBCCType e)
 	case AB_ERR:              return "AB_ERR";              // parse error at this position
 	case AB_EOFN:             return "AB_EOFN";             // end of function
 	case AB_EOF:              return "AB_EOF";
+
+	case AB_VARN_CMP_CONDN:   return "AB_VARN_CMP_CONDN";   // superinstructions
+	case AB_VARN_STEP:        return "AB_VARN_STEP";
+	case AB_VARN_ADDINT:      return "AB_VARN_ADDINT";
+	case AB_INT_OP:           return "AB_INT_OP";
 	}
 	return "?";
 }
 
-void C4AulScript::AddBCC(C4AulBCCType eType, std::intptr_t X, const char *SPos)
+void C4AulScript::AddBCC(C4AulBCCType eType, std::intptr_t X, std::uint32_t SPos)
 {
 	// range check
 	if (CodeSize >= CodeBufSize)
@@ -938,6 +955,7 @@ void C4AulScript::AddBCC(C4AulBCCType eType, std::intptr_t X, const char *SPos)
 	}
 	// store chunk
 	CPos->bccType = eType;
+	CPos->CallCache = 0;
 	CPos->bccX = X;
 	CPos->SPos = SPos;
 	CPos++; CodeSize++;
@@ -986,6 +1004,8 @@ bool C4AulScript::Preparse()
 void C4AulParseState::AddBCC(C4AulBCCType eType, std::intptr_t X)
 {
 	if (Type != PARSER) return;
+	// Evaluate operators on constants right away
+	if (!fJump && FoldConstant(eType)) return;
 	// Track stack size
 	switch (eType)
 	{
@@ -1118,6 +1138,19 @@ void C4AulParseState::AddBCC(C4AulBCCType eType, std::intptr_t X)
 	// Join checks only if it's not a jump target
 	if (!fJump)
 	{
+		// Don't push values which are discarded right away
+		while (eType == AB_STACK && X < 0 && a->CPos > a->Code && iJumpTarget + 1 < a->GetCodePos() && IsOptimized())
+		{
+			const auto prevType = (a->CPos - 1)->bccType;
+			if (prevType != AB_NIL && prevType != AB_INT && prevType != AB_BOOL && prevType != AB_STRING && prevType != AB_C4ID &&
+				prevType != AB_VARN_R && prevType != AB_VARN_V && prevType != AB_PARN_R && prevType != AB_PARN_V)
+				break;
+			a->CPos--;
+			a->CodeSize--;
+			// Nothing left to pop?
+			if (!++X) return;
+		}
+
 		// Join together stack operations
 		if (eType == AB_STACK &&
 			a->CPos > a->Code &&
@@ -1136,12 +1169,85 @@ void C4AulParseState::AddBCC(C4AulBCCType eType, std::intptr_t X)
 	}
 
 	// Add
-	a->AddBCC(eType, X, SPos);
+	if (fJump) iJumpTarget = a->GetCodePos();
+	a->AddBCC(eType, X, C4AulBCC::ToSPos(Fn->pOrgScript->GetScript(), SPos));
 
 	// Reset jump flag
 	fJump = false;
 }
 
+namespace
+{
+	bool IsOptimizedStrictness(C4AulScriptStrict strict)
+	{
+		return Config.Developer.OptimizeScripts && strict >= Config.Developer.OptimizeScriptsStrictness;
+	}
+
+	// evaluates the operator like C4AulExec would; nullopt if the result is not known at compile time
+	std::optional<C4Value> EvalConstantOperator(C4AulBCCType eType, std::int64_t a, std::int64_t b)
+	{
+		const auto toInt = [](std::int64_t result) -> std::optional<C4Value>
+		{
+			// leave overflows to run time
+			if (result < std::numeric_limits<C4ValueInt>::min() || result > std::numeric_limits<C4ValueInt>::max()) return std::nullopt;
+			return C4VInt(static_cast<C4ValueInt>(result));
+		};
+
+		switch (eType)
+		{
+		case AB_Neg: return toInt(-a);
+		case AB_BitNot: return toInt(~a);
+		case AB_Not: return C4VBool(!a);
+		case AB_Mul: return toInt(a * b);
+		case AB_Div: if (!b) return std::nullopt; return toInt(a / b); // division by zero results in nil
+		case AB_Mod: if (!b || b == -1) return std::nullopt; return toInt(a % b);
+		case AB_Sub: return toInt(a - b);
+		case AB_Sum: return toInt(a + b);
+		case AB_LeftShift: if (a < 0 || b < 0 || b >= 32) return std::nullopt; return toInt(a << b);
+		case AB_RightShift: if (b < 0 || b >= 32) return std::nullopt; return toInt(a >> b);
+		case AB_LessThan: return C4VBool(a < b);
+		case AB_LessThanEqual: return C4VBool(a <= b);
+		case AB_GreaterThan: return C4VBool(a > b);
+		case AB_GreaterThanEqual: return C4VBool(a >= b);
+		case AB_Equal: case AB_EqualIdent: return C4VBool(a == b);
+		case AB_NotEqual: case AB_NotEqualIdent: return C4VBool(a != b);
+		case AB_BitAnd: return toInt(a & b);
+		case AB_BitXOr: return toInt(a ^ b);
+		case AB_BitOr: return toInt(a | b);
+		default: return std::nullopt;
+		}
+	}
+}
+
+bool C4AulParseState::IsOptimized() const
+{
+	return IsOptimizedStrictness(Fn ? Fn->pOrgScript->Strict : a->Strict);
+}
+
+bool C4AulParseState::FoldConstant(C4AulBCCType eType)
+{
+	const size_t operands = (eType == AB_Neg || eType == AB_BitNot || eType == AB_Not) ? 1 : 2;
+	const auto pos = a->GetCodePos();
+	// operands must be int constants; only the first of them may be jumped to, the result takes its place
+	if (pos < operands || iJumpTarget > pos - operands) return false;
+	C4AulBCC *const pOperands = a->CPos - operands;
+	for (size_t i = 0; i < operands; ++i)
+		if (pOperands[i].bccType != AB_INT) return false;
+	if (!IsOptimized()) return false;
+
+	const auto result = EvalConstantOperator(eType,
+		static_cast<C4ValueInt>(pOperands[0].bccX), operands > 1 ? static_cast<C4ValueInt>(pOperands[1].bccX) : 0);
+	if (!result) return false;
+
+	// replace operands and operator by the result; bypass AddBCC, so a zero isn't turned into a nil in non-strict scripts
+	const std::uint32_t operandsPos = pOperands->SPos;
+	a->CPos -= operands;
+	a->CodeSize -= operands;
+	iStack -= operands - 1;
+	a->AddBCC(result->GetType() == C4V_Bool ? AB_BOOL : AB_INT, result->_getRaw(), operandsPos);
+	return true;
+}
+
 namespace
 {
 	void SkipExpressions(intptr_t n, C4AulBCC *&CPos, C4AulBCC *const Code)
@@ -1234,6 +1340,49 @@ namespace
 	}
 }
 
+namespace
+{
+	// superinstructions only replace the type of the first chunk of a sequence, so operands and jump offsets stay where they were
+	void FuseInstructions(C4AulBCC *const Code, const std::size_t CodeSize)
+	{
+		for (std::size_t i = 0; i + 1 < CodeSize; ++i)
+		{
+			C4AulBCC *const CPos = Code + i;
+			const std::size_t remaining = CodeSize - i;
+			switch (CPos->bccType)
+			{
+			case AB_VARN_V:
+				// local compare and branch
+				if (remaining >= 4 && CPos[1].bccType == AB_INT &&
+					Inside(CPos[2].bccType, AB_LessThan, AB_GreaterThanEqual) && CPos[3].bccType == AB_CONDN)
+					CPos->bccType = AB_VARN_CMP_CONDN;
+				break;
+
+			case AB_VARN_R:
+				// local increment/decrement as a statement
+				if (remaining >= 3 &&
+					(CPos[1].bccType == AB_Inc1 || CPos[1].bccType == AB_Dec1 || CPos[1].bccType == AB_Inc1_Postfix || CPos[1].bccType == AB_Dec1_Postfix) &&
+					CPos[2].bccType == AB_STACK && CPos[2].bccX == -1)
+					CPos->bccType = AB_VARN_STEP;
+				else if (remaining >= 4 && CPos[1].bccType == AB_INT &&
+					(CPos[2].bccType == AB_Inc || CPos[2].bccType == AB_Dec) &&
+					CPos[3].bccType == AB_STACK && CPos[3].bccX == -1)
+					CPos->bccType = AB_VARN_ADDINT;
+				break;
+
+			case AB_INT:
+				// arithmetic with a constant right side
+				if (Inside(CPos[1].bccType, AB_Div, AB_Sum))
+					CPos->bccType = AB_INT_OP;
+				break;
+
+			default:
+				break;
+			}
+		}
+	}
+}
+
 void C4AulParseState::SetNoRef()
 {
 	if (Type != PARSER) return;
@@ -1263,6 +1412,35 @@ void C4AulParseState::SetNoRef()
 	}
 }
 
+C4AulFunc *C4AulParseState::LookupFunc(const C4AulCodeCache::LookupType eType, const char *const szName, const std::int64_t iArg)
+{
+	C4AulFunc *const pFunc{C4AulCodeCache::FindFunc(*a, eType, szName, iArg)};
+	if (pCache) pCache->RecordFunc(eType, szName, iArg, pFunc);
+	return pFunc;
+}
+
+bool C4AulParseState::LookupTakesRef(C4AulFunc *const pFunc, const std::int32_t iPar)
+{
+	// pFunc either was the return value from a GetFuncFast-Call or
+	// pFunc is the only function that could be called, so checking the same-named functions is superflous
+	const bool fResult{C4AulCodeCache::FuncTakesRef(*a->Engine, pFunc, iPar)};
+	if (pCache) pCache->RecordTakesRef(pFunc, iPar, fResult);
+	return fResult;
+}
+
+std::int32_t C4AulParseState::LookupVar(const C4AulCodeCache::LookupType eType, const char *const szName)
+{
+	const std::int32_t iResult{C4AulCodeCache::FindVar(*a, eType, szName)};
+	if (pCache) pCache->RecordVar(eType, szName, iResult);
+	return iResult;
+}
+
+bool C4AulParseState::LookupConstant(const char *const szName, C4Value *const pValue)
+{
+	if (pCache) pCache->RecordConstant(szName);
+	return a->Engine->GetGlobalConstant(szName, pValue);
+}
+
 size_t C4AulParseState::JumpHere()
 {
 	// Set flag so the next generated code chunk won't get joined
@@ -1278,6 +1456,26 @@ namespace
 	}
 }
 
+namespace
+{
+	// jumps do not leave their function, so the code of each function can be threaded on its own up to its AB_EOFN chunk
+	void ThreadJumps(C4AulBCC *const FnCode)
+	{
+		for (C4AulBCC *CPos = FnCode; CPos->bccType != AB_EOFN; ++CPos)
+		{
+			if (!IsJumpType(CPos->bccType)) continue;
+
+			// an unconditional jump doesn't touch the stack, so any jump may skip it; bound the hops for endless loops
+			for (int hops = 0; hops < 8; ++hops)
+			{
+				const C4AulBCC *const target = CPos + CPos->bccX;
+				if (target == CPos || target->bccType != AB_JUMP || !target->bccX) break;
+				CPos->bccX += target->bccX;
+			}
+		}
+	}
+}
+
 void C4AulParseState::SetJumpHere(size_t iJumpOp)
 {
 	if (Type != PARSER) return;
@@ -1397,7 +1595,7 @@ void C4AulParseState::UnexpectedToken(const char *Expected)
 	throw C4AulParseError(this, std::format("{} expected, but found {}", Expected, GetTokenName(TokenType)));
 }
 
-void C4AulScript::ParseFn(C4AulScriptFunc *Fn, bool fExprOnly)
+void C4AulScript::LinkOverload(C4AulScriptFunc *Fn)
 {
 	// check if fn overloads other fn (all func tables are built now)
 	// *MUST* check Fn->Owner-list, because it may be the engine (due to linked globals)
@@ -1406,12 +1604,19 @@ void C4AulScript::ParseFn(C4AulScriptFunc *Fn, bool fExprOnly)
 			Fn->OwnerOverloaded->OverloadedBy = Fn;
 	// reset pointer to next same-named func (will be set in AfterLink)
 	Fn->NextSNFunc = nullptr;
+}
+
+void C4AulScript::ParseFn(C4AulScriptFunc *Fn, bool fExprOnly, C4AulCodeCache *pCache)
+{
+	LinkOverload(Fn);
+	if (pCache) pCache->BeginFunc(*Fn);
 	// store byte code pos
 	// (relative position to code start; code pointer may change while
 	//  parsing)
 	Fn->Code = reinterpret_cast<C4AulBCC *>(CPos - Code);
 	// parse
 	C4AulParseState state(Fn, this, C4AulParseState::PARSER);
+	state.pCache = pCache;
 	// get first token
 	state.Shift();
 	if (!fExprOnly)
@@ -1420,7 +1625,7 @@ void C4AulScript::ParseFn(C4AulScriptFunc *Fn, bool fExprOnly)
 	{
 		state.Parse_Expression();
 		state.SetNoRef();
-		AddBCC(AB_RETURN, 0, state.SPos);
+		AddBCC(AB_RETURN, 0, C4AulBCC::ToSPos(Fn->pOrgScript->GetScript(), state.SPos));
 	}
 	// done
 	return;
@@ -1987,7 +2192,7 @@ void C4AulParseState::Parse_Statement()
 			AddBCC(AB_STACK, -1);
 		}
 		// check for objectlocal variable (local)
-		else if (a->LocalNamed.GetItemNr(Idtf) != -1)
+		else if (LookupVar(C4AulCodeCache::LookupType::Local, Idtf) != -1)
 		{
 			// global func?
 			if (Fn->Owner == &Game.ScriptEngine)
@@ -1997,7 +2202,7 @@ void C4AulParseState::Parse_Statement()
 			AddBCC(AB_STACK, -1);
 		}
 		// check for global variable (static)
-		else if (a->Engine->GlobalNamedNames.GetItemNr(Idtf) != -1)
+		else if (LookupVar(C4AulCodeCache::LookupType::Global, Idtf) != -1)
 		{
 			Parse_Expression();
 			AddBCC(AB_STACK, -1);
@@ -2204,9 +2409,9 @@ void C4AulParseState::Parse_Statement()
 			else
 				// get regular function
 				if (Fn->Owner == &Game.ScriptEngine)
-					FoundFn = a->Owner->GetFuncRecursive(Idtf);
+					FoundFn = LookupFunc(C4AulCodeCache::LookupType::Func, Idtf, 1);
 				else
-					FoundFn = a->GetFuncRecursive(Idtf);
+					FoundFn = LookupFunc(C4AulCodeCache::LookupType::Func, Idtf);
 
 			if (FoundFn && FoundFn->SFunc() && FoundFn->SFunc()->Access < Fn->pOrgScript->GetAllowedAccess(FoundFn, Fn->pOrgScript))
 			{
@@ -2310,18 +2515,9 @@ int C4AulParseState::Parse_Params(int iMaxCnt, const char *sWarn, C4AulFunc *pFu
 		{
 			// get a parameter
 			Parse_Expression();
-			if (pFunc)
-			{
-				bool anyfunctakesref = pFunc->GetParCount() > size && (pFunc->GetParType()[size] == C4V_pC4Value);
-				// pFunc either was the return value from a GetFuncFast-Call or
-				// pFunc is the only function that could be called, so this loop is superflous
-				C4AulFunc *pFunc2 = pFunc;
-				while (pFunc2 = a->Engine->GetNextSNFunc(pFunc2))
-					if (pFunc2->GetParCount() > size && pFunc2->GetParType()[size] == C4V_pC4Value) anyfunctakesref = true;
-				// Change the bytecode to the equivalent that does not produce a reference.
-				if (!anyfunctakesref)
-					SetNoRef();
-			}
+			// Change the bytecode to the equivalent that does not produce a reference.
+			if (pFunc && !LookupTakesRef(pFunc, size))
+				SetNoRef();
 			++size;
 			// end of parameter list?
 			if (TokenType == ATT_COMMA)
@@ -2425,9 +2621,7 @@ void C4AulParseState::Parse_Map()
 			{
 				case ATT_IDTF:
 				{
-					C4String *string;
-					if (!(string = a->Engine->Strings.FindString(Idtf)))
-						string = a->Engine->Strings.RegString(Idtf);
+					C4String *string = a->Engine->Strings.RegString(Idtf);
 					if (Type == PARSER) string->Hold = true;
 					AddBCC(AB_STRING, reinterpret_cast<std::intptr_t>(string));
 					Shift();
@@ -2720,20 +2914,20 @@ void C4AulParseState::Parse_Expression(int iParentPrio)
 			Shift();
 		}
 		// check for variable (local)
-		else if (a->LocalNamed.GetItemNr(Idtf) != -1)
+		else if (const std::int32_t iLocal{LookupVar(C4AulCodeCache::LookupType::Local, Idtf)}; iLocal != -1)
 		{
 			// global func?
 			if (Fn->Owner == &Game.ScriptEngine)
 				throw C4AulParseError(this, "using local variable in global function!");
 			// insert variable by id
-			AddBCC(AB_LOCALN_R, a->LocalNamed.GetItemNr(Idtf));
+			AddBCC(AB_LOCALN_R, iLocal);
 			Shift();
 		}
 		// check for global variable (static)
-		else if (a->Engine->GlobalNamedNames.GetItemNr(Idtf) != -1)
+		else if (const std::int32_t iGlobal{LookupVar(C4AulCodeCache::LookupType::Global, Idtf)}; iGlobal != -1)
 		{
 			// insert variable by id
-			AddBCC(AB_GLOBALN_R, a->Engine->GlobalNamedNames.GetItemNr(Idtf));
+			AddBCC(AB_GLOBALN_R, iGlobal);
 			Shift();
 		}
 		// function identifier: check special functions
@@ -2808,9 +3002,9 @@ void C4AulParseState::Parse_Expression(int iParentPrio)
 			C4AulFunc *FoundFn;
 			// get regular function
 			if (Fn->Owner == &Game.ScriptEngine)
-				FoundFn = Fn->Owner->GetFuncRecursive(Idtf);
+				FoundFn = LookupFunc(C4AulCodeCache::LookupType::Func, Idtf, 2);
 			else
-				FoundFn = a->GetFuncRecursive(Idtf);
+				FoundFn = LookupFunc(C4AulCodeCache::LookupType::Func, Idtf);
 			if (Type == PREPARSER)
 			{
 				Shift();
@@ -2835,7 +3029,7 @@ void C4AulParseState::Parse_Expression(int iParentPrio)
 				// global constants have lowest priority for backwards compatibility
 				// it is now allowed to have functional overloads of these constants
 				C4Value val;
-				if (a->Engine->GetGlobalConstant(Idtf, &val))
+				if (LookupConstant(Idtf, &val))
 				{
 					// store as direct constant
 					switch (val.GetType())
@@ -3134,9 +3328,7 @@ bool C4AulParseState::Parse_Expression3()
 			Shift();
 			if (TokenType == ATT_IDTF)
 			{
-				C4String *string;
-				if (!(string = a->Engine->Strings.FindString(Idtf)))
-					string = a->Engine->Strings.RegString(Idtf);
+				C4String *string = a->Engine->Strings.RegString(Idtf);
 				if (Type == PARSER) string->Hold = true;
 				AddBCC(AB_MAPA_R, reinterpret_cast<std::intptr_t>(string));
 				Shift();
@@ -3175,7 +3367,7 @@ bool C4AulParseState::Parse_Expression3()
 						throw C4AulParseError(this, "direct object call: def not found: ", C4IdText(idNS));
 					}
 					// search func
-					if (!(pFunc = pDef->Script.GetSFunc(Idtf)))
+					if (!(pFunc = LookupFunc(C4AulCodeCache::LookupType::DefFunc, Idtf, idNS)))
 					{
 						throw C4AulParseError(this, std::format("direct object call: function {}::{} not found", C4IdText(idNS), +Idtf));
 					}
@@ -3206,13 +3398,13 @@ bool C4AulParseState::Parse_Expression3()
 				// search a function with the given name
 				if (eCallType == AB_CALLGLOBAL)
 				{
-					pFunc = a->Engine->GetFunc(Idtf, a->Engine, nullptr);
+					pFunc = LookupFunc(C4AulCodeCache::LookupType::GlobalFunc, Idtf);
 					// allocate space for return value, otherwise the call-target-variable is used, which is not present here
 					AddBCC(AB_STACK, +1);
 				}
 				else
 				{
-					pFunc = a->Engine->GetFirstFunc(Idtf);
+					pFunc = LookupFunc(C4AulCodeCache::LookupType::FirstFunc, Idtf);
 				}
 				if (!pFunc)
 				{
@@ -3507,7 +3699,7 @@ loopEnd:
 	return result;
 }
 
-bool C4AulScript::Parse()
+bool C4AulScript::Parse(C4AulCodeCache *pCache)
 {
 #if DEBUG_BYTECODE_DUMP
 	const auto logger = Application.LogSystem.GetOrCreate("C4AulScript");
@@ -3520,11 +3712,18 @@ bool C4AulScript::Parse()
 
 	// parse children
 	C4AulScript *s = Child0;
-	while (s) { s->Parse(); s = s->Next; }
+	while (s) { s->Parse(pCache); s = s->Next; }
 	// check state
 	if (State != ASS_LINKED) return false;
 	// don't parse global funcs again, as they're parsed already through links
 	if (this == Engine) return false;
+	// unchanged script? take the byte code of the last start
+	if (pCache && pCache->Load(*this))
+	{
+		Engine->lineCnt += SGetLine(Script.getData(), Script.getPtr(Script.getLength()));
+		State = ASS_PARSED;
+		return true;
+	}
 	// delete existing code
 	delete[] Code;
 	CodeSize = CodeBufSize = 0;
@@ -3532,6 +3731,7 @@ bool C4AulScript::Parse()
 	CPos = Code;
 
 	// parse script funcs
+	bool fErrors = false;
 	C4AulFunc *f;
 	for (f = Func0; f; f = f->Next)
 	{
@@ -3548,7 +3748,7 @@ bool C4AulScript::Parse()
 			// parse function
 			try
 			{
-				ParseFn(Fn);
+				ParseFn(Fn, false, pCache);
 			}
 			catch (const C4AulError &err)
 			{
@@ -3574,6 +3774,7 @@ bool C4AulScript::Parse()
 				}
 				// add an error chunk
 				AddBCC(AB_ERR);
+				fErrors = true;
 			}
 
 			// add separator
@@ -3594,12 +3795,23 @@ bool C4AulScript::Parse()
 			if (Fn) if (Fn->Owner != Engine) Fn = nullptr;
 		}
 		if (Fn)
+		{
 			Fn->Code = Code + reinterpret_cast<std::intptr_t>(Fn->Code);
+			// let jumps to jumps go to the final target directly; appended and included functions keep the strictness of their script
+			if (IsOptimizedStrictness(Fn->pOrgScript->Strict))
+				ThreadJumps(Fn->Code);
+		}
 	}
 
+	// replace common chunk sequences by superinstructions
+	FuseInstructions(Code, CodeSize);
+
 	// save line count
 	Engine->lineCnt += SGetLine(Script.getData(), Script.getPtr(Script.getLength()));
 
+	// remember the byte code for the next start; scripts with errors are parsed again, so the errors are shown every time
+	if (pCache) pCache->Store(*this, !fErrors);
+
 	// dump bytecode
 #if DEBUG_BYTECODE_DUMP
 	for (f = Func0; f; f = f->Next)
@@ -110,6 +110,8 @@ void C4ConfigGeneral::CompileFunc(StdCompiler *pComp)
 #else
 	pComp->Value(mkNamingAdapt(Preloading,           "Preloading",           true));
 #endif
+	pComp->Value(mkNamingAdapt(GroupCacheSize,       "GroupCacheSize",       0,     false, true));
+	pComp->Value(mkNamingAdapt(BinarySavegames,      "BinarySavegames",      false, false, true));
 
 #ifndef _WIN32
 	pComp->Value(mkNamingAdapt(ThreadPoolThreadCount, "ThreadPoolThreadCount", 8));
@@ -141,6 +143,9 @@ void C4ConfigDeveloper::CompileFunc(StdCompiler *pComp)
 {
 	pComp->Value(mkNamingAdapt(AutoFileReload, "AutoFileReload", true, false, true));
 	pComp->Value(mkNamingAdapt(ConsoleScriptStrictness, "ConsoleScriptStrictness", ConsoleScriptStrictnessWrapper{ConsoleScriptStrictnessWrapper::MaxStrictSentinel}));
+	pComp->Value(mkNamingAdapt(OptimizeScripts, "OptimizeScripts", true));
+	pComp->Value(mkNamingAdapt(OptimizeScriptsStrictness, "OptimizeScriptsStrictness", ConsoleScriptStrictnessWrapper{C4AulScriptStrict::NONSTRICT}));
+	pComp->Value(mkNamingAdapt(CacheScripts, "CacheScripts", true));
 }
 
 void C4ConfigGraphics::CompileFunc(StdCompiler *pComp)
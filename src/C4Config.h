@@ -85,6 +85,8 @@ public:
 	bool UseWhiteLobbyChat;
 	bool ShowLogTimestamps;
 	bool Preloading;
+	int32_t GroupCacheSize; // maximum size of the uncompressed group cache in MB; 0 disables it
+	bool BinarySavegames; // save objects of savegames in the binary format, which is faster but not editable
 #ifndef _WIN32
 	std::uint32_t ThreadPoolThreadCount;
 #endif
@@ -116,6 +118,9 @@ public:
 public:
 	bool AutoFileReload;
 	ConsoleScriptStrictnessWrapper ConsoleScriptStrictness;
+	bool OptimizeScripts; // fold constants and thread jumps when compiling scripts
+	ConsoleScriptStrictnessWrapper OptimizeScriptsStrictness; // minimum strictness of optimized scripts
+	bool CacheScripts; // keep the byte code of all scripts on disk and reuse it while no script changes
 
 	void CompileFunc(StdCompiler *pComp);
 };
@@ -18,6 +18,7 @@
 
 #include <C4Include.h>
 #include <C4Def.h>
+#include <C4DefPreload.h>
 #include <C4Version.h>
 #include <C4GameVersion.h>
 #include <C4FileMonitor.h>
@@ -521,7 +522,8 @@ void C4Def::Clear()
 bool C4Def::Load(C4Group &hGroup,
 	uint32_t dwLoadWhat,
 	const char *szLanguage,
-	C4SoundSystem *pSoundSystem)
+	C4SoundSystem *pSoundSystem,
+	C4DefPreload *pPreload)
 {
 	bool fSuccess = true;
 	const bool addFileMonitoring{!hGroup.IsPacked() && !SEqual(hGroup.GetFullName().getData(), Filename)};
@@ -600,7 +602,7 @@ bool C4Def::Load(C4Group &hGroup,
 
 	// Read surface bitmap
 	if (dwLoadWhat & C4D_Load_Bitmap)
-		if (!Graphics.LoadAllGraphics(hGroup, !!ColorByOwner))
+		if (!Graphics.LoadAllGraphics(hGroup, !!ColorByOwner, pPreload))
 		{
 			DebugLog(spdlog::level::err, "Error loading graphics of {} ({})", hGroup.GetFullName().getData(), C4IdText(id));
 			return false;
@@ -724,23 +726,29 @@ bool C4Def::Load(C4Group &hGroup,
 	// Post-load settings
 	Scale = C4DefCore::Scale / 100.0f;
 
+	// preloading: checked when the surfaces are created
+	if (!pPreload) CheckGraphics();
+
+	return true;
+}
+
+void C4Def::CheckGraphics()
+{
 	if (Graphics.GetBitmap())
 	{
 		// check SolidMask
 		if (SolidMask.x < 0 || SolidMask.y < 0 || SolidMask.x + SolidMask.Wdt > Graphics.Bitmap->Wdt || SolidMask.y + SolidMask.Hgt > Graphics.Bitmap->Hgt) SolidMask.Default();
 		// Set MainFace (unassigned bitmap: will be set by GetMainFace())
 		MainFace.Set(nullptr, 0, 0, Shape.Wdt, Shape.Hgt);
-	}
 
-	// validate TopFace
-	if (TopFace.x < 0 || TopFace.y < 0 || TopFace.x + TopFace.Wdt > Graphics.Bitmap->Wdt / Scale || TopFace.y + TopFace.Hgt > Graphics.Bitmap->Hgt / Scale)
-	{
-		TopFace.Default();
-		// warn in debug mode
-		DebugLog(spdlog::level::warn, "invalid TopFace in {}({})", Name.getData(), C4IdText(id));
+		// validate TopFace
+		if (TopFace.x < 0 || TopFace.y < 0 || TopFace.x + TopFace.Wdt > Graphics.Bitmap->Wdt / Scale || TopFace.y + TopFace.Hgt > Graphics.Bitmap->Hgt / Scale)
+		{
+			TopFace.Default();
+			// warn in debug mode
+			DebugLog(spdlog::level::warn, "invalid TopFace in {}({})", Name.getData(), C4IdText(id));
+		}
 	}
-
-	return true;
 }
 
 bool C4Def::LoadActMap(C4Group &hGroup)
@@ -925,10 +933,12 @@ int32_t C4DefList::Load(C4Group &hGroup, uint32_t dwLoadWhat,
 	if (fThisSearchMessage) { LogNTr("{}...", GetFilename(hGroup.GetName())); }
 
 	auto def = std::make_unique<C4Def>();
-	// Load primary definition
-	if (def->Load(hGroup, dwLoadWhat, szLanguage, pSoundSystem) && Add(def.get(), fOverload))
+	// Load primary definition; when preloading, its graphics are decoded while the next definitions load
+	auto preload = Preloader ? std::make_shared<C4DefPreload>(hGroup.GetFullName().getData()) : nullptr;
+	if (def->Load(hGroup, dwLoadWhat, szLanguage, pSoundSystem, preload.get()) && Add(def.get(), fOverload))
 	{
 		iResult++; fPrimaryDef = true;
+		if (preload) Preloader->Add(def.get(), std::move(preload));
 		def.release();
 	}
 	else
@@ -1047,7 +1057,15 @@ int32_t C4DefList::Load(const char *szSearch,
 		LoadFailure = true;
 		return iResult;
 	}
-	iResult += Load(hGroup, dwLoadWhat, szLanguage, pSoundSystem, fOverload, true, iMinProgress, iMaxProgress);
+	{
+		// let worker threads decode the graphics while loading
+		C4DefPreloader preloader{*this};
+		Preloader = &preloader;
+		iResult += Load(hGroup, dwLoadWhat, szLanguage, pSoundSystem, fOverload, true, iMinProgress, iMaxProgress);
+		preloader.FinishAll();
+		Preloader = nullptr;
+		preloader.LogTimings(szSearch);
+	}
 	hGroup.Close();
 
 	// progress (could go down one level of recursion...)
@@ -1080,6 +1098,7 @@ bool C4DefList::Add(C4Def *pDef, bool fOverload)
 	if (hasOld)
 	{
 		// Replace old def
+		if (Preloader) Preloader->Forget(old->get());
 		old->reset(pDef);
 	}
 	else
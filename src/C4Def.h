@@ -38,6 +38,9 @@
 #include <memory>
 #include <vector>
 
+class C4DefPreload;
+class C4DefPreloader;
+
 const int32_t C4D_None                   = 0,
               C4D_All                    = ~C4D_None,
 
@@ -345,7 +348,8 @@ public:
 	void Default();
 	bool Load(C4Group &hGroup,
 		uint32_t dwLoadWhat, const char *szLanguage,
-		class C4SoundSystem *pSoundSystem = nullptr);
+		class C4SoundSystem *pSoundSystem = nullptr,
+		C4DefPreload *pPreload = nullptr);
 	void Draw(C4Facet &cgo, bool fSelected = false, uint32_t iColor = 0, C4Object *pObj = nullptr, int32_t iPhaseX = 0, int32_t iPhaseY = 0);
 	inline C4Facet &GetMainFace(C4DefGraphics *pGraphics, uint32_t dwClr = 0) { MainFace.Surface = pGraphics->GetBitmap(dwClr); return MainFace; }
 	int32_t GetValue(C4Object *pInBase, int32_t iBuyPlayer); // get value of def; calling script functions if defined
@@ -353,6 +357,7 @@ public:
 	void ClearFairCrewPhysicals(); // remove cached fair crew physicals, will be created fresh on demand
 	void Synchronize();
 	const char *GetDesc() { return Desc.GetData(); }
+	void CheckGraphics(); // validate faces against the loaded graphics
 
 protected:
 	bool LoadPortraits(C4Group &hGroup);
@@ -384,6 +389,9 @@ public:
 public:
 	bool LoadFailure;
 
+protected:
+	C4DefPreloader *Preloader{nullptr}; // while loading a group by name
+
 public:
 	void Clear();
 	int32_t Load(C4Group &hGroup,
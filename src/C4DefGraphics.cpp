@@ -20,6 +20,8 @@
 #include <C4Include.h>
 #include <C4DefGraphics.h>
 
+#include <C4DefPreload.h>
+
 #include <C4SurfaceFile.h>
 #include <C4Object.h>
 #include <C4ObjectInfo.h>
@@ -55,11 +57,13 @@ void C4DefGraphics::Clear()
 	pNext = nullptr; fColorBitmapAutoCreated = false;
 }
 
-bool C4DefGraphics::LoadGraphics(C4Group &hGroup, const char *szFilename, const char *szFilenamePNG, const char *szOverlayPNG, bool fColorByOwner)
+bool C4DefGraphics::LoadGraphics(C4Group &hGroup, const char *szFilename, const char *szFilenamePNG, const char *szOverlayPNG, bool fColorByOwner, C4DefPreload *const pPreload)
 {
 	// try png
 	if (szFilenamePNG && hGroup.AccessEntry(szFilenamePNG))
 	{
+		// preloading: decoded on a worker thread, the surfaces are created when the definition is finished
+		if (pPreload) return pPreload->AddGraphics(hGroup, *this, szFilenamePNG, fColorByOwner ? szOverlayPNG : nullptr, fColorByOwner);
 		Bitmap = new C4Surface();
 		if (!Bitmap->ReadPNG(hGroup)) return false;
 	}
@@ -73,38 +77,64 @@ bool C4DefGraphics::LoadGraphics(C4Group &hGroup, const char *szFilename, const
 	// Create owner color bitmaps
 	if (fColorByOwner)
 	{
-		// Create additionmal bitmap
-		BitmapClr = new C4Surface();
 		// if overlay-surface is present, load from that
+		std::unique_ptr<C4Surface> overlay;
 		if (szOverlayPNG && hGroup.AccessEntry(szOverlayPNG))
 		{
-			if (!BitmapClr->ReadPNG(hGroup))
-				return false;
-			// set as Clr-surface, also checking size
-			if (!BitmapClr->SetAsClrByOwnerOf(Bitmap))
-			{
-				const char *szFn = szFilenamePNG ? szFilenamePNG : szFilename;
-				if (!szFn) szFn = "???";
-				DebugLog(spdlog::level::err, "Gfx loading error in {}: {} ({} x {}) doesn't match overlay {} ({} x {}) - invalid file or size mismatch",
-					hGroup.GetFullName().getData(), szFn, Bitmap ? Bitmap->Wdt : -1, Bitmap ? Bitmap->Hgt : -1,
-					szOverlayPNG, BitmapClr->Wdt, BitmapClr->Hgt);
-				delete BitmapClr; BitmapClr = nullptr;
-				return false;
-			}
+			overlay = std::make_unique<C4Surface>();
+			if (!overlay->ReadPNG(hGroup)) return false;
 		}
-		else
-			// otherwise, create by all blue shades
-			if (!BitmapClr->CreateColorByOwner(Bitmap)) return false;
-		fColorBitmapAutoCreated = true;
+		return LoadColorByOwner(overlay.release(), hGroup.GetFullName().getData(), szFilenamePNG ? szFilenamePNG : szFilename, szOverlayPNG);
 	}
 	// success
 	return true;
 }
 
-bool C4DefGraphics::LoadAllGraphics(C4Group &hGroup, bool fColorByOwner)
+bool C4DefGraphics::LoadGraphics(const StdBitmap &bitmap, const StdBitmap *const pOverlay, const bool fColorByOwner, const char *const szGroupName, const char *const szFilenamePNG, const char *const szOverlayPNG)
+{
+	Bitmap = new C4Surface();
+	if (!Bitmap->ReadBitmap(bitmap)) return false;
+	if (!fColorByOwner) return true;
+
+	std::unique_ptr<C4Surface> overlay;
+	if (pOverlay)
+	{
+		overlay = std::make_unique<C4Surface>();
+		if (!overlay->ReadBitmap(*pOverlay)) return false;
+	}
+	return LoadColorByOwner(overlay.release(), szGroupName, szFilenamePNG, szOverlayPNG);
+}
+
+bool C4DefGraphics::LoadColorByOwner(C4Surface *const pOverlay, const char *const szGroupName, const char *szFilename, const char *const szOverlayPNG)
+{
+	if (pOverlay)
+	{
+		BitmapClr = pOverlay;
+		// set as Clr-surface, also checking size
+		if (!BitmapClr->SetAsClrByOwnerOf(Bitmap))
+		{
+			if (!szFilename) szFilename = "???";
+			DebugLog(spdlog::level::err, "Gfx loading error in {}: {} ({} x {}) doesn't match overlay {} ({} x {}) - invalid file or size mismatch",
+				szGroupName, szFilename, Bitmap ? Bitmap->Wdt : -1, Bitmap ? Bitmap->Hgt : -1,
+				szOverlayPNG, BitmapClr->Wdt, BitmapClr->Hgt);
+			delete BitmapClr; BitmapClr = nullptr;
+			return false;
+		}
+	}
+	else
+	{
+		// otherwise, create by all blue shades
+		BitmapClr = new C4Surface();
+		if (!BitmapClr->CreateColorByOwner(Bitmap)) return false;
+	}
+	fColorBitmapAutoCreated = true;
+	return true;
+}
+
+bool C4DefGraphics::LoadAllGraphics(C4Group &hGroup, bool fColorByOwner, C4DefPreload *const pPreload)
 {
 	// load basic graphics
-	if (!LoadGraphics(hGroup, C4CFN_DefGraphics, C4CFN_DefGraphicsPNG, C4CFN_ClrByOwnerPNG, fColorByOwner)) return false;
+	if (!LoadGraphics(hGroup, C4CFN_DefGraphics, C4CFN_DefGraphicsPNG, C4CFN_ClrByOwnerPNG, fColorByOwner, pPreload)) return false;
 	// load additional graphics
 	// first, search all png-graphics in NewGfx
 	char Filename[_MAX_PATH + 1]; *Filename = 0;
@@ -137,7 +167,7 @@ bool C4DefGraphics::LoadAllGraphics(C4Group &hGroup, bool fColorByOwner)
 			EnforceExtension(OverlayFn, GetExtension(C4CFN_ClrByOwnerExPNG));
 		}
 		// load them
-		if (!pLastGraphics->LoadGraphics(hGroup, nullptr, Filename, fColorByOwner ? OverlayFn : nullptr, fColorByOwner))
+		if (!pLastGraphics->LoadGraphics(hGroup, nullptr, Filename, fColorByOwner ? OverlayFn : nullptr, fColorByOwner, pPreload))
 			return false;
 	}
 	// load bitmap-graphics
@@ -197,7 +227,7 @@ bool C4DefGraphics::LoadAllGraphics(C4Group &hGroup, bool fColorByOwner)
 		pLastGraphics->pNext = new C4PortraitGraphics(pDef, GrpName);
 		pLastGraphics = pLastGraphics->pNext;
 		// load them
-		if (!pLastGraphics->LoadGraphics(hGroup, fBMP ? Filename : nullptr, fBMP ? nullptr : Filename, *OverlayFn ? OverlayFn : nullptr, fColorByOwner))
+		if (!pLastGraphics->LoadGraphics(hGroup, fBMP ? Filename : nullptr, fBMP ? nullptr : Filename, *OverlayFn ? OverlayFn : nullptr, fColorByOwner, pPreload))
 			return false;
 	}
 	// done, success
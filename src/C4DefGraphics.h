@@ -32,6 +32,7 @@
 // defintion graphics
 class C4AdditionalDefGraphics;
 class C4DefGraphicsPtrBackup;
+class C4DefPreload;
 class C4PortraitGraphics;
 
 class C4DefGraphics
@@ -51,8 +52,9 @@ public:
 	C4DefGraphics(C4Def *pOwnDef = nullptr);
 	virtual ~C4DefGraphics() { Clear(); }
 
-	bool LoadGraphics(C4Group &hGroup, const char *szFilename, const char *szFilenamePNG, const char *szOverlayPNG, bool fColorByOwner); // load specified graphics from group
-	bool LoadAllGraphics(C4Group &hGroup, bool fColorByOwner); // load graphics from group
+	bool LoadGraphics(C4Group &hGroup, const char *szFilename, const char *szFilenamePNG, const char *szOverlayPNG, bool fColorByOwner, C4DefPreload *pPreload = nullptr); // load specified graphics from group; with pPreload, PNGs are only read and the surfaces created later
+	bool LoadGraphics(const StdBitmap &bitmap, const StdBitmap *pOverlay, bool fColorByOwner, const char *szGroupName, const char *szFilenamePNG, const char *szOverlayPNG); // create surfaces from decoded PNGs
+	bool LoadAllGraphics(C4Group &hGroup, bool fColorByOwner, C4DefPreload *pPreload = nullptr); // load graphics from group
 	bool ColorizeByMaterial(int32_t iMat, C4MaterialMap &rMats, uint8_t bGBM); // colorize all graphics by material
 	C4DefGraphics *Get(const char *szGrpName); // get graphics by name
 	void Clear(); // clear fields; delete additional graphics
@@ -71,6 +73,9 @@ public:
 
 	void DrawClr(C4Facet &cgo, bool fAspect = true, uint32_t dwClr = 0); // set surface color and draw
 
+protected:
+	bool LoadColorByOwner(C4Surface *pOverlay, const char *szGroupName, const char *szFilename, const char *szOverlayPNG); // takes pOverlay; creates the surface from Bitmap if there is none
+
 	friend class C4DefGraphicsPtrBackup;
 };
 
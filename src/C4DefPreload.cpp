@@ -0,0 +1,169 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4DefPreload.h>
+
+#include <C4Config.h>
+#include <C4Def.h>
+#include <C4Group.h>
+#include <C4Log.h>
+#include <C4ThreadPool.h>
+#include <StdPNG.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+	std::int64_t ToMilliseconds(const std::chrono::steady_clock::duration duration)
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+	}
+}
+
+bool C4DefPreload::AddGraphics(C4Group &hGroup, C4DefGraphics &graphics, const char *const szFilenamePNG, const char *const szOverlayPNG, const bool fColorByOwner)
+{
+	Graphics &added = PendingGraphics.emplace_back(&graphics, fColorByOwner, Images.size());
+	Image &image = Images.emplace_back();
+	image.Entry = szFilenamePNG;
+	if (!hGroup.LoadEntry(szFilenamePNG, image.Data)) return false;
+
+	if (szOverlayPNG && hGroup.AccessEntry(szOverlayPNG))
+	{
+		added.iOverlay = Images.size();
+		Image &overlay = Images.emplace_back();
+		overlay.Entry = szOverlayPNG;
+		if (!hGroup.LoadEntry(szOverlayPNG, overlay.Data)) return false;
+	}
+	return true;
+}
+
+void C4DefPreload::Decode()
+{
+	for (auto &image : Images)
+	{
+		try
+		{
+			CPNGFile png{image.Data.getData(), image.Data.getSize()};
+			image.Bitmap = std::make_unique<StdBitmap>(png.Width(), png.Height(), png.UsesAlpha());
+			png.Decode(image.Bitmap->GetBytes());
+		}
+		catch (const std::runtime_error &)
+		{
+			// the graphics fail to load like a PNG that is read from the group
+			image.Bitmap.reset();
+		}
+		image.Data.Clear();
+	}
+}
+
+bool C4DefPreload::Finish()
+{
+	for (const auto &graphics : PendingGraphics)
+	{
+		const Image &image{Images[graphics.iImage]};
+		const Image *const pOverlay{graphics.iOverlay ? &Images[*graphics.iOverlay] : nullptr};
+		if (!image.Bitmap || (pOverlay && !pOverlay->Bitmap)) return false;
+		if (!graphics.pGraphics->LoadGraphics(*image.Bitmap, pOverlay ? pOverlay->Bitmap.get() : nullptr, graphics.fColorByOwner,
+			GroupName.c_str(), image.Entry.c_str(), pOverlay ? pOverlay->Entry.c_str() : nullptr))
+			return false;
+	}
+	Images.clear();
+	return true;
+}
+
+C4DefPreloader::~C4DefPreloader()
+{
+	// tasks refer to the preloader
+	std::unique_lock lock{Mutex};
+	DecodedCondition.wait(lock, [this] { return DecodedCount == Submitted; });
+}
+
+void C4DefPreloader::Add(C4Def *const pDef, std::shared_ptr<C4DefPreload> preload)
+{
+	++Count;
+	if (C4ThreadPool::Global)
+	{
+		{
+			const std::lock_guard lock{Mutex};
+			++Submitted;
+		}
+		C4ThreadPool::Global->SubmitCallback([this, preload] { Decode(*preload); });
+	}
+	else
+	{
+		// no worker threads: decode right away
+		++Submitted;
+		Decode(*preload);
+	}
+	Pending.push_back({pDef, std::move(preload)});
+
+	// keep the workers busy, but don't let decoded images pile up
+	while (Pending.size() > MaxDecodeAhead) FinishFirst();
+}
+
+void C4DefPreloader::Decode(C4DefPreload &preload)
+{
+	const auto start = Clock::now();
+	preload.Decode();
+	const auto duration = Clock::now() - start;
+
+	const std::lock_guard lock{Mutex};
+	preload.Decoded = true;
+	++DecodedCount;
+	DecodeTime += duration;
+	DecodedCondition.notify_all();
+}
+
+void C4DefPreloader::FinishFirst()
+{
+	const Def def{std::move(Pending.front())};
+	Pending.pop_front();
+
+	const auto start = Clock::now();
+	{
+		std::unique_lock lock{Mutex};
+		DecodedCondition.wait(lock, [&def] { return def.Preload->Decoded; });
+	}
+	WaitTime += Clock::now() - start;
+
+	if (!def.Preload->Finish())
+	{
+		DebugLog(spdlog::level::err, "Error loading graphics of {} ({})", def.Preload->GroupName, C4IdText(def.pDef->id));
+		DefList.Remove(def.pDef);
+	}
+	else
+		def.pDef->CheckGraphics();
+}
+
+void C4DefPreloader::Forget(C4Def *const pDef)
+{
+	// decoding goes on, but the surfaces aren't created
+	std::erase_if(Pending, [pDef](const Def &def) { return def.pDef == pDef; });
+}
+
+void C4DefPreloader::FinishAll()
+{
+	while (!Pending.empty()) FinishFirst();
+}
+
+void C4DefPreloader::LogTimings(const char *const szName)
+{
+	if (Config.Graphics.VerboseObjectLoading < 1) return;
+
+	LogNTr("{}: {} definitions; decoding {} ms on worker threads (waited {} ms), {} ms in total",
+		szName, Count, ToMilliseconds(DecodeTime), ToMilliseconds(WaitTime), ToMilliseconds(Clock::now() - Start));
+}
@@ -0,0 +1,120 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// definition graphics which are decoded on worker threads while the following definitions are loaded
+
+#pragma once
+
+#include "StdBitmap.h"
+#include "StdBuf.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+class C4Def;
+class C4DefGraphics;
+class C4DefList;
+class C4Group;
+
+// PNG graphics of a single definition; C4DefGraphics::LoadGraphics reads them, the surfaces are created by Finish
+class C4DefPreload
+{
+public:
+	struct Image
+	{
+		std::string Entry;
+		StdBuf Data; // PNG file; freed after decoding
+		std::unique_ptr<StdBitmap> Bitmap; // nullptr if decoding failed
+	};
+
+	struct Graphics
+	{
+		C4DefGraphics *pGraphics;
+		bool fColorByOwner;
+		std::size_t iImage;
+		std::optional<std::size_t> iOverlay;
+	};
+
+private:
+	std::string GroupName;
+	std::vector<Image> Images;
+	std::vector<Graphics> PendingGraphics;
+	bool Decoded{false}; // guarded by C4DefPreloader::Mutex
+
+public:
+	C4DefPreload(std::string groupName) : GroupName{std::move(groupName)} {}
+
+	bool AddGraphics(C4Group &hGroup, C4DefGraphics &graphics, const char *szFilenamePNG, const char *szOverlayPNG, bool fColorByOwner); // main thread
+	void Decode(); // worker thread
+	bool Finish(); // main thread; creates the surfaces of all graphics
+
+	friend class C4DefPreloader;
+};
+
+// Definitions are loaded in a single walk over the group, so every entry is read once:
+// - loading: C4DefList::Load runs as before; only the PNG graphics are just read into memory
+// - decoding: the PNGs are decoded on C4ThreadPool::Global while the following definitions are loaded
+// - finishing: a limited number of definitions behind loading, the surfaces are created in the original order
+// Sounds, names, scripts and DefCores are still read and processed on the loading thread during the walk.
+class C4DefPreloader
+{
+public:
+	static constexpr std::size_t MaxDecodeAhead = 64; // limits the memory used by decoded images waiting to be finished
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Def
+	{
+		C4Def *pDef;
+		std::shared_ptr<C4DefPreload> Preload;
+	};
+
+	C4DefList &DefList;
+	std::deque<Def> Pending; // in load order
+	std::size_t Count{0};
+	std::size_t Submitted{0};
+	std::size_t DecodedCount{0};
+	std::mutex Mutex;
+	std::condition_variable DecodedCondition;
+
+	// timings
+	Clock::time_point Start;
+	Clock::duration DecodeTime{}; // summed over all worker threads
+	Clock::duration WaitTime{}; // loading thread waiting for decoding
+
+	void Decode(C4DefPreload &preload);
+	void FinishFirst();
+
+public:
+	C4DefPreloader(C4DefList &defList) : DefList{defList}, Start{Clock::now()} {}
+	~C4DefPreloader();
+
+	C4DefPreloader(const C4DefPreloader &) = delete;
+	C4DefPreloader &operator=(const C4DefPreloader &) = delete;
+
+	void Add(C4Def *pDef, std::shared_ptr<C4DefPreload> preload); // pDef was added to the list; starts decoding its graphics
+	void Forget(C4Def *pDef); // pDef is about to be deleted
+	void FinishAll();
+	void LogTimings(const char *szName);
+};
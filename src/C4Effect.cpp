@@ -25,7 +25,9 @@
 #include <C4Game.h>
 #include <C4Wrappers.h>
 
+#include <algorithm>
 #include <format>
+#include <limits>
 #include <numbers>
 
 void C4Effect::AssignCallbackFunctions()
@@ -72,6 +74,7 @@ C4Effect::C4Effect(C4Object *pForObj, const char *szName, int32_t iPrio, int32_t
 	AssignCallbackFunctions();
 	// get effect target
 	C4Effect **ppEffectList = pForObj ? &pForObj->pEffects : &Game.pGlobalEffects;
+	Reschedule(pForObj);
 	// assign a unique number for that object
 	iNumber = 1;
 	for (pCheck = *ppEffectList; pCheck; pCheck = pCheck->pNext)
@@ -198,7 +201,7 @@ void C4Effect::DenumeratePointers()
 	} while (pEff = pEff->pNext);
 }
 
-void C4Effect::ClearPointers(C4Object *pObj)
+void C4Effect::ClearPointers(C4Object *pForObj, C4Object *pObj)
 {
 	// clear pointers in all effects
 	C4Effect *pEff = this;
@@ -206,6 +209,7 @@ void C4Effect::ClearPointers(C4Object *pObj)
 		// command target lost: effect dead w/o callback
 		if (pEff->pCommandTarget == pObj)
 		{
+			Reschedule(pForObj);
 			pEff->SetDead();
 			pEff->pCommandTarget = nullptr;
 		}
@@ -316,8 +320,41 @@ int32_t C4Effect::Check(C4Object *pForObj, const char *szCheckEffect, int32_t iP
 	return 0;
 }
 
+namespace
+{
+	C4EffectListSchedule &GetSchedule(C4Object *pObj)
+	{
+		return pObj ? pObj->EffectSchedule : Game.GlobalEffectSchedule;
+	}
+}
+
+void C4Effect::UpdateTimes(C4Object *pObj)
+{
+	C4EffectListSchedule &rSchedule = GetSchedule(pObj);
+	if (!rSchedule.iLag) return;
+	// all effects have been alive during the skipped executions, because any change reschedules
+	for (C4Effect *pEff = pObj ? pObj->pEffects : Game.pGlobalEffects; pEff; pEff = pEff->pNext)
+		pEff->iTime += rSchedule.iLag;
+	rSchedule.iLag = 0;
+}
+
+void C4Effect::Reschedule(C4Object *pObj)
+{
+	UpdateTimes(pObj);
+	GetSchedule(pObj).iIdle = 0;
+}
+
 void C4Effect::Execute(C4Object *pObj)
 {
+	// nothing due? Then only the time passes
+	C4EffectListSchedule &rSchedule = GetSchedule(pObj);
+	if (rSchedule.iIdle)
+	{
+		--rSchedule.iIdle;
+		++rSchedule.iLag;
+		return;
+	}
+	UpdateTimes(pObj);
 	// get effect list
 	C4Effect **ppEffectList = pObj ? &pObj->pEffects : &Game.pGlobalEffects;
 	// execute all effects not marked as dead
@@ -360,10 +397,24 @@ void C4Effect::Execute(C4Object *pObj)
 			pEffect = pEffect->pNext;
 		}
 	} while (pEffect);
+	// find the next execution that calls a timer; dead effects are deleted in the next one
+	int32_t iIdle = std::numeric_limits<int32_t>::max();
+	for (pEffect = *ppEffectList; pEffect && iIdle; pEffect = pEffect->pNext)
+		if (pEffect->IsDead())
+			iIdle = 0;
+		else if (pEffect->iIntervall)
+		{
+			const int32_t iIntervall = Abs(pEffect->iIntervall);
+			int32_t iPhase = pEffect->iTime % iIntervall;
+			if (iPhase < 0) iPhase += iIntervall;
+			iIdle = std::min(iIdle, iIntervall - iPhase - 1);
+		}
+	rSchedule.iIdle = iIdle;
 }
 
 void C4Effect::Kill(C4Object *pObj)
 {
+	Reschedule(pObj);
 	const auto deletionTracker = TrackDeletion();
 	// active?
 	C4Effect *pLastRemovedEffect = nullptr;
@@ -411,6 +462,7 @@ void C4Effect::ClearAll(C4Object *pObj, int32_t iClearFlag)
 	// because this could hang the engine with poorly coded effects
 	if (pNext) pNext->ClearAll(pObj, iClearFlag);
 	if ((pObj && !pObj->Status) || IsDead()) return;
+	Reschedule(pObj);
 	int32_t iPrevPrio = iPriority;
 	SetDead();
 	if (pFnStop)
@@ -793,7 +845,7 @@ int32_t FnFxFireStop(C4AulContext *ctx, C4Object *pObj, int32_t iNumber, int32_t
 
 C4String *FnFxFireInfo(C4AulContext *ctx, C4Object *pObj, int32_t iNumber)
 {
-	return new C4String(LoadResStr(C4ResStrTableKey::IDS_OBJ_BURNS), &Game.ScriptEngine.Strings);
+	return Game.ScriptEngine.Strings.RegString(LoadResStr(C4ResStrTableKey::IDS_OBJ_BURNS));
 }
 
 // Some other, internal effects
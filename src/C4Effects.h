@@ -73,6 +73,14 @@ typedef unsigned long C4ID;
 #define C4Fx_FireMode_Object    3 // other (C4D_Object and no bit set (magic))
 #define C4Fx_FireMode_Last      3 // largest valid fire mode
 
+// execution state of an effect list (object or global effects)
+// executions in which no timer is due only count up iLag, which is added to the effect times on demand
+struct C4EffectListSchedule
+{
+	int32_t iIdle{0}; // upcoming executions that neither call a timer nor delete an effect
+	int32_t iLag{0}; // executions not yet added to the effect times
+};
+
 // generic object effect
 class C4Effect : private C4DeletionTrackable
 {
@@ -104,7 +112,7 @@ public:
 
 	void EnumeratePointers(); // object pointers to numbers
 	void DenumeratePointers(); // numbers to object pointers
-	void ClearPointers(C4Object *pObj); // clear all pointers to object - may kill some effects w/o callback, because the callback target is lost
+	void ClearPointers(C4Object *pForObj, C4Object *pObj); // clear all pointers to object - may kill some effects w/o callback, because the callback target is lost
 
 	void SetDead()              { iPriority = 0; }        // mark effect to be removed in next execution cycle
 	bool IsDead()               { return !iPriority; }    // return whether effect is to be removed
@@ -119,6 +127,8 @@ public:
 	C4AulScript *GetCallbackScript(); // get script context for effect callbacks
 
 	void Execute(C4Object *pObj); // execute all effects
+	static void UpdateTimes(C4Object *pObj); // bring effect times of object (or global effects) up to date
+	static void Reschedule(C4Object *pObj); // update effect times and execute all effects next time; call before changing the effect list
 	void Kill(C4Object *pObj); // mark this effect deleted and do approprioate calls
 	void ClearAll(C4Object *pObj, int32_t iClearFlag); // kill all effects doing removal calls w/o reagard of inactive effects
 	void DoDamage(C4Object *pObj, int32_t &riDamage, int32_t iDamageType, int32_t iCausePlr); // ask all effects for damage
@@ -161,6 +161,61 @@ C4FindObject *C4FindObject::CreateByValue(const C4Value &DataVal, C4SortObject *
 	return nullptr;
 }
 
+C4FindObject *C4FindObject::CreateByPars(const C4Value *pPars, bool fAllowSort)
+{
+	C4FindObject **ppFOs = new C4FindObject *[C4AUL_MAX_Par];
+	C4SortObject **ppSOs = new C4SortObject *[C4AUL_MAX_Par];
+	int32_t iCnt = 0, iSortCnt = 0;
+	// Read all parameters
+	for (int32_t i = 0; i < C4AUL_MAX_Par; i++)
+	{
+		const C4Value &Data = pPars[i].GetRefVal();
+		// No data given?
+		if (!Data) break;
+		// Construct
+		C4SortObject *pSO = nullptr;
+		C4FindObject *pFO = C4FindObject::CreateByValue(Data, fAllowSort ? &pSO : nullptr);
+		// Add FindObject
+		if (pFO)
+		{
+			ppFOs[iCnt++] = pFO;
+		}
+		// Add SortObject
+		if (pSO)
+		{
+			ppSOs[iSortCnt++] = pSO;
+		}
+	}
+	// No criterions?
+	if (!iCnt)
+	{
+		for (int32_t i = 0; i < iSortCnt; ++i) delete ppSOs[i];
+		delete[] ppSOs;
+		delete[] ppFOs;
+		return nullptr;
+	}
+	// create sort criterion
+	C4SortObject *pSO = nullptr;
+	if (iSortCnt > 1)
+		pSO = new C4SortObjectMultiple(iSortCnt, ppSOs);
+	else
+	{
+		if (iSortCnt) pSO = ppSOs[0];
+		delete[] ppSOs;
+	}
+	// Create search object
+	C4FindObject *pFO;
+	if (iCnt > 1)
+		pFO = new C4FindObjectAnd(iCnt, ppFOs);
+	else
+	{
+		pFO = ppFOs[0];
+		delete[] ppFOs;
+	}
+	if (pSO) pFO->SetSort(pSO);
+	return pFO;
+}
+
 int32_t C4FindObject::Count(const C4ObjectList &Objs)
 {
 	// Trivial cases
@@ -172,7 +227,7 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs)
 	int32_t iCount = 0;
 	for (C4ObjectLink *pLnk = Objs.First; pLnk; pLnk = pLnk->Next)
 		if (pLnk->Obj->Status)
-			if (Check(pLnk->Obj))
+			if (Match(pLnk->Obj))
 				iCount++;
 	return iCount;
 }
@@ -187,7 +242,7 @@ C4Object *C4FindObject::Find(const C4ObjectList &Objs)
 	C4Object *pBestResult = nullptr;
 	for (C4ObjectLink *pLnk = Objs.First; pLnk; pLnk = pLnk->Next)
 		if (pLnk->Obj->Status)
-			if (Check(pLnk->Obj))
+			if (Match(pLnk->Obj))
 				if (pLnk->Obj->Status)
 				{
 					// no sorting: Use first object found
@@ -210,7 +265,7 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs)
 	// Search
 	for (C4ObjectLink *pLnk = Objs.First; pLnk; pLnk = pLnk->Next)
 		if (pLnk->Obj->Status)
-			if (Check(pLnk->Obj))
+			if (Match(pLnk->Obj))
 			{
 				result.push_back(pLnk->Obj);
 			}
@@ -247,13 +302,27 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs, const C4LSectors &Sct)
 		// Create marker, count over all areas
 		uint32_t iMarker = ::Game.Objects.GetNextMarker();
 		int32_t iCount = 0;
+		// No script calls: sector contents can't change, so use the flat index
+		if (!CallsScript())
+		{
+			for (; pSct; pSct = Area.Next(pSct))
+				for (C4Object *const pObj : pSct->GetObjectShapeIndex())
+					if (pObj->Status)
+						if (pObj->Marker != iMarker)
+						{
+							pObj->Marker = iMarker;
+							if (Match(pObj))
+								iCount++;
+						}
+			return iCount;
+		}
 		for (; pLst; pLst = Area.NextObjectShapes(pLst, &pSct))
 			for (C4ObjectLink *pLnk = pLst->First; pLnk; pLnk = pLnk->Next)
 				if (pLnk->Obj->Status)
 					if (pLnk->Obj->Marker != iMarker)
 					{
 						pLnk->Obj->Marker = iMarker;
-						if (Check(pLnk->Obj))
+						if (Match(pLnk->Obj))
 							iCount++;
 					}
 		return iCount;
@@ -263,6 +332,15 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs, const C4LSectors &Sct)
 		// Count objects per area
 		C4LArea Area(&Game.Objects.Sectors, *pBounds); C4LSector *pSct;
 		int32_t iCount = 0;
+		if (!CallsScript())
+		{
+			for (pSct = Area.First(); pSct; pSct = Area.Next(pSct))
+				for (C4Object *const pObj : pSct->GetObjectIndex())
+					if (pObj->Status)
+						if (Match(pObj))
+							iCount++;
+			return iCount;
+		}
 		for (C4ObjectList *pLst = Area.FirstObjects(&pSct); pLst; pLst = Area.NextObjects(pLst, &pSct))
 			iCount += Count(*pLst);
 		return iCount;
@@ -279,6 +357,16 @@ C4Object *C4FindObject::Find(const C4ObjectList &Objs, const C4LSectors &Sct)
 	C4Rect *pBounds = GetBounds();
 	if (!pBounds)
 		return Find(Objs);
+	// Unsorted and without script calls: return first matching object from the flat index
+	else if (!pSort && !CallsScript())
+	{
+		C4LArea Area(&Game.Objects.Sectors, *pBounds);
+		for (C4LSector *pSct = Area.First(); pSct; pSct = Area.Next(pSct))
+			for (C4Object *const pObj : UseShapes() ? pSct->GetObjectShapeIndex() : pSct->GetObjectIndex())
+				if (pObj->Status)
+					if (Match(pObj))
+						return pObj;
+	}
 	// Traverse areas, return first matching object w/o sort or best with sort
 	else if (UseShapes())
 	{
@@ -329,29 +417,60 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors
 		// Set up array
 		// Create marker, search all areas
 		uint32_t iMarker = ::Game.Objects.GetNextMarker();
-		for (; pLst; pLst = Area.NextObjectShapes(pLst, &pSct))
-			for (C4ObjectLink *pLnk = pLst->First; pLnk; pLnk = pLnk->Next)
-				if (pLnk->Obj->Status)
-					if (pLnk->Obj->Marker != iMarker)
-					{
-						pLnk->Obj->Marker = iMarker;
-						if (Check(pLnk->Obj))
+		// No script calls: sector contents can't change, so use the flat index
+		if (!CallsScript())
+		{
+			for (; pSct; pSct = Area.Next(pSct))
+				for (C4Object *const pObj : pSct->GetObjectShapeIndex())
+					if (pObj->Status)
+						if (pObj->Marker != iMarker)
 						{
-							result.push_back(pLnk->Obj);
+							pObj->Marker = iMarker;
+							if (Match(pObj))
+							{
+								result.push_back(pObj);
+							}
 						}
-					}
+		}
+		else
+		{
+			for (; pLst; pLst = Area.NextObjectShapes(pLst, &pSct))
+				for (C4ObjectLink *pLnk = pLst->First; pLnk; pLnk = pLnk->Next)
+					if (pLnk->Obj->Status)
+						if (pLnk->Obj->Marker != iMarker)
+						{
+							pLnk->Obj->Marker = iMarker;
+							if (Match(pLnk->Obj))
+							{
+								result.push_back(pLnk->Obj);
+							}
+						}
+		}
 	}
 	else
 	{
 		// Search
 		C4LArea Area(&Game.Objects.Sectors, *pBounds); C4LSector *pSct;
-		for (C4ObjectList *pLst = Area.FirstObjects(&pSct); pLst; pLst = Area.NextObjects(pLst, &pSct))
-			for (C4ObjectLink *pLnk = pLst->First; pLnk; pLnk = pLnk->Next)
-				if (pLnk->Obj->Status)
-					if (Check(pLnk->Obj))
-					{
-						result.push_back(pLnk->Obj);
-					}
+		if (!CallsScript())
+		{
+			for (pSct = Area.First(); pSct; pSct = Area.Next(pSct))
+				for (C4Object *const pObj : pSct->GetObjectIndex())
+					if (pObj->Status)
+						if (Match(pObj))
+						{
+							result.push_back(pObj);
+						}
+		}
+		else
+		{
+			for (C4ObjectList *pLst = Area.FirstObjects(&pSct); pLst; pLst = Area.NextObjects(pLst, &pSct))
+				for (C4ObjectLink *pLnk = pLst->First; pLnk; pLnk = pLnk->Next)
+					if (pLnk->Obj->Status)
+						if (Match(pLnk->Obj))
+						{
+							result.push_back(pLnk->Obj);
+						}
+		}
 	}
 	// Recheck object status (may shrink array again)
 	CheckObjectStatus(result);
@@ -432,6 +551,8 @@ C4FindObjectAnd::C4FindObjectAnd(int32_t inCnt, C4FindObject **ppConds, bool fFr
 			}
 		}
 	}
+	// Check cheap conditions first (after the bounds are taken, so the searched area stays the same)
+	std::stable_sort(ppConds, ppConds + iCnt, [](C4FindObject *pCond1, C4FindObject *pCond2) { return pCond1->GetCost() < pCond2->GetCost(); });
 }
 
 C4FindObjectAnd::~C4FindObjectAnd()
@@ -458,6 +579,22 @@ bool C4FindObjectAnd::IsImpossible()
 	return false;
 }
 
+bool C4FindObjectAnd::CallsScript()
+{
+	for (int32_t i = 0; i < iCnt; i++)
+		if (ppConds[i]->CallsScript())
+			return true;
+	return false;
+}
+
+int32_t C4FindObjectAnd::GetCost()
+{
+	int32_t iCost = 0;
+	for (int32_t i = 0; i < iCnt; i++)
+		iCost = std::max(iCost, ppConds[i]->GetCost());
+	return iCost;
+}
+
 // *** C4FindObjectOr
 
 C4FindObjectOr::C4FindObjectOr(int32_t inCnt, C4FindObject **ppConds)
@@ -494,6 +631,8 @@ C4FindObjectOr::C4FindObjectOr(int32_t inCnt, C4FindObject **ppConds)
 			fHasBounds = true;
 		}
 	}
+	// Check cheap conditions first; they are all tried until one matches anyway
+	std::stable_sort(ppConds, ppConds + iCnt, [](C4FindObject *pCond1, C4FindObject *pCond2) { return pCond1->GetCost() < pCond2->GetCost(); });
 }
 
 C4FindObjectOr::~C4FindObjectOr()
@@ -519,11 +658,27 @@ bool C4FindObjectOr::IsEnsured()
 	return false;
 }
 
+bool C4FindObjectOr::CallsScript()
+{
+	for (int32_t i = 0; i < iCnt; i++)
+		if (ppConds[i]->CallsScript())
+			return true;
+	return false;
+}
+
+int32_t C4FindObjectOr::GetCost()
+{
+	int32_t iCost = 0;
+	for (int32_t i = 0; i < iCnt; i++)
+		iCost = std::max(iCost, ppConds[i]->GetCost());
+	return iCost;
+}
+
 // *** C4FindObject* (primitive conditions)
 
 bool C4FindObjectExclude::Check(C4Object *pObj)
 {
-	return pObj != pExclude;
+	return pObj != vExclude._getObj();
 }
 
 bool C4FindObjectID::Check(C4Object *pObj)
@@ -598,16 +753,16 @@ bool C4FindObjectActionTarget::Check(C4Object *pObj)
 {
 	assert(index >= 0 && index <= 1);
 	if (index == 0)
-		return pObj->Action.Target == pActionTarget;
+		return pObj->Action.Target == vActionTarget._getObj();
 	else if (index == 1)
-		return pObj->Action.Target2 == pActionTarget;
+		return pObj->Action.Target2 == vActionTarget._getObj();
 	else
 		return false;
 }
 
 bool C4FindObjectContainer::Check(C4Object *pObj)
 {
-	return pObj->Contained == pContainer;
+	return pObj->Contained == vContainer._getObj();
 }
 
 bool C4FindObjectAnyContainer::Check(C4Object *pObj)
@@ -670,7 +825,7 @@ bool C4FindObjectFunc::IsImpossible()
 
 bool C4FindObjectLayer::Check(C4Object *pObj)
 {
-	return pObj->pLayer == pLayer;
+	return pObj->pLayer == vLayer._getObj();
 }
 
 bool C4FindObjectLayer::IsImpossible()
@@ -954,3 +1109,93 @@ int32_t C4SortObjectFunc::CompareGetValue(C4Object *pObj)
 	// Call
 	return pCallFunc->Exec(pObj, Pars, true).getInt();
 }
+
+// *** C4FindObjectPlanCache
+
+namespace
+{
+	// strict comparison of search parameters - the cached condition may only be used for exactly the same search
+	bool IdenticalSearchPar(const C4Value &Value1, const C4Value &Value2)
+	{
+		const C4Value &val1 = Value1.GetRefVal(), &val2 = Value2.GetRefVal();
+		if (val1.GetType() != val2.GetType()) return false;
+		switch (val1.GetType())
+		{
+		case C4V_Array:
+		{
+			// the cache holds a reference, so a shared array cannot have been changed in place
+			const C4ValueArray &arr1 = *val1._getArray(), &arr2 = *val2._getArray();
+			if (&arr1 == &arr2) return true;
+			if (arr1.GetSize() != arr2.GetSize()) return false;
+			for (int32_t i = 0; i < arr1.GetSize(); i++)
+				if (!IdenticalSearchPar(arr1[i], arr2[i]))
+					return false;
+			return true;
+		}
+
+		case C4V_Map:
+			return val1._getMap() == val2._getMap();
+
+		default:
+			return val1.Equals(val2, C4AulScriptStrict::STRICT3);
+		}
+	}
+}
+
+C4FindObjectPlanCache::Plan::Plan(C4AulContext *cthr, const C4Value *pPars, bool fAllowSort)
+	: pCaller(cthr->Caller), iGeneration(Game.FindObjectPlans.iGeneration)
+{
+	for (int32_t i = 0; i < C4AUL_MAX_Par; i++)
+		Pars[i] = pPars[i].GetRefVal();
+	// direct exec code is freed right after execution, so it does not get an entry
+	if (pCaller && (pCaller->TemporaryScript || !pCaller->CPos || !pCaller->Func)) pCaller = nullptr;
+	// cached condition for this call site?
+	if (pCaller)
+	{
+		const auto it = Game.FindObjectPlans.Entries.find(pCaller->CPos);
+		if (it != Game.FindObjectPlans.Entries.end() && it->second.pCond &&
+			std::ranges::equal(Pars, it->second.Pars, &IdenticalSearchPar))
+		{
+			// keep the parameters the condition was created from, as it may point into them
+			Pars.swap(it->second.Pars);
+			pCond = std::move(it->second.pCond);
+		}
+	}
+	if (!pCond)
+		pCond.reset(C4FindObject::CreateByPars(Pars.data(), fAllowSort));
+	if (pCond)
+		pCond->iCandidates = pCond->iMatches = 0;
+}
+
+C4FindObjectPlanCache::Plan::~Plan()
+{
+	// not cached, or script code changed meanwhile?
+	if (!pCaller || !pCond || iGeneration != Game.FindObjectPlans.iGeneration) return;
+	// put back (a recursive search of the same call site may have put back its own condition already)
+	Entry &entry = Game.FindObjectPlans.Entries[pCaller->CPos];
+	entry.pFunc = pCaller->Func;
+	entry.iCalls++;
+	entry.iCandidates += pCond->iCandidates;
+	entry.iMatches += pCond->iMatches;
+	entry.Pars = std::move(Pars);
+	entry.pCond = std::move(pCond);
+}
+
+void C4FindObjectPlanCache::Clear()
+{
+	Entries.clear();
+	iGeneration++;
+}
+
+void C4FindObjectPlanCache::ResetProfilerStats()
+{
+	for (auto &[pPos, entry] : Entries)
+		entry.iCalls = entry.iCandidates = entry.iMatches = 0;
+}
+
+void C4FindObjectPlanCache::CollectProfilerStats(C4AulProfiler &rProfiler)
+{
+	for (const auto &[pPos, entry] : Entries)
+		if (entry.iCalls)
+			rProfiler.CollectSearchEntry(entry.pFunc, SGetLine(entry.pFunc->pOrgScript->GetScript(), pPos->GetSPos(entry.pFunc->pOrgScript->GetScript())), entry.iCalls, entry.iCandidates, entry.iMatches);
+}
@@ -22,6 +22,11 @@
 #include "C4Value.h"
 #include "C4Aul.h"
 
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
 // Condition map
 enum C4FindObjectCondID
 {
@@ -76,6 +81,7 @@ public:
 	virtual ~C4FindObject();
 
 	static C4FindObject *CreateByValue(const C4Value &Data, C4SortObject **ppSortObj = nullptr); // createFindObject or SortObject - if ppSortObj==nullptr, SortObject is not allowed
+	static C4FindObject *CreateByPars(const C4Value *pPars, bool fAllowSort); // create combined condition from script function parameters
 
 	int32_t Count(const C4ObjectList &Objs); // Counts objects for which the condition is true
 	C4Object *Find(const C4ObjectList &Objs);   // Returns first object for which the condition is true
@@ -87,6 +93,9 @@ public:
 
 	void SetSort(C4SortObject *pToSort);
 
+	// search statistics for the script profiler
+	uint32_t iCandidates{0}, iMatches{0};
+
 protected:
 	// Overridables
 	virtual bool Check(C4Object *pObj) = 0;
@@ -94,8 +103,18 @@ protected:
 	virtual bool UseShapes() { return false; }
 	virtual bool IsImpossible() { return false; }
 	virtual bool IsEnsured() { return false; }
+	virtual bool CallsScript() { return false; } // whether Check() may execute script and thus change object lists
+	virtual int32_t GetCost() { return 0; } // relative cost of Check(); cheaper conditions are checked first
 
 private:
+	bool Match(C4Object *pObj) // Check() for searched objects, counting statistics
+	{
+		++iCandidates;
+		if (!Check(pObj)) return false;
+		++iMatches;
+		return true;
+	}
+
 	void CheckObjectStatus(std::vector<C4Object *> &objects);
 	void CheckObjectStatusAfterSort(std::vector<C4Object *> &objects);
 };
@@ -115,6 +134,8 @@ protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual bool IsImpossible() override { return pCond->IsEnsured(); }
 	virtual bool IsEnsured() override { return pCond->IsImpossible(); }
+	virtual bool CallsScript() override { return pCond->CallsScript(); }
+	virtual int32_t GetCost() override { return pCond->GetCost(); }
 };
 
 class C4FindObjectAnd : public C4FindObject
@@ -134,6 +155,8 @@ protected:
 	virtual bool UseShapes() override { return fUseShapes; }
 	virtual bool IsEnsured() override { return !iCnt; }
 	virtual bool IsImpossible() override;
+	virtual bool CallsScript() override;
+	virtual int32_t GetCost() override;
 };
 
 class C4FindObjectOr : public C4FindObject
@@ -152,6 +175,8 @@ protected:
 	virtual C4Rect *GetBounds() override { return fHasBounds ? &Bounds : nullptr; }
 	virtual bool IsEnsured() override;
 	virtual bool IsImpossible() override { return !iCnt; }
+	virtual bool CallsScript() override;
+	virtual int32_t GetCost() override;
 };
 
 // Primitive conditions
@@ -159,10 +184,10 @@ class C4FindObjectExclude : public C4FindObject
 {
 public:
 	C4FindObjectExclude(C4Object *pExclude)
-		: pExclude(pExclude) {}
+		: vExclude(pExclude) {}
 
 private:
-	C4Object *pExclude;
+	C4Value vExclude; // cleared if the object is removed, so cached plans stay valid
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
@@ -193,6 +218,7 @@ private:
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
+	virtual int32_t GetCost() override { return 1; }
 	virtual C4Rect *GetBounds() override { return &rect; }
 	virtual bool IsImpossible() override;
 };
@@ -208,6 +234,7 @@ private:
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
+	virtual int32_t GetCost() override { return 1; }
 	virtual C4Rect *GetBounds() override { return &bounds; }
 	virtual bool UseShapes() override { return true; }
 };
@@ -223,6 +250,7 @@ private:
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
+	virtual int32_t GetCost() override { return 1; }
 	virtual C4Rect *GetBounds() override { return &bounds; }
 	virtual bool UseShapes() override { return true; }
 };
@@ -242,6 +270,7 @@ private:
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
+	virtual int32_t GetCost() override { return 2; }
 	virtual C4Rect *GetBounds() override { return &bounds; }
 	virtual bool UseShapes() override { return true; }
 };
@@ -258,6 +287,7 @@ private:
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
+	virtual int32_t GetCost() override { return 1; }
 	virtual C4Rect *GetBounds() override { return &bounds; }
 };
 
@@ -300,16 +330,17 @@ private:
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
+	virtual int32_t GetCost() override { return 1; }
 };
 
 class C4FindObjectActionTarget : public C4FindObject
 {
 public:
 	C4FindObjectActionTarget(C4Object *pActionTarget, int index)
-		: pActionTarget(pActionTarget), index(index) {}
+		: vActionTarget(pActionTarget), index(index) {}
 
 private:
-	C4Object *pActionTarget;
+	C4Value vActionTarget;
 	int index;
 
 protected:
@@ -320,10 +351,10 @@ class C4FindObjectContainer : public C4FindObject
 {
 public:
 	C4FindObjectContainer(C4Object *pContainer)
-		: pContainer(pContainer) {}
+		: vContainer(pContainer) {}
 
 private:
-	C4Object *pContainer;
+	C4Value vContainer;
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
@@ -364,16 +395,18 @@ private:
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
+	virtual int32_t GetCost() override { return 3; }
 	virtual bool IsImpossible() override;
+	virtual bool CallsScript() override { return true; }
 };
 
 class C4FindObjectLayer : public C4FindObject
 {
 public:
-	C4FindObjectLayer(C4Object *pLayer) : pLayer(pLayer) {}
+	C4FindObjectLayer(C4Object *pLayer) : vLayer(pLayer) {}
 
 private:
-	C4Object *pLayer;
+	C4Value vLayer;
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
@@ -531,3 +564,46 @@ private:
 protected:
 	int32_t CompareGetValue(C4Object *pFor) override;
 };
+
+// Search conditions of script calls (FindObjects etc.), kept per call site
+// A cached condition is only reused if the script passes identical parameters again
+class C4FindObjectPlanCache
+{
+public:
+	// condition for one search; handed back to the cache when the search is done
+	class Plan
+	{
+	public:
+		Plan(C4AulContext *cthr, const C4Value *pPars, bool fAllowSort);
+		~Plan();
+		Plan(const Plan &) = delete;
+		Plan &operator=(const Plan &) = delete;
+
+		C4FindObject *operator->() const { return pCond.get(); }
+		explicit operator bool() const { return pCond != nullptr; }
+
+	private:
+		C4AulScriptContext *pCaller; // nullptr if the search is not cached
+		uint32_t iGeneration;
+		std::array<C4Value, C4AUL_MAX_Par> Pars;
+		std::unique_ptr<C4FindObject> pCond;
+	};
+
+private:
+	struct Entry
+	{
+		std::array<C4Value, C4AUL_MAX_Par> Pars; // parameters the condition was created from
+		std::unique_ptr<C4FindObject> pCond; // nullptr while in use
+		C4AulScriptFunc *pFunc{nullptr};
+		// statistics for the script profiler
+		uint32_t iCalls{0}, iCandidates{0}, iMatches{0};
+	};
+
+	std::unordered_map<const C4AulBCC *, Entry> Entries;
+	uint32_t iGeneration{0}; // changed on Clear(), so searches running meanwhile are not put back
+
+public:
+	void Clear(); // must be called whenever script code is freed or relinked
+	void ResetProfilerStats();
+	void CollectProfilerStats(C4AulProfiler &rProfiler);
+};
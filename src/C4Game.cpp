@@ -57,6 +57,7 @@
 #include <format>
 #include <iterator>
 #include <sstream>
+#include <unordered_map>
 #include <utility>
 
 constexpr unsigned int defaultIngameGameTickDelay = 28;
@@ -547,6 +548,9 @@ void C4Game::Clear()
 		PreloadThread.join();
 	}
 
+	// savegames must be written completely before quitting
+	SaveGameWriter.Wait();
+
 	FileMonitor.reset();
 
 	if (Application.MusicSystem)
@@ -601,6 +605,7 @@ void C4Game::Clear()
 	MessageInput.Clear();
 	Info.Clear();
 	Title.Clear();
+	FindObjectPlans.Clear();
 	Script.Clear();
 	Names.Clear();
 	GameText.Clear();
@@ -786,7 +791,7 @@ bool C4Game::Execute() // Returns true if the game is over
 	if (HaltCount) return false;
 
 #ifdef DEBUGREC
-	Landscape.DoRelights();
+	Landscape.DoRelights(true);
 #endif
 
 	// Execute the control
@@ -841,7 +846,7 @@ bool C4Game::Execute() // Returns true if the game is over
 #ifdef DEBUGREC
 	AddDbgRec(RCT_Block, "eGame", 6);
 
-	Landscape.DoRelights();
+	Landscape.DoRelights(true);
 #endif
 
 	return true;
@@ -1003,7 +1008,7 @@ void C4Game::ClearPointers(C4Object *pObj)
 	MouseControl.ClearPointers(pObj);
 	TransferZones.ClearPointers(pObj);
 	if (pGlobalEffects)
-		pGlobalEffects->ClearPointers(pObj);
+		pGlobalEffects->ClearPointers(nullptr, pObj);
 }
 
 bool C4Game::TogglePause()
@@ -1291,12 +1296,11 @@ void C4Game::ShakeObjects(int32_t tx, int32_t ty, int32_t range, int32_t iCaused
 
 C4Object *C4Game::OverlapObject(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t category)
 {
-	C4Object *cObj; C4ObjectLink *clnk;
 	C4Rect rect1, rect2;
 	rect1.x = tx; rect1.y = ty; rect1.Wdt = wdt; rect1.Hgt = hgt;
-	C4LArea Area(&Objects.Sectors, tx, ty, wdt, hgt); C4LSector *pSector;
-	for (C4ObjectList *pObjs = Area.FirstObjectShapes(&pSector); pSector; pObjs = Area.NextObjectShapes(pObjs, &pSector))
-		for (clnk = pObjs->First; clnk && (cObj = clnk->Obj); clnk = clnk->Next)
+	C4LArea Area(&Objects.Sectors, tx, ty, wdt, hgt);
+	for (C4LSector *pSector = Area.First(); pSector; pSector = Area.Next(pSector))
+		for (C4Object *const cObj : pSector->GetObjectShapeIndex())
 			if (cObj->Status) if (!cObj->Contained)
 				if (cObj->Category & category & C4D_SortLimit)
 				{
@@ -1306,6 +1310,93 @@ C4Object *C4Game::OverlapObject(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt
 	return nullptr;
 }
 
+namespace
+{
+	// the conditions of the legacy search functions besides the search area
+	class C4LegacyObjectCondition
+	{
+		C4ID id;
+		uint32_t ocf;
+		const char *szAction; // nullptr for any action
+		bool fFindActIdle;
+		C4Object *pActionTarget, *pExclude, *pContainer;
+		int32_t iOwner;
+
+		// actions are matched by index in the ActMap of the definition instead of by name
+		C4Def *pActionDef{nullptr};
+		int32_t iActionIndex{ActIdle}; // index of the named action in the ActMap of pActionDef
+		bool fActionAmbiguous{false}; // multiple actions share the name, so it has to be compared
+
+		bool MatchAction(C4Object *cObj)
+		{
+			if (!szAction) return true;
+			if (cObj->Action.Act <= ActIdle) return fFindActIdle;
+			// objects of the same definition are usually listed together, so resolving the last definition again is rare
+			if (cObj->Def != pActionDef)
+			{
+				pActionDef = cObj->Def; iActionIndex = ActIdle; fActionAmbiguous = false;
+				for (int32_t iAct = 0; iAct < pActionDef->ActNum; ++iAct)
+					if (SEqual(szAction, pActionDef->ActMap[iAct].Name))
+					{
+						if (iActionIndex != ActIdle) { fActionAmbiguous = true; break; }
+						iActionIndex = iAct;
+					}
+			}
+			if (fActionAmbiguous) return SEqual(szAction, cObj->Def->ActMap[cObj->Action.Act].Name);
+			return cObj->Action.Act == iActionIndex;
+		}
+
+	public:
+		C4LegacyObjectCondition(C4ID id, uint32_t ocf, const char *szAction, C4Object *pActionTarget, C4Object *pExclude, C4Object *pContainer, int32_t iOwner)
+			: id{id}, ocf{ocf}, szAction{szAction && szAction[0] ? szAction : nullptr}, fFindActIdle{SEqual(szAction, "Idle") || SEqual(szAction, "ActIdle")},
+			pActionTarget{pActionTarget}, pExclude{pExclude}, pContainer{pContainer}, iOwner{iOwner} {}
+
+		bool Match(C4Object *cObj)
+		{
+			return cObj->Status
+				// ID
+				&& ((id == C4ID_None) || (cObj->Def->id == id))
+				// OCF (match any specified)
+				&& (cObj->OCF & ocf)
+				// Exclude
+				&& (cObj != pExclude)
+				// Action
+				&& MatchAction(cObj)
+				// ActionTarget
+				&& (!pActionTarget || ((cObj->Action.Act > ActIdle) && ((cObj->Action.Target == pActionTarget) || (cObj->Action.Target2 == pActionTarget))))
+				// Container
+				&& (!pContainer || (cObj->Contained == pContainer) || ((reinterpret_cast<std::intptr_t>(pContainer) == NO_CONTAINER) && !cObj->Contained) || ((reinterpret_cast<std::intptr_t>(pContainer) == ANY_CONTAINER) && cObj->Contained))
+				// Owner
+				&& ((iOwner == ANY_OWNER) || (cObj->Owner == iOwner));
+		}
+	};
+
+	// the search area of the legacy search functions
+	struct C4LegacyObjectArea
+	{
+		int32_t iX, iY, iWdt, iHgt;
+
+		bool IsFull() const { return !iX && !iY && !iWdt && !iHgt; }
+		bool IsPoint() const { return !IsFull() && !iWdt && !iHgt; }
+		bool IsClosest() const { return (iWdt == -1) && (iHgt == -1); }
+		// point and range searches can be done via the sectors
+		bool UseSectors() const { return IsPoint() || ((iWdt > 0) && (iHgt > 0)); }
+
+		bool Contains(C4Object *cObj) const
+		{
+			// Full range
+			if (IsFull())
+				return true;
+			// Point
+			if (IsPoint())
+				return Inside<int32_t>(iX - (cObj->x + cObj->Shape.x), 0, cObj->Shape.Wdt - 1)
+					&& Inside<int32_t>(iY - (cObj->y + cObj->Shape.y), 0, cObj->Shape.Hgt - 1);
+			// Range
+			return Inside<int32_t>(cObj->x - iX, 0, iWdt - 1) && Inside<int32_t>(cObj->y - iY, 0, iHgt - 1);
+		}
+	};
+}
+
 C4Object *C4Game::FindObject(C4ID id,
 	int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt,
 	uint32_t ocf,
@@ -1315,12 +1406,7 @@ C4Object *C4Game::FindObject(C4ID id,
 	int32_t iOwner,
 	C4Object *pFindNext)
 {
-	C4Object *pClosest = nullptr;
-	int32_t iClosest = 0, iDistance, iFartherThan = -1;
-	C4Object *cObj;
-	C4ObjectLink *cLnk;
-	C4Def *pDef;
-	C4Object *pFindNextCpy = pFindNext;
+	C4Def *pDef = nullptr;
 
 	// check the easy cases first
 	if (id != C4ID_None)
@@ -1329,73 +1415,90 @@ C4Object *C4Game::FindObject(C4ID id,
 		if (!pDef->Count) return nullptr; // no instances at all
 	}
 
-	// Finding next closest: find closest but further away than last closest
-	if (pFindNext && (iWdt == -1) && (iHgt == -1))
+	C4LegacyObjectCondition Condition(id, ocf, szAction, pActionTarget, pExclude, pContainer, iOwner);
+	const C4LegacyObjectArea Area{iX, iY, iWdt, iHgt};
+
+	// candidates may be visited in any order; the result is determined by the list order as if the whole list was scanned
+	Objects.UpdateOrder();
+
+	// Finding next: skip all objects up to pFindNext in the list
+	// Finding next closest: find closest but further away than last closest, or the next one at the same distance
+	C4ObjectLink *pFindNextLnk = nullptr;
+	int32_t iFartherThan = -1;
+	if (pFindNext)
 	{
-		iFartherThan = (pFindNext->x - iX) * (pFindNext->x - iX) + (pFindNext->y - iY) * (pFindNext->y - iY);
-		pFindNext = nullptr;
+		pFindNextLnk = Objects.GetIndexedLink(pFindNext);
+		if (Area.IsClosest())
+			iFartherThan = (pFindNext->x - iX) * (pFindNext->x - iX) + (pFindNext->y - iY) * (pFindNext->y - iY);
+		// all objects are skipped if pFindNext isn't listed at all
+		else if (!pFindNextLnk)
+			return nullptr;
 	}
+	const auto isAfterFindNext = [pFindNextLnk](C4ObjectLink *cLnk) { return pFindNextLnk && cLnk->Order > pFindNextLnk->Order; };
 
-	bool bFindActIdle = SEqual(szAction, "Idle") || SEqual(szAction, "ActIdle");
+	C4ObjectLink *pFound = nullptr; // first match, or closest object with the first one winning ties
+	C4ObjectLink *pSameDistance = nullptr; // first object after pFindNext at the distance of pFindNext
+	int32_t iClosest = 0;
 
-	// Scan all objects
-	for (cLnk = Objects.First; cLnk && (cObj = cLnk->Obj); cLnk = cLnk->Next)
+	const auto check = [&](C4ObjectLink *cLnk)
 	{
+		C4Object *const cObj = cLnk->Obj;
+		if (!Condition.Match(cObj)) return;
+		// Closest
+		if (Area.IsClosest())
+		{
+			const int32_t iDistance = (cObj->x - iX) * (cObj->x - iX) + (cObj->y - iY) * (cObj->y - iY);
+			// same distance?
+			if ((iDistance == iFartherThan) && isAfterFindNext(cLnk))
+			{
+				if (!pSameDistance || (cLnk->Order < pSameDistance->Order))
+					pSameDistance = cLnk;
+			}
+			// nearer than/first closest?
+			else if (iDistance > iFartherThan)
+				if (!pFound || (iDistance < iClosest) || ((iDistance == iClosest) && (cLnk->Order < pFound->Order)))
+				{
+					pFound = cLnk; iClosest = iDistance;
+				}
+			return;
+		}
 		// Not skipping to find next
-		if (!pFindNext)
-			// Status
-			if (cObj->Status)
-				// ID
-				if ((id == C4ID_None) || (cObj->Def->id == id))
-					// OCF (match any specified)
-					if (cObj->OCF & ocf)
-						// Exclude
-						if (cObj != pExclude)
-							// Action
-							if (!szAction || !szAction[0] || (bFindActIdle && cObj->Action.Act <= ActIdle) || ((cObj->Action.Act > ActIdle) && SEqual(szAction, cObj->Def->ActMap[cObj->Action.Act].Name)))
-								// ActionTarget
-								if (!pActionTarget || ((cObj->Action.Act > ActIdle) && ((cObj->Action.Target == pActionTarget) || (cObj->Action.Target2 == pActionTarget))))
-									// Container
-									if (!pContainer || (cObj->Contained == pContainer) || ((reinterpret_cast<std::intptr_t>(pContainer) == NO_CONTAINER) && !cObj->Contained) || ((reinterpret_cast<std::intptr_t>(pContainer) == ANY_CONTAINER) && cObj->Contained))
-										// Owner
-										if ((iOwner == ANY_OWNER) || (cObj->Owner == iOwner))
-											// Area
-										{
-											// Full range
-											if ((iX == 0) && (iY == 0) && (iWdt == 0) && (iHgt == 0))
-												return cObj;
-											// Point
-											if ((iWdt == 0) && (iHgt == 0))
-											{
-												if (Inside<int32_t>(iX - (cObj->x + cObj->Shape.x), 0, cObj->Shape.Wdt - 1))
-													if (Inside<int32_t>(iY - (cObj->y + cObj->Shape.y), 0, cObj->Shape.Hgt - 1))
-														return cObj;
-												continue;
-											}
-											// Closest
-											if ((iWdt == -1) && (iHgt == -1))
-											{
-												iDistance = (cObj->x - iX) * (cObj->x - iX) + (cObj->y - iY) * (cObj->y - iY);
-												// same distance?
-												if ((iDistance == iFartherThan) && !pFindNextCpy)
-													return cObj;
-												// nearer than/first closest?
-												if (!pClosest || (iDistance < iClosest))
-													if (iDistance > iFartherThan)
-													{
-														pClosest = cObj; iClosest = iDistance;
-													}
-											}
-											// Range
-											else if (Inside<int32_t>(cObj->x - iX, 0, iWdt - 1) && Inside<int32_t>(cObj->y - iY, 0, iHgt - 1))
-												return cObj;
-										}
+		if (pFindNext && !isAfterFindNext(cLnk)) return;
+		// Area
+		if (!Area.Contains(cObj)) return;
+		if (!pFound || (cLnk->Order < pFound->Order))
+			pFound = cLnk;
+	};
 
-		// Find next mark reached
-		if (cObj == pFindNextCpy) pFindNext = pFindNextCpy = nullptr;
+	const std::vector<C4ObjectLink *> *pInstances = pDef ? Objects.GetDefInstances(pDef) : nullptr;
+	if (pInstances)
+	{
+		// instances of the definition
+		for (C4ObjectLink *const cLnk : *pInstances)
+			check(cLnk);
+	}
+	else if (Area.UseSectors())
+	{
+		// objects positioned in the area or, for points, with shapes overlapping it
+		C4LArea SectorArea(&Objects.Sectors, Area.iX, Area.iY, Area.IsPoint() ? 1 : Area.iWdt, Area.IsPoint() ? 1 : Area.iHgt);
+		for (C4LSector *pSct = SectorArea.First(); pSct; pSct = SectorArea.Next(pSct))
+			for (C4Object *const cObj : Area.IsPoint() ? pSct->GetObjectShapeIndex() : pSct->GetObjectIndex())
+				if (C4ObjectLink *const cLnk = Objects.GetIndexedLink(cObj))
+					check(cLnk);
+	}
+	else
+	{
+		// Scan all objects
+		for (C4ObjectLink *cLnk = Objects.First; cLnk; cLnk = cLnk->Next)
+		{
+			check(cLnk);
+			// the list is scanned in order, so the first match is the result
+			if (pSameDistance || (pFound && !Area.IsClosest())) break;
+		}
 	}
 
-	return pClosest;
+	if (pSameDistance) return pSameDistance->Obj;
+	return pFound ? pFound->Obj : nullptr;
 }
 
 C4Object *C4Game::FindVisObject(int32_t tx, int32_t ty, int32_t iPlr, const C4Facet &fctViewport,
@@ -1481,7 +1584,7 @@ int32_t C4Game::ObjectCount(C4ID id,
 	C4Object *pContainer,
 	int32_t iOwner)
 {
-	int32_t iResult = 0; C4Def *pDef;
+	int32_t iResult = 0; C4Def *pDef = nullptr;
 	// check the easy cases first
 	if (id != C4ID_None)
 	{
@@ -1491,48 +1594,39 @@ int32_t C4Game::ObjectCount(C4ID id,
 			// plain id-search: return known count
 			return pDef->Count;
 	}
-	C4Object *cObj; C4ObjectLink *clnk;
-	bool bFindActIdle = SEqual(szAction, "Idle") || SEqual(szAction, "ActIdle");
-	for (clnk = Objects.First; clnk && (cObj = clnk->Obj); clnk = clnk->Next)
-		// Status
-		if (cObj->Status)
-			// ID
-			if ((id == C4ID_None) || (cObj->Def->id == id))
-				// OCF
-				if (cObj->OCF & ocf)
-					// Exclude
-					if (cObj != pExclude)
-						// Action
-						if (!szAction || !szAction[0] || (bFindActIdle && cObj->Action.Act <= ActIdle) || ((cObj->Action.Act > ActIdle) && SEqual(szAction, cObj->Def->ActMap[cObj->Action.Act].Name)))
-							// ActionTarget
-							if (!pActionTarget || ((cObj->Action.Act > ActIdle) && ((cObj->Action.Target == pActionTarget) || (cObj->Action.Target2 == pActionTarget))))
-								// Container
-								if (!pContainer || (cObj->Contained == pContainer) || ((reinterpret_cast<std::intptr_t>(pContainer) == NO_CONTAINER) && !cObj->Contained) || ((reinterpret_cast<std::intptr_t>(pContainer) == ANY_CONTAINER) && cObj->Contained))
-									// Owner
-									if ((iOwner == ANY_OWNER) || (cObj->Owner == iOwner))
-										// Area
-									{
-										// Full range
-										if ((x == 0) && (y == 0) && (wdt == 0) && (hgt == 0))
-										{
-											iResult++; continue;
-										}
-										// Point
-										if ((wdt == 0) && (hgt == 0))
-										{
-											if (Inside<int32_t>(x - (cObj->x + cObj->Shape.x), 0, cObj->Shape.Wdt - 1))
-												if (Inside<int32_t>(y - (cObj->y + cObj->Shape.y), 0, cObj->Shape.Hgt - 1))
-												{
-													iResult++; continue;
-												}
-											continue;
-										}
-										// Range
-										if (Inside<int32_t>(cObj->x - x, 0, wdt - 1) && Inside<int32_t>(cObj->y - y, 0, hgt - 1))
-										{
-											iResult++; continue;
-										}
-									}
+
+	C4LegacyObjectCondition Condition(id, ocf, szAction, pActionTarget, pExclude, pContainer, iOwner);
+	const C4LegacyObjectArea Area{x, y, wdt, hgt};
+
+	const std::vector<C4ObjectLink *> *pInstances = pDef ? Objects.GetDefInstances(pDef) : nullptr;
+	if (pInstances)
+	{
+		// instances of the definition
+		for (C4ObjectLink *const cLnk : *pInstances)
+			if (Condition.Match(cLnk->Obj) && Area.Contains(cLnk->Obj))
+				iResult++;
+	}
+	else if (Area.UseSectors())
+	{
+		// objects positioned in the area or, for points, with shapes overlapping it
+		// shapes may be listed in several sectors, so count each object once
+		C4LArea SectorArea(&Objects.Sectors, x, y, Area.IsPoint() ? 1 : wdt, Area.IsPoint() ? 1 : hgt);
+		const uint32_t iMarker = Objects.GetNextMarker();
+		for (C4LSector *pSct = SectorArea.First(); pSct; pSct = SectorArea.Next(pSct))
+			for (C4Object *const cObj : Area.IsPoint() ? pSct->GetObjectShapeIndex() : pSct->GetObjectIndex())
+				if (cObj->Marker != iMarker)
+				{
+					cObj->Marker = iMarker;
+					if (Condition.Match(cObj) && Area.Contains(cObj))
+						iResult++;
+				}
+	}
+	else
+	{
+		for (C4ObjectLink *cLnk = Objects.First; cLnk; cLnk = cLnk->Next)
+			if (Condition.Match(cLnk->Obj) && Area.Contains(cLnk->Obj))
+				iResult++;
+	}
 
 	return iResult;
 }
@@ -1797,6 +1891,7 @@ void C4Game::Default()
 	pScenarioSections = pCurrentScenarioSection = nullptr;
 	*CurrentScenarioSection = 0;
 	pGlobalEffects = nullptr;
+	GlobalEffectSchedule = {};
 	fResortAnyObject = false;
 	pNetworkStatistics = nullptr;
 	IsMusicEnabled = false;
@@ -1950,6 +2045,10 @@ void C4Game::CompileFunc(StdCompiler *pComp, CompileSettings comp)
 		pComp->Value(mkNamingAdapt(Landscape.Sky, "Sky"));
 	}
 
+	if (pComp->isCompiler())
+		GlobalEffectSchedule = {};
+	else
+		C4Effect::UpdateTimes(nullptr);
 	pComp->Value(mkNamingAdapt(mkNamingPtrAdapt(pGlobalEffects, "GlobalEffects"), "Effects"));
 
 	// scoreboard compiles into main level [Scoreboard]
@@ -2099,12 +2198,15 @@ bool C4Game::SaveGameTitle(C4Group &hGroup)
 			0.0f, 0.0f, float(Application.DDraw->lpBack->Wdt), float(Application.DDraw->lpBack->Hgt),
 			surface.get(), 0, 0, surfaceWidth, surfaceHeight);
 
-		if (!surface->SavePNG(Config.AtTempPath(C4CFN_TempTitle), false, !Config.Graphics.Shader, false))
+		char szTempTitle[_MAX_PATH + 1];
+		SCopy(Config.AtTempPath(C4CFN_TempTitle), szTempTitle);
+		MakeTempFilename(szTempTitle);
+		if (!surface->SavePNG(szTempTitle, false, !Config.Graphics.Shader, false))
 		{
 			return false;
 		}
 
-		if (!hGroup.Move(Config.AtTempPath(C4CFN_TempTitle), C4CFN_ScenarioTitlePNG))
+		if (!hGroup.Move(szTempTitle, C4CFN_ScenarioTitlePNG))
 		{
 			return false;
 		}
@@ -2246,17 +2348,32 @@ bool C4Game::QuickSave(const char *strFilename, const char *strTitle, bool fForc
 	Log(C4ResStrTableKey::IDS_HOLD_SAVINGGAME);
 	GraphicsSystem.MessageBoard.EnsureLastMessage();
 
+	// A previous savegame might still be written to the same file
+	SaveGameWriter.Wait();
+
 	// Save to target scenario file
+	const auto start = C4GameSaveWriter::Clock::now();
 	C4GameSave *pGameSave;
 	pGameSave = new C4GameSaveSavegame();
 	if (!pGameSave->Save(savePath.c_str()))
 	{
 		Log(C4ResStrTableKey::IDS_GAME_FAILSAVEGAME); delete pGameSave; return false;
 	}
+	std::unique_ptr<C4Group> pSaveGroup{pGameSave->TakeGroup()};
 	delete pGameSave;
+	const auto snapshotTime = C4GameSaveWriter::Clock::now() - start;
 
-	// Success
-	Log(C4ResStrTableKey::IDS_CNS_GAMESAVED);
+	// Compress and write in the background, so the game does not stall
+	SaveGameWriter.Start(std::move(pSaveGroup), nullptr, [snapshotTime](const bool fSuccess, const C4GameSaveWriter::Clock::duration writeTime)
+	{
+		spdlog::debug("Savegame: snapshot {} ms, writing {} ms", C4GameSaveWriter::ToMilliseconds(snapshotTime), C4GameSaveWriter::ToMilliseconds(writeTime));
+		if (!fSuccess)
+		{
+			Log(C4ResStrTableKey::IDS_GAME_FAILSAVEGAME); return;
+		}
+		// Success
+		Log(C4ResStrTableKey::IDS_CNS_GAMESAVED);
+	});
 	return true;
 }
 
@@ -2317,6 +2434,8 @@ bool C4Game::ReloadDef(C4ID id, uint32_t reloadWhat)
 				clnk->Obj->AssignRemoval();
 		// safety: If a removed def is being profiled, profiling must stop
 		C4AulProfiler::Abort();
+		FindObjectPlans.Clear();
+		ScriptEngine.ClearCallCaches();
 		// Kill def
 		Defs.Remove(pDef);
 		// Log
@@ -3890,10 +4009,28 @@ bool C4Game::InitNetworkHost()
 
 bool C4Game::CheckObjectEnumeration()
 {
+	// Collect the first two objects of each number, active objects first
+	struct NumberUse
+	{
+		C4Object *pObj[2]{};
+		bool fInactive[2]{};
+	};
+	std::unordered_map<int32_t, NumberUse> NumberUses;
+	for (C4ObjectList *pList : {static_cast<C4ObjectList *>(&Objects), &Objects.InactiveObjects})
+		for (C4ObjectLink *clnk = pList->First; clnk && clnk->Obj; clnk = clnk->Next)
+		{
+			NumberUse &use = NumberUses[clnk->Obj->Number];
+			for (int i = 0; i < 2; ++i)
+				if (!use.pObj[i])
+				{
+					use.pObj[i] = clnk->Obj;
+					use.fInactive[i] = (pList != &Objects);
+					break;
+				}
+		}
 	// Check valid & maximum number & duplicate numbers
 	int32_t iMax = 0;
 	C4Object *cObj; C4ObjectLink *clnk;
-	C4Object *cObj2; C4ObjectLink *clnk2;
 	clnk = Objects.First; if (!clnk) clnk = Objects.InactiveObjects.First;
 	while (clnk)
 	{
@@ -3907,20 +4044,16 @@ bool C4Game::CheckObjectEnumeration()
 		// Max
 		if (cObj->Number > iMax) iMax = cObj->Number;
 		// Duplicate
-		for (clnk2 = Objects.First; clnk2 && (cObj2 = clnk2->Obj); clnk2 = clnk2->Next)
-			if (cObj2 != cObj)
-				if (cObj->Number == cObj2->Number)
-				{
-					LogNTr(spdlog::level::err, "Duplicate object enumeration number {} ({} and {})", cObj2->Number, cObj->GetName(), cObj2->GetName());
-					return false;
-				}
-		for (clnk2 = Objects.InactiveObjects.First; clnk2 && (cObj2 = clnk2->Obj); clnk2 = clnk2->Next)
-			if (cObj2 != cObj)
-				if (cObj->Number == cObj2->Number)
-				{
-					LogNTr(spdlog::level::err, "Duplicate object enumeration number {} ({} and {}(i))", cObj2->Number, cObj->GetName(), cObj2->GetName());
-					return false;
-				}
+		const NumberUse &use = NumberUses[cObj->Number];
+		const int iOther = (use.pObj[0] == cObj ? 1 : 0);
+		if (C4Object *cObj2 = use.pObj[iOther])
+		{
+			if (use.fInactive[iOther])
+				LogNTr(spdlog::level::err, "Duplicate object enumeration number {} ({} and {}(i))", cObj2->Number, cObj->GetName(), cObj2->GetName());
+			else
+				LogNTr(spdlog::level::err, "Duplicate object enumeration number {} ({} and {})", cObj2->Number, cObj->GetName(), cObj2->GetName());
+			return false;
+		}
 		// next
 		if (!clnk->Next)
 			if (clnk == Objects.Last) clnk = Objects.InactiveObjects.First; else clnk = nullptr;
@@ -4084,6 +4217,9 @@ bool C4Game::LoadScenarioSection(const char *szSection, uint32_t dwFlags)
 	// save current section state
 	if (pLoadSect != pCurrentScenarioSection && dwFlags & (C4S_SAVE_LANDSCAPE | C4S_SAVE_OBJECTS))
 	{
+		// savegames and dynamics still being written may read the section files
+		SaveGameWriter.Wait();
+		Network.WaitForDynamic();
 		// ensure that the section file does point to temp store
 		if (!pCurrentScenarioSection->EnsureTempStore(!(dwFlags & C4S_SAVE_LANDSCAPE), !(dwFlags & C4S_SAVE_OBJECTS)))
 		{
@@ -44,7 +44,9 @@
 #include <C4GroupSet.h>
 #include <C4Extra.h>
 #include <C4GameControl.h>
+#include <C4GameSave.h>
 #include <C4Effects.h>
+#include <C4FindObject.h>
 #include <C4Fonts.h>
 #include "C4LangStringTable.h"
 #include "C4Scoreboard.h"
@@ -109,6 +111,7 @@ public:
 	C4ComponentHost Title;
 	C4ComponentHost Names;
 	C4ComponentHost GameText;
+	C4FindObjectPlanCache FindObjectPlans;
 	C4AulScriptEngine ScriptEngine;
 	C4GameScriptHost Script;
 	C4LangStringTable MainSysLangStringTable, ScenarioLangStringTable, ScenarioSysLangStringTable;
@@ -129,6 +132,7 @@ public:
 	C4GUI::Screen *pGUI;
 	C4ScenarioSection *pScenarioSections, *pCurrentScenarioSection;
 	C4Effect *pGlobalEffects;
+	C4EffectListSchedule GlobalEffectSchedule;
 #ifndef USE_CONSOLE
 	// We don't need fonts when we don't have graphics
 	C4FontLoader FontLoader;
@@ -361,6 +365,7 @@ protected:
 	CStdCSecEx PreloadMutex;
 	bool LandscapeLoaded;
 	std::unique_ptr<C4FileMonitor> FileMonitor;
+	C4GameSaveWriter SaveGameWriter; // writes quick saves in the background
 };
 
 const int32_t C4RULE_StructuresNeedEnergy      = 1,
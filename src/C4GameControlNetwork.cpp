@@ -555,6 +555,12 @@ void C4GameControlNetwork::HandleControlReq(const C4PacketControlReq &rPkt, C4Ne
 	}
 }
 
+void C4GameControlNetwork::SendCtrlSince(int32_t iTick, C4Network2IOConnection *pConn) // by main thread
+{
+	// same as if the client had asked for it
+	HandleControlReq(C4PacketControlReq(iTick), pConn);
+}
+
 void C4GameControlNetwork::HandleControlPkt(C4PacketType eCtrlType, C4ControlPacket *pCtrl, C4ControlDeliveryType eType) // main thread
 {
 	// direct control? execute at once
@@ -717,9 +723,12 @@ void C4GameControlNetwork::CheckCompleteCtrl(bool fSetEvent) // by both
 		if (fSetEvent && Game.GameGo && iControlReady >= Game.Control.ControlTick)
 			Application.NextTick(true);
 	}
-	// clear old ctrl
-	if (Game.Control.ControlTick >= C4ControlBacklog)
-		ClearCtrl(Game.Control.ControlTick - C4ControlBacklog);
+	// clear old ctrl; keep everything since a dynamic that is still being written, the clients waiting for it will need it
+	int32_t iClearTick = Game.Control.ControlTick - C4ControlBacklog;
+	if (fHost && pNetwork && pNetwork->getPendingDynamicTick() >= 0)
+		iClearTick = (std::min)(iClearTick, pNetwork->getPendingDynamicTick());
+	if (iClearTick >= 0)
+		ClearCtrl(iClearTick);
 	// target ctrl tick to reach?
 	if (iControlReady < iTargetTick &&
 		(!fActivated || iControlSent > iControlReady) &&
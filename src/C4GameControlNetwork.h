@@ -149,6 +149,9 @@ public:
 	// performance
 	void CalcPerformance(int32_t iCtrlTick); // by main thread
 
+	// joining clients
+	void SendCtrlSince(int32_t iTick, C4Network2IOConnection *pConn); // by main thread
+
 	// interfaces
 	void HandlePacket(char cStatus, const C4PacketBase *pPacket, C4Network2IOConnection *pConn);
 	void OnResComplete(C4Network2Res *pRes);
@@ -31,6 +31,11 @@
 C4GameObjects::C4GameObjects()
 {
 	Default();
+	// object pointers are looked up by number in both lists
+	EnableNumberIndex();
+	InactiveObjects.EnableNumberIndex();
+	// the legacy search functions look up active objects by definition and category
+	EnableInstanceIndex();
 }
 
 C4GameObjects::~C4GameObjects()
@@ -501,8 +506,7 @@ void C4ObjResort::Sort(C4ObjectLink *pFirst, C4ObjectLink *pLast)
 			if (OrderFunc->Exec(nullptr, Pars).getInt() < 0)
 			{
 				// so there's something to be reordered: swap the links
-				// FIXME: Inform C4ObjectList about this reorder
-				C4Object *pObj = pCurr->Obj; pCurr->Obj = pCurr2->Obj; pCurr2->Obj = pObj;
+				Game.Objects.SwapLinkObjects(pCurr, pCurr2);
 				// and readd to sector lists
 				pCurr->Obj->Unsorted = pCurr2->Obj->Unsorted = true;
 				// grow list section to scan next
@@ -532,20 +536,57 @@ void C4ObjResort::Sort(C4ObjectLink *pFirst, C4ObjectLink *pLast)
 #endif
 }
 
-int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
+namespace
 {
-	// Load data component
-	StdStrBuf Source;
-	if (!hGroup.LoadEntryString(C4CFN_ScenarioObjects, Source))
-		return 0;
+	// Active and inactive objects in a single name tree, so they are read back together like the concatenated INI data
+	struct C4ObjectListsAdapt
+	{
+		C4ObjectList &Objects;
+		C4ObjectList *pInactiveObjects;
+		bool fSkipPlayerObjects;
 
-	// Compile
-	StdStrBuf Name = hGroup.GetFullName() + DirSep C4CFN_ScenarioObjects;
-	if (!CompileFromBuf_LogWarn<StdCompilerINIRead>(
-		mkParAdapt(*this, false),
-		Source,
-		Name.getData()))
-		return 0;
+		void CompileFunc(StdCompiler *pComp) const
+		{
+			pComp->Value(mkParAdapt(Objects, false, fSkipPlayerObjects));
+			if (pInactiveObjects)
+				pComp->Value(mkParAdapt(*pInactiveObjects, false, fSkipPlayerObjects));
+		}
+	};
+}
+
+int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
+{
+	// Binary runtime data present? Preferred, because it is only written by the engine itself
+	if (hGroup.FindEntry(C4CFN_ScenarioObjectsBin))
+	{
+		// Load data component
+		StdBuf Source;
+		if (!hGroup.LoadEntry(C4CFN_ScenarioObjectsBin, Source))
+			return 0;
+
+		// Compile
+		StdStrBuf Name = hGroup.GetFullName() + DirSep C4CFN_ScenarioObjectsBin;
+		if (!CompileFromBuf_LogWarn<StdCompilerNamedBinRead>(
+			mkParAdapt(*this, false),
+			Source,
+			Name.getData()))
+			return 0;
+	}
+	else
+	{
+		// Load data component
+		StdStrBuf Source;
+		if (!hGroup.LoadEntryString(C4CFN_ScenarioObjects, Source))
+			return 0;
+
+		// Compile
+		StdStrBuf Name = hGroup.GetFullName() + DirSep C4CFN_ScenarioObjects;
+		if (!CompileFromBuf_LogWarn<StdCompilerINIRead>(
+			mkParAdapt(*this, false),
+			Source,
+			Name.getData()))
+			return 0;
+	}
 
 	// Process objects
 	C4ObjectLink *cLnk;
@@ -556,11 +597,8 @@ int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
 	{
 		C4Object *pObj = cLnk->Obj;
 		// check object number collision with inactive list
-		if (fKeepInactive)
-		{
-			for (C4ObjectLink *clnk = InactiveObjects.First; clnk; clnk = clnk->Next)
-				if (clnk->Obj->Number == pObj->Number) fObjectNumberCollision = true;
-		}
+		if (fKeepInactive && InactiveObjects.ObjectPointer(pObj->Number))
+			fObjectNumberCollision = true;
 		// keep track of numbers
 		iMaxObjectNumber = std::max<long>(iMaxObjectNumber, pObj->Number);
 		// add to list of backobjects
@@ -589,6 +627,7 @@ int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
 		for (cLnk = InactiveObjects.First; cLnk; cLnk = cLnk->Next)
 			if ((pObj = cLnk->Obj)->Status)
 				pObj->Number = ++Game.ObjectEnumerationIndex;
+		InactiveObjects.UpdateNumberIndex();
 	}
 
 	// special checks:
@@ -648,6 +687,9 @@ int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
 			Mass -= pObj->Mass;
 		}
 	}
+	UpdateNumberIndex();
+	UpdateInstanceIndex();
+	InactiveObjects.UpdateNumberIndex();
 
 	{
 		C4DebugRecOff DBGRECOFF; // - script callbacks that would kill DebugRec-sync for runtime start
@@ -676,19 +718,25 @@ int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
 	return ObjectCount();
 }
 
-bool C4GameObjects::Save(C4Group &hGroup, bool fSaveGame, bool fSaveInactive)
+bool C4GameObjects::Save(C4Group &hGroup, bool fSaveGame, bool fSaveInactive, bool fBinary)
 {
 	// Save to temp file
-	char szFilename[_MAX_PATH + 1]; SCopy(Config.AtTempPath(C4CFN_ScenarioObjects), szFilename);
-	if (!Save(szFilename, fSaveGame, fSaveInactive)) return false;
+	// the group may be written in the background, so the temp file must not be reused by the next save
+	const char *const szEntryName = fBinary ? C4CFN_ScenarioObjectsBin : C4CFN_ScenarioObjects;
+	char szFilename[_MAX_PATH + 1]; SCopy(Config.AtTempPath(szEntryName), szFilename);
+	MakeTempFilename(szFilename);
+	if (!Save(szFilename, fSaveGame, fSaveInactive, fBinary)) return false;
+
+	// Remove objects in the other format, so they won't be loaded instead
+	hGroup.Delete(fBinary ? C4CFN_ScenarioObjects : C4CFN_ScenarioObjectsBin);
 
 	// Move temp file to group
-	hGroup.Move(szFilename, nullptr); // check?
+	hGroup.Move(szFilename, szEntryName); // check?
 	// Success
 	return true;
 }
 
-bool C4GameObjects::Save(const char *szFilename, bool fSaveGame, bool fSaveInactive)
+bool C4GameObjects::Save(const char *szFilename, bool fSaveGame, bool fSaveInactive, bool fBinary)
 {
 	// Enumerate
 	Enumerate();
@@ -697,10 +745,15 @@ bool C4GameObjects::Save(const char *szFilename, bool fSaveGame, bool fSaveInact
 
 	// Decompile objects to buffer
 	std::string buffer;
-	bool fSuccess = DecompileToBuf_Log<StdCompilerINIWrite>(mkParAdapt(*this, false, !fSaveGame), &buffer, szFilename);
+	StdBuf binBuffer;
+	bool fSuccess;
+	if (fBinary)
+		fSuccess = DecompileToBuf_Log<StdCompilerNamedBinWrite>(C4ObjectListsAdapt{*this, fSaveInactive ? &InactiveObjects : nullptr, !fSaveGame}, &binBuffer, szFilename);
+	else
+		fSuccess = DecompileToBuf_Log<StdCompilerINIWrite>(mkParAdapt(*this, false, !fSaveGame), &buffer, szFilename);
 
 	// Decompile inactives
-	if (fSaveInactive)
+	if (fSaveInactive && !fBinary)
 	{
 		std::string inactiveBuffer;
 		fSuccess &= DecompileToBuf_Log<StdCompilerINIWrite>(mkParAdapt(InactiveObjects, false, !fSaveGame), &inactiveBuffer, szFilename);
@@ -717,6 +770,8 @@ bool C4GameObjects::Save(const char *szFilename, bool fSaveGame, bool fSaveInact
 		return false;
 
 	// Write
+	if (fBinary)
+		return binBuffer.SaveToFile(szFilename);
 	return StdStrBuf{buffer.c_str(), buffer.size(), false}.SaveToFile(szFilename);
 }
 
@@ -847,6 +902,8 @@ void C4GameObjects::FixObjectOrder()
 		if (!pLnk1stUnsorted) break; // done
 		pLnk0 = pLnk1stUnsorted;
 	}
+	// objects were swapped between links
+	UpdateInstanceIndex();
 	// objects fixed!
 }
 
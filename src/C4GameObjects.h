@@ -63,8 +63,8 @@ public:
 	void RemoveSolidMasks();
 
 	int Load(C4Group &hGroup, bool fKeepInactive);
-	bool Save(const char *szFilename, bool fSaveGame, bool fSaveInactive);
-	bool Save(C4Group &hGroup, bool fSaveGame, bool fSaveInactive);
+	bool Save(const char *szFilename, bool fSaveGame, bool fSaveInactive, bool fBinary = false);
+	bool Save(C4Group &hGroup, bool fSaveGame, bool fSaveInactive, bool fBinary = false); // fBinary: save as Objects.c4b, which is faster to write and read, but not editable
 
 	void UpdateScriptPointers(); // update pointers to C4AulScript *
 
@@ -19,6 +19,7 @@
 
 #include <C4GameSave.h>
 
+#include <C4Application.h>
 #include <C4Components.h>
 #include <C4Game.h>
 #include "C4Version.h"
@@ -27,6 +28,7 @@
 #include <C4Log.h>
 #include <C4Player.h>
 #include <C4RTF.h>
+#include <C4ThreadPool.h>
 
 #include <format>
 #include <utility>
@@ -201,7 +203,7 @@ bool C4GameSave::SaveRuntimeData()
 		Log(C4ResStrTableKey::IDS_ERR_SAVE_SCRIPTSTRINGS); return false;
 	}
 	// Objects
-	if (!Game.Objects.Save((*pSaveGroup), IsExact(), true))
+	if (!Game.Objects.Save((*pSaveGroup), IsExact(), true, GetSaveBinaryObjects()))
 	{
 		Log(C4ResStrTableKey::IDS_ERR_SAVE_OBJECTS); return false;
 	}
@@ -521,8 +523,26 @@ bool C4GameSave::Close()
 	return fSuccess;
 }
 
+std::unique_ptr<C4Group> C4GameSave::TakeGroup()
+{
+	// only groups created by this save can be handed over
+	if (!pSaveGroup || !fOwnGroup) return nullptr;
+	// sort group
+	const char *szSortOrder = GetSortOrder();
+	if (szSortOrder) pSaveGroup->Sort(szSortOrder);
+	std::unique_ptr<C4Group> pGroup{pSaveGroup};
+	pSaveGroup = nullptr;
+	fOwnGroup = false;
+	return pGroup;
+}
+
 // *** C4GameSaveSavegame
 
+bool C4GameSaveSavegame::GetSaveBinaryObjects()
+{
+	return Config.General.BinarySavegames;
+}
+
 bool C4GameSaveSavegame::OnSaving()
 {
 	if (!Game.IsRunning) return true;
@@ -615,3 +635,67 @@ void C4GameSaveNetwork::AdjustCore(C4Scenario &rC4S)
 	rC4S.Head.NetworkGame = true;
 	rC4S.Head.NetworkRuntimeJoin = !fInitial;
 }
+
+// *** C4GameSaveWriter
+
+bool C4GameSaveWriter::Write(C4Group &hGroup, const WrittenCallback &fnWritten)
+{
+	if (!hGroup.Close()) return false;
+	return !fnWritten || fnWritten();
+}
+
+void C4GameSaveWriter::Start(std::unique_ptr<C4Group> pGroup, WrittenCallback fnWritten, DoneCallback fnDone)
+{
+	// one write at a time
+	Wait();
+
+	if (!pGroup)
+	{
+		fnDone(false, {});
+		return;
+	}
+
+	if (!C4ThreadPool::Global)
+	{
+		// no worker threads: write right away
+		const auto start = Clock::now();
+		const bool fSuccess{Write(*pGroup, fnWritten)};
+		fnDone(fSuccess, Clock::now() - start);
+		return;
+	}
+
+	{
+		const std::lock_guard lock{Mutex};
+		fPending = true;
+	}
+
+	C4ThreadPool::Global->SubmitCallback([this, pGroup = std::shared_ptr<C4Group>{std::move(pGroup)}, fnWritten = std::move(fnWritten), fnDone = std::move(fnDone)]
+	{
+		const auto start = Clock::now();
+		const bool fSuccess{Write(*pGroup, fnWritten)};
+		const auto writeTime = Clock::now() - start;
+
+		Application.InteractiveThread.ExecuteInMainThread([fnDone, fSuccess, writeTime] { fnDone(fSuccess, writeTime); });
+
+		const std::lock_guard lock{Mutex};
+		fPending = false;
+		WrittenCondition.notify_all();
+	});
+}
+
+bool C4GameSaveWriter::IsPending()
+{
+	const std::lock_guard lock{Mutex};
+	return fPending;
+}
+
+void C4GameSaveWriter::Wait()
+{
+	std::unique_lock lock{Mutex};
+	WrittenCondition.wait(lock, [this] { return !fPending; });
+}
+
+std::int64_t C4GameSaveWriter::ToMilliseconds(const Clock::duration duration)
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+}
@@ -31,6 +31,13 @@
 #include <C4Group.h>
 #include <C4Components.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
 class C4GameSave
 {
 private:
@@ -69,6 +76,7 @@ protected:
 	virtual bool GetSaveScriptPlayers()     { return IsExact(); } // return whether joined script players shall be saved into SavePlayerInfos
 	virtual bool GetSaveUserPlayerFiles()   { return IsExact(); } // return whether .c4p files of joined user players shall be put into the scenario
 	virtual bool GetSaveScriptPlayerFiles() { return IsExact(); } // return whether .c4p files of joined script players shall be put into the scenario
+	virtual bool GetSaveBinaryObjects() { return false; } // return whether objects shall be saved in the binary format instead of Objects.txt
 
 	// savegame specializations
 	virtual void AdjustCore(C4Scenario &rC4S) {} // set specific C4S values
@@ -110,6 +118,7 @@ public:
 	bool Save(C4Group &hToGroup, bool fKeepGroup); // save game directly to target group
 	bool SaveDesc(C4Group &hToGroup); // save scenario desc to file
 	bool Close(); // close scenario group
+	std::unique_ptr<C4Group> TakeGroup(); // sort the group created by Save(szFilename) and hand it over without writing it; closing it writes the file
 
 	C4Group *GetGroup() { return pSaveGroup; } // get scenario saving group; only open between calls to Save() and Close()
 };
@@ -139,6 +148,7 @@ protected:
 	// savegame specializations
 	virtual bool GetSaveOrigin() override { return true; } // origin must be saved in savegames
 	virtual bool GetSaveUserPlayerFiles() override { return false; } // user player files are not needed in savegames, because they will be replaced by player files of resuming playerss
+	virtual bool GetSaveBinaryObjects() override; // binary objects if configured
 	virtual void AdjustCore(C4Scenario &rC4S) override; // set specific C4S values
 	virtual bool WriteDesc(std::string &desc) override; // write savegame desc (contents only)
 	virtual bool SaveComponents() override; // custom savegame components (title)
@@ -181,8 +191,40 @@ protected:
 	virtual bool GetKeepTitle() override { return false; } // always delete title files (not used in dynamics)
 	virtual bool GetSaveDesc() override { return false; } // no desc in dynamics
 	virtual bool GetCreateSmallFile() override { return true; } // return whether file size should be minimized
+	virtual bool GetSaveBinaryObjects() override { return true; } // dynamics are only loaded by clients running the same engine
 
 	virtual bool GetCopyScenario() override { return false; } // network dynamics do not base on normal scenario
 	// savegame specializations
 	virtual void AdjustCore(C4Scenario &rC4S) override; // set specific C4S values
 };
+
+// Saving is split into two stages:
+// - the snapshot: C4GameSave::Save puts the current game state into the group; it needs the game and stays on the main thread
+// - writing: closing the group calculates the checksums, compresses all entries and writes the file; this runs on C4ThreadPool::Global
+class C4GameSaveWriter
+{
+public:
+	using Clock = std::chrono::steady_clock;
+	using WrittenCallback = std::function<bool()>; // by worker thread, after the group has been written successfully
+	using DoneCallback = std::function<void(bool fSuccess, Clock::duration writeTime)>; // by main thread
+
+private:
+	std::mutex Mutex;
+	std::condition_variable WrittenCondition;
+	bool fPending{false};
+
+	static bool Write(C4Group &hGroup, const WrittenCallback &fnWritten);
+
+public:
+	C4GameSaveWriter() = default;
+	~C4GameSaveWriter() { Wait(); }
+
+	C4GameSaveWriter(const C4GameSaveWriter &) = delete;
+	C4GameSaveWriter &operator=(const C4GameSaveWriter &) = delete;
+
+	void Start(std::unique_ptr<C4Group> pGroup, WrittenCallback fnWritten, DoneCallback fnDone); // by main thread; waits for any previous write first
+	bool IsPending();
+	void Wait(); // until the group is written; fnDone may still be queued for the main thread
+
+	static std::int64_t ToMilliseconds(Clock::duration duration);
+};
@@ -164,7 +164,8 @@ void C4GraphicsSystem::Execute()
 	if (Game.pGUI && !C4GUI::IsActive())
 		SetMouseInGUI(false, false);
 
-	// Viewports
+	// Viewports share one relight allowance per frame
+	Game.Landscape.StartDrawFrame();
 	for (const auto &cvp : Viewports)
 		cvp->Execute();
 
@@ -21,6 +21,7 @@
 #include <C4Group.h>
 
 #include <C4Components.h>
+#include <C4GroupCache.h>
 #include <C4InputValidation.h>
 #include "StdConfig.h"
 
@@ -109,6 +110,11 @@ void C4Group_SetTempPath(const char *szPath)
 	else { SCopy(szPath, C4Group_TempPath, _MAX_PATH); AppendBackslash(C4Group_TempPath); }
 }
 
+void C4Group_SetCache(const char *szPath, size_t iMaxSize)
+{
+	GroupCache.Init(szPath, iMaxSize);
+}
+
 const char *C4Group_GetTempPath()
 {
 	return C4Group_TempPath;
@@ -755,8 +761,12 @@ bool C4Group::OpenRealGrpFile()
 	int cnt, file_entries;
 	C4GroupEntryCore corebuf;
 
-	// Open StdFile
-	if (!StdFile.Open(FileName, true)) return Error("OpenRealGrpFile: Cannot open standard file");
+	// Open StdFile: from the uncompressed cache image, if there is one
+	if (auto image = GroupCache.Get(FileName))
+	{
+		if (!StdFile.Open(FileName, std::move(image))) return Error("OpenRealGrpFile: Cannot open cache image");
+	}
+	else if (!StdFile.Open(FileName, true)) return Error("OpenRealGrpFile: Cannot open standard file");
 
 	// Read header
 	if (!StdFile.Read(reinterpret_cast<uint8_t *>(&Head), sizeof(C4GroupHeader))) return Error("OpenRealGrpFile: Error reading header");
@@ -1237,8 +1247,35 @@ bool C4Group::SetFilePtr(size_t iOffset)
 	if (Status == GRPF_Folder)
 		return Error("SetFilePtr not implemented for Folders");
 
+	// child of a packed group: let the mother chain seek to the absolute position directly
+	if (Mother && Mother->Status == GRPF_File)
+	{
+		const size_t iOldFilePtr = FilePtr;
+		FilePtr = iOffset;
+		if (!Mother->EnsureChildFilePtr(this))
+		{
+			FilePtr = iOldFilePtr;
+			return false;
+		}
+		return true;
+	}
+
+	// regular group: seek in the standard file, which only inflates from the nearest checkpoint
+	if (!Mother)
+	{
+		if (FilePtr != iOffset)
+		{
+			if (!StdFile.Seek(EntryOffset + iOffset))
+			{
+				RewindFilePtr(); return Error("SetFilePtr:");
+			}
+			FilePtr = iOffset;
+		}
+		return true;
+	}
+
 	// ensure mother is at correct pos
-	if (Mother && !Mother->EnsureChildFilePtr(this))
+	if (!Mother->EnsureChildFilePtr(this))
 		return false;
 
 	// Rewind if necessary
@@ -1324,6 +1361,14 @@ bool C4Group::AdvanceFilePtr(size_t iOffset, C4Group *pByChild)
 	return true;
 }
 
+const uint8_t *C4Group::GetMappedData(size_t iSize)
+{
+	if (Status != GRPF_File) return nullptr;
+	// Child group file: the mother's file ptr has been moved along
+	if (Mother) return Mother->GetMappedData(iSize);
+	return StdFile.GetMappedData(iSize);
+}
+
 bool C4Group::RewindFilePtr()
 {
 #ifndef NDEBUG
@@ -2240,6 +2285,29 @@ bool C4Group::LoadEntry(const char *szEntryName, StdBuf &Buf)
 	return true;
 }
 
+bool C4Group::LoadEntryView(const char *szEntryName, StdBuf &Buf)
+{
+	size_t size;
+	// Access entry
+	if (!AccessEntry(szEntryName, &size)) return Error("LoadEntry: Not found");
+	// Mapped cache image: refer to the data in place; the image stays mapped until the program exits
+	if (const uint8_t *const data = GetMappedData(size))
+	{
+		Buf.Ref(data, size);
+		return true;
+	}
+	// Allocate memory
+	Buf.New(size);
+	// Load data
+	if (!Read(Buf.getMData(), size))
+	{
+		Buf.Clear();
+		return Error("LoadEntry: Reading error");
+	}
+	// ok
+	return true;
+}
+
 bool C4Group::LoadEntryString(const char *szEntryName, StdStrBuf &Buf)
 {
 	size_t size;
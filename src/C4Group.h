@@ -59,6 +59,7 @@ const int C4GroupMaxMaker = 30,
 
 void C4Group_SetMaker(const char *szMaker);
 void C4Group_SetTempPath(const char *szPath);
+void C4Group_SetCache(const char *szPath, size_t iMaxSize);
 const char *C4Group_GetTempPath();
 void C4Group_SetSortList(const char **ppSortList);
 void C4Group_SetProcessCallback(bool(*fnCallback)(const char *, int));
@@ -220,6 +221,7 @@ public:
 	bool LoadEntry(const char *szEntryName, char **lpbpBuf,
 		size_t *ipSize = nullptr, int iAppendZeros = 0);
 	bool LoadEntry(const char *szEntryName, StdBuf &Buf);
+	bool LoadEntryView(const char *szEntryName, StdBuf &Buf); // Buf may refer to the mapped group cache image, so it must not be modified
 	bool LoadEntryString(const char *szEntryName, StdStrBuf &Buf);
 	bool FindEntry(const char *szWildCard,
 		char *sFileName = nullptr,
@@ -269,6 +271,7 @@ protected:
 	bool SetFilePtr(size_t iOffset);
 	bool RewindFilePtr();
 	bool AdvanceFilePtr(size_t iOffset, C4Group *pByChild = nullptr);
+	const uint8_t *GetMappedData(size_t iSize); // data at the file ptr if the group is read from a mapped cache image
 	bool AddEntry(int status,
 		bool childgroup,
 		const char *fname,
@@ -0,0 +1,181 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4GroupCache.h"
+
+#include "Standard.h"
+#include "StdBuf.h"
+#include "StdFile.h"
+#include "StdGzCompressedFile.h"
+
+#ifdef _WIN32
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <format>
+#include <tuple>
+#include <vector>
+
+#include <zlib.h>
+
+C4GroupCache GroupCache;
+
+namespace
+{
+	constexpr auto ImageExtension = ".c4i";
+	constexpr int MaxTempAttempts = 10;
+}
+
+void C4GroupCache::Init(const char *const szPath, const std::size_t iMaxSize)
+{
+	const std::lock_guard lock{Mutex};
+	Path.clear();
+	MaxSize = iMaxSize;
+	if (!szPath || !*szPath || !iMaxSize) return;
+
+	if (!DirectoryExists(szPath) && !MakeDirectory(szPath, nullptr)) return;
+
+	char path[_MAX_PATH + 1];
+	SCopy(szPath, path, _MAX_PATH);
+	AppendBackslash(path);
+	Path = path;
+
+	// the limit might have been lowered
+	Evict(0);
+}
+
+std::string C4GroupCache::GetImageName(const char *const szFilename) const
+{
+	char fullFilename[_MAX_PATH + 1];
+	RealPath(szFilename, fullFilename);
+	const auto pathCRC = crc32(0, reinterpret_cast<const Bytef *>(fullFilename), checked_cast<uInt>(SLen(fullFilename)));
+	return std::format("{}{:08x}-{:x}-{:x}{}", Path, pathCRC, FileSize(szFilename), static_cast<std::uint64_t>(FileTime(szFilename)), ImageExtension);
+}
+
+std::shared_ptr<const StdMappedFile> C4GroupCache::Get(const char *const szFilename)
+{
+	if (!IsEnabled() || FileSize(szFilename) < MinGroupSize) return nullptr;
+
+	const std::lock_guard lock{Mutex};
+	const std::string image{GetImageName(szFilename)};
+	if (const auto it = Images.find(image); it != Images.end()) return it->second;
+
+	if (FileExists(image.c_str()))
+	{
+		// mark as recently used
+#ifdef _WIN32
+		_utime(image.c_str(), nullptr);
+#else
+		utime(image.c_str(), nullptr);
+#endif
+	}
+	else if (!CreateImage(szFilename, image))
+	{
+		return nullptr;
+	}
+
+	try
+	{
+		auto mapped = std::make_shared<const StdMappedFile>(image);
+		Images.emplace(image, mapped);
+		return mapped;
+	}
+	catch (const StdMappedFile::Exception &)
+	{
+		EraseFile(image.c_str());
+		return nullptr;
+	}
+}
+
+bool C4GroupCache::CreateImage(const char *const szFilename, const std::string &image)
+{
+	// inflate to a temporary file first, so an interrupted write never leaves a truncated image
+	// other processes might be creating the same image, so the temporary file is created exclusively
+	StdStrBuf tempImage;
+	FILE *file{nullptr};
+	for (int i = 0; !file && i < MaxTempAttempts; ++i)
+	{
+		tempImage.Copy(image.c_str());
+		MakeTempFilename(&tempImage);
+		file = std::fopen(tempImage.getData(), "wbx");
+	}
+	if (!file) return false;
+
+	std::size_t size{0};
+	bool success{true};
+	try
+	{
+		StdGzCompressedFile::Read group{szFilename};
+		std::unique_ptr<uint8_t[]> buffer{new uint8_t[StdGzCompressedFile::ChunkSize]};
+		for (;;)
+		{
+			const auto progress = group.ReadData(buffer.get(), StdGzCompressedFile::ChunkSize);
+			if (!progress) break;
+
+			size += progress;
+			if (size > MaxSize || std::fwrite(buffer.get(), 1, progress, file) != progress)
+			{
+				success = false;
+				break;
+			}
+		}
+	}
+	catch (const StdGzCompressedFile::Exception &)
+	{
+		success = false;
+	}
+
+	if (std::fclose(file) != 0 || !size) success = false;
+
+	if (success)
+	{
+		Evict(size);
+		// another process might have created the same image meanwhile
+		success = RenameFile(tempImage.getData(), image.c_str()) || FileExists(image.c_str());
+	}
+
+	if (FileExists(tempImage.getData())) EraseFile(tempImage.getData());
+	return success;
+}
+
+void C4GroupCache::Evict(const std::size_t iReserve)
+{
+	std::vector<std::tuple<time_t, std::size_t, std::string>> images;
+	std::size_t totalSize{0};
+	for (DirectoryIterator it{Path.c_str()}; *it; ++it)
+	{
+		if (!SEqualNoCase(GetExtension(*it), ImageExtension + 1)) continue;
+
+		const auto size = FileSize(*it);
+		totalSize += size;
+		// images mapped by this process are in use and cannot be deleted everywhere
+		if (!Images.contains(*it))
+		{
+			images.emplace_back(FileTime(*it), size, *it);
+		}
+	}
+
+	// least recently used first
+	std::sort(images.begin(), images.end());
+	for (const auto &[time, size, filename] : images)
+	{
+		if (totalSize + iReserve <= MaxSize) break;
+		if (EraseFile(filename.c_str())) totalSize -= size;
+	}
+}
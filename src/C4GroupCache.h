@@ -0,0 +1,52 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// directory of uncompressed images of packed groups, which are memory-mapped instead of being inflated on every start
+
+#pragma once
+
+#include "StdMappedFile.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Each image is the inflated group file, so its header and entry table are read just like from the group itself.
+// Images are named after the full path, size and modification time of the group, so changed groups get a new image;
+// the least recently used images are deleted when the directory grows beyond its size limit.
+class C4GroupCache
+{
+public:
+	static constexpr std::size_t MinGroupSize = 256 * 1024; // smaller groups are inflated quickly enough
+
+private:
+	std::mutex Mutex;
+	std::string Path; // with trailing separator; empty if the cache is disabled
+	std::size_t MaxSize{0};
+	std::unordered_map<std::string, std::shared_ptr<const StdMappedFile>> Images; // mapped images by filename, kept mapped so views into them stay valid
+
+	std::string GetImageName(const char *szFilename) const;
+	bool CreateImage(const char *szFilename, const std::string &image);
+	void Evict(std::size_t iReserve);
+
+public:
+	void Init(const char *szPath, std::size_t iMaxSize); // no path or zero size disables the cache
+	bool IsEnabled() const { return !Path.empty(); }
+	std::shared_ptr<const StdMappedFile> Get(const char *szFilename); // mapped image of the packed group file; nullptr if it is not cached
+};
+
+extern C4GroupCache GroupCache;
@@ -39,10 +39,12 @@
 #include <StdBitmap.h>
 #include <StdPNG.h>
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 int32_t MVehic = MNone, MTunnel = MNone, MWater = MNone, MSnow = MNone, MEarth = MNone, MGranite = MNone;
 uint8_t MCVehic = 0;
@@ -110,8 +112,19 @@ void C4Landscape::ExecuteScan()
 	{
 		// Scan landscape column: sectors down
 		int32_t last_mat = -1;
+		const uint8_t *const tempConvCnt = TempConvCnt + (ScanX / 17) * PixCntPitch;
 		for (cy = 0; cy < Height; cy++)
 		{
+			// skip cells without temperature convertible material if the material above isn't convertible either:
+			// DoScan wouldn't do anything at any material change in there
+			while (!(cy % 15) && !tempConvCnt[cy / 15] && (last_mat == -1 || !MatTempConvertible(last_mat)))
+			{
+				cy = std::min<int32_t>(cy + 15, Height);
+				last_mat = _GetMat(ScanX, cy - 1);
+				if (cy >= Height) break;
+			}
+			if (cy >= Height) break;
+
 			mat = _GetMat(ScanX, cy);
 			// material change?
 			if (last_mat != mat)
@@ -254,9 +267,18 @@ void C4Landscape::Clear(bool fClearMapCreator, bool fClearSky)
 	Mode = C4LSC_Undefined;
 	// clear pixel count
 	delete[] PixCnt;         PixCnt           = nullptr;
+	delete[] TempConvCnt;    TempConvCnt      = nullptr;
 	PixCntPitch = 0;
 }
 
+void C4Landscape::StartDrawFrame()
+{
+	// relight statistics
+	LastFrameRelitPixels = RelitPixels;
+	RelitPixels = 0;
+	RelightAllowance = C4LS_MaxRelightArea;
+}
+
 void C4Landscape::Draw(C4FacetEx &cgo, int32_t iPlayer)
 {
 	if (Modulation) Application.DDraw->ActivateBlitModulation(Modulation);
@@ -715,6 +737,7 @@ bool C4Landscape::Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bo
 	int32_t PixCntWidth = (Width + 16) / 17;
 	PixCntPitch = (Height + 14) / 15;
 	PixCnt = new uint8_t[PixCntWidth * PixCntPitch];
+	TempConvCnt = new uint8_t[PixCntWidth * PixCntPitch];
 	UpdatePixCnt(C4Rect(0, 0, Width, Height));
 	ClearMatCount();
 	UpdateMatCnt(C4Rect(0, 0, Width, Height), true);
@@ -752,13 +775,7 @@ bool C4Landscape::SetPix(int32_t x, int32_t y, uint8_t npix)
 	if (npix == _GetPix(x, y))
 		return true;
 	// note for relight
-	C4Rect CheckRect(x - 2 * C4LS_MaxLightDistX, y - 2 * C4LS_MaxLightDistY, 4 * C4LS_MaxLightDistX + 1, 4 * C4LS_MaxLightDistY + 1);
-	for (int32_t i = 0; i < C4LS_MaxRelights; i++)
-		if (!Relights[i].Wdt || Relights[i].Overlap(CheckRect) || i + 1 >= C4LS_MaxRelights)
-		{
-			Relights[i].Add(C4Rect(x, y, 1, 1));
-			break;
-		}
+	AddRelight(C4Rect(x, y, 1, 1));
 	// set pixel
 	return _SetPix(x, y, npix);
 }
@@ -795,6 +812,11 @@ bool C4Landscape::_SetPix(int32_t x, int32_t y, uint8_t npix)
 	{
 		if (Pix2Dens[opix]) PixCnt[(y / 15) + (x / 17) * PixCntPitch]--;
 	}
+	if (Pix2TempConv[npix] != Pix2TempConv[opix])
+	{
+		if (Pix2TempConv[npix]) TempConvCnt[(y / 15) + (x / 17) * PixCntPitch]++;
+		else TempConvCnt[(y / 15) + (x / 17) * PixCntPitch]--;
+	}
 
 	// count material
 	if (!npix || MatValid(Pix2Mat[npix]))
@@ -887,9 +909,8 @@ bool C4Landscape::ClearPix(int32_t tx, int32_t ty)
 	return SetPix(tx, ty, bcol);
 }
 
-bool C4Landscape::_PathFree(int32_t x, int32_t y, int32_t x2, int32_t y2)
+bool C4Landscape::_PathFreeCells(int32_t x, int32_t y, int32_t x2, int32_t y2)
 {
-	x /= 17; y /= 15; x2 /= 17; y2 /= 15;
 	while (x != x2 && y != y2)
 	{
 		if (PixCnt[x * PixCntPitch + y])
@@ -1489,12 +1510,14 @@ bool C4Landscape::SaveDiff(C4Group &hGroup, bool fSyncSave)
 	if (fSyncSave || fChanged)
 	{
 		// Save landscape surface
-		if (!Surface8->Save(Config.AtTempPath(C4CFN_TempLandscape)))
+		char szTempLandscape[_MAX_PATH + 1];
+		SCopy(Config.AtTempPath(C4CFN_TempLandscape), szTempLandscape);
+		MakeTempFilename(szTempLandscape);
+		if (!Surface8->Save(szTempLandscape))
 			return false;
 
 		// Move temp file to group
-		if (!hGroup.Move(Config.AtTempPath(C4CFN_TempLandscape),
-			C4CFN_DiffLandscape))
+		if (!hGroup.Move(szTempLandscape, C4CFN_DiffLandscape))
 			return false;
 	}
 
@@ -1660,6 +1683,10 @@ void C4Landscape::Default()
 	Modulation = 0;
 	fMapChanged = false;
 	ShadeMaterials = true;
+	Relights.Clear();
+	RelitPixels = LastFrameRelitPixels = 0;
+	RelightAllowance = C4LS_MaxRelightArea;
+	ChangeRect.Default();
 }
 
 void C4Landscape::ClearBlastMatCount()
@@ -2226,12 +2253,14 @@ bool C4Landscape::SaveMap(C4Group &hGroup)
 	Game.TextureMap.StoreMapPalette(bypPalette, Game.Material);
 
 	// Save map surface
-	if (!Map->Save(Config.AtTempPath(C4CFN_TempMap), bypPalette))
+	char szTempMap[_MAX_PATH + 1];
+	SCopy(Config.AtTempPath(C4CFN_TempMap), szTempMap);
+	MakeTempFilename(szTempMap);
+	if (!Map->Save(szTempMap, bypPalette))
 		return false;
 
 	// Move temp file to group
-	if (!hGroup.Move(Config.AtTempPath(C4CFN_TempMap),
-		C4CFN_Map))
+	if (!hGroup.Move(szTempMap, C4CFN_Map))
 		return false;
 
 	// Success
@@ -2487,9 +2516,43 @@ uint8_t C4Landscape::GetMapIndex(int32_t iX, int32_t iY)
 	return Map->GetPix(iX, iY);
 }
 
-bool C4Landscape::DoRelights()
+void C4Landscape::AddRelight(C4Rect rect)
+{
+	// already pending?
+	for (auto &relight : Relights)
+		if (relight.Contains(rect.x, rect.y) && relight.Contains(rect.x + rect.Wdt - 1, rect.y + rect.Hgt - 1))
+			return;
+	// merge with all regions near the new one; a merged region may reach further ones, so repeat until nothing is in range anymore
+	for (bool merged = true; merged; )
+	{
+		merged = false;
+		C4Rect checkRect(rect.x - 2 * C4LS_MaxLightDistX, rect.y - 2 * C4LS_MaxLightDistY, rect.Wdt + 4 * C4LS_MaxLightDistX, rect.Hgt + 4 * C4LS_MaxLightDistY);
+		for (size_t i = 0; i < Relights.GetCount(); )
+		{
+			if (Relights.Get(i).Overlap(checkRect))
+			{
+				rect.Add(Relights.Get(i));
+				Relights.RemoveIndexedRect(i);
+				merged = true;
+			}
+			else
+			{
+				++i;
+			}
+		}
+	}
+	// too many separate regions: join with the last one to keep lookups cheap
+	if (Relights.GetCount() >= C4LS_MaxRelights)
+	{
+		rect.Add(Relights.back());
+		Relights.pop_back();
+	}
+	Relights.AddRect(rect);
+}
+
+bool C4Landscape::DoRelights(const bool all)
 {
-	if (!Relights[0].Wdt) return true;
+	if (Relights.empty()) return true;
 
 	if (!Surface32->Lock()) return false;
 	if (AnimationSurface)
@@ -2497,11 +2560,25 @@ bool C4Landscape::DoRelights()
 		AnimationSurface->Lock();
 	}
 
-	for (int32_t i = 0; i < C4LS_MaxRelights; i++)
+	while (!Relights.empty() && (all || RelightAllowance > 0))
 	{
-		if (!Relights[i].Wdt)
-			break;
-		C4Rect SolidMaskRect = Relights[i];
+		// take next region; if it exceeds the remaining allowance, only relight as many rows as fit and keep the rest pending
+		C4Rect relight = Relights.front();
+		const int32_t rows = all ? relight.Hgt : std::clamp(RelightAllowance / relight.Wdt, 1, relight.Hgt);
+		if (rows < relight.Hgt)
+		{
+			Relights.front().y += rows;
+			Relights.front().Hgt -= rows;
+			relight.Hgt = rows;
+		}
+		else
+		{
+			Relights.erase(Relights.begin());
+		}
+		RelightAllowance = std::max(RelightAllowance - relight.Wdt * relight.Hgt, 0);
+		RelitPixels += relight.Wdt * relight.Hgt;
+
+		C4Rect SolidMaskRect = relight;
 		SolidMaskRect.x -= 2 * C4LS_MaxLightDistX; SolidMaskRect.y -= 2 * C4LS_MaxLightDistY;
 		SolidMaskRect.Wdt += 4 * C4LS_MaxLightDistX; SolidMaskRect.Hgt += 4 * C4LS_MaxLightDistY;
 		C4SolidMask *pSolid;
@@ -2509,13 +2586,12 @@ bool C4Landscape::DoRelights()
 		{
 			pSolid->RemoveTemporary(SolidMaskRect);
 		}
-		Relight(Relights[i]);
+		Relight(relight);
 		// Restore Solidmasks
 		for (pSolid = C4SolidMask::First; pSolid; pSolid = pSolid->Next)
 		{
 			pSolid->PutTemporary(SolidMaskRect);
 		}
-		Relights[i].Default();
 		C4SolidMask::CheckConsistency();
 	}
 
@@ -2534,6 +2610,28 @@ bool C4Landscape::Relight(C4Rect To)
 	return ApplyLighting(To);
 }
 
+void C4Landscape::GetPlacementRow(const int32_t y, const int32_t x, const int32_t wdt, int32_t *const out)
+{
+	// outside the landscape vertically: border rules apply to the whole row
+	if (y < 0 || y >= Height)
+	{
+		for (int32_t i = 0; i < wdt; ++i)
+			out[i] = GetPlacement(x + i, y);
+		return;
+	}
+
+	// left and right border pixels are bounds checked, everything in between is read straight from the 8 bit surface
+	const int32_t from = std::clamp(-x, 0, wdt);
+	const int32_t to = std::clamp(Width - x, from, wdt);
+	for (int32_t i = 0; i < from; ++i)
+		out[i] = GetPlacement(x + i, y);
+	const uint8_t *const pix = Surface8->Bits + y * Surface8->Pitch + x;
+	for (int32_t i = from; i < to; ++i)
+		out[i] = Pix2Place[pix[i]];
+	for (int32_t i = to; i < wdt; ++i)
+		out[i] = GetPlacement(x + i, y);
+}
+
 bool C4Landscape::ApplyLighting(C4Rect To)
 {
 	// clip to landscape size
@@ -2543,31 +2641,50 @@ bool C4Landscape::ApplyLighting(C4Rect To)
 
 	if (!Surface32->LockForUpdate(To)) return false;
 	Surface32->ClearBoxDw(To.x, To.y, To.Wdt, To.Hgt);
-	// do lightning
-	for (int32_t iX = To.x; iX < To.x + To.Wdt; ++iX)
-	{
-		int AboveDensity = 0, BelowDensity = 0;
-		if (ShadeMaterials)
+
+	// The lighting is done row by row: Placement rows of the vertical light range are kept in a ring buffer,
+	// so every landscape row is only read once, and the sliding density sums above and below each pixel
+	// are updated for the whole row at once. The row stride includes one pixel left and right of the
+	// target rect for the horizontal neighbour density.
+	constexpr int32_t LightRows = 2 * C4LS_MaxLightDistY + 2; // rows y - 9 to y + 8 (and y + 9 while advancing)
+	const int32_t stride = To.Wdt + 2;
+	std::vector<int32_t> placementRows;
+	std::vector<int32_t> aboveDensity, belowDensity;
+	const auto placementRow = [&](const int32_t y) { return placementRows.data() + ((y % LightRows + LightRows) % LightRows) * stride; };
+
+	if (ShadeMaterials)
+	{
+		placementRows.resize(LightRows * stride);
+		aboveDensity.resize(To.Wdt);
+		belowDensity.resize(To.Wdt);
+		for (int32_t y = To.y - C4LS_MaxLightDistY - 1; y <= To.y + C4LS_MaxLightDistY; ++y)
+			GetPlacementRow(y, To.x - 1, stride, placementRow(y));
+		for (int32_t i = 1; i <= C4LS_MaxLightDistY; ++i)
 		{
-			for (int i = 1; i <= 8; ++i)
+			const int32_t *const above = placementRow(To.y - i) + 1;
+			const int32_t *const below = placementRow(To.y + i) + 1;
+			for (int32_t x = 0; x < To.Wdt; ++x)
 			{
-				AboveDensity += GetPlacement(iX, To.y - i - 1);
-				BelowDensity += GetPlacement(iX, To.y + i - 1);
+				aboveDensity[x] += above[x];
+				belowDensity[x] += below[x];
 			}
 		}
+	}
+
+	// do lightning
+	for (int32_t iY = To.y; iY < To.y + To.Hgt; ++iY)
+	{
+		const uint8_t *const pixRow = Surface8->Bits + iY * Surface8->Pitch;
+		const int32_t *const ownRow = ShadeMaterials ? placementRow(iY) : nullptr;
 
-		for (int32_t iY = To.y; iY < To.y + To.Hgt; ++iY)
+		for (int32_t i = 0; i < To.Wdt; ++i)
 		{
-			// do not move that code into the if (ShadeMaterials) block, as it needs to be run for sky pixels as well
-			AboveDensity -= GetPlacement(iX, iY - 9);
-			AboveDensity += GetPlacement(iX, iY - 1);
-			BelowDensity -= GetPlacement(iX, iY);
-			BelowDensity += GetPlacement(iX, iY + 8);
+			const int32_t iX = To.x + i;
 
 			// Normal color
 			uint32_t dwBackClr = GetClrByTex(iX, iY);
 
-			uint8_t pix = _GetPix(iX, iY);
+			const uint8_t pix = pixRow[iX];
 			// Sky
 			if (!pix)
 			{
@@ -2581,10 +2698,10 @@ bool C4Landscape::ApplyLighting(C4Rect To)
 				int iOwnDens = Pix2Place[pix];
 				if (!iOwnDens) continue;
 				iOwnDens *= 2;
-				iOwnDens += GetPlacement(iX + 1, iY) + GetPlacement(iX - 1, iY);
+				iOwnDens += ownRow[i + 2] + ownRow[i];
 				iOwnDens /= 4;
 				// get density of surrounding materials
-				int iCompareDens = AboveDensity / 8;
+				int iCompareDens = aboveDensity[i] / 8;
 				if (iOwnDens > iCompareDens)
 				{
 					// apply light
@@ -2594,7 +2711,7 @@ bool C4Landscape::ApplyLighting(C4Rect To)
 				{
 					DarkenClrBy(dwBackClr, (std::min)(30, 2 * (iCompareDens - iOwnDens)));
 				}
-				iCompareDens = BelowDensity / 8;
+				iCompareDens = belowDensity[i] / 8;
 				if (iOwnDens > iCompareDens)
 				{
 					DarkenClrBy(dwBackClr, (std::min)(30, 2 * (iOwnDens - iCompareDens)));
@@ -2603,6 +2720,21 @@ bool C4Landscape::ApplyLighting(C4Rect To)
 
 			Surface32->SetPixDw(iX, iY, dwBackClr);
 		}
+
+		if (ShadeMaterials && iY + 1 < To.y + To.Hgt)
+		{
+			// advance the sliding sums by one row; the row leaving the range at the top shares its slot with the new bottom row
+			const int32_t *const enterAbove = placementRow(iY) + 1;
+			const int32_t *const leaveAbove = placementRow(iY - C4LS_MaxLightDistY) + 1;
+			const int32_t *const leaveBelow = placementRow(iY + 1) + 1;
+			for (int32_t x = 0; x < To.Wdt; ++x)
+				aboveDensity[x] += enterAbove[x] - leaveAbove[x];
+
+			GetPlacementRow(iY + C4LS_MaxLightDistY + 1, To.x - 1, stride, placementRow(iY + C4LS_MaxLightDistY + 1));
+			const int32_t *const enterBelow = placementRow(iY + C4LS_MaxLightDistY + 1) + 1;
+			for (int32_t x = 0; x < To.Wdt; ++x)
+				belowDensity[x] += enterBelow[x] - leaveBelow[x];
+		}
 	}
 	Surface32->Unlock();
 
@@ -2617,11 +2749,12 @@ bool C4Landscape::UpdateAnimationSurface(C4Rect To)
 
 	AnimationSurface->ClearBoxDw(To.x, To.y, To.Wdt, To.Hgt);
 
-	for (int32_t iX = To.x; iX < To.x + To.Wdt; ++iX)
+	for (int32_t iY = To.y; iY < To.y + To.Hgt; ++iY)
 	{
-		for (int32_t iY = To.y; iY < To.y + To.Hgt; ++iY)
+		const uint8_t *const pixRow = Surface8->Bits + iY * Surface8->Pitch;
+		for (int32_t iX = To.x; iX < To.x + To.Wdt; ++iX)
 		{
-			AnimationSurface->SetPixDw(iX, iY, DensityLiquid(Pix2Dens[_GetPix(iX, iY)]) ? 255 << 24 : 0);
+			AnimationSurface->SetPixDw(iX, iY, DensityLiquid(Pix2Dens[pixRow[iX]]) ? 255 << 24 : 0);
 		}
 	}
 
@@ -2835,7 +2968,24 @@ void C4Landscape::UpdatePixMaps()
 	for (i = 0; i < 256; i++) Pix2Mat[i] = PixCol2Mat(i);
 	for (i = 0; i < 256; i++) Pix2Dens[i] = MatDensity(Pix2Mat[i]);
 	for (i = 0; i < 256; i++) Pix2Place[i] = MatValid(Pix2Mat[i]) ? Game.Material.Map[Pix2Mat[i]].Placement : 0;
+	for (i = 0; i < 256; i++) Pix2TempConv[i] = MatValid(Pix2Mat[i]) && MatTempConvertible(Pix2Mat[i]);
 	Pix2Place[0] = 0;
+	Pix2TempConv[0] = false;
+	// pixel materials may have changed: recount convertible pixels
+	if (TempConvCnt)
+	{
+		const int32_t PixCntWidth = (Width + 16) / 17;
+		std::fill_n(TempConvCnt, PixCntWidth * PixCntPitch, 0);
+		for (int32_t y = 0; y < Height; ++y)
+			for (int32_t x = 0; x < Width; ++x)
+				if (Pix2TempConv[_GetPix(x, y)])
+					TempConvCnt[(y / 15) + (x / 17) * PixCntPitch]++;
+	}
+}
+
+bool C4Landscape::MatTempConvertible(const int32_t mat)
+{
+	return Game.Material.Map[mat].BelowTempConvertTo || Game.Material.Map[mat].AboveTempConvertTo;
 }
 
 bool C4Landscape::Mat2Pal()
@@ -2871,14 +3021,28 @@ void C4Landscape::PrepareChange(C4Rect BoundingBox, const bool updateMatCnt)
 	{
 		pSolid->RemoveTemporary(SolidMaskRect);
 	}
-	if (updateMatCnt) UpdateMatCnt(BoundingBox, false);
+	// remember the pixels before the change, so FinishChange only has to recount the columns that actually changed
+	if (updateMatCnt)
+	{
+		assert(!ChangeRect.Wdt);
+		ChangeRect = BoundingBox;
+		ChangeRect.Intersect(C4Rect(0, 0, Width, Height));
+		if (ChangeRect.Wdt <= 0 || ChangeRect.Hgt <= 0)
+		{
+			ChangeRect.Default();
+			return;
+		}
+		ChangeSnapshot.resize(ChangeRect.Wdt * ChangeRect.Hgt);
+		for (int32_t y = 0; y < ChangeRect.Hgt; ++y)
+			std::copy_n(Surface8->Bits + (ChangeRect.y + y) * Surface8->Pitch + ChangeRect.x, ChangeRect.Wdt, ChangeSnapshot.data() + y * ChangeRect.Wdt);
+	}
 }
 
 void C4Landscape::FinishChange(C4Rect BoundingBox, const bool updateMatAndPixCnt)
 {
 	// relight
 	Relight(BoundingBox);
-	if (updateMatAndPixCnt) UpdateMatCnt(BoundingBox, true);
+	if (updateMatAndPixCnt) UpdateChangedCnt();
 	// Restore Solidmasks
 	C4Rect SolidMaskRect = BoundingBox;
 	SolidMaskRect.x -= 2 * C4LS_MaxLightDistX; SolidMaskRect.y -= 2 * C4LS_MaxLightDistY;
@@ -2887,95 +3051,151 @@ void C4Landscape::FinishChange(C4Rect BoundingBox, const bool updateMatAndPixCnt
 	{
 		pSolid->Repair(SolidMaskRect);
 	}
-	if (updateMatAndPixCnt) UpdatePixCnt(BoundingBox);
 	C4SolidMask::CheckConsistency();
 }
 
 void C4Landscape::UpdatePixCnt(const C4Rect &Rect, bool fCheck)
 {
-	int32_t PixCntWidth = (Width + 16) / 17;
-	for (int32_t y = std::max<int32_t>(0, Rect.y / 15); y < std::min<int32_t>(PixCntPitch, (Rect.y + Rect.Hgt + 14) / 15); y++)
-		for (int32_t x = std::max<int32_t>(0, Rect.x / 17); x < std::min<int32_t>(PixCntWidth, (Rect.x + Rect.Wdt + 16) / 17); x++)
+	const int32_t PixCntWidth = (Width + 16) / 17;
+	const int32_t iX1 = std::max<int32_t>(0, Rect.x / 17), iX2 = std::min<int32_t>(PixCntWidth, (Rect.x + Rect.Wdt + 16) / 17);
+	const int32_t iY1 = std::max<int32_t>(0, Rect.y / 15), iY2 = std::min<int32_t>(PixCntPitch, (Rect.y + Rect.Hgt + 14) / 15);
+	if (iX1 >= iX2) return;
+	// count a whole row of cells at once, reading the landscape row by row
+	std::vector<int32_t> counts(iX2 - iX1), tempConvCounts(iX2 - iX1);
+	for (int32_t y = iY1; y < iY2; y++)
+	{
+		std::fill(counts.begin(), counts.end(), 0);
+		std::fill(tempConvCounts.begin(), tempConvCounts.end(), 0);
+		for (int32_t y2 = y * 15; y2 < std::min<int32_t>(y * 15 + 15, Height); y2++)
+		{
+			const uint8_t *const pixRow = Surface8->Bits + y2 * Surface8->Pitch;
+			for (int32_t x = iX1; x < iX2; x++)
+			{
+				int32_t iCnt = 0, iTempConvCnt = 0;
+				for (int32_t x2 = x * 17; x2 < std::min<int32_t>(x * 17 + 17, Width); x2++)
+				{
+					iCnt += Pix2Dens[pixRow[x2]] != 0;
+					iTempConvCnt += Pix2TempConv[pixRow[x2]];
+				}
+				counts[x - iX1] += iCnt;
+				tempConvCounts[x - iX1] += iTempConvCnt;
+			}
+		}
+		for (int32_t x = iX1; x < iX2; x++)
 		{
-			int iCnt = 0;
-			for (int32_t x2 = x * 17; x2 < std::min<int32_t>(x * 17 + 17, Width); x2++)
-				for (int32_t y2 = y * 15; y2 < std::min<int32_t>(y * 15 + 15, Height); y2++)
-					if (_GetDensity(x2, y2))
-						iCnt++;
 			if (fCheck)
-				assert(iCnt == PixCnt[x * PixCntPitch + y]);
-			PixCnt[x * PixCntPitch + y] = iCnt;
+			{
+				assert(counts[x - iX1] == PixCnt[x * PixCntPitch + y]);
+				assert(tempConvCounts[x - iX1] == TempConvCnt[x * PixCntPitch + y]);
+			}
+			PixCnt[x * PixCntPitch + y] = counts[x - iX1];
+			TempConvCnt[x * PixCntPitch + y] = tempConvCounts[x - iX1];
 		}
+	}
 }
 
 void C4Landscape::UpdateMatCnt(C4Rect Rect, bool fPlus)
 {
 	Rect.Intersect(C4Rect(0, 0, Width, Height));
 	if (!Rect.Hgt || !Rect.Wdt) return;
-	// Multiplicator for changes
-	const int32_t iMul = fPlus ? +1 : -1;
 	// Count pixels
 	for (int32_t x = 0; x < Rect.Wdt; x++)
+		UpdateMatCntColumn(Rect, x, Surface8->Bits + Rect.y * Surface8->Pitch + Rect.x + x, Surface8->Pitch, fPlus ? +1 : -1);
+}
+
+void C4Landscape::UpdateChangedCnt()
+{
+	const C4Rect Rect = ChangeRect;
+	ChangeRect.Default();
+	if (!Rect.Wdt || !Rect.Hgt) return;
+	// find changed columns; compare the whole rect row by row
+	std::vector<uint8_t> changed(Rect.Wdt, 0);
+	for (int32_t y = 0; y < Rect.Hgt; ++y)
 	{
-		int iHgt = 0;
-		int32_t y;
-		for (y = 1; y < Rect.Hgt; y++)
+		const uint8_t *const before = ChangeSnapshot.data() + y * Rect.Wdt;
+		const uint8_t *const after = Surface8->Bits + (Rect.y + y) * Surface8->Pitch + Rect.x;
+		for (int32_t x = 0; x < Rect.Wdt; ++x)
 		{
-			int32_t iMat = _GetMat(Rect.x + x, Rect.y + y - 1);
-			// Same material? Count it.
-			if (iMat == _GetMat(Rect.x + x, Rect.y + y))
-				iHgt++;
-			else
+			if (before[x] == after[x]) continue;
+			changed[x] = 1;
+			// the change was drawn to the surface directly, so the pixel counts only miss the difference of the changed pixels
+			// (solid masks are removed and repaired through _SetPix, which counts on its own)
+			const int32_t iCell = (Rect.y + y) / 15 + (Rect.x + x) / 17 * PixCntPitch;
+			PixCnt[iCell] += (Pix2Dens[after[x]] != 0) - (Pix2Dens[before[x]] != 0);
+			TempConvCnt[iCell] += Pix2TempConv[after[x]] - Pix2TempConv[before[x]];
+		}
+	}
+	// Counts of a column only depend on the column's pixels, and pixels outside the rect didn't change.
+	// So unchanged columns would be subtracted and added again with the same values and can be skipped.
+	for (int32_t x = 0; x < Rect.Wdt; x++)
+	{
+		if (!changed[x]) continue;
+		UpdateMatCntColumn(Rect, x, ChangeSnapshot.data() + x, Rect.Wdt, -1);
+		UpdateMatCntColumn(Rect, x, Surface8->Bits + Rect.y * Surface8->Pitch + Rect.x + x, Surface8->Pitch, +1);
+	}
+}
+
+void C4Landscape::UpdateMatCntColumn(const C4Rect &Rect, const int32_t x, const uint8_t *const pix, const int32_t pitch, const int32_t iMul)
+{
+	int iHgt = 0;
+	int32_t y;
+	int32_t iMat = Pix2Mat[pix[0]];
+	for (y = 1; y < Rect.Hgt; y++)
+	{
+		const int32_t iNextMat = Pix2Mat[pix[y * pitch]];
+		// Same material? Count it.
+		if (iMat == iNextMat)
+			iHgt++;
+		else
+		{
+			if (iMat >= 0)
 			{
-				if (iMat >= 0)
+				// Normal material counting
+				MatCount[iMat] += iMul * (iHgt + 1);
+				// Effective material counting enabled?
+				if (int32_t iMinHgt = Game.Material.Map[iMat].MinHeightCount)
 				{
-					// Normal material counting
-					MatCount[iMat] += iMul * (iHgt + 1);
-					// Effective material counting enabled?
-					if (int32_t iMinHgt = Game.Material.Map[iMat].MinHeightCount)
+					// First chunk? Add any material above when checking chunk height
+					int iAddedHeight = 0;
+					if (Rect.y && iHgt + 1 == y)
+						iAddedHeight = GetMatHeight(Rect.x + x, Rect.y - 1, -1, iMat, iMinHgt);
+					// Check the chunk height
+					if (iHgt + 1 + iAddedHeight >= iMinHgt)
 					{
-						// First chunk? Add any material above when checking chunk height
-						int iAddedHeight = 0;
-						if (Rect.y && iHgt + 1 == y)
-							iAddedHeight = GetMatHeight(Rect.x + x, Rect.y - 1, -1, iMat, iMinHgt);
-						// Check the chunk height
-						if (iHgt + 1 + iAddedHeight >= iMinHgt)
-						{
-							EffectiveMatCount[iMat] += iMul * (iHgt + 1);
-							if (iAddedHeight < iMinHgt)
-								EffectiveMatCount[iMat] += iMul * iAddedHeight;
-						}
+						EffectiveMatCount[iMat] += iMul * (iHgt + 1);
+						if (iAddedHeight < iMinHgt)
+							EffectiveMatCount[iMat] += iMul * iAddedHeight;
 					}
 				}
-				// Next chunk of material
-				iHgt = 0;
 			}
+			// Next chunk of material
+			iHgt = 0;
 		}
-		// Check last pixel
-		int32_t iMat = _GetMat(Rect.x + x, Rect.y + Rect.Hgt - 1);
-		if (iMat >= 0)
+		iMat = iNextMat;
+	}
+	// Check last pixel
+	if (iMat >= 0)
+	{
+		// Normal material counting
+		MatCount[iMat] += iMul * (iHgt + 1);
+		// Minimum height counting?
+		if (int32_t iMinHgt = Game.Material.Map[iMat].MinHeightCount)
 		{
-			// Normal material counting
-			MatCount[iMat] += iMul * (iHgt + 1);
-			// Minimum height counting?
-			if (int32_t iMinHgt = Game.Material.Map[iMat].MinHeightCount)
+			int iAddedHeight1 = 0, iAddedHeight2 = 0;
+			// Add any material above for chunk size check
+			if (Rect.y && iHgt + 1 == Rect.Hgt)
+				iAddedHeight1 = GetMatHeight(Rect.x + x, Rect.y - 1, -1, iMat, iMinHgt);
+			// Add any material below for chunk size check
+			if (Rect.y + y < Height)
+				iAddedHeight2 = GetMatHeight(Rect.x + x, Rect.y + Rect.Hgt, 1, iMat, iMinHgt);
+			// Chunk tall enough?
+			if (iHgt + 1 + iAddedHeight1 + iAddedHeight2 >= Game.Material.Map[iMat].MinHeightCount)
 			{
-				int iAddedHeight1 = 0, iAddedHeight2 = 0;
-				// Add any material above for chunk size check
-				if (Rect.y && iHgt + 1 == Rect.Hgt)
-					iAddedHeight1 = GetMatHeight(Rect.x + x, Rect.y - 1, -1, iMat, iMinHgt);
-				// Add any material below for chunk size check
-				if (Rect.y + y < Height)
-					iAddedHeight2 = GetMatHeight(Rect.x + x, Rect.y + Rect.Hgt, 1, iMat, iMinHgt);
-				// Chunk tall enough?
-				if (iHgt + 1 + iAddedHeight1 + iAddedHeight2 >= Game.Material.Map[iMat].MinHeightCount)
-				{
-					EffectiveMatCount[iMat] += iMul * (iHgt + 1);
-					if (iAddedHeight1 < iMinHgt)
-						EffectiveMatCount[iMat] += iMul * iAddedHeight1;
-					if (iAddedHeight2 < iMinHgt)
-						EffectiveMatCount[iMat] += iMul * iAddedHeight2;
-				}
+				EffectiveMatCount[iMat] += iMul * (iHgt + 1);
+				if (iAddedHeight1 < iMinHgt)
+					EffectiveMatCount[iMat] += iMul * iAddedHeight1;
+				if (iAddedHeight2 < iMinHgt)
+					EffectiveMatCount[iMat] += iMul * iAddedHeight2;
 			}
 		}
 	}
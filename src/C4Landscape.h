@@ -25,6 +25,7 @@
 #include <StdSurface8.h>
 
 #include <cstdint>
+#include <vector>
 
 const uint8_t GBM        = 128,
               GBM_ColNum = 64,
@@ -41,6 +42,7 @@ const int32_t C4LSC_Undefined = 0,
               C4LSC_Exact = 3;
 
 const int32_t C4LS_MaxRelights = 50;
+const int32_t C4LS_MaxRelightArea = 512 * 512; // pixels relit per drawn frame at most, over all viewports; remaining regions are continued in the next frame
 
 class C4MapCreatorS2;
 class C4Object;
@@ -71,15 +73,22 @@ public:
 	C4MapCreatorS2 *pMapCreator; // map creator for script-generated maps
 	bool fMapChanged;
 	uint8_t *pInitial; // Initial landscape after creation - used for diff
+	int32_t RelitPixels; // NoSave // pixels relit in the current frame so far
+	int32_t LastFrameRelitPixels; // NoSave // pixels relit in the previous frame
+	int32_t RelightAllowance; // NoSave // pixels that may still be relit in the current frame
 
 protected:
 	C4Surface *Surface32;
 	C4Surface *AnimationSurface;
 	CSurface8 *Surface8;
 	int32_t Pix2Mat[256], Pix2Dens[256], Pix2Place[256];
+	bool Pix2TempConv[256]; // whether the pixel's material has any temperature conversion
 	int32_t PixCntPitch;
 	uint8_t *PixCnt;
-	C4Rect Relights[C4LS_MaxRelights];
+	uint8_t *TempConvCnt; // pixels of temperature convertible material per PixCnt cell; lets ExecuteScan skip cells
+	C4RectList Relights; // pending relight regions
+	C4Rect ChangeRect; // rect between PrepareChange and FinishChange
+	std::vector<uint8_t> ChangeSnapshot; // pixels of ChangeRect before the change
 
 public:
 	void Default();
@@ -87,6 +96,7 @@ public:
 	void Execute();
 	void Synchronize();
 	void Draw(C4FacetEx &cgo, int32_t iPlayer = -1);
+	void StartDrawFrame(); // renew the relight allowance before the viewports of a frame are drawn
 	void ScenarioInit();
 	void ClearRect(int32_t iTx, int32_t iTy, int32_t iWdt, int32_t iHgt);
 	void ClearRectDensity(int32_t iTx, int32_t iTy, int32_t iWdt, int32_t iHgt, int32_t iOfDensity);
@@ -186,7 +196,13 @@ public:
 	}
 
 	inline int32_t GetPixMat(uint8_t byPix) { return Pix2Mat[byPix]; }
-	bool _PathFree(int32_t x, int32_t y, int32_t x2, int32_t y2); // quickly checks wether there *might* be pixel in the path.
+	inline bool _PathFree(int32_t x, int32_t y, int32_t x2, int32_t y2) // quickly checks wether there *might* be pixel in the path.
+	{
+		x /= 17; y /= 15; x2 /= 17; y2 /= 15;
+		// common case: start and end in the same cell
+		if (x == x2 && y == y2) return !PixCnt[x * PixCntPitch + y];
+		return _PathFreeCells(x, y, x2, y2);
+	}
 	int32_t GetMatHeight(int32_t x, int32_t y, int32_t iYDir, int32_t iMat, int32_t iMax);
 	int32_t DigFreePix(int32_t tx, int32_t ty);
 	int32_t ShakeFreePix(int32_t tx, int32_t ty);
@@ -209,7 +225,7 @@ public:
 	void SetMapChanged() { fMapChanged = true; }
 	void HandleTexMapUpdate();
 	void UpdatePixMaps();
-	bool DoRelights();
+	bool DoRelights(bool all = false); // relight pending regions within the allowance of the current frame unless all is set
 	void RemoveUnusedTexMapEntries();
 
 protected:
@@ -227,8 +243,10 @@ protected:
 	bool SkyToLandscape(int32_t iToX, int32_t iToY, int32_t iToWdt, int32_t iToHgt, int32_t iOffX, int32_t iOffY);
 	CSurface8 *CreateMap(); // create map by landscape attributes
 	CSurface8 *CreateMapS2(C4Group &ScenFile); // create map by def file
+	void AddRelight(C4Rect rect); // add region to pending relights, merging it with overlapping ones
 	bool Relight(C4Rect To);
 	bool ApplyLighting(C4Rect To);
+	void GetPlacementRow(int32_t y, int32_t x, int32_t wdt, int32_t *out); // get material placement of wdt pixels starting at x (bounds checked)
 	bool UpdateAnimationSurface(C4Rect To);
 	uint32_t GetClrByTex(int32_t iX, int32_t iY);
 	bool Mat2Pal(); // assign material colors to landscape palette
@@ -240,7 +258,11 @@ protected:
 	}
 
 	void UpdatePixCnt(const class C4Rect &Rect, bool fCheck = false);
+	bool _PathFreeCells(int32_t x, int32_t y, int32_t x2, int32_t y2); // _PathFree in PixCnt cell coordinates
+	bool MatTempConvertible(int32_t mat); // whether the material has any temperature conversion
 	void UpdateMatCnt(C4Rect Rect, bool fPlus);
+	void UpdateChangedCnt(); // update pixel counts and material counts of columns for the pixels changed since PrepareChange
+	void UpdateMatCntColumn(const C4Rect &Rect, int32_t x, const uint8_t *pix, int32_t pitch, int32_t iMul); // count column x of Rect from pixels pix with given pitch
 	void PrepareChange(C4Rect BoundingBox, bool updateMatCnt = true);
 	void FinishChange(C4Rect BoundingBox, bool updateMatAndPixCnt = true);
 	static bool DrawLineLandscape(int32_t iX, int32_t iY, int32_t iGrade);
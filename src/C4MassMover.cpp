@@ -24,6 +24,8 @@
 #include <C4Game.h>
 #include <C4Wrappers.h>
 
+#include <algorithm>
+
 // Note: creation optimized using advancing CreatePtr, so sequential
 // creation does not keep rescanning the complete set for a free
 // slot. (This had caused extreme delays.) This had the effect that
@@ -45,47 +47,85 @@ C4MassMoverSet::~C4MassMoverSet()
 	Clear();
 }
 
-void C4MassMoverSet::Clear() {}
+void C4MassMoverSet::Clear()
+{
+	Blocks.clear();
+	Active.clear();
+}
+
+void C4MassMoverSet::AddBlock()
+{
+	auto block = std::make_unique<C4MassMover[]>(C4MassMoverChunk);
+	for (int32_t cnt = 0; cnt < C4MassMoverChunk; cnt++) block[cnt].Mat = MNone;
+	Blocks.push_back(std::move(block));
+}
 
 void C4MassMoverSet::Execute()
 {
-	C4MassMover *cmm;
 	// Init counts
 	Count = 0;
 	// Execute & count
 	for (int32_t speed = 2; speed > 0; speed--)
 	{
-		cmm = &(Set[C4MassMoverChunk - 1]);
-		for (int32_t cnt = 0; cnt < C4MassMoverChunk; cnt++, cmm--)
-			if (cmm->Mat != MNone)
+		// Descending slot order; movers created below the current slot are executed in this pass as well
+		for (ExecPos = static_cast<int32_t>(Active.size()) - 1; ExecPos >= 0; ExecPos--)
+		{
+			C4MassMover &cmm = GetMover(Active[ExecPos]);
+			if (cmm.Mat != MNone)
 			{
-				Count++; cmm->Execute();
+				Count++; cmm.Execute();
 			}
+		}
+		Compact();
 	}
 }
 
 bool C4MassMoverSet::Create(int32_t x, int32_t y, bool fExecute)
 {
-	if (Count == C4MassMoverChunk) return false;
 #ifdef DEBUGREC
 	C4RCMassMover rc;
 	rc.x = x; rc.y = y;
 	AddDbgRec(RCT_MMC, &rc, sizeof(rc));
 #endif
-	int32_t cptr = CreatePtr;
-	do
+	if (Blocks.empty()) AddBlock();
+	// Find first free slot after CreatePtr, wrapping around at the end of the set
+	const int32_t capacity = GetCapacity();
+	int32_t cptr = CreatePtr + 1;
+	if (cptr >= capacity) cptr = 0;
+	auto it = std::lower_bound(Active.begin(), Active.end(), cptr);
+	bool fFound = false;
+	for (int32_t cnt = 0; cnt < capacity; cnt++)
 	{
-		cptr++;
-		if (cptr >= C4MassMoverChunk) cptr = 0;
-		if (Set[cptr].Mat == MNone)
+		// unused or ceased slot?
+		if (it == Active.end() || *it != cptr || GetMover(cptr).Mat == MNone)
 		{
-			if (!Set[cptr].Init(x, y)) return false;
-			CreatePtr = cptr;
-			if (fExecute) Set[cptr].Execute();
-			return true;
+			fFound = true;
+			break;
 		}
-	} while (cptr != CreatePtr);
-	return false;
+		++it;
+		if (++cptr >= capacity)
+		{
+			cptr = 0; it = Active.begin();
+		}
+	}
+	// Set full: grow
+	if (!fFound)
+	{
+		AddBlock();
+		cptr = capacity; it = Active.end();
+	}
+	C4MassMover &cmm = GetMover(cptr);
+	if (!cmm.Init(x, y)) return false;
+	// Ceased slots are still listed
+	if (it == Active.end() || *it != cptr)
+	{
+		// keep position of the currently executed mover
+		if (it - Active.begin() <= ExecPos) ExecPos++;
+		Active.insert(it, cptr);
+	}
+	CreatePtr = cptr;
+	if (fExecute) cmm.Execute();
+	return true;
 }
 
 bool C4MassMover::Init(int32_t tx, int32_t ty)
@@ -172,22 +212,19 @@ bool C4MassMover::Corrosion(int32_t dx, int32_t dy)
 
 void C4MassMoverSet::Default()
 {
-	int32_t cnt;
-	for (cnt = 0; cnt < C4MassMoverChunk; cnt++) Set[cnt].Mat = MNone;
+	Blocks.clear();
+	Active.clear();
+	ExecPos = -1;
 	Count = 0;
 	CreatePtr = 0;
 }
 
 bool C4MassMoverSet::Save(C4Group &hGroup)
 {
-	int32_t cnt;
 	// Consolidate
 	Consolidate();
 	// Recount
-	Count = 0;
-	for (cnt = 0; cnt < C4MassMoverChunk; cnt++)
-		if (Set[cnt].Mat != MNone)
-			Count++;
+	Count = static_cast<int32_t>(Active.size());
 	// All empty: delete component
 	if (!Count)
 	{
@@ -195,7 +232,11 @@ bool C4MassMoverSet::Save(C4Group &hGroup)
 		return true;
 	}
 	// Save set
-	if (!hGroup.Add(C4CFN_MassMover, Set, Count * sizeof(C4MassMover)))
+	StdBuf buf;
+	buf.New(Count * sizeof(C4MassMover));
+	for (int32_t cnt = 0; cnt < Count; cnt += C4MassMoverChunk)
+		buf.Write(Blocks[cnt / C4MassMoverChunk].get(), std::min(Count - cnt, C4MassMoverChunk) * sizeof(C4MassMover), cnt * sizeof(C4MassMover));
+	if (!hGroup.Add(C4CFN_MassMover, buf, false, true))
 		return false;
 	// Success
 	return true;
@@ -212,36 +253,36 @@ bool C4MassMoverSet::Load(C4Group &hGroup)
 
 	// load new
 	Count = iBinSize / iMoverSize;
-	if (!hGroup.Read(Set, iBinSize)) return false;
+	while (GetCapacity() < Count) AddBlock();
+	for (int32_t cnt = 0; cnt < Count; cnt += C4MassMoverChunk)
+		if (!hGroup.Read(Blocks[cnt / C4MassMoverChunk].get(), std::min(Count - cnt, C4MassMoverChunk) * iMoverSize)) return false;
+	for (int32_t cnt = 0; cnt < Count; cnt++)
+		if (GetMover(cnt).Mat != MNone)
+			Active.push_back(cnt);
 	return true;
 }
 
+void C4MassMoverSet::Compact()
+{
+	// Remove ceased movers from active list
+	Active.erase(std::remove_if(Active.begin(), Active.end(), [this](const int32_t slot) { return GetMover(slot).Mat == MNone; }), Active.end());
+}
+
 void C4MassMoverSet::Consolidate()
 {
-	// Consolidate set
-	int32_t iSpot, iPtr, iConsolidated;
-	for (iSpot = -1, iPtr = 0, iConsolidated = 0; iPtr < C4MassMoverChunk; iPtr++)
-	{
-		// Empty: set new spot if needed
-		if (Set[iPtr].Mat == MNone)
-		{
-			if (iSpot == -1) iSpot = iPtr;
-		}
-		// Full: move down to empty spot if possible
-		else if (iSpot != -1)
+	Compact();
+	// Move movers down to the lowest slots, keeping their order
+	const auto size = static_cast<int32_t>(Active.size());
+	for (int32_t iPtr = 0; iPtr < size; iPtr++)
+		if (Active[iPtr] != iPtr)
 		{
-			// Move to spot
-			Set[iSpot] = Set[iPtr];
-			Set[iPtr].Mat = MNone;
-			iConsolidated++;
-			// Advance empty spot (as far as ptr)
-			for (; iSpot < iPtr; iSpot++)
-				if (Set[iSpot].Mat == MNone)
-					break;
-			// No empty spot below ptr
-			if (iSpot == iPtr) iSpot = -1;
+			GetMover(iPtr) = GetMover(Active[iPtr]);
+			GetMover(Active[iPtr]).Mat = MNone;
+			Active[iPtr] = iPtr;
 		}
-	}
+	// Release unused blocks
+	const size_t iBlocks = std::max<size_t>((size + C4MassMoverChunk - 1) / C4MassMoverChunk, 1);
+	while (Blocks.size() > iBlocks) Blocks.pop_back();
 	// Reset create ptr
 	CreatePtr = 0;
 }
@@ -256,5 +297,11 @@ void C4MassMoverSet::Copy(C4MassMoverSet &rSet)
 	Clear();
 	Count = rSet.Count;
 	CreatePtr = rSet.CreatePtr;
-	for (int32_t cnt = 0; cnt < C4MassMoverChunk; cnt++) Set[cnt] = rSet.Set[cnt];
+	ExecPos = -1;
+	for (const auto &block : rSet.Blocks)
+	{
+		AddBlock();
+		std::copy_n(block.get(), C4MassMoverChunk, Blocks.back().get());
+	}
+	Active = rSet.Active;
 }
@@ -21,8 +21,10 @@
 #include "C4ForwardDeclarations.h"
 
 #include <cstdint>
+#include <memory>
+#include <vector>
 
-const int32_t C4MassMoverChunk = 10000;
+const int32_t C4MassMoverChunk = 10000; // slots are allocated in blocks of this size
 
 class C4MassMoverSet;
 
@@ -51,7 +53,9 @@ public:
 	int32_t CreatePtr;
 
 protected:
-	C4MassMover Set[C4MassMoverChunk];
+	std::vector<std::unique_ptr<C4MassMover[]>> Blocks; // mover slots; blocks are never moved, so movers may create movers while executing
+	std::vector<int32_t> Active; // ascending indices of used slots; may contain ceased movers until the next Compact()
+	int32_t ExecPos; // position in Active currently being executed; -1 if not executing
 
 public:
 	void Copy(C4MassMoverSet &rSet);
@@ -65,4 +69,8 @@ public:
 
 protected:
 	void Consolidate();
+	void Compact();
+	void AddBlock();
+	int32_t GetCapacity() const { return static_cast<int32_t>(Blocks.size()) * C4MassMoverChunk; }
+	C4MassMover &GetMover(int32_t slot) { return Blocks[slot / C4MassMoverChunk][slot % C4MassMoverChunk]; }
 };
@@ -459,6 +459,7 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 		LogNTr("/set faircrew [on/off] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_ENABLEORDISABLEFAIRCREW));
 		LogNTr("/set maxplayer [4] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_SETANEWMAXIMUMNUMBEROFPLA));
 		LogNTr("/script [script] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_EXECUTEASCRIPTCOMMAND));
+		LogNTr("/profile [id] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_STARTORSTOPTHESCRIPTPROFI));
 		LogNTr("/clear - {}", LoadResStr(C4ResStrTableKey::IDS_MSG_CLEARTHEMESSAGEBOARD));
 		return true;
 	}
@@ -472,6 +473,26 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 		Game.Control.DoInput(CID_Script, new C4ControlScript(pCmdPar, C4ControlScript::SCOPE_Console, Config.Developer.ConsoleScriptStrictness), CDT_Decide);
 		return true;
 	}
+	// script profiler: local only, so it does not need debug mode
+	if (SEqual(szCmdName, "profile"))
+	{
+		if (!Game.IsRunning) return false;
+		if (C4AulProfiler::IsProfiling())
+		{
+			C4AulProfiler::StopProfiling();
+			return true;
+		}
+		// profile a definition or everything
+		C4AulScript *pScript = &Game.ScriptEngine;
+		if (*pCmdPar)
+		{
+			C4Def *pDef = Game.Defs.ID2Def(C4Id(pCmdPar));
+			if (!pDef) return false;
+			pScript = &pDef->Script;
+		}
+		C4AulProfiler::StartProfiling(pScript);
+		return true;
+	}
 	// set runtimte properties
 	if (SEqual(szCmdName, "set"))
 	{
@@ -198,6 +198,7 @@ C4Network2::C4Network2()
 	: Clients(&NetIO),
 	fAllowJoin(false),
 	iDynamicTick(-1), fDynamicNeeded(false),
+	iPendingDynamicTick(-1), iDynamicSerial(0),
 	fStatusAck(false), fStatusReached(false),
 	fChasing(false),
 	pLobby(nullptr), fLobbyRunning(false), pLobbyCountdown(nullptr),
@@ -745,6 +746,10 @@ void C4Network2::Execute()
 
 void C4Network2::Clear()
 {
+	// a dynamic being written must not be added to the cleared ressource list
+	DynamicWriter.Wait();
+	++iDynamicSerial;
+	iPendingDynamicTick = -1;
 	// stop timer
 	if (pSec1Timer) pSec1Timer->Release(); pSec1Timer = nullptr;
 	// stop streaming
@@ -1101,21 +1106,26 @@ void C4Network2::OnGameSynchronized()
 	// savegame needed?
 	if (fDynamicNeeded)
 	{
-		// create dynamic
-		bool fSuccess = CreateDynamic(false);
-		// check for clients that still need join-data
-		C4Network2Client *pClient = nullptr;
-		while (pClient = Clients.GetNextClient(pClient))
-			if (!pClient->hasJoinData())
-				if (fSuccess)
-					// now we can provide join data: send it
-					SendJoinData(pClient);
-				else
-					// join data could not be created: emergency kick
-					Game.Clients.CtrlRemove(pClient->getClient(), LoadResStr(C4ResStrTableKey::IDS_ERR_ERRORWHILECREATINGJOINDAT));
+		// create dynamic; join data is provided as soon as it is written
+		if (!CreateDynamic(false))
+			ProvideJoinData(false);
 	}
 }
 
+void C4Network2::ProvideJoinData(bool fDynamicCreated)
+{
+	// check for clients that still need join-data
+	C4Network2Client *pClient = nullptr;
+	while (pClient = Clients.GetNextClient(pClient))
+		if (!pClient->hasJoinData())
+			if (fDynamicCreated)
+				// now we can provide join data: send it
+				SendJoinDataPacket(pClient);
+			else
+				// join data could not be created: emergency kick
+				Game.Clients.CtrlRemove(pClient->getClient(), LoadResStr(C4ResStrTableKey::IDS_ERR_ERRORWHILECREATINGJOINDAT));
+}
+
 void C4Network2::DrawStatus(C4FacetEx &cgo)
 {
 	if (!isEnabled()) return;
@@ -1822,6 +1832,8 @@ void C4Network2::SendJoinData(C4Network2Client *pClient)
 	if (pClient->hasJoinData()) return;
 	// host only, scenario must be available
 	assert(isHost());
+	// dynamic being written? join data will be sent afterwards
+	if (iPendingDynamicTick >= 0) return;
 	// dynamic available?
 	if (ResDynamic.isNull() || iDynamicTick < Game.Control.ControlTick)
 	{
@@ -1830,6 +1842,11 @@ void C4Network2::SendJoinData(C4Network2Client *pClient)
 		Game.Control.DoInput(CID_Synchronize, new C4ControlSynchronize(false, true), CDT_Sync);
 		return;
 	}
+	SendJoinDataPacket(pClient);
+}
+
+void C4Network2::SendJoinDataPacket(C4Network2Client *pClient)
+{
 	// save his client ID
 	C4PacketJoinData JoinData;
 	JoinData.SetClientID(pClient->getID());
@@ -1844,6 +1861,9 @@ void C4Network2::SendJoinData(C4Network2Client *pClient)
 	pClient->SendMsg(MkC4NetIOPacket(PID_JoinData, JoinData));
 	// send addresses
 	Clients.SendAddresses(pClient->getMsgConn());
+	// dynamic was written in the background: send the control executed since then
+	if (pControl && iDynamicTick < Game.Control.ControlTick)
+		pControl->SendCtrlSince(iDynamicTick, pClient->getMsgConn());
 	// flag client (he will have to accept the network status sent next)
 	pClient->SetStatus(NCS_Chasing);
 	if (!iLastChaseTargetUpdate) iLastChaseTargetUpdate = time(nullptr);
@@ -1945,6 +1965,8 @@ C4Network2Res::Ref C4Network2::RetrieveRes(const C4Network2ResCore &Core, int32_
 bool C4Network2::CreateDynamic(bool fInit)
 {
 	if (!isHost()) return false;
+	// the dynamic being written will serve all waiting clients
+	if (iPendingDynamicTick >= 0) return true;
 	// remove all existing dynamic data
 	RemoveDynamic();
 	// log
@@ -1955,20 +1977,64 @@ bool C4Network2::CreateDynamic(bool fInit)
 	if (!ResList.FindTempResFileName(szDynamicBase, szDynamicFilename))
 		Log(C4ResStrTableKey::IDS_NET_SAVE_ERR_CREATEDYNFILE);
 	// save dynamic data
+	const auto start = C4GameSaveWriter::Clock::now();
 	C4GameSaveNetwork SaveGame(fInit);
-	if (!SaveGame.Save(szDynamicFilename) || !SaveGame.Close())
+	if (!SaveGame.Save(szDynamicFilename))
 	{
 		Log(C4ResStrTableKey::IDS_NET_SAVE_ERR_SAVEDYNFILE); return false;
 	}
-	// add ressource
-	C4Network2Res::Ref pRes = ResList.AddByFile(szDynamicFilename, true, NRT_Dynamic);
-	if (!pRes) { Log(C4ResStrTableKey::IDS_NET_SAVE_ERR_ADDDYNDATARES); return false; }
+	const int32_t iTick = Game.Control.getNextControlTick();
+	// initial dynamic: needed before anyone can join, so write it right away
+	if (fInit)
+	{
+		if (!SaveGame.Close())
+		{
+			Log(C4ResStrTableKey::IDS_NET_SAVE_ERR_SAVEDYNFILE); return false;
+		}
+		// add ressource
+		C4Network2Res::Ref pRes = ResList.AddByFile(szDynamicFilename, true, NRT_Dynamic);
+		if (!pRes) { Log(C4ResStrTableKey::IDS_NET_SAVE_ERR_ADDDYNDATARES); return false; }
+		// save
+		ResDynamic = pRes->getCore();
+		iDynamicTick = iTick;
+		fDynamicNeeded = false;
+		// ok
+		return true;
+	}
+	const auto snapshotTime = C4GameSaveWriter::Clock::now() - start;
+	// runtime join: the game goes on while the dynamic is compressed, written and added as ressource in the background
+	const int32_t iResID = ResList.nextResID();
+	iPendingDynamicTick = iTick;
+	DynamicWriter.Start(SaveGame.TakeGroup(),
+		[this, szFilename = std::string{szDynamicFilename}, iResID] { return !!ResList.AddByFile(szFilename.c_str(), true, NRT_Dynamic, iResID); },
+		[this, iSerial = iDynamicSerial, iResID, iTick, snapshotTime](const bool fSuccess, const C4GameSaveWriter::Clock::duration writeTime)
+		{
+			// network has been cleared meanwhile?
+			if (iSerial != iDynamicSerial) return;
+			Logger->info("dynamic for tick {}: snapshot {} ms, writing {} ms", iTick, C4GameSaveWriter::ToMilliseconds(snapshotTime), C4GameSaveWriter::ToMilliseconds(writeTime));
+			OnDynamicWritten(fSuccess, iResID, iTick);
+		});
+	return true;
+}
+
+void C4Network2::OnDynamicWritten(const bool fSuccess, const int32_t iResID, const int32_t iTick)
+{
+	iPendingDynamicTick = -1;
+	if (!fSuccess)
+	{
+		Log(C4ResStrTableKey::IDS_NET_SAVE_ERR_SAVEDYNFILE); ProvideJoinData(false); return;
+	}
+	C4Network2Res::Ref pRes = ResList.getRefRes(iResID);
+	if (!pRes)
+	{
+		Log(C4ResStrTableKey::IDS_NET_SAVE_ERR_ADDDYNDATARES); ProvideJoinData(false); return;
+	}
 	// save
 	ResDynamic = pRes->getCore();
-	iDynamicTick = Game.Control.getNextControlTick();
+	iDynamicTick = iTick;
 	fDynamicNeeded = false;
-	// ok
-	return true;
+	// send to all clients that joined meanwhile
+	ProvideJoinData(true);
 }
 
 void C4Network2::RemoveDynamic()
@@ -22,6 +22,7 @@
 #include "C4Application.h"
 #include "C4Network2Client.h"
 #include "C4Network2Res.h"
+#include "C4GameSave.h"
 #include "C4Network2IO.h"
 #include "C4Network2Players.h"
 #include "C4GameParameters.h"
@@ -181,6 +182,11 @@ protected:
 	int32_t iDynamicTick;
 	bool fDynamicNeeded;
 
+	// runtime dynamics are written in the background; the waiting clients get their join data afterwards
+	C4GameSaveWriter DynamicWriter;
+	int32_t iPendingDynamicTick; // start control tick of the dynamic being written; -1 if none
+	uint32_t iDynamicSerial; // invalidates callbacks of dynamics written before the last Clear()
+
 	// game status flags
 	bool fStatusAck, fStatusReached;
 	bool fChasing;
@@ -260,6 +266,8 @@ public:
 	bool isFrozen()      const;
 
 	bool isJoinAllowed()      const { return fAllowJoin; }
+	int32_t getPendingDynamicTick() const { return iPendingDynamicTick; } // control since this tick is needed by clients waiting for join data
+	void WaitForDynamic() { DynamicWriter.Wait(); } // until a dynamic being written in the background is on disk
 
 	class C4GameLobby::MainDlg *GetLobby() const { return pLobby; } // lobby publication
 	const char *GetPassword()              const { return sPassword.getData(); } // Oh noez, now the password is public!
@@ -378,9 +386,12 @@ protected:
 	void OnClientDisconnect(C4Network2Client *pClient);
 
 	void SendJoinData(C4Network2Client *pClient);
+	void SendJoinDataPacket(C4Network2Client *pClient);
+	void ProvideJoinData(bool fDynamicCreated); // send join data to all waiting clients or kick them
 
 	// ressource list
-	bool CreateDynamic(bool fInit);
+	bool CreateDynamic(bool fInit); // the initial dynamic is written right away, runtime dynamics in the background
+	void OnDynamicWritten(bool fSuccess, int32_t iResID, int32_t iTick);
 	void RemoveDynamic();
 
 	// status changes
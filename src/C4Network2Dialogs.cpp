@@ -976,6 +976,7 @@ C4ChartDialog::C4ChartDialog() : Dialog(DialogWidth, DialogHeight, LoadResStr(C4
 	// add some graphs as subcomponents
 	AddChart(StdStrBuf("oc"));
 	AddChart(StdStrBuf("FPS"));
+	AddChart(StdStrBuf("Relight"));
 	AddChart(StdStrBuf("NetIO"));
 	if (Game.Network.isEnabled())
 		AddChart(StdStrBuf("Pings"));
@@ -300,6 +300,7 @@ C4Network2Stats::C4Network2Stats() : pSec1Timer(nullptr)
 	ControlCounter = 0;
 	// init graphs
 	statObjCount.SetTitle(LoadResStr(C4ResStrTableKey::IDS_MSG_OBJCOUNT));
+	statRelitPixels.SetTitle(LoadResStr(C4ResStrTableKey::IDS_MSG_RELITPIXELS));
 	statFPS.SetTitle(LoadResStr(C4ResStrTableKey::IDS_MSG_FPS));
 	statNetI.SetTitle(LoadResStr(C4ResStrTableKey::IDS_NET_INPUT));
 	statNetI.SetColorDw(0x00ff00);
@@ -326,6 +327,7 @@ C4Network2Stats::~C4Network2Stats()
 void C4Network2Stats::ExecuteFrame()
 {
 	statObjCount.RecordValue(C4Graph::ValueType(Game.Objects.ObjectCount()));
+	statRelitPixels.RecordValue(C4Graph::ValueType(Game.Landscape.LastFrameRelitPixels));
 }
 
 void C4Network2Stats::ExecuteSecond()
@@ -372,6 +374,7 @@ C4Graph *C4Network2Stats::GetGraphByName(const StdStrBuf &rszName, bool &rfIsTem
 	// compare against default graph names
 	rfIsTemp = false;
 	if (SEqualNoCase(rszName.getData(), "oc")) return &statObjCount;
+	if (SEqualNoCase(rszName.getData(), "relight")) return &statRelitPixels;
 	if (SEqualNoCase(rszName.getData(), "fps")) return &statFPS;
 	if (SEqualNoCase(rszName.getData(), "netio")) return &graphNetIO;
 	if (SEqualNoCase(rszName.getData(), "pings")) return &statPings;
@@ -171,6 +171,7 @@ private:
 
 	// per-frame stats
 	C4TableGraph statObjCount;
+	C4TableGraph statRelitPixels;
 
 	// per-second stats
 	C4TableGraph statFPS;
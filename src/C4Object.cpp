@@ -143,6 +143,7 @@ void C4Object::Default()
 	pGraphics = nullptr;
 	pDrawTransform = nullptr;
 	pEffects = nullptr;
+	EffectSchedule = {};
 	FirstRef = nullptr;
 	pGfxOverlay = nullptr;
 	iLastAttachMovementFrame = -1;
@@ -1197,6 +1198,7 @@ bool C4Object::ChangeDef(C4ID idNew)
 	Def = pDef;
 	id = pDef->id;
 	Def->Count++;
+	Game.Objects.ReindexObject(this);
 	LocalNamed.SetNameList(&pDef->Script.LocalNamed);
 	// new def: Needs to be resorted
 	Unsorted = true;
@@ -2167,7 +2169,7 @@ bool C4Object::Promote(int32_t torank, bool fForceRankName)
 void C4Object::ClearPointers(C4Object *pObj)
 {
 	// effects
-	if (pEffects) pEffects->ClearPointers(pObj);
+	if (pEffects) pEffects->ClearPointers(this, pObj);
 	// contents/contained: not necessary, because it's done in AssignRemoval and StatusDeactivate
 	// Action targets
 	if (Action.Target == pObj) Action.Target = nullptr;
@@ -2792,6 +2794,10 @@ void C4Object::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(pLayer,                                  "Layer",              C4EnumeratedObjectPtr{}));
 	pComp->Value(mkNamingAdapt(C4DefGraphicsAdapt(pGraphics),           "Graphics",           &Def->Graphics));
 	pComp->Value(mkNamingPtrAdapt(pDrawTransform,                       "DrawTransform"));
+	if (pComp->isCompiler())
+		EffectSchedule = {};
+	else
+		C4Effect::UpdateTimes(this);
 	pComp->Value(mkNamingPtrAdapt(pEffects,                             "Effects"));
 	pComp->Value(mkNamingAdapt(C4GraphicsOverlayListAdapt(pGfxOverlay), "GfxOverlay",         nullptr));
 
@@ -4064,6 +4070,14 @@ void C4Object::DrawCommand(C4Facet &cgoBar, int32_t iAlign, const char *szFuncti
 		pRegions->Add(cgoLeft.X, cgoLeft.Y, cgoLeft.Wdt * 2, cgoLeft.Hgt, cpDesc ? cpDesc : GetName(), iCom);
 }
 
+void C4Object::SetCategory(int32_t Category)
+{
+	this->Category = Category;
+	Game.Objects.ReindexObject(this);
+	Resort();
+	SetOCF();
+}
+
 void C4Object::Resort()
 {
 	// Flag resort
@@ -182,6 +182,7 @@ public:
 	std::array<int32_t, C4MaxMaterial> MaterialContents; // SyncClearance-NoSave //
 	C4DefGraphics *pGraphics; // currently set object graphics
 	C4Effect *pEffects; // linked list of effects
+	C4EffectListSchedule EffectSchedule; // timer state of pEffects
 	C4ParticleList FrontParticles, BackParticles; // lists of object local particles
 
 	bool PhysicalTemporary; // physical temporary counter
@@ -308,7 +309,7 @@ public:
 	bool SetAction(int32_t iAct, C4Object *pTarget = nullptr, C4Object *pTarget2 = nullptr, int32_t iCalls = SAC_StartCall | SAC_AbortCall, bool fForce = false);
 	bool SetActionByName(const char *szActName, C4Object *pTarget = nullptr, C4Object *pTarget2 = nullptr, int32_t iCalls = SAC_StartCall | SAC_AbortCall, bool fForce = false);
 	void SetDir(int32_t tdir);
-	void SetCategory(int32_t Category) { this->Category = Category; Resort(); SetOCF(); }
+	void SetCategory(int32_t Category);
 	int32_t GetProcedure();
 	bool Enter(C4Object *pTarget, bool fCalls = true, bool fCopyMotion = true, bool *pfRejectCollect = nullptr);
 	bool Exit(int32_t iX = 0, int32_t iY = 0, int32_t iR = 0, C4Fixed iXDir = Fix0, C4Fixed iYDir = Fix0, C4Fixed iRDir = Fix0, bool fCalls = true);
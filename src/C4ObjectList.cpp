@@ -24,6 +24,7 @@
 #include <C4Application.h>
 
 #include <format>
+#include <utility>
 
 C4ObjectList::C4ObjectList() : FirstIter(nullptr)
 {
@@ -50,6 +51,8 @@ void C4ObjectList::Clear()
 	}
 	First = Last = nullptr;
 	pEnumerated.reset();
+	UpdateNumberIndex();
+	UpdateInstanceIndex();
 }
 
 const int MaxTempListID = 500;
@@ -321,6 +324,28 @@ int C4ObjectList::ObjectCount(C4ID id, int32_t dwCategory) const
 {
 	C4ObjectLink *cLnk;
 	int iCount = 0;
+	// count via instance index if possible
+	if (pInstanceIndex && (id != C4ID_None || dwCategory != C4D_All))
+	{
+		if (id != C4ID_None)
+		{
+			C4Def *pDef = C4Id2Def(id);
+			if (!pDef) return 0;
+			const auto it = pInstanceIndex->Defs.find(pDef);
+			if (it == pInstanceIndex->Defs.end()) return 0;
+			for (C4ObjectLink *const pLnk : it->second)
+				if (pLnk->Obj->Status)
+					if ((dwCategory == C4D_All) || (pLnk->Obj->Category & dwCategory))
+						iCount++;
+			return iCount;
+		}
+		for (const auto &[iCategory, links] : pInstanceIndex->Categories)
+			if (iCategory & dwCategory)
+				for (C4ObjectLink *const pLnk : links)
+					if (pLnk->Obj->Status)
+						iCount++;
+		return iCount;
+	}
 	for (cLnk = First; cLnk; cLnk = cLnk->Next)
 		if (cLnk->Obj->Status)
 			if ((id == C4ID_None) || (cLnk->Obj->Def->id == id))
@@ -434,6 +459,9 @@ int32_t C4ObjectList::ObjectNumber(C4Object *pObj)
 {
 	C4ObjectLink *cLnk;
 	if (!pObj) return 0;
+	// indexed?
+	if (pNumberIndex)
+		return First && pNumberIndex->Objects.contains(pObj) ? pObj->Number : 0;
 	for (cLnk = First; cLnk; cLnk = cLnk->Next)
 		if (cLnk->Obj == pObj)
 			return cLnk->Obj->Number;
@@ -543,6 +571,13 @@ void C4ObjectList::CompileFunc(StdCompiler *pComp, bool fSaveRefs, bool fSkipPla
 
 C4Object *C4ObjectList::ObjectPointer(int32_t iNumber)
 {
+	// indexed? The first object of the number in list order wins
+	if (pNumberIndex)
+	{
+		if (!First) return nullptr;
+		const auto it = pNumberIndex->Numbers.find(iNumber);
+		return it != pNumberIndex->Numbers.end() ? it->second.front()->Obj : nullptr;
+	}
 	C4ObjectLink *cLnk;
 	for (cLnk = First; cLnk; cLnk = cLnk->Next)
 		if (cLnk->Obj->Number == iNumber)
@@ -615,6 +650,8 @@ void C4ObjectList::RemoveLink(C4ObjectLink *pLnk)
 {
 	if (pLnk->Prev) pLnk->Prev->Next = pLnk->Next; else First = pLnk->Next;
 	if (pLnk->Next) pLnk->Next->Prev = pLnk->Prev; else Last = pLnk->Prev;
+	if (pNumberIndex) UnindexObject(pLnk->Obj);
+	if (pInstanceIndex) UnindexInstance(pLnk->Obj);
 }
 
 void C4ObjectList::InsertLink(C4ObjectLink *pLnk, C4ObjectLink *pAfter)
@@ -633,6 +670,8 @@ void C4ObjectList::InsertLink(C4ObjectLink *pLnk, C4ObjectLink *pAfter)
 		if (First) First->Prev = pLnk; else Last = pLnk;
 		First = pLnk;
 	}
+	if (pNumberIndex) IndexObject(pLnk);
+	if (pInstanceIndex) { IndexInstance(pLnk); AssignOrder(pLnk); }
 }
 
 void C4ObjectList::InsertLinkBefore(C4ObjectLink *pLnk, C4ObjectLink *pBefore)
@@ -651,6 +690,192 @@ void C4ObjectList::InsertLinkBefore(C4ObjectLink *pLnk, C4ObjectLink *pBefore)
 		if (Last) Last->Next = pLnk; else First = pLnk;
 		Last = pLnk;
 	}
+	if (pNumberIndex) IndexObject(pLnk);
+	if (pInstanceIndex) { IndexInstance(pLnk); AssignOrder(pLnk); }
+}
+
+void C4ObjectList::EnableNumberIndex()
+{
+	if (pNumberIndex) return;
+	pNumberIndex = std::make_unique<NumberIndex>();
+	UpdateNumberIndex();
+}
+
+void C4ObjectList::UpdateNumberIndex()
+{
+	if (!pNumberIndex) return;
+	pNumberIndex->Numbers.clear();
+	pNumberIndex->Objects.clear();
+	for (C4ObjectLink *cLnk = First; cLnk; cLnk = cLnk->Next)
+	{
+		pNumberIndex->Objects.insert_or_assign(cLnk->Obj, cLnk->Obj->Number);
+		pNumberIndex->Numbers[cLnk->Obj->Number].push_back(cLnk);
+	}
+}
+
+void C4ObjectList::IndexObject(C4ObjectLink *pLnk)
+{
+	C4Object *const pObj = pLnk->Obj;
+	pNumberIndex->Objects.insert_or_assign(pObj, pObj->Number);
+	auto &links = pNumberIndex->Numbers[pObj->Number];
+	// the list order decides between objects of the same number, so put the link behind the closest preceding one
+	auto pos = links.begin();
+	if (!links.empty() && pLnk->Prev)
+	{
+		if (!pLnk->Next)
+			pos = links.end();
+		else
+			for (C4ObjectLink *cLnk = pLnk->Prev; cLnk; cLnk = cLnk->Prev)
+			{
+				const auto it = pNumberIndex->Objects.find(cLnk->Obj);
+				if (it != pNumberIndex->Objects.end() && it->second == pObj->Number)
+				{
+					pos = std::ranges::find(links, cLnk) + 1;
+					break;
+				}
+			}
+	}
+	links.insert(pos, pLnk);
+}
+
+void C4ObjectList::UnindexObject(C4Object *pObj)
+{
+	// objects are found by the number they were indexed with, even if they have been renumbered since
+	const auto it = pNumberIndex->Objects.find(pObj);
+	if (it == pNumberIndex->Objects.end()) return;
+	const auto bucket = pNumberIndex->Numbers.find(it->second);
+	pNumberIndex->Objects.erase(it);
+	if (bucket == pNumberIndex->Numbers.end()) return;
+	std::erase_if(bucket->second, [pObj](const C4ObjectLink *const pLnk) { return pLnk->Obj == pObj; });
+	if (bucket->second.empty()) pNumberIndex->Numbers.erase(bucket);
+}
+
+void C4ObjectList::EnableInstanceIndex()
+{
+	if (pInstanceIndex) return;
+	pInstanceIndex = std::make_unique<InstanceIndex>();
+	UpdateInstanceIndex();
+}
+
+void C4ObjectList::UpdateInstanceIndex()
+{
+	if (!pInstanceIndex) return;
+	pInstanceIndex->Entries.clear();
+	pInstanceIndex->Defs.clear();
+	pInstanceIndex->Categories.clear();
+	for (C4ObjectLink *cLnk = First; cLnk; cLnk = cLnk->Next)
+		IndexInstance(cLnk);
+	UpdateOrder();
+}
+
+void C4ObjectList::IndexInstance(C4ObjectLink *pLnk)
+{
+	C4Object *const pObj = pLnk->Obj;
+	auto &defInstances = pInstanceIndex->Defs[pObj->Def];
+	auto &categoryInstances = pInstanceIndex->Categories[pObj->Category];
+	pInstanceIndex->Entries.insert_or_assign(pObj, InstanceIndex::Entry{pLnk, pObj->Def, pObj->Category, defInstances.size(), categoryInstances.size()});
+	defInstances.push_back(pLnk);
+	categoryInstances.push_back(pLnk);
+}
+
+void C4ObjectList::UnindexInstance(C4Object *pObj)
+{
+	const auto it = pInstanceIndex->Entries.find(pObj);
+	if (it == pInstanceIndex->Entries.end()) return;
+	const InstanceIndex::Entry entry = it->second;
+	pInstanceIndex->Entries.erase(it);
+	// swap-remove from the instance lists and fix the position of the moved link
+	const auto erase = [this](auto &instances, const auto key, const std::size_t pos, std::size_t InstanceIndex::Entry::*member)
+	{
+		const auto listIt = instances.find(key);
+		auto &links = listIt->second;
+		if (pos + 1 < links.size())
+		{
+			links[pos] = links.back();
+			(pInstanceIndex->Entries.at(links[pos]->Obj).*member) = pos;
+		}
+		links.pop_back();
+		if (links.empty()) instances.erase(listIt);
+	};
+	erase(pInstanceIndex->Defs, static_cast<const C4Def *>(entry.Def), entry.DefPos, &InstanceIndex::Entry::DefPos);
+	erase(pInstanceIndex->Categories, entry.Category, entry.CategoryPos, &InstanceIndex::Entry::CategoryPos);
+}
+
+void C4ObjectList::SwapLinkObjects(C4ObjectLink *pLnk1, C4ObjectLink *pLnk2)
+{
+	if (pNumberIndex) { UnindexObject(pLnk1->Obj); UnindexObject(pLnk2->Obj); }
+	std::swap(pLnk1->Obj, pLnk2->Obj);
+	// the list order decides between objects of the same number
+	if (pNumberIndex) { IndexObject(pLnk1); IndexObject(pLnk2); }
+	if (!pInstanceIndex) return;
+	// the links keep their order keys; only the instance lists need the new links
+	for (C4ObjectLink *const pLnk : {pLnk1, pLnk2})
+	{
+		const auto it = pInstanceIndex->Entries.find(pLnk->Obj);
+		if (it == pInstanceIndex->Entries.end()) continue;
+		InstanceIndex::Entry &entry = it->second;
+		entry.Link = pLnk;
+		pInstanceIndex->Defs.at(entry.Def)[entry.DefPos] = pLnk;
+		pInstanceIndex->Categories.at(entry.Category)[entry.CategoryPos] = pLnk;
+	}
+}
+
+void C4ObjectList::ReindexObject(C4Object *pObj)
+{
+	if (!pInstanceIndex) return;
+	const auto it = pInstanceIndex->Entries.find(pObj);
+	if (it == pInstanceIndex->Entries.end()) return;
+	if (it->second.Def == pObj->Def && it->second.Category == pObj->Category) return;
+	C4ObjectLink *const pLnk = it->second.Link;
+	UnindexInstance(pObj);
+	IndexInstance(pLnk);
+}
+
+const std::vector<C4ObjectLink *> *C4ObjectList::GetDefInstances(C4Def *pDef)
+{
+	static const std::vector<C4ObjectLink *> NoInstances;
+	if (!pInstanceIndex) return nullptr;
+	const auto it = pInstanceIndex->Defs.find(pDef);
+	return it != pInstanceIndex->Defs.end() ? &it->second : &NoInstances;
+}
+
+C4ObjectLink *C4ObjectList::GetIndexedLink(C4Object *pObj)
+{
+	if (!pInstanceIndex) return nullptr;
+	const auto it = pInstanceIndex->Entries.find(pObj);
+	return it != pInstanceIndex->Entries.end() ? it->second.Link : nullptr;
+}
+
+// distance of the order keys of neighbouring links after renumbering, leaving room for insertions
+static constexpr std::int64_t C4ObjectOrderSpacing = 1 << 20;
+
+void C4ObjectList::UpdateOrder()
+{
+	if (!pInstanceIndex || pInstanceIndex->OrderValid) return;
+	std::int64_t iOrder = 0;
+	for (C4ObjectLink *cLnk = First; cLnk; cLnk = cLnk->Next, iOrder += C4ObjectOrderSpacing)
+		cLnk->Order = iOrder;
+	pInstanceIndex->OrderValid = true;
+}
+
+void C4ObjectList::AssignOrder(C4ObjectLink *pLnk)
+{
+	// no need to keep keys up to date if they are renumbered anyway
+	if (!pInstanceIndex->OrderValid) return;
+	// take a key between the neighbours; renumber on the next query if there is no room
+	if (pLnk->Prev && pLnk->Next)
+	{
+		if (pLnk->Next->Order - pLnk->Prev->Order > 1)
+			pLnk->Order = pLnk->Prev->Order + (pLnk->Next->Order - pLnk->Prev->Order) / 2;
+		else
+			pInstanceIndex->OrderValid = false;
+	}
+	else if (pLnk->Prev)
+		pLnk->Order = pLnk->Prev->Order + C4ObjectOrderSpacing;
+	else if (pLnk->Next)
+		pLnk->Order = pLnk->Next->Order - C4ObjectOrderSpacing;
+	else
+		pLnk->Order = 0;
 }
 
 void C4NotifyingObjectList::InsertLinkBefore(C4ObjectLink *pLink, C4ObjectLink *pBefore)
@@ -729,6 +954,8 @@ void C4ObjectList::Default()
 	First = Last = nullptr;
 	Mass = 0;
 	pEnumerated.reset();
+	UpdateNumberIndex();
+	UpdateInstanceIndex();
 }
 
 void C4ObjectList::UpdateTransferZones()
@@ -785,6 +1012,7 @@ bool C4ObjectList::OrderObjectBefore(C4Object *pObj1, C4Object *pObj2)
 	// relink into new one
 	if (pLnk1->Prev = pLnk2->Prev) pLnk2->Prev->Next = pLnk1; else First = pLnk1;
 	pLnk1->Next = pLnk2; pLnk2->Prev = pLnk1;
+	if (pInstanceIndex) AssignOrder(pLnk1);
 	// done, success
 	return true;
 }
@@ -808,6 +1036,7 @@ bool C4ObjectList::OrderObjectAfter(C4Object *pObj1, C4Object *pObj2)
 	// relink into new one
 	if (pLnk1->Next = pLnk2->Next) pLnk2->Next->Prev = pLnk1; else Last = pLnk1;
 	pLnk1->Prev = pLnk2; pLnk2->Next = pLnk1;
+	if (pInstanceIndex) AssignOrder(pLnk1);
 	// done, success
 	return true;
 }
@@ -827,6 +1056,7 @@ bool C4ObjectList::ShiftContents(C4Object *pNewFirst)
 	Last = pNewFirstLnk->Prev;
 	// 3. Uncycle list
 	First->Prev = Last->Next = nullptr;
+	InvalidateOrder();
 	// done, success
 	return true;
 }
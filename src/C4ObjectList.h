@@ -19,6 +19,7 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "C4Id.h"
@@ -38,12 +39,48 @@ class C4ObjectLink
 public:
 	C4Object *Obj;
 	C4ObjectLink *Prev, *Next;
+	std::int64_t Order; // ascending in list order if the list has an instance index (see C4ObjectList::UpdateOrder)
 };
 
 class C4ObjectList
 {
 	std::unique_ptr<std::vector<int32_t>> pEnumerated;
 
+	// optional index for lookups by number
+	struct NumberIndex
+	{
+		std::unordered_map<int32_t, std::vector<C4ObjectLink *>> Numbers; // links of the objects of each number in list order
+		std::unordered_map<C4Object *, int32_t> Objects; // all listed objects and the number they are indexed with
+	};
+	std::unique_ptr<NumberIndex> pNumberIndex;
+
+	void IndexObject(C4ObjectLink *pLnk);
+	void UnindexObject(C4Object *pObj);
+
+	// optional index of the listed objects by definition and category
+	// the instance lists are unordered; the list order is restored through C4ObjectLink::Order
+	struct InstanceIndex
+	{
+		struct Entry
+		{
+			C4ObjectLink *Link;
+			C4Def *Def; // definition and category the object is indexed with
+			int32_t Category;
+			std::size_t DefPos, CategoryPos; // positions in the instance lists
+		};
+
+		std::unordered_map<const C4Object *, Entry> Entries;
+		std::unordered_map<const C4Def *, std::vector<C4ObjectLink *>> Defs;
+		std::unordered_map<int32_t, std::vector<C4ObjectLink *>> Categories;
+		bool OrderValid{false}; // whether the order keys of all links are ascending
+	};
+	std::unique_ptr<InstanceIndex> pInstanceIndex;
+
+	void IndexInstance(C4ObjectLink *pLnk);
+	void UnindexInstance(C4Object *pObj);
+	void AssignOrder(C4ObjectLink *pLnk);
+	void InvalidateOrder() { if (pInstanceIndex) pInstanceIndex->OrderValid = false; }
+
 public:
 	C4ObjectList();
 	C4ObjectList(const C4ObjectList &List);
@@ -115,6 +152,17 @@ public:
 	bool DenumerateRead();
 	void CompileFunc(StdCompiler *pComp, bool fSaveRefs = true, bool fSkipPlayerObjects = false);
 
+	void EnableNumberIndex(); // maintain an index for ObjectPointer/ObjectNumber
+	void UpdateNumberIndex(); // rebuild index after links or object numbers have been changed directly
+
+	void EnableInstanceIndex(); // maintain an index for lookups by definition and category
+	void UpdateInstanceIndex(); // rebuild index after links have been changed directly
+	void SwapLinkObjects(C4ObjectLink *pLnk1, C4ObjectLink *pLnk2); // exchange the objects of two links, keeping the indices up to date
+	void ReindexObject(C4Object *pObj); // update index after definition or category of a listed object have changed
+	const std::vector<C4ObjectLink *> *GetDefInstances(C4Def *pDef); // links of all listed objects of the definition in no particular order; nullptr if there is no index
+	C4ObjectLink *GetIndexedLink(C4Object *pObj); // link of the object via the instance index; nullptr if not listed or there is no index
+	void UpdateOrder(); // make the order keys of all links ascending in list order
+
 	int32_t ObjectNumber(C4Object *pObj);
 	bool IsContained(C4Object *pObj);
 	int ClearPointers(C4Object *pObj);
@@ -23,45 +23,58 @@
 #include <C4Random.h>
 #include <C4Wrappers.h>
 
+#include <algorithm>
+
 static const C4Fixed WindDrift_Factor = itofix(1, 800);
 
-void C4PXS::Execute()
+void C4PXSSystem::ExecutePXS(const size_t index)
 {
+	// work on copies: reactions may create PXS and thus reallocate the slot arrays
+	int32_t mat = Mat[index];
+	C4Fixed x = X[index], y = Y[index], xdir = XDir[index], ydir = YDir[index];
 #ifdef DEBUGREC_PXS
 	{
 		C4RCExecPXS rc;
-		rc.x = x; rc.y = y; rc.iMat = Mat;
+		rc.x = x; rc.y = y; rc.iMat = mat;
 		rc.pos = 0;
 		AddDbgRec(RCT_ExecPXS, &rc, sizeof(rc));
 	}
 #endif
+	const auto store = [&, this](const C4Fixed newX, const C4Fixed newY)
+	{
+		Mat[index] = mat;
+		X[index] = newX; Y[index] = newY;
+		XDir[index] = xdir; YDir[index] = ydir;
+	};
+
 	int32_t inmat;
 
 	// Safety
-	if (!MatValid(Mat))
+	if (!MatValid(mat))
 	{
-		Deactivate(); return;
+		Deactivate(index, mat); return;
 	}
 
 	// Out of bounds
 	if ((x < 0) || (x >= GBackWdt) || (y < -10) || (y >= GBackHgt))
 	{
-		Deactivate(); return;
+		Deactivate(index, mat); return;
 	}
 
 	// Material conversion
 	int32_t iX = fixtoi(x), iY = fixtoi(y);
 	inmat = GBackMat(iX, iY);
-	C4MaterialReaction *pReact = Game.Material.GetReactionUnsafe(Mat, inmat);
-	if (pReact && (*pReact->pFunc)(pReact, iX, iY, iX, iY, xdir, ydir, Mat, inmat, meePXSPos, nullptr))
+	C4MaterialReaction *pReact = Game.Material.GetReactionUnsafe(mat, inmat);
+	if (pReact && (*pReact->pFunc)(pReact, iX, iY, iX, iY, xdir, ydir, mat, inmat, meePXSPos, nullptr))
 	{
-		Deactivate(); return;
+		Deactivate(index, mat); return;
 	}
 
 	// Gravity
 	ydir += GravAccel;
 
-	if (GBackDensity(iX, iY + 1) < Game.Material.Map[Mat].Density)
+	const C4Material &material = Game.Material.Map[mat];
+	if (GBackDensity(iX, iY + 1) < material.Density)
 	{
 		// Air speed: Wind plus some random
 		int32_t iWind = GBackWind(iX, iY);
@@ -69,7 +82,7 @@ void C4PXS::Execute()
 		C4Fixed tydir = FIXED256(Random(1200) - 600);
 
 		// Air friction, based on WindDrift. MaxSpeed is ignored.
-		int32_t iWindDrift = (std::max)(Game.Material.Map[Mat].WindDrift - 20, 0);
+		int32_t iWindDrift = (std::max)(material.WindDrift - 20, 0);
 		xdir += ((txdir - xdir) * iWindDrift) * WindDrift_Factor;
 		ydir += ((tydir - ydir) * iWindDrift) * WindDrift_Factor;
 	}
@@ -84,7 +97,7 @@ void C4PXS::Execute()
 		// Check path
 		if (Game.Landscape._PathFree(iX, iY, iToX, iToY))
 		{
-			x = ctcox; y = ctcoy;
+			store(ctcox, ctcoy);
 			return;
 		}
 
@@ -96,12 +109,12 @@ void C4PXS::Execute()
 		int32_t inX = iX + Sign(iToX - iX), inY = iY + Sign(iToY - iY);
 		// Contact?
 		inmat = GBackMat(inX, inY);
-		C4MaterialReaction *pReact = Game.Material.GetReactionUnsafe(Mat, inmat);
+		C4MaterialReaction *pReact = Game.Material.GetReactionUnsafe(mat, inmat);
 		if (pReact)
-			if ((*pReact->pFunc)(pReact, iX, iY, inX, inY, xdir, ydir, Mat, inmat, meePXSMove, &fStopMovement))
+			if ((*pReact->pFunc)(pReact, iX, iY, inX, inY, xdir, ydir, mat, inmat, meePXSMove, &fStopMovement))
 			{
 				// destructive contact
-				Deactivate();
+				Deactivate(index, mat);
 				return;
 			}
 			else
@@ -109,7 +122,7 @@ void C4PXS::Execute()
 				// no destructive contact, but speed or position changed: Stop moving for now
 				if (fStopMovement)
 				{
-					x = itofix(iX); y = itofix(iY);
+					store(itofix(iX), itofix(iY));
 					return;
 				}
 				// there was a reaction func, but it didn't do anything - continue movement
@@ -118,11 +131,11 @@ void C4PXS::Execute()
 	} while (iX != iToX || iY != iToY);
 
 	// No contact? Free movement
-	x = ctcox; y = ctcoy;
+	store(ctcox, ctcoy);
 #ifdef DEBUGREC_PXS
 	{
 		C4RCExecPXS rc;
-		rc.x = x; rc.y = y; rc.iMat = Mat;
+		rc.x = ctcox; rc.y = ctcoy; rc.iMat = mat;
 		rc.pos = 1;
 		AddDbgRec(RCT_ExecPXS, &rc, sizeof(rc));
 	}
@@ -130,16 +143,15 @@ void C4PXS::Execute()
 	return;
 }
 
-void C4PXS::Deactivate()
+void C4PXSSystem::Deactivate(const size_t index, const int32_t mat)
 {
 #ifdef DEBUGREC_PXS
 	C4RCExecPXS rc;
-	rc.x = x; rc.y = y; rc.iMat = Mat;
+	rc.x = X[index]; rc.y = Y[index]; rc.iMat = mat;
 	rc.pos = 2;
 	AddDbgRec(RCT_ExecPXS, &rc, sizeof(rc));
 #endif
-	Mat = MNone;
-	Game.PXS.Delete(this);
+	Delete(index);
 }
 
 C4PXSSystem::C4PXSSystem()
@@ -155,82 +167,84 @@ C4PXSSystem::~C4PXSSystem()
 void C4PXSSystem::Default()
 {
 	Count = 0;
-	for (unsigned int cnt = 0; cnt < PXSMaxChunk; cnt++)
-	{
-		Chunk[cnt] = nullptr;
-		iChunkPXS[cnt] = 0;
-	}
+	Clear();
 }
 
 void C4PXSSystem::Clear()
 {
-	for (unsigned int cnt = 0; cnt < PXSMaxChunk; cnt++)
-	{
-		delete[] Chunk[cnt];
-		Chunk[cnt] = nullptr;
-		iChunkPXS[cnt] = 0;
-	}
+	Mat.clear(); Mat.shrink_to_fit();
+	X.clear(); X.shrink_to_fit();
+	Y.clear(); Y.shrink_to_fit();
+	XDir.clear(); XDir.shrink_to_fit();
+	YDir.clear(); YDir.shrink_to_fit();
+	LiveEnd = FirstFree = LiveCount = 0;
 }
 
-C4PXS *C4PXSSystem::New()
+void C4PXSSystem::Resize(const size_t size)
 {
-	unsigned int cnt, cnt2;
-	C4PXS *pxp;
-	// Check chunks for available space
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-	{
-		// Create new chunk if necessary
-		if (!Chunk[cnt])
-		{
-			Chunk[cnt] = new C4PXS[PXSChunkSize];
-			iChunkPXS[cnt] = 0;
-		}
-		// Check this chunk for space
-		if (iChunkPXS[cnt] < PXSChunkSize)
-			for (cnt2 = 0, pxp = Chunk[cnt]; cnt2 < PXSChunkSize; cnt2++, pxp++)
-				if (pxp->Mat == MNone)
-				{
-					// count theam
-					iChunkPXS[cnt]++;
-					return pxp;
-				}
-	}
-	return nullptr;
+	Mat.resize(size, MNone);
+	X.resize(size, Fix0);
+	Y.resize(size, Fix0);
+	XDir.resize(size, Fix0);
+	YDir.resize(size, Fix0);
+}
+
+void C4PXSSystem::UpdateLiveRange()
+{
+	LiveEnd = Mat.size();
+	while (LiveEnd && Mat[LiveEnd - 1] == MNone) --LiveEnd;
+	FirstFree = 0;
+	while (FirstFree < LiveEnd && Mat[FirstFree] != MNone) ++FirstFree;
+	LiveCount = std::count_if(Mat.begin(), Mat.begin() + LiveEnd, [](const int32_t mat) { return mat != MNone; });
+}
+
+bool C4PXSSystem::New(size_t &index)
+{
+	// PXS limit reached?
+	const int32_t maxPXS = Game.C4S.Landscape.MaxPXS;
+	if (maxPXS > 0 && LiveCount >= static_cast<size_t>(maxPXS)) return false;
+	// always use the lowest free slot, so the execution order is the same on all clients
+	while (FirstFree < LiveEnd && Mat[FirstFree] != MNone) ++FirstFree;
+	if (FirstFree >= Mat.size())
+		Resize(Mat.size() + PXSChunkSize);
+	index = FirstFree++;
+	LiveEnd = std::max(LiveEnd, FirstFree);
+	++LiveCount;
+	return true;
+}
+
+void C4PXSSystem::Delete(const size_t index)
+{
+	Mat[index] = MNone;
+	--LiveCount;
+	FirstFree = std::min(FirstFree, index);
+	// shrink live range
+	if (index + 1 == LiveEnd)
+		while (LiveEnd && Mat[LiveEnd - 1] == MNone) --LiveEnd;
 }
 
 bool C4PXSSystem::Create(int32_t mat, C4Fixed ix, C4Fixed iy, C4Fixed ixdir, C4Fixed iydir)
 {
-	C4PXS *pxp;
+	size_t index;
 	if (!MatValid(mat)) return false;
-	if (!(pxp = New())) return false;
-	pxp->Mat = mat;
-	pxp->x = ix; pxp->y = iy;
-	pxp->xdir = ixdir; pxp->ydir = iydir;
+	if (!New(index)) return false;
+	Mat[index] = mat;
+	X[index] = ix; Y[index] = iy;
+	XDir[index] = ixdir; YDir[index] = iydir;
 	return true;
 }
 
 void C4PXSSystem::Execute()
 {
-	// Execute all chunks
+	// Execute all PXS in slot order
+	// LiveEnd is reevaluated each step so PXS created behind the current one are executed as well
 	Count = 0;
-	for (unsigned int cchunk = 0; cchunk < PXSMaxChunk; cchunk++)
-		if (Chunk[cchunk])
-			// empty chunk?
-			if (!iChunkPXS[cchunk])
-			{
-				delete[] Chunk[cchunk]; Chunk[cchunk] = nullptr;
-			}
-			else
-			{
-				// Execute chunk pxs, check for empty
-				C4PXS *pxp = Chunk[cchunk];
-				for (unsigned int cnt2 = 0; cnt2 < PXSChunkSize; cnt2++, pxp++)
-					if (pxp->Mat != MNone)
-					{
-						pxp->Execute();
-						Count++;
-					}
-			}
+	for (size_t i = 0; i < LiveEnd; ++i)
+		if (Mat[i] != MNone)
+		{
+			ExecutePXS(i);
+			Count++;
+		}
 }
 
 void C4PXSSystem::Draw(C4FacetEx &cgo)
@@ -241,33 +255,27 @@ void C4PXSSystem::Draw(C4FacetEx &cgo)
 
 	// First pass: draw old-style PXS (lines/pixels)
 	int32_t cgox = cgo.X - cgo.TargetX, cgoy = cgo.Y - cgo.TargetY;
-	unsigned int cnt;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
+	for (size_t i = 0; i < LiveEnd; ++i)
+		if (Mat[i] != MNone && VisibleRect.Contains(fixtoi(X[i]), fixtoi(Y[i])))
 		{
-			C4PXS *pxp = Chunk[cnt];
-			for (unsigned int cnt2 = 0; cnt2 < PXSChunkSize; cnt2++, pxp++)
-				if (pxp->Mat != MNone && VisibleRect.Contains(fixtoi(pxp->x), fixtoi(pxp->y)))
-				{
-					C4Material *pMat = &Game.Material.Map[pxp->Mat];
-					if (pMat->PXSFace.Surface && Config.Graphics.PXSGfx)
-						continue;
-					// old-style: unicolored pixels or lines
-					uint32_t dwMatClr = Game.Landscape.GetPal()->GetClr(Mat2PixColDefault(pxp->Mat));
-					if (fixtoi(pxp->xdir) || fixtoi(pxp->ydir))
-					{
-						// lines for stuff that goes whooosh!
-						int len = fixtoi(Abs(pxp->xdir) + Abs(pxp->ydir));
-						dwMatClr = uint32_t(std::max<int>(dwMatClr >> 24, 195 - (195 - (dwMatClr >> 24)) / len)) << 24 | (dwMatClr & 0xffffff);
-						Application.DDraw->DrawLineDw(cgo.Surface,
-							fixtof(pxp->x - pxp->xdir) + cgox, fixtof(pxp->y - pxp->ydir) + cgoy,
-							fixtof(pxp->x) + cgox, fixtof(pxp->y) + cgoy,
-							dwMatClr);
-					}
-					else
-						// single pixels for slow stuff
-						Application.DDraw->DrawPix(cgo.Surface, fixtof(pxp->x) + cgox, fixtof(pxp->y) + cgoy, dwMatClr);
-				}
+			C4Material *pMat = &Game.Material.Map[Mat[i]];
+			if (pMat->PXSFace.Surface && Config.Graphics.PXSGfx)
+				continue;
+			// old-style: unicolored pixels or lines
+			uint32_t dwMatClr = Game.Landscape.GetPal()->GetClr(Mat2PixColDefault(Mat[i]));
+			if (fixtoi(XDir[i]) || fixtoi(YDir[i]))
+			{
+				// lines for stuff that goes whooosh!
+				int len = fixtoi(Abs(XDir[i]) + Abs(YDir[i]));
+				dwMatClr = uint32_t(std::max<int>(dwMatClr >> 24, 195 - (195 - (dwMatClr >> 24)) / len)) << 24 | (dwMatClr & 0xffffff);
+				Application.DDraw->DrawLineDw(cgo.Surface,
+					fixtof(X[i] - XDir[i]) + cgox, fixtof(Y[i] - YDir[i]) + cgoy,
+					fixtof(X[i]) + cgox, fixtof(Y[i]) + cgoy,
+					dwMatClr);
+			}
+			else
+				// single pixels for slow stuff
+				Application.DDraw->DrawPix(cgo.Surface, fixtof(X[i]) + cgox, fixtof(Y[i]) + cgoy, dwMatClr);
 		}
 
 	// PXS graphics disabled?
@@ -275,28 +283,24 @@ void C4PXSSystem::Draw(C4FacetEx &cgo)
 		return;
 
 	// Second pass: draw new-style PXS (graphics)
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
+	for (size_t i = 0; i < LiveEnd; ++i)
+		if (Mat[i] != MNone && VisibleRect.Contains(fixtoi(X[i]), fixtoi(Y[i])))
 		{
-			C4PXS *pxp = Chunk[cnt];
-			for (unsigned int cnt2 = 0; cnt2 < PXSChunkSize; cnt2++, pxp++)
-				if (pxp->Mat != MNone && VisibleRect.Contains(fixtoi(pxp->x), fixtoi(pxp->y)))
-				{
-					C4Material *pMat = &Game.Material.Map[pxp->Mat];
-					if (!pMat->PXSFace.Surface)
-						continue;
-					// new-style: graphics
-					int32_t pnx, pny;
-					pMat->PXSFace.GetPhaseNum(pnx, pny);
-					int32_t fcWdt = pMat->PXSFace.Wdt; int32_t fcWdtH = (std::max)(fcWdt / 3, 1);
-					// calculate draw width and tile to use (random-ish)
-					int32_t z = 1 + ((cnt2 / std::max<int32_t>(pnx * pny, 1)) ^ 341) % pMat->PXSGfxSize;
-					pny = (cnt2 / pnx) % pny; pnx = cnt2 % pnx;
-					// draw
-					Application.DDraw->ActivateBlitModulation((std::min)((fcWdtH - z) * 16, 255) << 24 | 0xffffff);
-					pMat->PXSFace.DrawX(cgo.Surface, fixtoi(pxp->x) + cgox + z * pMat->PXSGfxRt.tx / fcWdt, fixtoi(pxp->y) + cgoy + z * pMat->PXSGfxRt.ty / fcWdt, z, z * pMat->PXSFace.Hgt / fcWdt, pnx, pny);
-					Application.DDraw->DeactivateBlitModulation();
-				}
+			C4Material *pMat = &Game.Material.Map[Mat[i]];
+			if (!pMat->PXSFace.Surface)
+				continue;
+			// new-style: graphics
+			int32_t pnx, pny;
+			pMat->PXSFace.GetPhaseNum(pnx, pny);
+			int32_t fcWdt = pMat->PXSFace.Wdt; int32_t fcWdtH = (std::max)(fcWdt / 3, 1);
+			// calculate draw width and tile to use (random-ish)
+			const int32_t slot = static_cast<int32_t>(i % PXSChunkSize);
+			int32_t z = 1 + ((slot / std::max<int32_t>(pnx * pny, 1)) ^ 341) % pMat->PXSGfxSize;
+			pny = (slot / pnx) % pny; pnx = slot % pnx;
+			// draw
+			Application.DDraw->ActivateBlitModulation((std::min)((fcWdtH - z) * 16, 255) << 24 | 0xffffff);
+			pMat->PXSFace.DrawX(cgo.Surface, fixtoi(X[i]) + cgox + z * pMat->PXSGfxRt.tx / fcWdt, fixtoi(Y[i]) + cgoy + z * pMat->PXSGfxRt.ty / fcWdt, z, z * pMat->PXSFace.Hgt / fcWdt, pnx, pny);
+			Application.DDraw->DeactivateBlitModulation();
 		}
 }
 
@@ -317,37 +321,50 @@ void C4PXSSystem::Cast(int32_t mat, int32_t num, int32_t tx, int32_t ty, int32_t
 
 bool C4PXSSystem::Save(C4Group &hGroup)
 {
-	unsigned int cnt;
-
-	// Check used chunk count
-	int32_t iChunks = 0;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
-			iChunks++;
-	if (!iChunks)
+	if (!LiveCount)
 	{
 		hGroup.Delete(C4CFN_PXS);
 		return true;
 	}
 
 	// Save chunks to temp file
+	// the group may be written in the background, so the temp file must not be reused by the next save
+	char szTempPXS[_MAX_PATH + 1];
+	SCopy(Config.AtTempPath(C4CFN_TempPXS), szTempPXS);
+	MakeTempFilename(szTempPXS);
 	CStdFile hTempFile;
-	if (!hTempFile.Create(Config.AtTempPath(C4CFN_TempPXS)))
+	if (!hTempFile.Create(szTempPXS))
 		return false;
 	int32_t iNumFormat = 1;
 	if (!hTempFile.Write(&iNumFormat, sizeof(iNumFormat)))
 		return false;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt]) // must save all chunks in order to keep order consistent on all clients
-			if (!hTempFile.Write(Chunk[cnt], PXSChunkSize * sizeof(C4PXS)))
-				return false;
+	// must save all chunks of the live range in order to keep slot order consistent on all clients
+	const size_t chunkCount = (LiveEnd + PXSChunkSize - 1) / PXSChunkSize;
+	std::vector<C4PXS> chunk(PXSChunkSize);
+	for (size_t cnt = 0; cnt < chunkCount; cnt++)
+	{
+		for (size_t cnt2 = 0; cnt2 < PXSChunkSize; cnt2++)
+		{
+			const size_t i = cnt * PXSChunkSize + cnt2;
+			C4PXS &pxs = chunk[cnt2];
+			if (i < LiveEnd && Mat[i] != MNone)
+			{
+				pxs.Mat = Mat[i];
+				pxs.x = X[i]; pxs.y = Y[i];
+				pxs.xdir = XDir[i]; pxs.ydir = YDir[i];
+			}
+			else
+				pxs = C4PXS{};
+		}
+		if (!hTempFile.Write(chunk.data(), PXSChunkSize * sizeof(C4PXS)))
+			return false;
+	}
 
 	if (!hTempFile.Close())
 		return false;
 
 	// Move temp file to group
-	if (!hGroup.Move(Config.AtTempPath(C4CFN_TempPXS),
-		C4CFN_PXS))
+	if (!hGroup.Move(szTempPXS, C4CFN_PXS))
 		return false;
 
 	return true;
@@ -356,7 +373,7 @@ bool C4PXSSystem::Save(C4Group &hGroup)
 bool C4PXSSystem::Load(C4Group &hGroup)
 {
 	// load new
-	size_t iBinSize, iChunkNum, cnt2;
+	size_t iBinSize, iChunkNum;
 	size_t iChunkSize = PXSChunkSize * sizeof(C4PXS);
 	if (!hGroup.AccessEntry(C4CFN_PXS, &iBinSize)) return false;
 	// clear previous
@@ -373,22 +390,24 @@ bool C4PXSSystem::Load(C4Group &hGroup)
 	else if (iBinSize % iChunkSize != 0) return false;
 	// calc chunk count
 	iChunkNum = iBinSize / iChunkSize;
-	if (iChunkNum > PXSMaxChunk) return false;
-	for (uint32_t cnt = 0; cnt < iChunkNum; cnt++)
+	Resize(iChunkNum * PXSChunkSize);
+	std::vector<C4PXS> chunk(PXSChunkSize);
+	for (size_t cnt = 0; cnt < iChunkNum; cnt++)
 	{
-		Chunk[cnt] = new C4PXS[PXSChunkSize];
-		if (!hGroup.Read(Chunk[cnt], iChunkSize)) return false;
-		// count the PXS, Peter!
-		// convert num format, if neccessary
-		C4PXS *pxp; iChunkPXS[cnt] = 0;
-		for (cnt2 = 0, pxp = Chunk[cnt]; cnt2 < PXSChunkSize; cnt2++, pxp++)
-			if (pxp->Mat != MNone)
-			{
-				++iChunkPXS[cnt];
-				// convert number format
-				if (iNumForm == 2) { FLOAT_TO_FIXED(&pxp->x); FLOAT_TO_FIXED(&pxp->y); FLOAT_TO_FIXED(&pxp->xdir); FLOAT_TO_FIXED(&pxp->ydir); }
-			}
+		if (!hGroup.Read(chunk.data(), iChunkSize)) { Clear(); return false; }
+		for (size_t cnt2 = 0; cnt2 < PXSChunkSize; cnt2++)
+		{
+			C4PXS &pxs = chunk[cnt2];
+			if (pxs.Mat == MNone) continue;
+			// convert number format
+			if (iNumForm == 2) { FLOAT_TO_FIXED(&pxs.x); FLOAT_TO_FIXED(&pxs.y); FLOAT_TO_FIXED(&pxs.xdir); FLOAT_TO_FIXED(&pxs.ydir); }
+			const size_t i = cnt * PXSChunkSize + cnt2;
+			Mat[i] = pxs.Mat;
+			X[i] = pxs.x; Y[i] = pxs.y;
+			XDir[i] = pxs.xdir; YDir[i] = pxs.ydir;
+		}
 	}
+	UpdateLiveRange();
 	return true;
 }
 
@@ -400,32 +419,23 @@ void C4PXSSystem::Synchronize()
 void C4PXSSystem::SyncClearance()
 {
 	// consolidate chunks; remove empty chunks
-	C4PXS **pDestChunk = Chunk;
-	int32_t iDestChunk = 0;
-	for (unsigned int cnt = 0; cnt < PXSMaxChunk; cnt++)
+	size_t dest = 0;
+	for (size_t src = 0; src < LiveEnd; src += PXSChunkSize)
 	{
-		if (Chunk[cnt] && iChunkPXS[cnt])
-		{
-			*pDestChunk++ = Chunk[cnt];
-			iChunkPXS[iDestChunk++] = iChunkPXS[cnt];
-		}
-		else
+		const size_t end = std::min(src + PXSChunkSize, LiveEnd);
+		if (std::all_of(Mat.begin() + src, Mat.begin() + end, [](const int32_t mat) { return mat == MNone; }))
+			continue;
+		if (dest != src)
 		{
-			delete[] Chunk[cnt];
-			Chunk[cnt] = nullptr;
+			std::copy(Mat.begin() + src, Mat.begin() + src + PXSChunkSize, Mat.begin() + dest);
+			std::copy(X.begin() + src, X.begin() + src + PXSChunkSize, X.begin() + dest);
+			std::copy(Y.begin() + src, Y.begin() + src + PXSChunkSize, Y.begin() + dest);
+			std::copy(XDir.begin() + src, XDir.begin() + src + PXSChunkSize, XDir.begin() + dest);
+			std::copy(YDir.begin() + src, YDir.begin() + src + PXSChunkSize, YDir.begin() + dest);
 		}
+		dest += PXSChunkSize;
 	}
-}
-
-void C4PXSSystem::Delete(C4PXS *pPXS)
-{
-	// find chunk
-	unsigned int cnt;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
-			if (pPXS >= Chunk[cnt] && pPXS < Chunk[cnt] + PXSChunkSize)
-				break;
-	// decrease pxs counter
-	if (cnt < PXSMaxChunk)
-		iChunkPXS[cnt]--;
+	// release the remaining chunks
+	Resize(dest);
+	UpdateLiveRange();
 }
@@ -22,22 +22,21 @@
 #include <C4Material.h>
 #include "Fixed.h"
 
+#include <vector>
+
+// Single PXS as stored in savegames
 class C4PXS
 {
+public:
 	C4PXS() : Mat(MNone), x(Fix0), y(Fix0), xdir(Fix0), ydir(Fix0) {}
 
-	friend class C4PXSSystem;
-
-protected:
+public:
 	int32_t Mat;
 	C4Fixed x, y, xdir, ydir;
-
-protected:
-	void Execute();
-	void Deactivate();
 };
 
-const size_t PXSChunkSize = 500, PXSMaxChunk = 20;
+// Slots are allocated in blocks of PXSChunkSize; the savegame stores one chunk per block
+const size_t PXSChunkSize = 500;
 
 class C4PXSSystem
 {
@@ -49,11 +48,14 @@ public:
 	int32_t Count;
 
 protected:
-	C4PXS *Chunk[PXSMaxChunk];
-	size_t iChunkPXS[PXSMaxChunk];
+	// PXS data, one entry per slot; a slot is free if its Mat is MNone
+	std::vector<int32_t> Mat;
+	std::vector<C4Fixed> X, Y, XDir, YDir;
+	size_t LiveEnd; // all slots from here on are free
+	size_t FirstFree; // all slots before this one are used
+	size_t LiveCount; // number of used slots
 
 public:
-	void Delete(C4PXS *pPXS);
 	void Default();
 	void Clear();
 	void Execute();
@@ -66,5 +68,10 @@ public:
 	bool Save(C4Group &hGroup);
 
 protected:
-	C4PXS *New();
+	bool New(size_t &index);
+	void Delete(size_t index);
+	void ExecutePXS(size_t index);
+	void Deactivate(size_t index, int32_t mat);
+	void Resize(size_t size);
+	void UpdateLiveRange();
 };
@@ -322,6 +322,7 @@ void C4SLandscape::Default()
 	NewStyleLandscape = 0;
 	FoWRes = CClrModAddMap::iDefResolutionX;
 	ShadeMaterials = true;
+	MaxPXS = C4S_DefaultMaxPXS;
 }
 
 void C4SLandscape::GetMapSize(int32_t &rWdt, int32_t &rHgt, int32_t iPlayerNum)
@@ -367,6 +368,7 @@ void C4SLandscape::CompileFunc(StdCompiler *pComp, bool newScenario)
 	pComp->Value(mkNamingAdapt(NewStyleLandscape,         "NewStyleLandscape", 0));
 	pComp->Value(mkNamingAdapt(FoWRes,                    "FoWRes",            static_cast<int32_t>(CClrModAddMap::iDefResolutionX)));
 	pComp->Value(mkNamingAdapt(ShadeMaterials,            "ShadeMaterials",    newScenario));
+	pComp->Value(mkNamingAdapt(MaxPXS,                    "MaxPXS",            C4S_DefaultMaxPXS));
 }
 
 void C4SWeather::Default()
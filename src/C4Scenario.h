@@ -190,6 +190,7 @@ const int32_t C4S_NoGoal      = 0,
 // Maximum map player extend factor
 
 const int32_t C4S_MaxMapPlayerExtend = 4;
+const int32_t C4S_DefaultMaxPXS = 10000;
 
 class C4SPlrStart
 {
@@ -242,6 +243,7 @@ public:
 	int32_t NewStyleLandscape; // if set to 2, the landscape uses up to 125 mat/texture pairs
 	int32_t FoWRes; // chunk size of FoGOfWar
 	bool ShadeMaterials;
+	int32_t MaxPXS; // maximum number of loose material pixels; 0 for unlimited
 
 public:
 	void Default();
@@ -82,12 +82,12 @@ inline const static char *FnStringPar(const C4String *const pString)
 
 inline C4String *String(const char *str)
 {
-	return str ? new C4String((str), &Game.ScriptEngine.Strings) : nullptr;
+	return str ? Game.ScriptEngine.Strings.RegString(str) : nullptr;
 }
 
 inline C4String *String(StdStrBuf &&str)
 {
-	return str ? new C4String(std::forward<StdStrBuf>(str), &Game.ScriptEngine.Strings) : nullptr;
+	return str ? Game.ScriptEngine.Strings.RegString(std::forward<StdStrBuf>(str)) : nullptr;
 }
 
 static std::string FnStringFormat(C4AulContext *cthr, const char *szFormatPar, C4Value *Par0 = nullptr, C4Value *Par1 = nullptr, C4Value *Par2 = nullptr, C4Value *Par3 = nullptr,
@@ -1985,102 +1985,37 @@ static C4Object *FnFindBase(C4AulContext *cthr, C4ValueInt iOwner, C4ValueInt iI
 	return Game.FindBase(iOwner, iIndex);
 }
 
-C4FindObject *CreateCriterionsFromPars(const C4Value *pPars, C4FindObject **pFOs, C4SortObject **pSOs)
-{
-	int i, iCnt = 0, iSortCnt = 0;
-	// Read all parameters
-	for (i = 0; i < C4AUL_MAX_Par; i++)
-	{
-		const C4Value &Data = pPars[i].GetRefVal();
-		// No data given?
-		if (!Data) break;
-		// Construct
-		C4SortObject *pSO = nullptr;
-		C4FindObject *pFO = C4FindObject::CreateByValue(Data, pSOs ? &pSO : nullptr);
-		// Add FindObject
-		if (pFO)
-		{
-			pFOs[iCnt++] = pFO;
-		}
-		// Add SortObject
-		if (pSO)
-		{
-			pSOs[iSortCnt++] = pSO;
-		}
-	}
-	// No criterions?
-	if (!iCnt)
-	{
-		for (i = 0; i < iSortCnt; ++i) delete pSOs[i];
-		return nullptr;
-	}
-	// create sort criterion
-	C4SortObject *pSO = nullptr;
-	if (iSortCnt)
-	{
-		if (iSortCnt == 1)
-			pSO = pSOs[0];
-		else
-			pSO = new C4SortObjectMultiple(iSortCnt, pSOs, false);
-	}
-	// Create search object
-	C4FindObject *pFO;
-	if (iCnt == 1)
-		pFO = pFOs[0];
-	else
-		pFO = new C4FindObjectAnd(iCnt, pFOs, false);
-	if (pSO) pFO->SetSort(pSO);
-	return pFO;
-}
-
 static C4Value FnObjectCount2(C4AulContext *cthr, const C4Value *pPars)
 {
-	// Create FindObject-structure
-	C4FindObject *pFOs[C4AUL_MAX_Par];
-	C4FindObject *pFO = CreateCriterionsFromPars(pPars, pFOs, nullptr);
+	// Get FindObject-structure
+	C4FindObjectPlanCache::Plan pFO(cthr, pPars, false);
 	// Error?
 	if (!pFO)
 		throw C4AulExecError(cthr->Obj, "ObjectCount: No valid search criterions supplied!");
 	// Search
-	int32_t iCnt = pFO->Count(Game.Objects, Game.Objects.Sectors);
-	// Free
-	delete pFO;
-	// Return
-	return C4VInt(iCnt);
+	return C4VInt(pFO->Count(Game.Objects, Game.Objects.Sectors));
 }
 
 static C4Value FnFindObject2(C4AulContext *cthr, const C4Value *pPars)
 {
-	// Create FindObject-structure
-	C4FindObject *pFOs[C4AUL_MAX_Par];
-	C4SortObject *pSOs[C4AUL_MAX_Par];
-	C4FindObject *pFO = CreateCriterionsFromPars(pPars, pFOs, pSOs);
+	// Get FindObject-structure
+	C4FindObjectPlanCache::Plan pFO(cthr, pPars, true);
 	// Error?
 	if (!pFO)
 		throw C4AulExecError(cthr->Obj, "FindObject: No valid search criterions supplied!");
 	// Search
-	C4Object *pObj = pFO->Find(Game.Objects, Game.Objects.Sectors);
-	// Free
-	delete pFO;
-	// Return
-	return C4VObj(pObj);
+	return C4VObj(pFO->Find(Game.Objects, Game.Objects.Sectors));
 }
 
 static C4Value FnFindObjects(C4AulContext *cthr, const C4Value *pPars)
 {
-	// Create FindObject-structure
-	C4FindObject *pFOs[C4AUL_MAX_Par];
-	C4SortObject *pSOs[C4AUL_MAX_Par];
-	C4FindObject *pFO = CreateCriterionsFromPars(pPars, pFOs, pSOs);
+	// Get FindObject-structure
+	C4FindObjectPlanCache::Plan pFO(cthr, pPars, true);
 	// Error?
 	if (!pFO)
 		throw C4AulExecError(cthr->Obj, "FindObjects: No valid search criterions supplied!");
 	// Search
-	C4ValueArray *pResult = pFO->FindMany(Game.Objects, Game.Objects.Sectors);
-	// Free
-	delete pFO;
-	// Return
-	return C4VArray(pResult);
+	return C4VArray(pFO->FindMany(Game.Objects, Game.Objects.Sectors));
 }
 
 static C4ValueInt FnObjectCount(C4AulContext *cthr, C4ID id, C4ValueInt x, C4ValueInt y, C4ValueInt wdt, C4ValueInt hgt, C4ValueInt dwOCF, C4String *szAction, C4Object *pActionTarget, C4Value vContainer, C4ValueInt iOwner)
@@ -5477,7 +5412,7 @@ static C4Value FnGetEffect(C4AulContext *ctx, C4String *psEffectName, C4Object *
 	case 3: return C4VInt(pEffect->iIntervall);     // 3: timer intervall
 	case 4: return C4VObj(pEffect->pCommandTarget); // 4: command target
 	case 5: return C4VID(pEffect->idCommandTarget); // 5: command target ID
-	case 6: return C4VInt(pEffect->iTime);          // 6: effect time
+	case 6: C4Effect::UpdateTimes(pTarget); return C4VInt(pEffect->iTime); // 6: effect time
 	}
 	// invalid data queried
 	return C4VNull;
@@ -5500,7 +5435,10 @@ static bool FnRemoveEffect(C4AulContext *ctx, C4String *psEffectName, C4Object *
 	if (!pEffect) return false;
 	// kill it
 	if (fDoNoCalls)
+	{
+		C4Effect::Reschedule(pTarget);
 		pEffect->SetDead();
+	}
 	else
 		pEffect->Kill(pTarget);
 	// done, success
@@ -5530,6 +5468,7 @@ static bool FnChangeEffect(C4AulContext *ctx, C4String *psEffectName, C4Object *
 	// set new timer
 	if (iNewTimer >= 0)
 	{
+		C4Effect::Reschedule(pTarget);
 		pEffect->iIntervall = iNewTimer;
 		pEffect->iTime = 0;
 	}
@@ -6135,7 +6074,11 @@ class C4AulEngineFunc : public C4AulEngineFuncHelper<sizeof...(Pars)>
 	Func func;
 
 public:
-	C4AulEngineFunc(C4AulScript *owner, const char *name, Func func, bool pub) : C4AulEngineFuncHelper<ParCount>{owner, name, pub, C4ValueConv<Pars>::Type()...}, func{func} {}
+	C4AulEngineFunc(C4AulScript *owner, const char *name, Func func, bool pub) : C4AulEngineFuncHelper<ParCount>{owner, name, pub, C4ValueConv<Pars>::Type()...}, func{func}
+	{
+		if constexpr ((IsFastCallPar<Pars> && ...))
+			this->FastCall = &FastCallHelper;
+	}
 
 	virtual C4V_Type GetRetType() noexcept override
 	{
@@ -6166,6 +6109,39 @@ private:
 	{
 		return func(context, C4ValueConv<Pars>::_FromC4V(pars[indices])...);
 	}
+
+	// parameters which the generic conversion would pass on unchanged if they already have the expected type or are nil
+	template<typename T>
+	static constexpr bool IsFastCallPar = std::is_same_v<T, C4ValueInt> || std::is_same_v<T, bool> || std::is_same_v<T, C4ID> || std::is_same_v<T, C4Object *> || std::is_same_v<T, C4String *>;
+
+	template<typename T>
+	static bool CheckFastCallPar(const C4Value &par)
+	{
+		const C4V_Type type{par.GetRawType()};
+		return type == C4ValueConv<T>::Type() || (type == C4V_Any && !par._getRaw());
+	}
+
+	static bool FastCallHelper(C4AulFunc *that, C4AulContext *context, const C4Value pars[], C4Value &result)
+	{
+		return static_cast<C4AulEngineFunc *>(that)->FastExecHelper(context, pars, result, std::make_index_sequence<ParCount>());
+	}
+
+	template<std::size_t... indices>
+	bool FastExecHelper(C4AulContext *context, const C4Value pars[], C4Value &result, std::index_sequence<indices...>) const
+	{
+		if (!(CheckFastCallPar<Pars>(pars[indices]) && ...)) return false;
+		// the result may be stored in place of the first parameter, so it is only set after the call
+		if constexpr (isVoid)
+		{
+			func(context, C4ValueConv<Pars>::_FromC4V(pars[indices])...);
+			result.Set0();
+		}
+		else
+		{
+			result.Set(C4ValueConv<Ret>::ToC4V(func(context, C4ValueConv<Pars>::_FromC4V(pars[indices])...)));
+		}
+		return true;
+	}
 };
 
 template <typename Ret, typename... Pars>
@@ -25,6 +25,22 @@
 #include <C4Log.h>
 #include <C4Record.h>
 
+namespace
+{
+	// copy the list into the index unless the list is unchanged since the last time
+	const std::vector<C4Object *> &UpdateIndex(std::vector<C4Object *> &index, bool &fValid, const C4ObjectList &list)
+	{
+		if (!fValid)
+		{
+			index.clear();
+			for (const C4ObjectLink *pLnk = list.First; pLnk; pLnk = pLnk->Next)
+				index.push_back(pLnk->Obj);
+			fValid = true;
+		}
+		return index;
+	}
+}
+
 /* sector */
 
 void C4LSector::Init(int ix, int iy)
@@ -40,6 +56,45 @@ void C4LSector::Clear()
 	// clear objects
 	Objects.Clear();
 	ObjectShapes.Clear();
+	ObjectIndex.clear();
+	ObjectShapeIndex.clear();
+	ObjectIndexValid = ObjectShapeIndexValid = false;
+}
+
+void C4LSector::AddObject(C4Object *pObj, C4ObjectList *pMainList)
+{
+	// objects change sectors all the time, so the index is only rebuilt when it is queried
+	if (Objects.Add(pObj, C4ObjectList::stMain, pMainList))
+		ObjectIndexValid = false;
+}
+
+bool C4LSector::RemoveObject(C4Object *pObj)
+{
+	if (!Objects.Remove(pObj)) return false;
+	ObjectIndexValid = false;
+	return true;
+}
+
+void C4LSector::AddObjectShape(C4Object *pObj, C4ObjectList *pMainList)
+{
+	if (ObjectShapes.Add(pObj, C4ObjectList::stMain, pMainList))
+		ObjectShapeIndexValid = false;
+}
+
+void C4LSector::RemoveObjectShape(C4Object *pObj)
+{
+	if (ObjectShapes.Remove(pObj))
+		ObjectShapeIndexValid = false;
+}
+
+const std::vector<C4Object *> &C4LSector::GetObjectIndex()
+{
+	return UpdateIndex(ObjectIndex, ObjectIndexValid, Objects);
+}
+
+const std::vector<C4Object *> &C4LSector::GetObjectShapeIndex()
+{
+	return UpdateIndex(ObjectShapeIndex, ObjectShapeIndexValid, ObjectShapes);
 }
 
 void C4LSector::CompileFunc(StdCompiler *pComp)
@@ -48,6 +103,7 @@ void C4LSector::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(mkIntAdapt(y), "y"));
 	pComp->Value(mkNamingAdapt(Objects,       "Objects"));
 	pComp->Value(mkNamingAdapt(ObjectShapes,  "ObjectShapes"));
+	if (pComp->isCompiler()) ObjectIndexValid = ObjectShapeIndexValid = false;
 }
 
 /* sector map */
@@ -90,14 +146,14 @@ void C4LSectors::Add(C4Object *pObj, C4ObjectList *pMainList)
 	assert(Sectors);
 	// Add to owning sector
 	C4LSector *pSct = SectorAt(pObj->x, pObj->y);
-	pSct->Objects.Add(pObj, C4ObjectList::stMain, pMainList);
+	pSct->AddObject(pObj, pMainList);
 	// Save position
 	pObj->old_x = pObj->x; pObj->old_y = pObj->y;
 	// Add to all sectors in shape area
 	pObj->Area.Set(this, pObj);
 	for (pSct = pObj->Area.First(); pSct; pSct = pObj->Area.Next(pSct))
 	{
-		pSct->ObjectShapes.Add(pObj, C4ObjectList::stMain, pMainList);
+		pSct->AddObjectShape(pObj, pMainList);
 	}
 #ifdef DEBUGREC
 	pObj->Area.DebugRec(pObj, 'A');
@@ -121,8 +177,8 @@ void C4LSectors::Update(C4Object *pObj, C4ObjectList *pMainList)
 		pNew = SectorAt(pObj->x, pObj->y);
 		if (pOld != pNew)
 		{
-			pOld->Objects.Remove(pObj);
-			pNew->Objects.Add(pObj, C4ObjectList::stMain, pMainList);
+			pOld->RemoveObject(pObj);
+			pNew->AddObject(pObj, pMainList);
 		}
 		// Save position
 		pObj->old_x = pObj->x; pObj->old_y = pObj->y;
@@ -133,12 +189,12 @@ void C4LSectors::Update(C4Object *pObj, C4ObjectList *pMainList)
 	// Remove from all old sectors in shape area
 	for (pOld = pObj->Area.First(); pOld; pOld = pObj->Area.Next(pOld))
 		if (!NewArea.Contains(pOld))
-			pOld->ObjectShapes.Remove(pObj);
+			pOld->RemoveObjectShape(pObj);
 	// Add to all new sectors in shape area
 	for (pNew = NewArea.First(); pNew; pNew = NewArea.Next(pNew))
 		if (!pObj->Area.Contains(pNew))
 		{
-			pNew->ObjectShapes.Add(pObj, C4ObjectList::stMain, pMainList);
+			pNew->AddObjectShape(pObj, pMainList);
 		}
 	// Update area
 	pObj->Area = NewArea;
@@ -152,7 +208,7 @@ void C4LSectors::Remove(C4Object *pObj)
 	assert(Sectors); assert(pObj);
 	// Remove from owning sector
 	C4LSector *pSct = SectorAt(pObj->old_x, pObj->old_y);
-	if (!pSct->Objects.Remove(pObj))
+	if (!pSct->RemoveObject(pObj))
 	{
 #ifndef NDEBUG
 		LogNTr(spdlog::level::warn, "Object {} of type {} deleted but not found in pos sector list!", pObj->Number, C4IdText(pObj->id));
@@ -160,23 +216,23 @@ void C4LSectors::Remove(C4Object *pObj)
 		// if it was not found in owning sector, it must be somewhere else. yeah...
 		bool fFound = false;
 		for (pSct = pObj->Area.First(); pSct; pSct = pObj->Area.Next(pSct))
-			if (pSct->Objects.Remove(pObj)) { fFound = true; break; }
+			if (pSct->RemoveObject(pObj)) { fFound = true; break; }
 		// yukh, somewhere else entirely...
 		if (!fFound)
 		{
-			fFound = !!SectorOut.Objects.Remove(pObj);
+			fFound = SectorOut.RemoveObject(pObj);
 			if (!fFound)
 			{
 				pSct = Sectors;
 				for (int cnt = 0; cnt < Size; cnt++, pSct++)
-					if (pSct->Objects.Remove(pObj)) { fFound = true; break; }
+					if (pSct->RemoveObject(pObj)) { fFound = true; break; }
 			}
 			assert(fFound);
 		}
 	}
 	// Remove from all sectors in shape area
 	for (pSct = pObj->Area.First(); pSct; pSct = pObj->Area.Next(pSct))
-		pSct->ObjectShapes.Remove(pObj);
+		pSct->RemoveObjectShape(pObj);
 #ifdef DEBUGREC
 	pObj->Area.DebugRec(pObj, 'R');
 #endif
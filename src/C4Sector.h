@@ -21,6 +21,8 @@
 
 #include <C4ObjectList.h>
 
+#include <vector>
+
 // class predefs
 class C4LSector;
 class C4LSectors;
@@ -41,12 +43,29 @@ protected:
 	void Init(int ix, int iy);
 	void Clear();
 
+	// list manipulation keeping the flat indices in sync
+	void AddObject(C4Object *pObj, C4ObjectList *pMainList);
+	bool RemoveObject(C4Object *pObj);
+	void AddObjectShape(C4Object *pObj, C4ObjectList *pMainList);
+	void RemoveObjectShape(C4Object *pObj);
+
 public:
 	int x, y; // pos
 
 	C4ObjectList Objects; // objects within this sector
 	C4ObjectList ObjectShapes; // objects with shapes that overlap this sector
 
+private:
+	// contiguous copies of the lists above in the same order; rebuilt by the first query after the list has changed
+	std::vector<C4Object *> ObjectIndex;
+	std::vector<C4Object *> ObjectShapeIndex;
+	bool ObjectIndexValid{false}, ObjectShapeIndexValid{false};
+
+public:
+	// only for queries that do not call script, because the indices must not change while being iterated
+	const std::vector<C4Object *> &GetObjectIndex();
+	const std::vector<C4Object *> &GetObjectShapeIndex();
+
 	void CompileFunc(StdCompiler *pComp);
 
 	friend class C4LSectors;
@@ -120,7 +120,7 @@ void C4SoundSystem::LoadEffects(C4Group &group)
 				[&](const auto &sample) { return SEqualNoCase(filename, sample.name.c_str()); });
 			// Load sample
 			StdBuf buf;
-			if (!group.LoadEntry(filename, buf)) continue;
+			if (!group.LoadEntryView(filename, buf)) continue;
 			try
 			{
 				samples.emplace_back(filename, buf.getData(), buf.getSize());
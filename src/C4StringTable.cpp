@@ -30,6 +30,7 @@ C4String::C4String(StdStrBuf &&strString, C4StringTable *pnTable)
 {
 	// take string
 	Data.Take(strString);
+	Hash = std::hash<std::string_view>{}(GetView());
 	// reg
 	Reg(pnTable);
 }
@@ -39,6 +40,7 @@ C4String::C4String(const char *strString, C4StringTable *pnTable)
 {
 	// copy string
 	Data = strString;
+	Hash = std::hash<std::string_view>{}(GetView());
 	// reg
 	Reg(pnTable);
 }
@@ -79,12 +81,17 @@ void C4String::Reg(C4StringTable *pnTable)
 	pnTable->Last = this;
 
 	pTable = pnTable;
+
+	[[maybe_unused]] const bool fInserted{pTable->Interned.emplace(GetView(), this).second};
+	assert(fInserted);
 }
 
 void C4String::UnReg()
 {
 	if (!pTable) return;
 
+	pTable->Interned.erase(GetView());
+
 	if (Next)
 		Next->Prev = Prev;
 	else
@@ -114,59 +121,47 @@ C4StringTable::~C4StringTable()
 	while (First) First->UnReg();
 }
 
-void C4StringTable::Clear()
+void C4StringTable::ReleaseHold(const std::unordered_set<const C4String *> &StillUsed)
 {
-	bool bContinue;
-	do
+	// release hold strings no code refers to anymore; strings still in use stay registered, so they remain unique
+	for (C4String *pAct = First, *pNext; pAct; pAct = pNext)
 	{
-		bContinue = false;
-		// find string to delete / unreg
-		for (C4String *pAct = First; pAct; pAct = pAct->Next)
-			if (pAct->Hold)
-			{
-				pAct->UnReg();
-				bContinue = true;
-				break;
-			}
-	} while (bContinue);
+		pNext = pAct->Next;
+		if (pAct->Hold && !StillUsed.contains(pAct))
+		{
+			pAct->Hold = false;
+			if (pAct->iRefCnt <= 0)
+				delete pAct;
+		}
+	}
 }
 
 int C4StringTable::EnumStrings()
 {
 	int iCurrID = 0;
 	for (C4String *pAct = First; pAct; pAct = pAct->Next)
-	{
-		if (!pAct->Hold || pAct->iRefCnt)
-		{
-			C4String *same;
-			if ((same = FindSaveString(pAct)) == pAct)
-			{
-				pAct->iEnumID = iCurrID++;
-			}
-			else
-			{
-				pAct->iEnumID = same->iEnumID;
-			}
-		}
-		else
-		{
-			pAct->iEnumID = -1;
-		}
-	}
+		pAct->iEnumID = (!pAct->Hold || pAct->iRefCnt) ? iCurrID++ : -1;
 	return iCurrID;
 }
 
 C4String *C4StringTable::RegString(const char *strString)
 {
+	if (C4String *pString = FindString(strString))
+		return pString;
 	return new C4String(strString, this);
 }
 
+C4String *C4StringTable::RegString(StdStrBuf &&strString)
+{
+	if (const auto it = Interned.find(std::string_view{strString.getData(), strString.getLength()}); it != Interned.end())
+		return it->second;
+	return new C4String(std::move(strString), this);
+}
+
 C4String *C4StringTable::FindString(const char *strString)
 {
-	for (C4String *pAct = First; pAct; pAct = pAct->Next)
-		if (SEqual(pAct->Data.getData(), strString))
-			return pAct;
-	return nullptr;
+	const auto it = Interned.find(strString ? std::string_view{strString} : std::string_view{});
+	return it != Interned.end() ? it->second : nullptr;
 }
 
 C4String *C4StringTable::FindString(C4String *pString)
@@ -185,19 +180,6 @@ C4String *C4StringTable::FindString(int iEnumID)
 	return nullptr;
 }
 
-C4String *C4StringTable::FindSaveString(C4String *pString)
-{
-	for (C4String *pAct = First; pAct; pAct = pAct->Next)
-	{
-		if (SEqual(pAct->Data.getData(), pString->Data.getData()) && (!pAct->Hold || pAct->iRefCnt))
-		{
-			return pAct;
-		}
-	}
-
-	return nullptr;
-}
-
 bool C4StringTable::Load(C4Group &ParentGroup)
 {
 	// read data
@@ -210,10 +192,7 @@ bool C4StringTable::Load(C4Group &ParentGroup)
 	{
 		SReplaceChar(strBuf, 0x0D, 0x00);
 		// add string to list
-		C4String *pnString;
-		if (!(pnString = FindString(strBuf)))
-			pnString = RegString(strBuf);
-		pnString->iEnumID = i;
+		RegString(strBuf)->iEnumID = i;
 	}
 	// delete data
 	delete[] pData;
@@ -230,7 +209,7 @@ bool C4StringTable::Save(C4Group &ParentGroup)
 	C4String *pAct;
 	for (pAct = First; pAct; pAct = pAct->Next)
 	{
-		if (pAct->iEnumID > -1 && FindSaveString(pAct) == pAct)
+		if (pAct->iEnumID > -1)
 		{
 			iTableSize += SLen(pAct->Data.getData()) + 2;
 		}
@@ -243,7 +222,7 @@ bool C4StringTable::Save(C4Group &ParentGroup)
 	*pData = 0;
 	for (pAct = First; pAct; pAct = pAct->Next)
 	{
-		if (pAct->iEnumID > -1 && FindSaveString(pAct) == pAct)
+		if (pAct->iEnumID > -1)
 		{
 			SCopy(pAct->Data.getData(), pPos);
 			if (strchr(pPos, 10) || strchr(pPos, 13))
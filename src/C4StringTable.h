@@ -20,14 +20,23 @@
 
 #include "StdBuf.h"
 
+#include <cstddef>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
 class C4StringTable;
 class C4Group;
 
+// strings are interned: a table holds at most one string per contents, so strings of the same table are equal if they are identical
+// thus, they are created by C4StringTable::RegString only and their data must not be changed
 class C4String
 {
-public:
+private:
 	C4String(StdStrBuf &&strString, C4StringTable *pTable);
 	C4String(const char *strString, C4StringTable *pTable);
+
+public:
 	virtual ~C4String();
 
 	// increment/decrement reference count on this string
@@ -35,6 +44,7 @@ public:
 	void DecRef();
 
 	StdStrBuf Data; // string data
+	std::size_t Hash; // hash of the string data
 	int iRefCnt; // reference count on string (by C4Value)
 	bool Hold; // string stays hold when RefCnt reaches 0 (for in-script strings)
 
@@ -44,8 +54,12 @@ public:
 
 	C4StringTable *pTable; // owning table
 
+	std::string_view GetView() const { return {Data.getData(), Data.getLength()}; }
+
 	void Reg(C4StringTable *pTable);
 	void UnReg();
+
+	friend class C4StringTable;
 };
 
 class C4StringTable
@@ -54,13 +68,15 @@ public:
 	C4StringTable();
 	virtual ~C4StringTable();
 
-	void Clear();
+	// drop the hold flag of all hold strings not in StillUsed, deleting unreferenced ones
+	void ReleaseHold(const std::unordered_set<const C4String *> &StillUsed);
 
+	// get the string with the given contents, creating it if necessary
 	C4String *RegString(const char *strString);
+	C4String *RegString(StdStrBuf &&strString);
 	C4String *FindString(const char *strString);
 	C4String *FindString(C4String *pString);
 	C4String *FindString(int iEnumID);
-	C4String *FindSaveString(C4String *pString);
 
 	int EnumStrings();
 
@@ -68,4 +84,9 @@ public:
 	bool Save(C4Group &ParentGroup);
 
 	C4String *First, *Last; // string list
+
+private:
+	std::unordered_map<std::string_view, C4String *> Interned; // strings by contents; the keys reference the string data
+
+	friend class C4String;
 };
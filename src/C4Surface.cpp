@@ -921,12 +921,10 @@ bool C4Surface::ReadPNG(C4Group &hGroup)
 	hGroup.Read(pData.get(), iSize);
 	// load as png file
 	std::unique_ptr<StdBitmap> bmp;
-	std::uint32_t width, height; bool useAlpha;
 	try
 	{
 		CPNGFile png(pData.get(), iSize);
-		width = png.Width(); height = png.Height(), useAlpha = png.UsesAlpha();
-		bmp.reset(new StdBitmap(width, height, useAlpha));
+		bmp.reset(new StdBitmap(png.Width(), png.Height(), png.UsesAlpha()));
 		png.Decode(bmp->GetBytes());
 	}
 	catch (const std::runtime_error &e)
@@ -938,8 +936,14 @@ bool C4Surface::ReadPNG(C4Group &hGroup)
 	pData.reset();
 	// abort if loading wasn't successful
 	if (!bmp) return false;
+	return ReadBitmap(*bmp);
+}
+
+bool C4Surface::ReadBitmap(const StdBitmap &bmp)
+{
+	const bool useAlpha{bmp.UsesAlpha()};
 	// create surface(s) - do not create an 8bit-buffer!
-	if (!Create(width, height)) return false;
+	if (!Create(bmp.GetWidth(), bmp.GetHeight())) return false;
 	// lock for writing data
 	if (!Lock()) return false;
 	if (!ppTex)
@@ -966,7 +970,7 @@ bool C4Surface::ReadPNG(C4Group &hGroup)
 				// Optimize the easy case of a png in the same format as the display
 				// 32 bit
 				uint32_t *pPix = reinterpret_cast<uint32_t *>((reinterpret_cast<char *>(pTexRef->texLock.pBits)) + iY * pTexRef->texLock.Pitch);
-				memcpy(pPix, static_cast<const std::uint32_t *>(bmp->GetPixelAddr32(0, rY)) +
+				memcpy(pPix, static_cast<const std::uint32_t *>(bmp.GetPixelAddr32(0, rY)) +
 					tX * iTexSize, maxX * 4);
 				int iX = maxX;
 				while (iX--) { if (reinterpret_cast<uint8_t *>(pPix)[3] == 0xff) *pPix = 0xff000000; ++pPix; }
@@ -977,7 +981,7 @@ bool C4Surface::ReadPNG(C4Group &hGroup)
 				// Loop through every pixel and convert
 				for (int iX = 0; iX < maxX; ++iX)
 				{
-					uint32_t dwCol = bmp->GetPixel(iX + tX * iTexSize, rY);
+					uint32_t dwCol = bmp.GetPixel(iX + tX * iTexSize, rY);
 					// if color is fully transparent, ensure it's black
 					if (dwCol >> 24 == 0xff) dwCol = 0xff000000;
 					// set pix in surface
@@ -65,6 +65,7 @@ extern CStdDDraw *lpDDraw;
 
 class C4Group;
 class C4GroupSet;
+class StdBitmap;
 
 class C4Surface
 {
@@ -117,6 +118,7 @@ public:
 	bool SavePNG(C4Group &hGroup, const char *szFilename, bool fSaveAlpha = true, bool fApplyGamma = false, bool fSaveOverlayOnly = false);
 	bool Copy(C4Surface &fromSfc);
 	bool ReadPNG(C4Group &hGroup);
+	bool ReadBitmap(const StdBitmap &bmp); // create the surface from a decoded image
 	bool ReadJPEG(C4Group &hGroup);
 
 private:
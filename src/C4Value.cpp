@@ -25,6 +25,7 @@
 #include <functional>
 #include <format>
 #include <string_view>
+#include <utility>
 
 #include <C4Game.h>
 #include <C4Object.h>
@@ -34,7 +35,7 @@ const C4Value C4VNull{};
 const C4Value C4VTrue{C4VBool(true)};
 const C4Value C4VFalse{C4VBool(false)};
 
-C4Value::~C4Value()
+void C4Value::Destroy()
 {
 	// resolve all C4Values referencing this Value
 	while (FirstRef)
@@ -75,6 +76,16 @@ C4Value &C4Value::operator=(const C4Value &nValue)
 	return *this;
 }
 
+C4Value &C4Value::operator=(C4Value &&nValue)
+{
+	// assignments to and from references keep their copy semantics
+	if (Type == C4V_pC4Value || nValue.Type == C4V_pC4Value)
+		return operator=(static_cast<const C4Value &>(nValue));
+
+	Set(std::move(nValue));
+	return *this;
+}
+
 void C4Value::AddDataRef()
 {
 	switch (Type)
@@ -118,7 +129,7 @@ void C4Value::DelDataRef(C4V_Data Data, C4V_Type Type, C4Value *pNextRef, C4Valu
 	}
 }
 
-void C4Value::Set(C4V_Data nData, C4V_Type nType)
+void C4Value::SetTracked(C4V_Data nData, C4V_Type nType)
 {
 	// Do not add this to the same linked list twice.
 	if (Data == nData && Type == nType) return;
@@ -142,7 +153,35 @@ void C4Value::Set(C4V_Data nData, C4V_Type nType)
 	CheckRemoveFromMap();
 }
 
-void C4Value::Set0()
+void C4Value::SetMoved(C4Value &&nValue)
+{
+	if (this == &nValue) return;
+	if (!nValue.IsMovable())
+	{
+		Set(nValue.Data, nValue.Type);
+		return;
+	}
+
+	C4V_Data oData = Data;
+	C4V_Type oType = Type;
+	C4Value *oNextRef = NextRef;
+	auto *oBaseContainer = BaseContainer;
+	auto oHasBaseContainer = HasBaseContainer;
+
+	// take over data and the reference it holds
+	Data = nValue.Data;
+	Type = nValue.Type;
+	nValue.Data.Raw = 0;
+	nValue.Type = C4V_Any;
+
+	// clean up
+	if (oType >= C4V_C4Object)
+		DelDataRef(oData, oType, oHasBaseContainer ? nullptr : oNextRef, oHasBaseContainer ? oBaseContainer : nullptr);
+
+	CheckRemoveFromMap();
+}
+
+void C4Value::Set0Tracked()
 {
 	C4V_Data oData = Data;
 	C4V_Type oType = Type;
@@ -671,14 +710,14 @@ C4Value C4VString(const char *strString)
 {
 	// safety
 	if (!strString) return C4Value();
-	return C4Value(new C4String(strString, &Game.ScriptEngine.Strings));
+	return C4Value(Game.ScriptEngine.Strings.RegString(strString));
 }
 
 C4Value C4VString(StdStrBuf &&Str)
 {
 	// safety
 	if (Str.isNull()) return C4Value();
-	return C4Value(new C4String(std::forward<StdStrBuf>(Str), &Game.ScriptEngine.Strings));
+	return C4Value(Game.ScriptEngine.Strings.RegString(std::forward<StdStrBuf>(Str)));
 }
 
 void C4Value::DenumeratePointer()
@@ -845,7 +884,7 @@ bool C4Value::Equals(const C4Value &other, C4AulScriptStrict strict) const
 				case C4V_Bool:
 					return _getBool() == other._getBool();
 				case C4V_String:
-					return Data.Str->Data == other.Data.Str->Data;
+					return Data.Str == other.Data.Str;
 				case C4V_Array:
 					return *Data.Array == *other.Data.Array;
 				case C4V_Map:
@@ -906,7 +945,7 @@ bool C4Value::operator==(const C4Value &Value2) const
 	case C4V_C4Object:
 		return Data == Value2.Data && Type == Value2.Type;
 	case C4V_String:
-		return Type == Value2.Type && Data.Str->Data == Value2.Data.Str->Data;
+		return Type == Value2.Type && Data.Str == Value2.Data.Str;
 	case C4V_Array:
 		return Type == Value2.Type && *(Data.Array) == *(Value2.Data.Array);
 		break;
@@ -993,8 +1032,7 @@ std::size_t std::hash<C4Value>::operator()(C4Value value) const
 
 		case C4V_String:
 		{
-			const auto &str = ref._getStr()->Data;
-			hashCombine(hash, std::hash<std::string_view>{}({str.getData(), str.getLength()}));
+			hashCombine(hash, ref._getStr()->Hash);
 			break;
 		}
 		case C4V_Array:
@@ -24,6 +24,7 @@
 #include <optional>
 #include <string>
 #include <type_traits>
+#include <utility>
 
 // class declarations
 class C4Value;
@@ -95,12 +96,25 @@ public:
 
 	C4Value(const C4Value &nValue, C4ValueHash *owningMap = nullptr) : Data(nValue.Data), Type(nValue.Type), NextRef(nullptr), FirstRef(nullptr), OwningMap(owningMap)
 	{
-		AddDataRef();
+		if (NeedsAddDataRef()) AddDataRef();
+	}
+
+	// takes over the data of movable values, which are left nil; copies all others
+	// (see IsMovable)
+	C4Value(C4Value &&nValue) noexcept : Data(nValue.Data), Type(nValue.Type), NextRef(nullptr), FirstRef(nullptr)
+	{
+		if (nValue.IsMovable())
+		{
+			nValue.Data.Raw = 0;
+			nValue.Type = C4V_Any;
+		}
+		else if (NeedsAddDataRef())
+			AddDataRef();
 	}
 
 	C4Value(C4V_Data nData, C4V_Type nType) : Data(nData), Type(nData || nType == C4V_Int || nType == C4V_Bool ? nType : C4V_Any), NextRef(nullptr), FirstRef(nullptr)
 	{
-		AddDataRef();
+		if (NeedsAddDataRef()) AddDataRef();
 	}
 
 	template<typename T> requires (!std::same_as<T, C4ID>)
@@ -149,8 +163,13 @@ public:
 	}
 
 	C4Value &operator=(const C4Value &nValue);
+	C4Value &operator=(C4Value &&nValue);
 
-	~C4Value();
+	~C4Value()
+	{
+		// plain values without references to them need no clean up
+		if (FirstRef || HasDataRef()) Destroy();
+	}
 
 	// explicit conversion from int, bool and id
 	std::optional<StdStrBuf> toString() const;
@@ -185,6 +204,14 @@ public:
 	explicit operator bool() const { return static_cast<bool>(GetRefVal().GetData()); }
 
 	void Set(const C4Value &nValue) { if (this != &nValue) Set(nValue.Data, nValue.Type); }
+	// takes over the data of movable values like the move constructor; plain values are copied
+	void Set(C4Value &&nValue)
+	{
+		if (nValue.HasDataRef())
+			SetMoved(std::move(nValue));
+		else
+			Set(static_cast<const C4Value &>(nValue));
+	}
 
 	void SetInt(C4ValueInt i) { C4V_Data d; d.Raw = 0; d.Int = i; Set(d, C4V_Int); }
 
@@ -202,7 +229,16 @@ public:
 
 	void SetRef(C4Value *nValue) { C4V_Data d; d.Ref = nValue; Set(d, C4V_pC4Value); }
 
-	void Set0();
+	void Set0()
+	{
+		if (HasDataRef() || OwningMap)
+			Set0Tracked();
+		else
+		{
+			Data.Raw = 0;
+			Type = C4V_Any;
+		}
+	}
 
 	bool Equals(const C4Value &other, C4AulScriptStrict strict) const;
 
@@ -228,6 +264,8 @@ public:
 
 	// get type of referenced value
 	C4V_Type GetType() const { return GetRefVal().Type; }
+	// get type of this value itself, which is C4V_pC4Value for references
+	C4V_Type GetRawType() const { return Type; }
 
 	// return referenced value
 	const C4Value &GetRefVal() const;
@@ -279,7 +317,28 @@ protected:
 	C4Value *GetNextRef() { if (HasBaseContainer) return nullptr; else return NextRef; }
 	C4ValueContainer *GetBaseContainer() { if (HasBaseContainer) return BaseContainer; else return nullptr; }
 
-	void Set(C4V_Data nData, C4V_Type nType);
+	// plain values (nil, int, bool and id) are neither reference counted nor linked into reference lists,
+	// so copying and destroying them doesn't need any bookkeeping
+	bool HasDataRef() const { return Type >= C4V_C4Object; }
+	bool NeedsAddDataRef() const { return HasDataRef() || (Type == C4V_Any && Data); } // untyped data has its type guessed
+	// values can be moved by taking over their data unless their address is known elsewhere:
+	// references and objects link the value into reference lists, and values may be referenced themselves or belong to a map
+	bool IsMovable() const { return !FirstRef && !OwningMap && Type != C4V_pC4Value && Type != C4V_C4Object && Type != C4V_C4ObjectEnum && (Type != C4V_Any || !Data); }
+
+	void Set(C4V_Data nData, C4V_Type nType)
+	{
+		if (!HasDataRef() && !OwningMap && (nType == C4V_Int || nType == C4V_Bool || nType == C4V_C4ID || !nData))
+		{
+			Data = nData;
+			Type = (nData || nType == C4V_Int || nType == C4V_Bool) ? nType : C4V_Any;
+			return;
+		}
+		SetTracked(nData, nType);
+	}
+	void SetTracked(C4V_Data nData, C4V_Type nType);
+	void SetMoved(C4Value &&nValue);
+	void Set0Tracked();
+	void Destroy();
 
 	void AddRef(C4Value *pRef);
 	void DelRef(const C4Value *pRef, C4Value *pNextRef, C4ValueContainer *pBaseContainer);
@@ -17,8 +17,8 @@
 #include "C4ValueHash.h"
 #include "C4StringTable.h"
 
-#include <optional>
-#include <stdexcept>
+#include <algorithm>
+#include <bit>
 
 C4ValueHash::C4ValueHash() { }
 
@@ -46,52 +46,126 @@ void C4ValueHash::DenumeratePointers()
 	}
 }
 
+std::size_t C4ValueHash::find(const C4Value &key, std::size_t hash) const
+{
+	if (index.empty()) return NotFound;
+
+	const std::size_t mask = index.size() - 1;
+	for (auto i = hash & mask; ; i = (i + 1) & mask)
+	{
+		const auto cell = index[i];
+		if (cell == EmptyIndex) return NotFound;
+		if (cell == RemovedIndex) continue;
+
+		const auto &entry = entries[cell - 1];
+		if (entry.hash == hash && entry.slot->key.Equals(key, C4AulScriptStrict::MAXSTRICT)) return cell - 1;
+	}
+}
+
+void C4ValueHash::insertIndex(std::size_t entry)
+{
+	const std::size_t mask = index.size() - 1;
+	auto i = entries[entry].hash & mask;
+	// removed cells are not reused, so the number of used cells always equals entries.size()
+	while (index[i] != EmptyIndex) i = (i + 1) & mask;
+	index[i] = static_cast<std::uint32_t>(entry + 1);
+}
+
+void C4ValueHash::rehash(std::size_t minEntries)
+{
+	// drop the holes of removed entries, keeping the insertion order
+	if (count != entries.size())
+	{
+		std::size_t live = 0;
+		for (const auto &entry : entries)
+		{
+			if (entry.slot) entries[live++] = entry;
+		}
+		entries.resize(live);
+		minEntries = std::max(minEntries, live + 1);
+	}
+
+	// keep the load factor at or below 1/2 after growing
+	index.assign(std::max<std::size_t>(std::bit_ceil(minEntries * 2), 8), EmptyIndex);
+	for (std::size_t i = 0; i < entries.size(); ++i) insertIndex(i);
+}
+
+void C4ValueHash::detach(std::size_t entry)
+{
+	const std::size_t mask = index.size() - 1;
+	auto i = entries[entry].hash & mask;
+	while (index[i] != entry + 1) i = (i + 1) & mask;
+	index[i] = RemovedIndex;
+
+	freeSlots.push_back(entries[entry].slot);
+	entries[entry].slot = nullptr;
+	--count;
+}
+
 void C4ValueHash::removeValue(C4Value *value)
 {
-	const auto erase = [this](const auto &it)
+	// clearing the other half of a slot which is being removed calls back here
+	if (detaching && (value == &detaching->key || value == &detaching->value)) return;
+
+	for (std::size_t i = 0; i < entries.size(); ++i)
 	{
-		keyOrder.erase(it->second.keyOrderIterator);
-		map.erase(it);
-	};
-	bool found = false;
-	auto keyIt = map.end();
-	for (auto it = map.begin(); it != map.end(); )
+		const auto slot = entries[i].slot;
+		if (!slot || (value != &slot->key && value != &slot->value)) continue;
+
+		detach(i);
+
+		// release whatever the other half still holds; it is reinitialized when the slot is reused
+		detaching = slot;
+		slot->key.Set0();
+		slot->value.Set0();
+		detaching = nullptr;
+		return;
+	}
+}
+
+std::size_t C4ValueHash::position(const std::uintptr_t seq) const
+{
+	std::size_t pos = 0;
+	if (!entries.empty() && seq > entries.front().seq)
 	{
-		if (&it->first == value)
+		// sequence numbers are unique and ascending, so the entry is at most this far in; it is exactly there unless entries have been compacted since
+		const std::uintptr_t guess = seq - entries.front().seq;
+		if (guess < entries.size() && entries[guess].seq == seq)
 		{
-			keyIt = it;
-			emptyValues.push_front(it->second.value);
+			pos = guess;
 		}
-		else if (it->second.value == value)
+		else
 		{
-			erase(it++);
-			found = true;
-			continue;
+			const auto last = entries.begin() + std::min<std::uintptr_t>(guess, entries.size());
+			pos = std::lower_bound(entries.begin(), last, seq, [](const Entry &entry, std::uintptr_t seq) { return entry.seq < seq; }) - entries.begin();
 		}
-		++it;
 	}
-	if (found) emptyValues.push_front(value);
-	if (keyIt != map.end()) erase(keyIt);
+
+	// skip removed entries
+	while (pos < entries.size() && !entries[pos].slot) ++pos;
+	return pos;
 }
 
 bool C4ValueHash::contains(const C4Value &key) const
 {
-	return map.find(key) != map.end();
+	return find(key, std::hash<C4Value>{}(key)) != NotFound;
 }
 
 void C4ValueHash::clear()
 {
-	for (auto &[key, value] : map) delete value.value;
-	map.clear();
-	for (auto &value : emptyValues) delete value;
-	emptyValues.clear();
+	for (const auto &entry : entries) delete entry.slot;
+	entries.clear();
+	index.clear();
+	count = 0;
+	for (auto *const slot : freeSlots) delete slot;
+	freeSlots.clear();
 }
 
 C4ValueHash &C4ValueHash::operator=(const C4ValueHash &other)
 {
-	for (const auto key : other.keyOrder)
+	for (const auto &entry : other.entries)
 	{
-		(*this)[*key].Set(*other.map.at(*key).value);
+		if (entry.slot) (*this)[entry.slot->key].Set(entry.slot->value);
 	}
 	return *this;
 }
@@ -100,9 +174,12 @@ bool C4ValueHash::operator==(const C4ValueHash &other) const
 {
 	if (other.size() != size()) return false;
 
-	for (const auto &it : map)
+	for (const auto &entry : entries)
 	{
-		if (!other.contains(it.first) || other[it.first] != *it.second.value)
+		if (!entry.slot) continue;
+
+		const auto pos = other.find(entry.slot->key, entry.hash);
+		if (pos == NotFound || other.entries[pos].slot->value != entry.slot->value)
 			return false;
 	}
 
@@ -116,78 +193,94 @@ bool C4ValueHash::hasIndex(const C4Value &key) const
 
 C4Value &C4ValueHash::operator[](const C4Value &key)
 {
-	try
+	const auto hash = std::hash<C4Value>{}(key);
+	if (const auto pos = find(key, hash); pos != NotFound)
 	{
-		return *map.at(key).value;
+		return entries[pos].slot->value;
 	}
-	catch (const std::out_of_range &)
-	{
-		C4Value *value;
-		if (emptyValues.empty()) value = C4Value::OfMap(this);
-		else
-		{
-			value = emptyValues.front();
-			emptyValues.pop_front();
-		}
 
-		const auto &inserted = map.emplace(std::piecewise_construct, std::forward_as_tuple(key, this), std::forward_as_tuple(MapEntry{value, {}})).first;
-		inserted->second.keyOrderIterator = keyOrder.insert(keyOrder.end(), &inserted->first);
-		return *value;
+	if ((entries.size() + 1) * 4 > index.size() * 3)
+	{
+		rehash(count + 1);
 	}
-}
 
-const C4Value &C4ValueHash::operator[](const C4Value &key) const
-{
-	try
+	Slot *slot;
+	if (freeSlots.empty())
 	{
-		return *map.at(key).value;
+		slot = new Slot{key, this};
 	}
-	catch (const std::out_of_range &)
+	else
 	{
-		return C4VNull;
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+		slot->key.Set(key);
 	}
+
+	entries.push_back({slot, hash, nextSeq++});
+	insertIndex(entries.size() - 1);
+	++count;
+	return slot->value;
+}
+
+const C4Value &C4ValueHash::operator[](const C4Value &key) const
+{
+	const auto pos = find(key, std::hash<C4Value>{}(key));
+	return pos != NotFound ? entries[pos].slot->value : C4VNull;
 }
 
 C4ValueHash::Iterator C4ValueHash::begin()
 {
-	return Iterator(this, keyOrder.begin(), keyOrder.end());
+	return Iterator(this, 0);
 }
 
 C4ValueHash::Iterator C4ValueHash::end()
 {
-	return Iterator(this, keyOrder.end(), keyOrder.end());
+	return Iterator(this, Iterator::EndSeq);
 }
 
-C4ValueHash::Iterator::Iterator(C4ValueHash *map, C4ValueHash::Iterator::iterator_type it, C4ValueHash::Iterator::iterator_type end) : it(it), end(end), map(map)
+C4ValueHash::Iterator::Iterator(C4ValueHash *map, std::uintptr_t seq) : map(map), seq(seq)
 {
 	update();
 }
 
+std::size_t C4ValueHash::Iterator::position() const
+{
+	return map->position(seq);
+}
+
 void C4ValueHash::Iterator::update()
 {
-	if (it != end)
+	const auto pos = position();
+
+	if (pos < map->entries.size())
 	{
-		current.emplace(**it, (*map)[**it]);
+		// stick to this entry, even if it is removed meanwhile
+		const auto &entry = map->entries[pos];
+		seq = entry.seq;
+		current.emplace(entry.slot->key, entry.slot->value);
 	}
 	else
 	{
+		seq = EndSeq;
 		current.reset();
 	}
 }
 
 C4ValueHash::Iterator &C4ValueHash::Iterator::operator++()
 {
-	++it;
+	if (seq != EndSeq) ++seq;
 	update();
 	return *this;
 }
 
 C4ValueHash::Iterator::pair_type &C4ValueHash::Iterator::operator*()
 {
+	// the map may have changed since the last step
+	update();
 	return *current;
 }
 
 bool C4ValueHash::Iterator::operator==(const C4ValueHash::Iterator &other) const
 {
-	return it == other.it;
+	return map == other.map && position() == other.position();
 }
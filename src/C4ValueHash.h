@@ -18,55 +18,79 @@
 #include "C4Value.h"
 #include "C4ValueStandardRefCountedContainer.h"
 
-#include <unordered_map>
-#include <forward_list>
-#include <list>
-#include <memory>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
 
+// insertion-ordered hash map with open addressing
+// keys and values live in separately allocated slots, because C4Values must not move: references and objects point to them
 class C4ValueHash : public C4ValueStandardRefCountedContainer<C4ValueHash>
 {
 public:
 	using key_type = C4Value;
 	using mapped_type = C4Value;
 
+	class Iterator;
+
 private:
-	struct MapEntry
+	struct Slot
 	{
-		C4Value *value;
-		std::list<const C4Value *>::iterator keyOrderIterator;
+		C4Value key, value;
+
+		Slot(const C4Value &key, C4ValueHash *map) : key{key, map}, value{C4VNull, map} {}
 	};
 
-	struct KeyEqual
+	struct Entry
 	{
-		bool operator()(const C4Value &lhs, const C4Value &rhs) const noexcept { return lhs.Equals(rhs, C4AulScriptStrict::MAXSTRICT); }
+		Slot *slot; // nullptr: removed
+		std::size_t hash;
+		std::uintptr_t seq; // ascending in insertion order; identifies the position of iterators across compaction
 	};
 
-	std::unordered_map<key_type, MapEntry, std::hash<key_type>, KeyEqual> map;
-	std::forward_list<C4Value *> emptyValues;
+	static constexpr std::uint32_t EmptyIndex = 0;
+	static constexpr std::uint32_t RemovedIndex = UINT32_MAX;
 
 	// we need a defined order for network sync
-	std::list<const C4Value *> keyOrder;
+	std::vector<Entry> entries; // in insertion order, with holes of removed entries
+	std::vector<std::uint32_t> index; // linear probing table of entry index + 1; size is a power of two
+	std::size_t count{0}; // number of entries in use
+	std::vector<Slot *> freeSlots; // slots of removed entries; kept because removed values may still be referenced
+	std::uintptr_t nextSeq{1}; // sequence number of the next inserted entry; 0 is never used
+	Slot *detaching{nullptr}; // slot currently being removed
+
+	static constexpr auto NotFound = static_cast<std::size_t>(-1);
+	std::size_t find(const C4Value &key, std::size_t hash) const;
+	void insertIndex(std::size_t entry);
+	void rehash(std::size_t minEntries);
+	void detach(std::size_t entry);
+	std::size_t position(std::uintptr_t seq) const; // first live entry whose sequence number is at least seq
 
 public:
 
+	// iterators are not registered with the map: they keep the sequence number of their entry, which survives compaction
 	class Iterator
 	{
 		using pair_type = std::pair<const C4Value &, C4Value &>;
-		using iterator_type = decltype(keyOrder.begin());
-		iterator_type it, end;
 		C4ValueHash *map;
+		std::uintptr_t seq;
 		std::optional<pair_type> current;
 
+		std::size_t position() const;
 		void update();
 
 	public:
-		Iterator(C4ValueHash *map, iterator_type it, iterator_type end);
+		static constexpr auto EndSeq = UINTPTR_MAX;
+
+		Iterator(C4ValueHash *map, std::uintptr_t seq); // at the first entry inserted no earlier than the one with sequence number seq
 
 		Iterator &operator++();
 		pair_type &operator*();
 		bool operator==(const Iterator &other) const;
-	};
 
+		bool IsEnd() const { return position() == map->entries.size(); }
+		std::uintptr_t GetSeq() const { return seq; } // resume with Iterator(map, GetSeq())
+	};
 	C4ValueHash();
 	C4ValueHash(const C4ValueHash &other);
 
@@ -85,6 +109,6 @@ public:
 
 	bool contains(const C4Value &key) const;
 	void removeValue(C4Value *value);
-	auto size() const { return map.size(); }
+	auto size() const { return count; }
 	void clear();
 };
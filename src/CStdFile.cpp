@@ -29,11 +29,13 @@
 
 #include <algorithm>
 #include <cstring>
+#include <utility>
 
 CStdFile::CStdFile()
 {
 	Status = false;
 	hFile = nullptr;
+	MappedPtr = 0;
 	ClearBuffer();
 	ModeWrite = false;
 	Name[0] = 0;
@@ -117,6 +119,21 @@ bool CStdFile::Open(const char *szFilename, bool fCompressed)
 	return true;
 }
 
+bool CStdFile::Open(const char *szFilename, std::shared_ptr<const StdMappedFile> mapped)
+{
+	if (!mapped) return false;
+	SCopy(szFilename, Name, _MAX_PATH);
+	// Set modes
+	ModeWrite = false;
+	mappedFile = std::move(mapped);
+	MappedPtr = 0;
+	// Reset buffer
+	ClearBuffer();
+	// Set status
+	Status = true;
+	return true;
+}
+
 bool CStdFile::Append(const char *szFilename)
 {
 	SCopy(szFilename, Name, _MAX_PATH);
@@ -142,6 +159,7 @@ bool CStdFile::Close()
 	// Close file(s)
 	readCompressedFile.reset();
 	writeCompressedFile.reset();
+	mappedFile.reset();
 	if (hFile) if (fclose(hFile) != 0) rval = false;
 	hFile = nullptr;
 	return !!rval;
@@ -153,8 +171,9 @@ bool CStdFile::Default()
 	Name[0] = 0;
 	readCompressedFile.reset();
 	writeCompressedFile.reset();
+	mappedFile.reset();
 	hFile = nullptr;
-	BufferLoad = BufferPtr = 0;
+	BufferLoad = BufferPtr = MappedPtr = 0;
 	return true;
 }
 
@@ -165,6 +184,15 @@ bool CStdFile::Read(void *pBuffer, size_t iSize, size_t *ipFSize)
 	if (ModeWrite) return false;
 	uint8_t *bypBuffer = static_cast<uint8_t *>(pBuffer);
 	if (ipFSize) *ipFSize = 0;
+	// Mapped: copy straight from the mapping
+	if (mappedFile)
+	{
+		const auto transfer = std::min(mappedFile->GetSize() - MappedPtr, iSize);
+		std::memcpy(bypBuffer, mappedFile->GetData() + MappedPtr, transfer);
+		MappedPtr += transfer;
+		if (ipFSize) *ipFSize = transfer;
+		return transfer == iSize;
+	}
 	while (iSize > 0)
 	{
 		// Valid data in the buffer: Transfer as much as possible
@@ -264,6 +292,7 @@ bool CStdFile::Rewind()
 {
 	if (ModeWrite) return false;
 	ClearBuffer();
+	MappedPtr = 0;
 	if (hFile) rewind(hFile);
 	if (readCompressedFile)
 	{
@@ -275,6 +304,7 @@ bool CStdFile::Rewind()
 bool CStdFile::Advance(size_t iOffset)
 {
 	if (ModeWrite) return false;
+	if (mappedFile) return Seek(MappedPtr + iOffset);
 	while (iOffset > 0)
 	{
 		// Valid data in the buffer: Transfer as much as possible
@@ -294,6 +324,40 @@ bool CStdFile::Advance(size_t iOffset)
 	return true;
 }
 
+bool CStdFile::Seek(size_t iPosition)
+{
+	if (ModeWrite) return false;
+	if (hFile)
+	{
+		ClearBuffer();
+		return !fseek(hFile, static_cast<long>(iPosition), SEEK_SET);
+	}
+	if (mappedFile)
+	{
+		if (iPosition > mappedFile->GetSize()) return false;
+		MappedPtr = iPosition;
+		return true;
+	}
+	if (!readCompressedFile) return false;
+	// target within the loaded buffer?
+	const size_t iBufferStart = readCompressedFile->Position() - BufferLoad;
+	if (iPosition >= iBufferStart && iPosition <= iBufferStart + BufferLoad)
+	{
+		BufferPtr = iPosition - iBufferStart;
+		return true;
+	}
+	ClearBuffer();
+	try
+	{
+		readCompressedFile->Seek(iPosition);
+	}
+	catch (const StdGzCompressedFile::Exception &)
+	{
+		return false;
+	}
+	return true;
+}
+
 bool CStdFile::Save(const char *szFilename, const uint8_t *bpBuf,
 					size_t iSize, bool fCompressed, bool executable, bool exclusive)
 {
@@ -342,6 +406,13 @@ size_t CStdFile::AccessedEntrySize()
 		fseek(hFile, pos, SEEK_SET);
 		return static_cast<size_t>(r);
 	}
+	if (mappedFile) return mappedFile->GetSize();
 	assert(!readCompressedFile);
 	return 0;
 }
+
+const uint8_t *CStdFile::GetMappedData(size_t iSize) const
+{
+	if (!mappedFile || iSize > mappedFile->GetSize() - MappedPtr) return nullptr;
+	return mappedFile->GetData() + MappedPtr;
+}
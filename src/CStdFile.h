@@ -20,6 +20,7 @@
 
 #include <StdFile.h>
 #include <StdGzCompressedFile.h>
+#include <StdMappedFile.h>
 
 #include <memory>
 #include <cstdio>
@@ -38,6 +39,8 @@ protected:
 	FILE *hFile;
 	std::shared_ptr<StdGzCompressedFile::Read> readCompressedFile;
 	std::shared_ptr<StdGzCompressedFile::Write> writeCompressedFile;
+	std::shared_ptr<const StdMappedFile> mappedFile; // read directly from the mapping instead of Buffer
+	size_t MappedPtr;
 	uint8_t Buffer[CStdFileBufSize];
 	size_t BufferLoad, BufferPtr;
 	bool ModeWrite;
@@ -45,6 +48,7 @@ protected:
 public:
 	bool Create(const char *szFileName, bool fCompressed = false, bool fExecutable = false, bool exclusive = false);
 	bool Open(const char *szFileName, bool fCompressed = false);
+	bool Open(const char *szFileName, std::shared_ptr<const StdMappedFile> mapped); // read the mapped contents in place of the file
 	bool Append(const char *szFilename); // append (uncompressed only)
 	bool Close();
 	bool Default();
@@ -54,6 +58,7 @@ public:
 	bool WriteString(const char *szStr);
 	bool Rewind();
 	bool Advance(size_t iOffset);
+	bool Seek(size_t iPosition); // absolute position in the (uncompressed) file contents
 	// Single line commands
 	bool Load(const char *szFileName, uint8_t **lpbpBuf,
 		size_t *ipSize = nullptr, int iAppendZeros = 0,
@@ -66,6 +71,7 @@ public:
 	// flush contents to disk
 	inline bool Flush() { if (ModeWrite && BufferLoad) return SaveBuffer(); else return true; }
 	size_t AccessedEntrySize();
+	const uint8_t *GetMappedData(size_t iSize) const; // the next iSize bytes if the file is mapped; nullptr otherwise
 
 protected:
 	void ClearBuffer();
@@ -25,6 +25,7 @@
 #include <cinttypes>
 #include <cstring>
 #include <format>
+#include <limits>
 #include <utility>
 
 StdCompiler::NameGuard::NameGuard(NameGuard &&other) noexcept
@@ -756,20 +757,20 @@ void StdCompilerINIRead::Raw(void *pData, size_t iSize, RawCompileType eType)
 std::string StdCompilerINIRead::getPosition() const
 {
 	if (pPos)
-		return std::format("line {}", SGetLine(Buf.getData(), pPos));
+		return std::format("line {}", GetLine(pPos));
 	else if (iDepth == iRealDepth)
 	{
 		if (pName->Section)
 		{
-			return std::format("section \"{}\", after line {}", pName->Name.getData(), SGetLine(Buf.getData(), pName->Pos));
+			return std::format("section \"{}\", after line {}", pName->Name.getData(), GetLine(pName->Pos));
 		}
 		else
 		{
-			return std::format("value \"{}\", line {}", pName->Name.getData(), SGetLine(Buf.getData(), pName->Pos));
+			return std::format("value \"{}\", line {}", pName->Name.getData(), GetLine(pName->Pos));
 		}
 	}
 	else if (iRealDepth)
-		return std::format("missing value/section \"{}\" inside section \"{}\" (line {})", NotFoundName.getData(), pName->Name.getData(), SGetLine(Buf.getData(), pName->Pos));
+		return std::format("missing value/section \"{}\" inside section \"{}\" (line {})", NotFoundName.getData(), pName->Name.getData(), GetLine(pName->Pos));
 	else
 		return std::format("missing value/section \"{}\"", NotFoundName.getData());
 }
@@ -783,6 +784,7 @@ void StdCompilerINIRead::Begin()
 	// Start must be inside a section
 	iDepth = iRealDepth = 0;
 	pPos = nullptr; pReenter = nullptr;
+	pLinePos = nullptr;
 }
 
 void StdCompilerINIRead::End()
@@ -1066,3 +1068,613 @@ void StdCompilerINIRead::notFound(const char *szWhat)
 {
 	excNotFound("{} expected", szWhat);
 }
+
+int StdCompilerINIRead::GetLine(const char *const pAt) const
+{
+	// count on from the last position if possible
+	if (!pLinePos || pAt < pLinePos)
+	{
+		pLinePos = Buf.getData();
+		iLinePos = 0;
+	}
+	iLinePos += SGetLine(pLinePos, pAt);
+	pLinePos = pAt;
+	return iLinePos;
+}
+
+// *** StdCompilerNamedBinWrite
+
+namespace
+{
+	constexpr char NamedBinMagic[4]{'C', '4', 'N', 'B'};
+
+	// node tags
+	enum : std::uint8_t
+	{
+		NBN_Section = 1,
+		NBN_Value = 2
+	};
+
+	// value tokens
+	enum : std::uint8_t
+	{
+		NBT_None = 0, // end of value; never written
+		NBT_Int = 0x10, // zigzag encoded
+		NBT_UInt,
+		NBT_Bool,
+		NBT_Char,
+		NBT_String,
+		NBT_Raw,
+		NBT_Sep
+	};
+
+	// little endian base 128
+	void AppendUInt(std::string &buf, std::uint64_t iValue)
+	{
+		do
+		{
+			const auto iByte = static_cast<std::uint8_t>(iValue & 0x7f);
+			iValue >>= 7;
+			buf += static_cast<char>(iValue ? iByte | 0x80 : iByte);
+		} while (iValue);
+	}
+}
+
+StdCompiler::NameGuard StdCompilerNamedBinWrite::Name(const char *szName)
+{
+	// Sub-namings exist, so it's a section
+	if (!Namings.empty() && Namings.back().Type == Naming::None)
+		PutNode(Namings.back(), true);
+	// Values can't have sub-namings
+	assert(Namings.empty() || Namings.back().Type == Naming::Section);
+	// Get name index
+	auto it = NameIndices.find(std::string_view{szName});
+	if (it == NameIndices.end())
+	{
+		it = NameIndices.emplace(szName, static_cast<std::uint32_t>(Names.size())).first;
+		Names.emplace_back(szName);
+	}
+	// Push naming; the node is put when the first value or sub-naming is
+	Namings.push_back({it->second, Naming::None, 0});
+	return {this, true};
+}
+
+void StdCompilerNamedBinWrite::NameEnd(bool fBreak)
+{
+	assert(!Namings.empty());
+	// Empty namings aren't put at all, just like in INI files
+	if (Namings.back().Type != Naming::None)
+		EndNode(Namings.back());
+	Namings.pop_back();
+}
+
+bool StdCompilerNamedBinWrite::Separator(Sep eSep)
+{
+	assert(!Namings.empty());
+	Naming &naming = Namings.back();
+	if (naming.Type == Naming::Section)
+	{
+		// Start another section with the same name
+		EndNode(naming);
+		PutNode(naming, true);
+	}
+	else
+	{
+		PrepareForValue();
+		WriteToken(NBT_Sep);
+		Body += static_cast<char>(eSep);
+	}
+	return true;
+}
+
+void StdCompilerNamedBinWrite::QWord(int64_t &rInt)
+{
+	PrepareForValue();
+	WriteToken(NBT_Int);
+	AppendUInt(Body, (static_cast<std::uint64_t>(rInt) << 1) ^ static_cast<std::uint64_t>(rInt >> 63));
+}
+
+void StdCompilerNamedBinWrite::QWord(uint64_t &rInt)
+{
+	PrepareForValue();
+	WriteToken(NBT_UInt);
+	AppendUInt(Body, rInt);
+}
+
+void StdCompilerNamedBinWrite::DWord(int32_t &rInt)    { int64_t iValue{rInt};    QWord(iValue); }
+void StdCompilerNamedBinWrite::DWord(uint32_t &rInt)   { uint64_t iValue{rInt};   QWord(iValue); }
+void StdCompilerNamedBinWrite::Word(int16_t &rShort)   { int64_t iValue{rShort};  QWord(iValue); }
+void StdCompilerNamedBinWrite::Word(uint16_t &rShort)  { uint64_t iValue{rShort}; QWord(iValue); }
+void StdCompilerNamedBinWrite::Byte(int8_t &rByte)     { int64_t iValue{rByte};   QWord(iValue); }
+void StdCompilerNamedBinWrite::Byte(uint8_t &rByte)    { uint64_t iValue{rByte};  QWord(iValue); }
+
+void StdCompilerNamedBinWrite::Boolean(bool &rBool)
+{
+	PrepareForValue();
+	WriteToken(NBT_Bool);
+	Body += static_cast<char>(rBool);
+}
+
+void StdCompilerNamedBinWrite::Character(char &rChar)
+{
+	PrepareForValue();
+	WriteToken(NBT_Char);
+	Body += rChar;
+}
+
+void StdCompilerNamedBinWrite::String(char *szString, size_t iMaxLength, RawCompileType eType)
+{
+	PrepareForValue();
+	WriteToken(NBT_String);
+	WriteData(szString, strlen(szString));
+}
+
+void StdCompilerNamedBinWrite::String(std::string &str, RawCompileType eType)
+{
+	PrepareForValue();
+	WriteToken(NBT_String);
+	WriteData(str.data(), str.size());
+}
+
+void StdCompilerNamedBinWrite::Raw(void *pData, size_t iSize, RawCompileType eType)
+{
+	PrepareForValue();
+	WriteToken(NBT_Raw);
+	WriteData(pData, iSize);
+}
+
+void StdCompilerNamedBinWrite::Begin()
+{
+	Namings.clear();
+	Names.clear();
+	NameIndices.clear();
+	Body.clear();
+}
+
+void StdCompilerNamedBinWrite::End()
+{
+	// Ensure all namings were closed properly
+	assert(Namings.empty());
+	// Header and name table
+	std::string header{NamedBinMagic, sizeof(NamedBinMagic)};
+	AppendUInt(header, FormatVersion);
+	AppendUInt(header, Names.size());
+	for (const auto &name : Names)
+	{
+		AppendUInt(header, name.size());
+		header += name;
+	}
+	// Size of the nodes, so a truncated file is noticed even if it ends between two nodes
+	AppendUInt(header, Body.size());
+	// Put together
+	Buf.New(header.size() + Body.size());
+	Buf.Write(header.data(), header.size());
+	Buf.Write(Body.data(), Body.size(), header.size());
+	Body.clear();
+}
+
+void StdCompilerNamedBinWrite::PutNode(Naming &naming, bool fSection)
+{
+	Body += static_cast<char>(fSection ? NBN_Section : NBN_Value);
+	AppendUInt(Body, naming.Name);
+	// Payload size is filled in by EndNode
+	naming.SizePos = Body.size();
+	Body.append(4, '\0');
+	naming.Type = fSection ? Naming::Section : Naming::Value;
+}
+
+void StdCompilerNamedBinWrite::EndNode(const Naming &naming)
+{
+	const auto iSize = static_cast<std::uint32_t>(Body.size() - naming.SizePos - 4);
+	for (size_t i = 0; i < 4; ++i)
+		Body[naming.SizePos + i] = static_cast<char>(iSize >> (8 * i));
+}
+
+void StdCompilerNamedBinWrite::PrepareForValue()
+{
+	// No values allowed on top-level - must be contained in at least one naming
+	assert(!Namings.empty());
+	// Put name (value-type), if not already done so
+	if (Namings.back().Type == Naming::None)
+		PutNode(Namings.back(), false);
+	// No data allowed inside of sections
+	assert(Namings.back().Type == Naming::Value);
+}
+
+void StdCompilerNamedBinWrite::WriteToken(std::uint8_t iToken)
+{
+	Body += static_cast<char>(iToken);
+}
+
+void StdCompilerNamedBinWrite::WriteData(const void *pData, size_t iSize)
+{
+	AppendUInt(Body, iSize);
+	Body.append(static_cast<const char *>(pData), iSize);
+}
+
+// *** StdCompilerNamedBinRead
+
+StdCompiler::NameGuard StdCompilerNamedBinRead::Name(const char *szName)
+{
+	// Increase depth
+	iDepth++;
+	// Parent category virtual?
+	if (iDepth - 1 > iRealDepth)
+		return {this, false};
+	// Search name; names which aren't in the name table can't be found at all
+	const auto it = NameIndices.find(szName);
+	if (it == NameIndices.end() || !EnterName(it->second))
+	{
+		NotFoundName = szName;
+		return {this, false};
+	}
+	return {this, true};
+}
+
+void StdCompilerNamedBinRead::NameEnd(bool fBreak)
+{
+	assert(iDepth > 0);
+	if (iRealDepth == iDepth)
+	{
+		// Report unused entries
+		if (!fBreak)
+			for (const auto &node : pName->Children)
+				if (!node.Used)
+					Warn("Unexpected {} \"{}\"!", node.Section ? "section" : "value", Names[node.Name]);
+		// Remove childs
+		pName->Children = {};
+		// Remove name so it won't be found again
+		pName->Used = true;
+		// Go up
+		pName = pName->Parent;
+		iRealDepth--;
+	}
+	// Decrease depth
+	iDepth--;
+	// This is the middle of nowhere
+	pPos = nullptr; pReenter = nullptr;
+}
+
+bool StdCompilerNamedBinRead::FollowName(const char *szName)
+{
+	// Current naming virtual?
+	if (iDepth > iRealDepth)
+		return false;
+	// Next section must be the one
+	const NameNode *pNext{nullptr};
+	if (pName->Parent)
+	{
+		const auto &siblings = pName->Parent->Children;
+		for (auto i = static_cast<size_t>(pName - siblings.data()) + 1; i < siblings.size(); ++i)
+			if (!siblings[i].Used)
+			{
+				pNext = &siblings[i];
+				break;
+			}
+	}
+	const auto it = NameIndices.find(szName);
+	if (!pNext || it == NameIndices.end() || pNext->Name != it->second)
+	{
+		// End current naming
+		NameEnd();
+		// Go into virtual naming
+		iDepth++;
+		return false;
+	}
+	// End current naming
+	NameEnd();
+	// Start new one
+	Name(szName).Disarm();
+	// Done
+	return true;
+}
+
+bool StdCompilerNamedBinRead::Separator(Sep eSep)
+{
+	if (iDepth > iRealDepth) return false;
+	// In section?
+	if (pName->Section)
+	{
+		// Search another section with the same name
+		const std::uint32_t iName{pName->Name};
+		NameEnd();
+		iDepth++;
+		if (EnterName(iName)) return true;
+		NotFoundName = Names[iName];
+		return false;
+	}
+	// Position saved back from separator mismatch?
+	if (pReenter) { pPos = pReenter; pReenter = nullptr; }
+	// Nothing to read?
+	if (!pPos) return false;
+	// Separator mismatch? Let all read attempts fail until the correct separator is found or the naming ends.
+	if (PeekToken() != NBT_Sep || pPos + 1 >= pName->End || pPos[1] != eSep) { pReenter = pPos; pPos = nullptr; return false; }
+	// Go over separator, success
+	pPos += 2;
+	return true;
+}
+
+void StdCompilerNamedBinRead::NoSeparator()
+{
+	// Position saved back from separator mismatch?
+	if (pReenter) { pPos = pReenter; pReenter = nullptr; }
+}
+
+int StdCompilerNamedBinRead::NameCount(const char *szName)
+{
+	// not in virtual naming
+	if (iDepth > iRealDepth || !pName || !pName->Section) return 0;
+	std::uint32_t iName{0};
+	if (szName)
+	{
+		const auto it = NameIndices.find(szName);
+		if (it == NameIndices.end()) return 0;
+		iName = it->second;
+	}
+	// count within current name
+	// if no name is given, all valid subsections are counted
+	return static_cast<int>(std::count_if(pName->Children.begin() + pName->FirstUnused, pName->Children.end(),
+		[szName, iName](const NameNode &node) { return !node.Used && (!szName || node.Name == iName); }));
+}
+
+template <class T>
+void StdCompilerNamedBinRead::ReadNum(T &rValue)
+{
+	const std::uint8_t iToken{PeekToken()};
+	if (iToken != NBT_Int && iToken != NBT_UInt)
+	{
+		notFound("Number"); return;
+	}
+	const std::uint8_t *p{pPos + 1};
+	const std::uint64_t iRaw{ReadUInt(p, pName->End)};
+	pPos = p;
+	// Any integer may be read into any type, so the size of values can change between versions
+	const auto assign = [this, &rValue](const auto iNum)
+	{
+		using Limits = std::numeric_limits<T>;
+		if (std::cmp_less(iNum, Limits::min()) || std::cmp_greater(iNum, Limits::max()))
+		{
+			Warn("number out of range ({} to {}): {} ", Limits::min(), Limits::max(), iNum);
+			rValue = std::cmp_less(iNum, Limits::min()) ? Limits::min() : Limits::max();
+		}
+		else
+			rValue = static_cast<T>(iNum);
+	};
+	if (iToken == NBT_Int)
+		assign(static_cast<std::int64_t>(iRaw >> 1) ^ -static_cast<std::int64_t>(iRaw & 1));
+	else
+		assign(iRaw);
+}
+
+void StdCompilerNamedBinRead::QWord(int64_t &rInt)   { ReadNum(rInt); }
+void StdCompilerNamedBinRead::QWord(uint64_t &rInt)  { ReadNum(rInt); }
+void StdCompilerNamedBinRead::DWord(int32_t &rInt)   { ReadNum(rInt); }
+void StdCompilerNamedBinRead::DWord(uint32_t &rInt)  { ReadNum(rInt); }
+void StdCompilerNamedBinRead::Word(int16_t &rShort)  { ReadNum(rShort); }
+void StdCompilerNamedBinRead::Word(uint16_t &rShort) { ReadNum(rShort); }
+void StdCompilerNamedBinRead::Byte(int8_t &rByte)    { ReadNum(rByte); }
+void StdCompilerNamedBinRead::Byte(uint8_t &rByte)   { ReadNum(rByte); }
+
+void StdCompilerNamedBinRead::Boolean(bool &rBool)
+{
+	switch (PeekToken())
+	{
+	case NBT_Bool:
+		if (pPos + 1 >= pName->End) { excEOF(); return; }
+		rBool = !!pPos[1];
+		pPos += 2;
+		break;
+	case NBT_Int: case NBT_UInt:
+	{
+		// numbers are accepted like in INI files
+		std::uint8_t iValue;
+		ReadNum(iValue);
+		rBool = !!iValue;
+		break;
+	}
+	default:
+		notFound("Boolean");
+	}
+}
+
+void StdCompilerNamedBinRead::Character(char &rChar)
+{
+	if (PeekToken() != NBT_Char)
+	{
+		notFound("Character"); return;
+	}
+	if (pPos + 1 >= pName->End) { excEOF(); return; }
+	rChar = static_cast<char>(pPos[1]);
+	pPos += 2;
+}
+
+void StdCompilerNamedBinRead::String(char *szString, size_t iMaxLength, RawCompileType eType)
+{
+	if (PeekToken() != NBT_String)
+	{
+		notFound("String"); return;
+	}
+	const std::string str{ReadData()};
+	SCopy(str.c_str(), szString, iMaxLength);
+}
+
+void StdCompilerNamedBinRead::String(std::string &str, RawCompileType type)
+{
+	if (PeekToken() != NBT_String)
+	{
+		notFound("String"); return;
+	}
+	str = ReadData();
+}
+
+void StdCompilerNamedBinRead::Raw(void *pData, size_t iSize, RawCompileType eType)
+{
+	const std::uint8_t iToken{PeekToken()};
+	if (iToken != NBT_Raw && iToken != NBT_String)
+	{
+		notFound("Raw data"); return;
+	}
+	const std::string_view data{ReadData()};
+	// Correct size?
+	if (data.size() != iSize)
+		Warn("got {} bytes raw data, but {} bytes expected!", data.size(), iSize);
+	// Copy
+	std::memcpy(pData, data.data(), std::min(data.size(), iSize));
+}
+
+std::string StdCompilerNamedBinRead::getPosition() const
+{
+	if (!pName)
+		return "header";
+	const auto offset = [this](const std::uint8_t *const p) { return p - static_cast<const std::uint8_t *>(Buf.getData()); };
+	if (iDepth == iRealDepth)
+	{
+		if (pName == &Root)
+			return std::format("byte {}", offset(pName->Begin));
+		else if (pPos)
+			return std::format("value \"{}\", byte {}", Names[pName->Name], offset(pPos));
+		else
+			return std::format("{} \"{}\", byte {}", pName->Section ? "section" : "value", Names[pName->Name], offset(pName->Begin));
+	}
+	else if (pName != &Root)
+		return std::format("missing value/section \"{}\" inside section \"{}\"", NotFoundName, Names[pName->Name]);
+	else
+		return std::format("missing value/section \"{}\"", NotFoundName);
+}
+
+void StdCompilerNamedBinRead::Begin()
+{
+	// Already running? This may happen if someone confuses Compile with Value.
+	assert(!iDepth && !iRealDepth);
+	pName = nullptr; pPos = pReenter = nullptr;
+	Names.clear();
+	NameIndices.clear();
+	// Header
+	const auto *p = static_cast<const std::uint8_t *>(Buf.getData());
+	const auto *const pEnd = p + Buf.getSize();
+	if (Buf.getSize() < sizeof(NamedBinMagic) || std::memcmp(p, NamedBinMagic, sizeof(NamedBinMagic)))
+	{
+		excCorrupt("not a named binary file"); return;
+	}
+	p += sizeof(NamedBinMagic);
+	if (const auto iVersion = ReadUInt(p, pEnd); iVersion > StdCompilerNamedBinWrite::FormatVersion)
+	{
+		excCorrupt("unsupported format version {}", iVersion); return;
+	}
+	// Name table
+	const auto iNameCount = ReadUInt(p, pEnd);
+	for (std::uint64_t i = 0; i < iNameCount; ++i)
+	{
+		const auto iLength = ReadUInt(p, pEnd);
+		if (iLength > static_cast<std::uint64_t>(pEnd - p)) { excEOF(); return; }
+		Names.emplace_back(reinterpret_cast<const char *>(p), static_cast<size_t>(iLength));
+		NameIndices.emplace(Names.back(), static_cast<std::uint32_t>(i));
+		p += iLength;
+	}
+	// Nodes must fill the rest exactly
+	if (const auto iBodySize = ReadUInt(p, pEnd); iBodySize != static_cast<std::uint64_t>(pEnd - p))
+	{
+		if (iBodySize > static_cast<std::uint64_t>(pEnd - p))
+			excEOF();
+		else
+			excCorrupt("{} bytes of garbage after the end", static_cast<std::uint64_t>(pEnd - p) - iBodySize);
+		return;
+	}
+	// Root section
+	Root = {};
+	Root.Section = true;
+	Root.Begin = p;
+	Root.End = pEnd;
+	Root.Parent = nullptr;
+	ReadChildren(Root);
+	// Start must be inside a section
+	pName = &Root;
+	iDepth = iRealDepth = 0;
+}
+
+void StdCompilerNamedBinRead::End()
+{
+	assert(!iDepth && !iRealDepth);
+	Root = {};
+	pName = nullptr;
+	Names.clear();
+	NameIndices.clear();
+}
+
+bool StdCompilerNamedBinRead::EnterName(std::uint32_t iName)
+{
+	// Values have no children
+	if (!pName->Section) return false;
+	// Search name
+	auto &children = pName->Children;
+	while (pName->FirstUnused < children.size() && children[pName->FirstUnused].Used)
+		++pName->FirstUnused;
+	const auto it = std::find_if(children.begin() + pName->FirstUnused, children.end(),
+		[iName](const NameNode &node) { return !node.Used && node.Name == iName; });
+	if (it == children.end()) return false;
+	// Save tree position
+	pName = &*it;
+	if (pName->Section && !pName->ChildrenRead)
+		ReadChildren(*pName);
+	pPos = pName->Section ? nullptr : pName->Begin;
+	pReenter = nullptr;
+	iRealDepth++;
+	return true;
+}
+
+void StdCompilerNamedBinRead::ReadChildren(NameNode &node)
+{
+	node.ChildrenRead = true;
+	const std::uint8_t *p{node.Begin};
+	while (p < node.End)
+	{
+		const std::uint8_t iTag{*p++};
+		if (iTag != NBN_Section && iTag != NBN_Value)
+		{
+			excCorrupt("invalid node type {}", iTag); return;
+		}
+		const auto iName = ReadUInt(p, node.End);
+		if (iName >= Names.size())
+		{
+			excCorrupt("invalid name index {}", iName); return;
+		}
+		if (node.End - p < 4) { excEOF(); return; }
+		const std::uint32_t iSize{p[0] | p[1] << 8 | p[2] << 16 | static_cast<std::uint32_t>(p[3]) << 24};
+		p += 4;
+		if (iSize > static_cast<std::uint32_t>(node.End - p)) { excEOF(); return; }
+		node.Children.push_back({static_cast<std::uint32_t>(iName), iTag == NBN_Section, false, false, 0, p, p + iSize, &node, {}});
+		p += iSize;
+	}
+}
+
+std::uint8_t StdCompilerNamedBinRead::PeekToken() const
+{
+	return pPos && pPos < pName->End ? *pPos : NBT_None;
+}
+
+std::uint64_t StdCompilerNamedBinRead::ReadUInt(const std::uint8_t *&pData, const std::uint8_t *const pEnd)
+{
+	std::uint64_t iValue{0};
+	for (int iShift = 0; ; iShift += 7)
+	{
+		if (pData >= pEnd) { excEOF(); return 0; }
+		if (iShift > 63) { excCorrupt("invalid number"); return 0; }
+		const std::uint8_t iByte{*pData++};
+		iValue |= static_cast<std::uint64_t>(iByte & 0x7f) << iShift;
+		if (!(iByte & 0x80)) return iValue;
+	}
+}
+
+std::string_view StdCompilerNamedBinRead::ReadData()
+{
+	const std::uint8_t *p{pPos + 1};
+	const auto iSize = ReadUInt(p, pName->End);
+	if (iSize > static_cast<std::uint64_t>(pName->End - p)) { excEOF(); return {}; }
+	pPos = p + iSize;
+	return {reinterpret_cast<const char *>(p), static_cast<size_t>(iSize)};
+}
+
+void StdCompilerNamedBinRead::notFound(const char *szWhat)
+{
+	excNotFound("{} expected", szWhat);
+}
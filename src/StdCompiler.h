@@ -21,10 +21,14 @@
 
 #include <assert.h>
 #include <concepts>
+#include <cstdint>
+#include <functional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 // Provides an interface of generalized compiling/decompiling
 // (serialization/deserialization - note that the term "compile" is used for both directions)
@@ -692,6 +696,10 @@ protected:
 	// Uppermost name that wasn't found
 	StdStrBuf NotFoundName;
 
+	// Last position a line number was counted for; every missing value asks for its position, mostly in reading order
+	mutable const char *pLinePos{nullptr};
+	mutable int iLinePos{0};
+
 	// * Implementation
 
 	// Name tree
@@ -728,5 +736,181 @@ protected:
 	bool TestStringEnd(RawCompileType eType);
 	char ReadEscapedChar();
 
+	void notFound(const char *szWhat);
+	int GetLine(const char *pAt) const;
+};
+
+// *** Named binary compiler
+
+// Binary encoding of the same name tree the INI compiler produces, so everything compiling
+// through StdCompilerINIRead/Write can use it without changes: sections and values may be
+// reordered, omitted (defaulting) or unknown (skipped with a warning) just like in INI files.
+// Names are stored once in a name table; values are tagged, so integers of different sizes
+// can be read back interchangeably.
+//
+// Format: magic, version, name table, size of the nodes, then the nodes of the root section. Each node is a tag,
+// the name index and the payload size; sections contain nodes, values contain tagged tokens.
+
+// binary writer
+class StdCompilerNamedBinWrite : public StdCompiler
+{
+public:
+	static constexpr std::uint32_t FormatVersion = 1;
+
+	// Result
+	typedef StdBuf OutT;
+	inline const OutT &getOutput() { return Buf; }
+
+	// Properties
+	virtual bool hasNaming() override { return true; }
+	virtual bool isVerbose() override { return false; }
+
+	// Naming
+	virtual NameGuard Name(const char *szName) override;
+	virtual void NameEnd(bool fBreak = false) override;
+
+	// Separators
+	virtual bool Separator(Sep eSep) override;
+
+	// Data writers
+	virtual void QWord(int64_t &rInt) override;
+	virtual void QWord(uint64_t &rInt) override;
+	virtual void DWord(int32_t &rInt) override;
+	virtual void DWord(uint32_t &rInt) override;
+	virtual void Word(int16_t &rShort) override;
+	virtual void Word(uint16_t &rShort) override;
+	virtual void Byte(int8_t &rByte) override;
+	virtual void Byte(uint8_t &rByte) override;
+	virtual void Boolean(bool &rBool) override;
+	virtual void Character(char &rChar) override;
+	virtual void String(char *szString, size_t iMaxLength, RawCompileType eType = RCT_Escaped) override;
+	virtual void String(std::string &str, RawCompileType eType = RCT_Escaped) override;
+	virtual void Raw(void *pData, size_t iSize, RawCompileType eType = RCT_Escaped) override;
+
+	// Passes
+	virtual void Begin() override;
+	virtual void End() override;
+
+protected:
+	struct NameHash
+	{
+		using is_transparent = void;
+		std::size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+	};
+
+	// Naming stack; like in INI files, a naming only becomes a node once something is put into it
+	struct Naming
+	{
+		std::uint32_t Name;
+		enum { None, Section, Value } Type;
+		size_t SizePos; // position of the payload size in Body
+	};
+	std::vector<Naming> Namings;
+
+	// Name table
+	std::vector<std::string> Names;
+	std::unordered_map<std::string, std::uint32_t, NameHash, std::equal_to<>> NameIndices;
+
+	// Nodes
+	std::string Body;
+
+	// Result
+	StdBuf Buf;
+
+	void PutNode(Naming &naming, bool fSection);
+	void EndNode(const Naming &naming);
+	void PrepareForValue();
+	void WriteToken(std::uint8_t iToken);
+	void WriteData(const void *pData, size_t iSize);
+};
+
+// binary reader
+class StdCompilerNamedBinRead : public StdCompiler
+{
+public:
+	// Input
+	typedef StdBuf InT;
+	void setInput(const InT &In) { Buf.Ref(In); }
+
+	// Properties
+	virtual bool isCompiler() override { return true; }
+	virtual bool hasNaming() override { return true; }
+	virtual bool isVerbose() override { return false; }
+
+	// Naming
+	virtual NameGuard Name(const char *szName) override;
+	virtual void NameEnd(bool fBreak = false) override;
+	virtual bool FollowName(const char *szName) override;
+
+	// Separators
+	virtual bool Separator(Sep eSep) override;
+	virtual void NoSeparator() override;
+
+	// Counters
+	virtual int NameCount(const char *szName = nullptr) override;
+
+	// Data readers
+	virtual void QWord(int64_t &rInt) override;
+	virtual void QWord(uint64_t &rInt) override;
+	virtual void DWord(int32_t &rInt) override;
+	virtual void DWord(uint32_t &rInt) override;
+	virtual void Word(int16_t &rShort) override;
+	virtual void Word(uint16_t &rShort) override;
+	virtual void Byte(int8_t &rByte) override;
+	virtual void Byte(uint8_t &rByte) override;
+	virtual void Boolean(bool &rBool) override;
+	virtual void Character(char &rChar) override;
+	virtual void String(char *szString, size_t iMaxLength, RawCompileType eType = RCT_Escaped) override;
+	virtual void String(std::string &str, RawCompileType eType = RCT_Escaped) override;
+	virtual void Raw(void *pData, size_t iSize, RawCompileType eType = RCT_Escaped) override;
+
+	// Position
+	virtual std::string getPosition() const override;
+
+	// Passes
+	virtual void Begin() override;
+	virtual void End() override;
+
+protected:
+	// Name tree; children of a section are only read when it is entered
+	struct NameNode
+	{
+		std::uint32_t Name;
+		bool Section;
+		bool Used{false}; // compiled already, so it won't be found again
+		bool ChildrenRead{false};
+		std::size_t FirstUnused{0}; // children before this index have all been used
+		const std::uint8_t *Begin, *End; // payload
+		NameNode *Parent;
+		std::vector<NameNode> Children;
+	};
+	NameNode Root;
+	NameNode *pName{nullptr};
+	// Current depth
+	int iDepth{0};
+	// Real depth (depth of recursive Name()-calls - if iDepth != iRealDepth, we are in a nonexistent namespace)
+	int iRealDepth{0};
+
+	// Name table
+	std::vector<std::string_view> Names;
+	std::unordered_map<std::string_view, std::uint32_t> NameIndices;
+
+	// Data
+	StdBuf Buf;
+	// Position in the current value
+	const std::uint8_t *pPos{nullptr};
+	// Reenter position (if an nonexistent separator was specified)
+	const std::uint8_t *pReenter{nullptr};
+
+	// Uppermost name that wasn't found
+	std::string NotFoundName;
+
+	bool EnterName(std::uint32_t iName);
+	void ReadChildren(NameNode &node);
+	std::uint8_t PeekToken() const;
+	std::uint64_t ReadUInt(const std::uint8_t *&pData, const std::uint8_t *pEnd);
+	std::string_view ReadData();
+	template <class T> void ReadNum(T &rValue);
+
 	void notFound(const char *szWhat);
 };
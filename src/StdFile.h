@@ -64,6 +64,7 @@ void RemoveExtension(char *szFileName);
 void RemoveExtension(StdStrBuf *psFileName);
 void AppendBackslash(char *szFileName);
 void TruncateBackslash(char *szFilename);
+void RealPath(const char *szFilename, char *pFullFilename); // pFullFilename must hold _MAX_PATH + 1 chars
 void MakeTempFilename(char *szFileName);
 void MakeTempFilename(class StdStrBuf *sFileName);
 bool WildcardListMatch(const char *szWildcardList, const char *szString); // match string in list like *.png|*.bmp
@@ -19,6 +19,7 @@
 #include <cerrno>
 #include <cstring>
 #include <format>
+#include <iterator>
 #include <memory>
 
 namespace StdGzCompressedFile
@@ -180,17 +181,11 @@ size_t Read::ReadData(uint8_t *const toBuffer, const size_t size)
 		const auto oldAvailIn = gzStream.avail_in;
 		const auto oldAvailOut = gzStream.avail_out;
 
-		if (const auto ret = inflate(&gzStream, Z_SYNC_FLUSH); ret != Z_OK)
+		// stop at the next block boundary when a checkpoint is due
+		const auto ret = inflate(&gzStream, position >= NextCheckpointPosition() ? Z_BLOCK : Z_SYNC_FLUSH);
+		if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR && gzStream.avail_out != 0)
 		{
-			if (ret == Z_STREAM_END)
-			{
-				inflateEnd(&gzStream);
-				gzStreamValid = false;
-			}
-			else if (ret != Z_BUF_ERROR && gzStream.avail_out != 0)
-			{
-				throw Exception(std::string{"inflate failed: "} + zError(ret));
-			}
+			throw Exception(std::string{"inflate failed: "} + zError(ret));
 		}
 		const auto outProgress = oldAvailOut - gzStream.avail_out;
 		position += outProgress;
@@ -199,6 +194,24 @@ size_t Read::ReadData(uint8_t *const toBuffer, const size_t size)
 		const auto inProgress = oldAvailIn - gzStream.avail_in;
 		bufferPtr += inProgress;
 		bufferedSize -= inProgress;
+
+		if (ret == Z_STREAM_END)
+		{
+			inflateEnd(&gzStream);
+			gzStreamValid = false;
+
+			// raw inflation stops in front of the gzip trailer
+			if (rawInflate)
+			{
+				rawInflate = false;
+				SkipInput(GzTrailerSize);
+			}
+		}
+		// bit 128: at a block boundary, bit 64: in the last block
+		else if ((gzStream.data_type & 128) && !(gzStream.data_type & 64) && position >= NextCheckpointPosition())
+		{
+			AddCheckpoint();
+		}
 	}
 
 	return readSize;
@@ -206,6 +219,7 @@ size_t Read::ReadData(uint8_t *const toBuffer, const size_t size)
 
 void Read::RefillBuffer()
 {
+	bufferFileOffset = ftell(file);
 	bufferedSize = static_cast<unsigned int>(fread(buffer.get(), 1, ChunkSize, file));
 	if (ferror(file)) throw Exception("fread failed");
 	bufferPtr = buffer.get();
@@ -221,9 +235,151 @@ void Read::Rewind()
 	gzStream.next_out = nullptr;
 	gzStream.avail_out = 0;
 	bufferedSize = 0;
+	rawInflate = false;
 	PrepareInflate();
 }
 
+void Read::Seek(const size_t targetPosition)
+{
+	const auto next = std::upper_bound(checkpoints.begin(), checkpoints.end(), targetPosition,
+		[](const size_t target, const Checkpoint &checkpoint) { return target < checkpoint.Position; });
+	const size_t checkpointPosition = next != checkpoints.begin() ? std::prev(next)->Position : 0;
+
+	// just inflate forward if the current position is at least as close to the target
+	if (targetPosition < position || position < checkpointPosition)
+	{
+		if (next == checkpoints.begin())
+		{
+			Rewind();
+		}
+		else
+		{
+			RestoreCheckpoint(*std::prev(next));
+		}
+	}
+
+	Skip(targetPosition - position);
+}
+
+size_t Read::NextCheckpointPosition() const
+{
+	return (checkpoints.empty() ? 0 : checkpoints.back().Position) + CheckpointSpacing;
+}
+
+void Read::AddCheckpoint()
+{
+	Checkpoint checkpoint{position, bufferFileOffset + static_cast<long>(gzStream.next_in - buffer.get()), gzStream.data_type & 7};
+	checkpoint.Window.resize(WindowSize);
+
+	uInt windowSize = WindowSize;
+	if (inflateGetDictionary(&gzStream, checkpoint.Window.data(), &windowSize) != Z_OK)
+	{
+		// seeking will inflate from an earlier checkpoint instead
+		return;
+	}
+
+	checkpoint.Window.resize(windowSize);
+	checkpoints.emplace_back(std::move(checkpoint));
+}
+
+void Read::RestoreCheckpoint(const Checkpoint &checkpoint)
+{
+	if (gzStreamValid)
+	{
+		inflateEnd(&gzStream);
+		gzStreamValid = false;
+	}
+
+	// the block may start within the previous byte
+	if (fseek(file, checkpoint.FileOffset - (checkpoint.Bits ? 1 : 0), SEEK_SET) != 0)
+	{
+		throw Exception("fseek failed");
+	}
+
+	RefillBuffer();
+
+	gzStream.zalloc = nullptr;
+	gzStream.zfree = nullptr;
+	gzStream.opaque = nullptr;
+	gzStream.next_in = bufferPtr;
+	gzStream.avail_in = bufferedSize;
+
+	// the checkpoint is inside of the deflate data, so there is no gzip header
+	if (const auto ret = inflateInit2(&gzStream, -15); ret != Z_OK)
+	{
+		throw Exception(std::string{"inflateInit2 failed: "} + zError(ret));
+	}
+
+	gzStreamValid = true;
+	rawInflate = true;
+
+	if (checkpoint.Bits)
+	{
+		if (bufferedSize == 0)
+		{
+			throw Exception("Unexpected end of file while restoring a checkpoint");
+		}
+
+		const uint8_t bits = *bufferPtr;
+		++bufferPtr;
+		--bufferedSize;
+
+		if (const auto ret = inflatePrime(&gzStream, checkpoint.Bits, bits >> (8 - checkpoint.Bits)); ret != Z_OK)
+		{
+			throw Exception(std::string{"inflatePrime failed: "} + zError(ret));
+		}
+
+		gzStream.next_in = bufferPtr;
+		gzStream.avail_in = bufferedSize;
+	}
+
+	if (const auto ret = inflateSetDictionary(&gzStream, checkpoint.Window.data(), checked_cast<uInt>(checkpoint.Window.size())); ret != Z_OK)
+	{
+		throw Exception(std::string{"inflateSetDictionary failed: "} + zError(ret));
+	}
+
+	position = checkpoint.Position;
+}
+
+void Read::Skip(size_t size)
+{
+	std::unique_ptr<uint8_t[]> skipBuffer{new uint8_t[WindowSize]};
+	for (; size > 0;)
+	{
+		const auto progress = ReadData(skipBuffer.get(), std::min<size_t>(size, WindowSize));
+		if (progress == 0)
+		{
+			throw Exception("Unexpected end of file while seeking");
+		}
+
+		size -= progress;
+	}
+}
+
+void Read::SkipInput(size_t size)
+{
+	for (; size > 0;)
+	{
+		if (bufferedSize == 0)
+		{
+			RefillBuffer();
+
+			if (bufferedSize == 0)
+			{
+				throw Exception("Unexpected end of file while skipping the gzip trailer");
+			}
+		}
+
+		const auto progress = std::min<size_t>(size, bufferedSize);
+		bufferPtr += progress;
+		bufferedSize -= static_cast<unsigned int>(progress);
+		size -= progress;
+	}
+
+	gzStream.next_in = bufferPtr;
+	gzStream.avail_in = bufferedSize;
+}
+
 Write::Write(const std::string &filename)
 {
 	file = fopen(filename.c_str(), "wb");
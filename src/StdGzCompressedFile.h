@@ -24,6 +24,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <zlib.h>
 
@@ -34,6 +35,9 @@ using Exception = std::runtime_error;
 static constexpr uint8_t C4GroupMagic[2] = {0x1e, 0x8c};
 static constexpr uint8_t GZMagic[2] = {0x1f, 0x8b};
 static constexpr auto ChunkSize = 1024 * 1024;
+static constexpr auto CheckpointSpacing = 1024 * 1024; // minimum uncompressed distance between two seek checkpoints
+static constexpr auto WindowSize = 32 * 1024; // maximum distance deflate refers back to
+static constexpr auto GzTrailerSize = 8;
 
 class Read
 {
@@ -45,9 +49,21 @@ class Read
 	unsigned int bufferedSize = 0;
 
 	FILE *file;
+	long bufferFileOffset = 0; // file offset of the start of buffer
 	size_t position = 0;
 	z_stream gzStream;
 	bool gzStreamValid = false;
+	bool rawInflate = false; // inflation was resumed at a checkpoint and does not see the gzip wrapper
+
+	// state needed to resume inflating at a deflate block boundary, recorded while reading
+	struct Checkpoint
+	{
+		size_t Position; // uncompressed position
+		long FileOffset; // offset of the first input byte that is not completely consumed
+		int Bits; // number of bits of the previous input byte which belong to the next block
+		std::vector<uint8_t> Window; // the last output, which the next block may refer back to
+	};
+	std::vector<Checkpoint> checkpoints;
 
 public:
 	Read(const std::string &filename);
@@ -55,11 +71,18 @@ public:
 	size_t UncompressedSize();
 	size_t ReadData(uint8_t *toBuffer, size_t size);
 	void Rewind();
+	void Seek(size_t targetPosition); // only inflates from the last checkpoint before the target
+	size_t Position() const { return position; }
 
 private:
 	void CheckMagicBytes();
 	void PrepareInflate();
 	void RefillBuffer();
+	size_t NextCheckpointPosition() const;
+	void AddCheckpoint();
+	void RestoreCheckpoint(const Checkpoint &checkpoint);
+	void Skip(size_t size);
+	void SkipInput(size_t size);
 };
 
 class Write
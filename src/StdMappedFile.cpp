@@ -0,0 +1,106 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "StdMappedFile.h"
+
+#include <cerrno>
+#include <cstring>
+#include <format>
+
+#ifdef _WIN32
+#include "C4Windows.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+StdMappedFile::StdMappedFile(const std::string &filename)
+{
+	const HANDLE file{CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr)};
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		throw Exception{std::format("Opening \"{}\": error {}", filename, GetLastError())};
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || !fileSize.QuadPart)
+	{
+		CloseHandle(file);
+		throw Exception{std::format("\"{}\" is empty or its size cannot be determined", filename)};
+	}
+
+	// the mapping keeps the file open
+	mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping)
+	{
+		throw Exception{std::format("Mapping \"{}\": error {}", filename, GetLastError())};
+	}
+
+	data = static_cast<const std::uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (!data)
+	{
+		CloseHandle(mapping);
+		throw Exception{std::format("Mapping a view of \"{}\": error {}", filename, GetLastError())};
+	}
+
+	size = static_cast<std::size_t>(fileSize.QuadPart);
+}
+
+StdMappedFile::~StdMappedFile()
+{
+	UnmapViewOfFile(data);
+	CloseHandle(mapping);
+}
+
+#else
+
+StdMappedFile::StdMappedFile(const std::string &filename)
+{
+	const int fd{open(filename.c_str(), O_RDONLY)};
+	if (fd == -1)
+	{
+		throw Exception{std::format("Opening \"{}\": {}", filename, std::strerror(errno))};
+	}
+
+	struct stat status;
+	if (fstat(fd, &status) != 0 || status.st_size <= 0)
+	{
+		close(fd);
+		throw Exception{std::format("\"{}\" is empty or its size cannot be determined", filename)};
+	}
+
+	// the mapping stays valid after closing the descriptor
+	void *const mapped{mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, fd, 0)};
+	close(fd);
+	if (mapped == MAP_FAILED)
+	{
+		throw Exception{std::format("Mapping \"{}\": {}", filename, std::strerror(errno))};
+	}
+
+	data = static_cast<const std::uint8_t *>(mapped);
+	size = static_cast<std::size_t>(status.st_size);
+}
+
+StdMappedFile::~StdMappedFile()
+{
+	munmap(const_cast<std::uint8_t *>(data), size);
+}
+
+#endif
@@ -0,0 +1,45 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// read-only memory mapping of a whole file
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+class StdMappedFile
+{
+public:
+	using Exception = std::runtime_error;
+
+	explicit StdMappedFile(const std::string &filename);
+	~StdMappedFile();
+
+	StdMappedFile(const StdMappedFile &) = delete;
+	StdMappedFile &operator=(const StdMappedFile &) = delete;
+
+	const std::uint8_t *GetData() const { return data; }
+	std::size_t GetSize() const { return size; }
+
+private:
+	const std::uint8_t *data{nullptr};
+	std::size_t size{0};
+#ifdef _WIN32
+	void *mapping{nullptr};
+#endif
+};
@@ -0,0 +1,79 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "C4TestEngine.h"
+
+#include <C4Application.h>
+#include <C4Console.h>
+#include <C4FullScreen.h>
+#include <C4Script.h>
+
+#include <format>
+
+// the globals of C4WinMain.cpp, which isn't part of the engine library
+C4Application Application;
+C4Console Console;
+C4FullScreen FullScreen;
+C4Game Game;
+C4Config Config;
+
+C4TestScript::C4TestScript(const std::string_view source, const char *const szName)
+{
+	Script.Copy(source.data(), source.size());
+	ScriptName = szName;
+	Reg2List(&Game.ScriptEngine, &Game.ScriptEngine);
+	Preparse();
+}
+
+std::vector<C4AulBCC> C4TestScript::GetCode(const char *const szFunc)
+{
+	std::vector<C4AulBCC> code;
+	const C4AulScriptFunc *const pFunc{GetSFunc(szFunc)};
+	if (!pFunc || !pFunc->Code) return code;
+	for (const C4AulBCC *pCPos = pFunc->Code; ; ++pCPos)
+	{
+		code.push_back(*pCPos);
+		if (pCPos->bccType == AB_EOFN) break;
+	}
+	return code;
+}
+
+C4Value C4TestScript::Call(const char *const szFunc, const C4AulParSet &Pars)
+{
+	C4AulScriptFunc *const pFunc{GetSFunc(szFunc)};
+	if (!pFunc) throw C4AulExecError{nullptr, std::format("no function {} in {}", szFunc, ScriptName)};
+	return pFunc->Exec(nullptr, Pars, true);
+}
+
+namespace C4TestEngine
+{
+	void ResetScriptEngine()
+	{
+		// cached byte code of earlier test scripts must not be reused
+		Config.Developer.CacheScripts = false;
+		Game.ScriptEngine.Clear();
+		InitFunctionMap(&Game.ScriptEngine);
+	}
+
+	C4TestScript &LoadScript(const std::string_view source)
+	{
+		ResetScriptEngine();
+		auto *const pScript = new C4TestScript{source};
+		Game.ScriptEngine.Link(&Game.Defs);
+		Game.ScriptEngine.GlobalNamed.SetNameList(&Game.ScriptEngine.GlobalNamedNames);
+		return *pScript;
+	}
+}
@@ -0,0 +1,43 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// engine setup shared by the tests that link the engine library
+
+#pragma once
+
+#include <C4Aul.h>
+
+#include <string_view>
+#include <vector>
+
+// script that is preparsed from a string instead of a group file; registered in Game.ScriptEngine, which deletes it
+class C4TestScript : public C4AulScript
+{
+public:
+	C4TestScript(std::string_view source, const char *szName = "Test.c");
+
+	// byte code of a function up to and including its AB_EOFN chunk
+	std::vector<C4AulBCC> GetCode(const char *szFunc);
+	// call a function of this script like the engine does
+	C4Value Call(const char *szFunc, const C4AulParSet &Pars = C4AulParSet{});
+};
+
+namespace C4TestEngine
+{
+	// clear Game.ScriptEngine and register the engine functions and constants again
+	void ResetScriptEngine();
+	// reset the script engine, then link it with the given script
+	C4TestScript &LoadScript(std::string_view source);
+}
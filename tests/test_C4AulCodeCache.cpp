@@ -0,0 +1,190 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "C4TestEngine.h"
+
+#include <C4Components.h>
+#include <C4Config.h>
+#include <C4Game.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	using Code = std::vector<std::pair<C4AulBCCType, std::intptr_t>>;
+
+	// type and operand of each chunk without the pointers, which differ between links
+	Code GetCode(C4TestScript &script, const char *const szFunc)
+	{
+		Code code;
+		for (const auto &bcc : script.GetCode(szFunc))
+		{
+			const bool pointer{bcc.bccType == AB_FUNC || bcc.bccType == AB_CALL || bcc.bccType == AB_CALLFS || bcc.bccType == AB_STRING};
+			code.emplace_back(bcc.bccType, pointer ? 0 : bcc.bccX);
+		}
+		return code;
+	}
+
+	// the cache file lives in a directory of its own for each run, so that concurrent runs of the tests don't share it
+	const std::filesystem::path &CacheDirectory()
+	{
+		static const struct TempDirectory
+		{
+			std::filesystem::path Path{std::filesystem::temp_directory_path() / std::format("C4AulCodeCacheTest-{:08x}", std::random_device{}())};
+			TempDirectory() { std::filesystem::create_directories(Path); }
+			~TempDirectory() { std::filesystem::remove_all(Path); }
+		} directory;
+		return directory.Path;
+	}
+
+	std::filesystem::path CacheFile()
+	{
+		return CacheDirectory() / C4CFN_ScriptCodeCache;
+	}
+
+	struct LinkResult
+	{
+		std::vector<C4TestScript *> Scripts;
+		std::uint64_t Hits, Misses;
+	};
+
+	// link the scripts with the code cache in the temporary directory
+	LinkResult LinkCached(const std::vector<std::string_view> &sources)
+	{
+		C4TestEngine::ResetScriptEngine();
+		Config.Developer.CacheScripts = true;
+		SCopy((CacheDirectory().string() + DirSep).c_str(), Config.General.ExePath, CFG_MaxString);
+
+		LinkResult result;
+		for (std::size_t i = 0; i < sources.size(); ++i)
+			result.Scripts.push_back(new C4TestScript{sources[i], std::format("Test{}.c", i).c_str()});
+
+		const auto hits = Game.ScriptEngine.CodeCacheHits, misses = Game.ScriptEngine.CodeCacheMisses;
+		Game.ScriptEngine.Link(&Game.Defs);
+		Game.ScriptEngine.GlobalNamed.SetNameList(&Game.ScriptEngine.GlobalNamedNames);
+		result.Hits = Game.ScriptEngine.CodeCacheHits - hits;
+		result.Misses = Game.ScriptEngine.CodeCacheMisses - misses;
+
+		Config.Developer.CacheScripts = false;
+		return result;
+	}
+
+	constexpr std::string_view Library{"#strict 2\nstatic const Offset = 5;\nglobal func Twice(int x) { return 2 * x; }"};
+	constexpr std::string_view User{"#strict 2\nfunc f() { return Twice(Offset) + GetLength(\"abc\"); }\nfunc g() { var a = [1, 2]; a[0] = 7; return a[0] + a[1]; }"};
+	constexpr std::string_view Other{"#strict 2\nfunc h() { return 1; }"};
+}
+
+TEST_CASE("Unchanged scripts are taken from the code cache", "[C4AulCodeCache]")
+{
+	std::filesystem::remove(CacheFile());
+
+	auto first = LinkCached({Library, User});
+	CHECK(first.Hits == 0);
+	CHECK(first.Misses == 2);
+	CHECK(first.Scripts[1]->Call("f").getInt() == 13);
+	const Code f{GetCode(*first.Scripts[1], "f")}, g{GetCode(*first.Scripts[1], "g")};
+
+	// the functions and strings of the cached code belong to the new link
+	auto second = LinkCached({Library, User});
+	CHECK(second.Hits == 2);
+	CHECK(second.Misses == 0);
+	CHECK(GetCode(*second.Scripts[1], "f") == f);
+	CHECK(GetCode(*second.Scripts[1], "g") == g);
+	CHECK(second.Scripts[1]->Call("f").getInt() == 13);
+	CHECK(second.Scripts[1]->Call("g").getInt() == 9);
+}
+
+TEST_CASE("Only changed scripts are parsed again", "[C4AulCodeCache]")
+{
+	std::filesystem::remove(CacheFile());
+	LinkCached({Library, User, Other});
+
+	auto changed = LinkCached({Library, User, "#strict 2\nfunc h() { return 2; }"});
+	CHECK(changed.Hits == 2);
+	CHECK(changed.Misses == 1);
+	CHECK(changed.Scripts[2]->Call("h").getInt() == 2);
+	CHECK(changed.Scripts[1]->Call("f").getInt() == 13);
+
+	// the entries of both versions are kept
+	auto back = LinkCached({Library, User, Other});
+	CHECK(back.Hits == 3);
+	CHECK(back.Scripts[2]->Call("h").getInt() == 1);
+}
+
+TEST_CASE("Cached code is checked against the scripts it uses", "[C4AulCodeCache]")
+{
+	std::filesystem::remove(CacheFile());
+	LinkCached({Library, User});
+
+	SECTION("a changed constant is inlined again")
+	{
+		auto result = LinkCached({"#strict 2\nstatic const Offset = 6;\nglobal func Twice(int x) { return 2 * x; }", User});
+		CHECK(result.Hits == 0);
+		CHECK(result.Misses == 2);
+		CHECK(result.Scripts[1]->Call("f").getInt() == 15);
+	}
+
+	SECTION("a changed parameter list is parsed again")
+	{
+		auto result = LinkCached({"#strict 2\nstatic const Offset = 5;\nglobal func Twice(int x, int y) { return 2 * x + y; }", User});
+		CHECK(result.Misses == 2);
+		CHECK(result.Scripts[1]->Call("f").getInt() == 13);
+	}
+
+	SECTION("a function that moved to another script is linked to its new place")
+	{
+		auto result = LinkCached({"#strict 2\nstatic const Offset = 5;", User, "#strict 2\nglobal func Twice(int x) { return 2 * x; }"});
+		CHECK(result.Hits == 1);
+		CHECK(result.Misses == 2);
+		CHECK(result.Scripts[1]->Call("f").getInt() == 13);
+	}
+}
+
+TEST_CASE("A damaged code cache falls back to parsing", "[C4AulCodeCache]")
+{
+	std::filesystem::remove(CacheFile());
+	LinkCached({Library, User});
+
+	SECTION("garbage")
+	{
+		std::ofstream{CacheFile(), std::ios::binary} << "not a code cache";
+	}
+
+	SECTION("truncated")
+	{
+		std::filesystem::resize_file(CacheFile(), std::filesystem::file_size(CacheFile()) / 2);
+	}
+
+	auto damaged = LinkCached({Library, User});
+	CHECK(damaged.Hits == 0);
+	CHECK(damaged.Misses == 2);
+	CHECK(damaged.Scripts[1]->Call("f").getInt() == 13);
+
+	// rewritten by the fallback
+	auto repaired = LinkCached({Library, User});
+	CHECK(repaired.Hits == 2);
+	CHECK(repaired.Scripts[1]->Call("g").getInt() == 9);
+}
@@ -0,0 +1,343 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "C4TestEngine.h"
+
+#include <C4Application.h>
+#include <C4Components.h>
+#include <C4Def.h>
+#include <C4Game.h>
+#include <C4Group.h>
+#include <C4Object.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// Fused works on a local variable and constants, which is what the superinstructions match;
+	// Plain does the same on its parameter and variables, which executes the original sequences
+	constexpr std::string_view SuperinstructionScript{
+		"#strict 3\n"
+		"func Fused(a) {\n"
+		"  var x = a, n = 0, r = [];\n"
+		"  while (x < 5) { x++; if (++n > 10) break; }\n"
+		"  r[0] = x; x = a; n = 0;\n"
+		"  while (x >= -3) { x -= 2; if (++n > 10) break; }\n"
+		"  r[1] = x; x = a; n = 0;\n"
+		"  while (x <= 20) { x += 7; --x; if (++n > 10) break; }\n"
+		"  r[2] = x; x = a; n = 0;\n"
+		"  while (x > 0) { x--; if (++n > 10) break; }\n"
+		"  r[3] = x; x = a;\n"
+		"  r[4] = x * 3; r[5] = x / 2; r[6] = x % 4; r[7] = x - 1; r[8] = x + 1; r[9] = x / 0; r[10] = x % 0;\n"
+		"  return r;\n"
+		"}\n"
+		"func Plain(a) {\n"
+		"  var b = a, n = 0, r = [], c0 = 0, c1 = 1, c2 = 2, c3 = 3, c4 = 4, c5 = 5, c7 = 7, c10 = 10, c20 = 20, cm3 = -3;\n"
+		"  while (a < c5) { a++; if (++n > c10) break; }\n"
+		"  r[0] = a; a = b; n = 0;\n"
+		"  while (a >= cm3) { a -= c2; if (++n > c10) break; }\n"
+		"  r[1] = a; a = b; n = 0;\n"
+		"  while (a <= c20) { a += c7; --a; if (++n > c10) break; }\n"
+		"  r[2] = a; a = b; n = 0;\n"
+		"  while (a > c0) { a--; if (++n > c10) break; }\n"
+		"  r[3] = a; a = b;\n"
+		"  r[4] = a * c3; r[5] = a / c2; r[6] = a % c4; r[7] = a - c1; r[8] = a + c1; r[9] = a / c0; r[10] = a % c0;\n"
+		"  return r;\n"
+		"}\n"
+	};
+
+	std::size_t CountChunks(const std::vector<C4AulBCC> &code, const C4AulBCCType eType)
+	{
+		return std::count_if(code.begin(), code.end(), [eType](const C4AulBCC &bcc) { return bcc.bccType == eType; });
+	}
+
+	// puts the original chunks back in place of the superinstructions, so the function executes like before they were generated
+	void Unfuse(C4AulScriptFunc *const pFunc)
+	{
+		for (C4AulBCC *pCPos = pFunc->Code; pCPos->bccType != AB_EOFN; ++pCPos)
+			switch (pCPos->bccType)
+			{
+			case AB_VARN_CMP_CONDN: pCPos->bccType = AB_VARN_V; break;
+			case AB_VARN_STEP: case AB_VARN_ADDINT: pCPos->bccType = AB_VARN_R; break;
+			case AB_INT_OP: pCPos->bccType = AB_INT; break;
+			default: break;
+			}
+	}
+
+	// result of a call as text, so that failing calls can be compared as well
+	std::string CallToString(C4TestScript &script, const char *const szFunc, const C4Value &par)
+	{
+		try
+		{
+			return script.Call(szFunc, C4AulParSet{par}).GetDataString();
+		}
+		catch (const C4AulError &)
+		{
+			return "error";
+		}
+	}
+}
+
+TEST_CASE("Superinstructions are generated for their sequences only", "[C4AulExec]")
+{
+	auto &script = C4TestEngine::LoadScript(SuperinstructionScript);
+
+	const auto fused = script.GetCode("Fused");
+	CHECK(CountChunks(fused, AB_VARN_CMP_CONDN) == 4);
+	CHECK(CountChunks(fused, AB_VARN_STEP) == 3);
+	CHECK(CountChunks(fused, AB_VARN_ADDINT) == 2);
+	CHECK(CountChunks(fused, AB_INT_OP) == 7);
+
+	const auto plain = script.GetCode("Plain");
+	for (const auto eType : {AB_VARN_CMP_CONDN, AB_VARN_STEP, AB_VARN_ADDINT, AB_INT_OP})
+		CHECK(CountChunks(plain, eType) == 0);
+}
+
+TEST_CASE("Superinstructions compute the same as the sequences they replace", "[C4AulExec]")
+{
+	auto &script = C4TestEngine::LoadScript(SuperinstructionScript);
+
+	// ints take the shortcuts, everything else falls back to the original sequence
+	for (const C4Value &par : {C4VInt(0), C4VInt(3), C4VInt(-7), C4VInt(100), C4Value{}, C4VBool(true), C4VString("x")})
+	{
+		const std::string fused{CallToString(script, "Fused", par)};
+		INFO("a = " << par.GetDataString() << ": " << fused);
+		CHECK(fused == CallToString(script, "Plain", par));
+	}
+
+	CHECK(CallToString(script, "Fused", C4VInt(3)) == "[5, -5, 21, 0, 9, 1, 3, 2, 4, nil, nil]");
+}
+
+namespace
+{
+	// a definition folder with a script, loaded into Game.Defs; the definition is removed again at the end of the test
+	class C4TestDef
+	{
+	public:
+		C4TestDef(const char *const szID, const std::string_view script)
+			: Path{std::filesystem::temp_directory_path() / std::format("C4AulExecTest-{}-{:08x}.c4d", szID, std::random_device{}())}, ID{C4Id(szID)}
+		{
+			std::filesystem::create_directories(Path);
+			std::ofstream{Path / C4CFN_DefCore} << std::format("[DefCore]\nid={}\nVersion=4,9,10,7\nCategory=C4D_Object\nWidth=10\nHeight=10\n", szID);
+			SetScript(script);
+
+			auto *const pDef = new C4Def;
+			C4Group group;
+			REQUIRE(group.Open(Path.string().c_str()));
+			REQUIRE(pDef->Load(group, C4D_Load_Script, "US", nullptr));
+			Game.Defs.Add(pDef, false);
+		}
+
+		~C4TestDef()
+		{
+			delete Object;
+			if (C4Def *const pDef{GetDef()}) Game.Defs.Remove(pDef);
+			std::filesystem::remove_all(Path);
+		}
+
+		void SetScript(const std::string_view script)
+		{
+			std::ofstream{Path / "Script.c"} << script;
+		}
+
+		void Break()
+		{
+			std::filesystem::remove(Path / C4CFN_DefCore);
+		}
+
+		C4Def *GetDef() { return Game.Defs.ID2Def(ID); }
+
+		// an object of the definition to call functions in; not in any object list
+		C4Object *GetObject()
+		{
+			if (!Object)
+			{
+				Object = new C4Object;
+				Object->Def = GetDef();
+				Object->id = ID;
+				Object->Status = C4OS_NORMAL;
+			}
+			return Object;
+		}
+
+		void DeleteObject()
+		{
+			delete Object;
+			Object = nullptr;
+		}
+
+	private:
+		std::filesystem::path Path;
+		C4ID ID;
+		C4Object *Object{nullptr};
+	};
+
+	constexpr std::string_view CallerScript{"#strict 2\nfunc CallValue(object obj) { return obj->~Value(); }"};
+}
+
+TEST_CASE("Object calls are resolved again after the scripts changed", "[C4AulExec]")
+{
+	C4TestEngine::ResetScriptEngine();
+	C4TestDef first{"TSTA", "#strict 2\nfunc Value() { return 1; }"};
+	C4TestDef second{"TSTB", "#strict 2\nfunc Value() { return 2; }"};
+	auto *const pCaller = new C4TestScript{CallerScript};
+	Game.ScriptEngine.Link(&Game.Defs);
+	const auto call = [&](C4TestDef &def) { return pCaller->Call("CallValue", C4AulParSet{C4VObj(def.GetObject())}).getInt(); };
+
+	// each definition called at the same site has an entry of its own
+	CHECK(call(first) == 1);
+	CHECK(call(second) == 2);
+	const auto hits = Game.ScriptEngine.CallCacheHits;
+	CHECK(call(first) == 1);
+	CHECK(call(second) == 2);
+	CHECK(Game.ScriptEngine.CallCacheHits == hits + 2);
+
+	SECTION("unlinked")
+	{
+		Game.ScriptEngine.UnLink();
+		CHECK(Game.ScriptEngine.CallCaches.empty());
+		Game.ScriptEngine.Link(&Game.Defs);
+		CHECK(call(first) == 1);
+	}
+
+	SECTION("reloaded definition")
+	{
+		first.SetScript("#strict 2\nfunc Value() { return 3; }");
+		REQUIRE(Game.ReloadDef(C4Id("TSTA"), C4D_Load_Script));
+		CHECK(Game.ScriptEngine.CallCaches.empty());
+		CHECK(call(first) == 3);
+		CHECK(call(second) == 2);
+	}
+
+	SECTION("function removed by reloading")
+	{
+		first.SetScript("#strict 2\nfunc Other() { return 3; }");
+		REQUIRE(Game.ReloadDef(C4Id("TSTA"), C4D_Load_Script));
+		CHECK(call(first) == 0);
+	}
+
+	SECTION("definition removed after a failed reload")
+	{
+		// the object would be removed along with its definition
+		first.DeleteObject();
+		first.Break();
+		CHECK(!Game.ReloadDef(C4Id("TSTA"), C4D_Load_Script));
+		CHECK(!first.GetDef());
+		CHECK(Game.ScriptEngine.CallCaches.empty());
+		CHECK(call(second) == 2);
+	}
+}
+
+TEST_CASE("The profiler records the call stacks of scripts", "[C4AulExec]")
+{
+	auto &script = C4TestEngine::LoadScript(
+		"#strict 2\n"
+		"func Inner() { var n = 0; for (var i = 0; i < 100; ++i) n += GetLength(\"abc\"); return n; }\n"
+		"func Recurse(int depth) { var n = 0; for (var i = 0; i < 100; ++i) ++n; if (depth) n += Recurse(depth - 1); return n; }\n"
+		"func Outer() { var n = 0; for (var i = 0; i < 100; ++i) ++n; return n + Inner() + Inner() + Recurse(2); }\n");
+
+	const std::filesystem::path directory{std::filesystem::temp_directory_path() / std::format("C4AulExecTest-{:08x}", std::random_device{}())};
+	std::filesystem::create_directories(directory);
+	SCopy((directory.string() + DirSep).c_str(), Config.General.ExePath, CFG_MaxString);
+	// the profiler shows its statistics in the log, which the application opens at startup
+	[[maybe_unused]] static const bool logOpened{[] { Application.LogSystem.OpenLog(false); return true; }()};
+
+	C4AulProfiler::StartProfiling(&Game.ScriptEngine);
+	CHECK(script.Call("Outer").getInt() == 100 + 2 * 300 + 300);
+	C4AulProfiler::StopProfiling();
+
+	// each call path once, with the exclusive time after the last space
+	std::vector<std::string> stacks;
+	std::ifstream folded{directory / C4CFN_ScriptProfile};
+	for (std::string line; std::getline(folded, line); )
+	{
+		const std::size_t iSpace{line.rfind(' ')};
+		REQUIRE(iSpace != std::string::npos);
+		CHECK(std::stoull(line.substr(iSpace + 1)) > 0);
+		stacks.push_back(line.substr(0, iSpace));
+	}
+	folded.close();
+	std::filesystem::remove_all(directory);
+
+	const std::string outer{C4AulProfiler::GetFuncName(script.GetSFunc("Outer"))};
+	const std::string inner{outer + ";" + C4AulProfiler::GetFuncName(script.GetSFunc("Inner"))};
+	const std::string recurse{C4AulProfiler::GetFuncName(script.GetSFunc("Recurse"))};
+	std::vector<std::string> expected{outer, inner, inner + ";engine GetLength", outer + ";" + recurse, outer + ";" + recurse + ";" + recurse, outer + ";" + recurse + ";" + recurse + ";" + recurse};
+	std::sort(stacks.begin(), stacks.end());
+	std::sort(expected.begin(), expected.end());
+	CHECK(stacks == expected);
+}
+
+TEST_CASE("Script execution", "[.][benchmark][C4AulExec]")
+{
+	constexpr std::string_view source{
+		"#strict 2\n"
+		"func Loop() { var sum = 0; for (var i = 0; i < 10000; ++i) sum += i % 7; return sum; }\n"
+		"func Add(a, b) { return a + b; }\n"
+		"func Calls() { var sum = 0; for (var i = 0; i < 10000; ++i) sum = Add(sum, i); return sum; }\n"
+		"func Arrays() { var a = CreateArray(100); for (var i = 0; i < 10000; ++i) a[i % 100] += i; return a[42]; }\n"};
+	auto &script = C4TestEngine::LoadScript(source);
+
+	// the same script without superinstructions; the engine owns both
+	auto &plain = *new C4TestScript{source};
+	Game.ScriptEngine.Link(&Game.Defs);
+	for (const char *const szFunc : {"Loop", "Add", "Calls", "Arrays"})
+	{
+		Unfuse(plain.GetSFunc(szFunc));
+		CHECK(script.Call(szFunc, C4AulParSet{C4VInt(1), C4VInt(2)}) == plain.Call(szFunc, C4AulParSet{C4VInt(1), C4VInt(2)}));
+	}
+	REQUIRE(CountChunks(script.GetCode("Loop"), AB_VARN_CMP_CONDN) == 1);
+	REQUIRE(CountChunks(plain.GetCode("Loop"), AB_VARN_CMP_CONDN) == 0);
+
+	BENCHMARK("loop")
+	{
+		return script.Call("Loop");
+	};
+
+	BENCHMARK("loop (plain)")
+	{
+		return plain.Call("Loop");
+	};
+
+	BENCHMARK("calls")
+	{
+		return script.Call("Calls");
+	};
+
+	BENCHMARK("calls (plain)")
+	{
+		return plain.Call("Calls");
+	};
+
+	BENCHMARK("array access")
+	{
+		return script.Call("Arrays");
+	};
+
+	BENCHMARK("array access (plain)")
+	{
+		return plain.Call("Arrays");
+	};
+}
@@ -0,0 +1,183 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "C4TestEngine.h"
+
+#include <C4Config.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	using Code = std::vector<std::pair<C4AulBCCType, std::intptr_t>>;
+
+	// type and operand of each chunk; operands of calls are function pointers and those of operators indices into the operator table, so both are left out
+	Code GetCode(C4TestScript &script, const char *const szFunc)
+	{
+		Code code;
+		for (const auto &bcc : script.GetCode(szFunc))
+		{
+			const bool pointer{bcc.bccType == AB_FUNC || bcc.bccType == AB_CALL || bcc.bccType == AB_CALLFS || bcc.bccType == AB_STRING};
+			code.emplace_back(bcc.bccType, pointer || Inside(bcc.bccType, AB_Inc1, AB_Set) ? 0 : bcc.bccX);
+		}
+		return code;
+	}
+
+	C4TestScript &LoadScript(const std::string &source, const bool fOptimize, const C4AulScriptStrict minStrictness = C4AulScriptStrict::NONSTRICT)
+	{
+		Config.Developer.OptimizeScripts = fOptimize;
+		Config.Developer.OptimizeScriptsStrictness = {minStrictness};
+		return C4TestEngine::LoadScript(source);
+	}
+}
+
+TEST_CASE("Operators on constants are folded", "[C4AulParse]")
+{
+	SECTION("arithmetic")
+	{
+		auto &script = LoadScript("#strict 3\nfunc f() { return 2 * 3 + 1; }", true);
+		CHECK(GetCode(script, "f") == Code{{AB_INT, 7}, {AB_RETURN, 0}, {AB_EOFN, 0}});
+	}
+
+	SECTION("comparisons result in booleans")
+	{
+		auto &script = LoadScript("#strict 3\nfunc f() { return 1 < 2; }", true);
+		CHECK(GetCode(script, "f") == Code{{AB_BOOL, 1}, {AB_RETURN, 0}, {AB_EOFN, 0}});
+	}
+
+	SECTION("unary operators")
+	{
+		auto &script = LoadScript("#strict 3\nfunc f() { return -(4 | 1); }", true);
+		CHECK(GetCode(script, "f") == Code{{AB_INT, -5}, {AB_RETURN, 0}, {AB_EOFN, 0}});
+	}
+
+	SECTION("a zero result stays an integer in non-strict scripts")
+	{
+		auto &script = LoadScript("func f() { return 1 - 1; }", true);
+		CHECK(GetCode(script, "f") == Code{{AB_INT, 0}, {AB_RETURN, 0}, {AB_EOFN, 0}});
+	}
+}
+
+TEST_CASE("Operators without a compile-time result are kept", "[C4AulParse]")
+{
+	SECTION("division by zero")
+	{
+		auto &script = LoadScript("#strict 3\nfunc f() { return 1 / 0; }", true);
+		CHECK(GetCode(script, "f") == Code{{AB_INT, 1}, {AB_INT_OP, 0}, {AB_Div, 0}, {AB_RETURN, 0}, {AB_EOFN, 0}});
+		CHECK(script.Call("f").GetType() == C4V_Any);
+	}
+
+	SECTION("overflow")
+	{
+		auto &script = LoadScript("#strict 3\nfunc f() { return 2147483647 + 1; }", true);
+		CHECK(GetCode(script, "f") == Code{{AB_INT, 2147483647}, {AB_INT_OP, 1}, {AB_Sum, 0}, {AB_RETURN, 0}, {AB_EOFN, 0}});
+	}
+
+	SECTION("variable operands")
+	{
+		auto &script = LoadScript("#strict 3\nfunc f(a) { return a * 2; }", true);
+		CHECK(GetCode(script, "f") == Code{{AB_PARN_V, 0}, {AB_INT_OP, 2}, {AB_Mul, 0}, {AB_RETURN, 0}, {AB_EOFN, 0}});
+	}
+
+	SECTION("disabled optimization")
+	{
+		auto &script = LoadScript("#strict 3\nfunc f() { return 2 * 3; }", false);
+		CHECK(GetCode(script, "f") == Code{{AB_INT, 2}, {AB_INT_OP, 3}, {AB_Mul, 0}, {AB_RETURN, 0}, {AB_EOFN, 0}});
+	}
+}
+
+TEST_CASE("Values which are discarded right away are not pushed", "[C4AulParse]")
+{
+	const std::string source{"#strict 3\nfunc f(a) { a = 2; a; 5; return a; }"};
+
+	auto &optimized = LoadScript(source, true);
+	CHECK(GetCode(optimized, "f") == Code{{AB_PARN_R, 0}, {AB_INT, 2}, {AB_Set, 0}, {AB_STACK, -1}, {AB_PARN_V, 0}, {AB_RETURN, 0}, {AB_EOFN, 0}});
+
+	auto &unoptimized = LoadScript(source, false);
+	CHECK(GetCode(unoptimized, "f") == Code{{AB_PARN_R, 0}, {AB_INT, 2}, {AB_Set, 0}, {AB_STACK, -1}, {AB_PARN_V, 0}, {AB_STACK, -1}, {AB_INT, 5}, {AB_STACK, -1}, {AB_PARN_V, 0}, {AB_RETURN, 0}, {AB_EOFN, 0}});
+}
+
+TEST_CASE("Jumps to jumps are threaded", "[C4AulParse]")
+{
+	// the end of the inner else jumps to the end of the outer if, which jumps over the outer else
+	const std::string body{"func f(a) { var r; if (a) { if (a > 1) r = 1; else r = 2; } else r = 3; return r; }"};
+
+	const auto hasJumpToJump = [](const Code &code)
+	{
+		bool fJumpToJump{false};
+		for (std::size_t i = 0; i < code.size(); ++i)
+			if (code[i].first == AB_JUMP || code[i].first == AB_CONDN)
+			{
+				const auto target = static_cast<std::intptr_t>(i) + code[i].second;
+				REQUIRE(target >= 0);
+				REQUIRE(target < static_cast<std::intptr_t>(code.size()));
+				fJumpToJump |= code[target].first == AB_JUMP;
+			}
+		return fJumpToJump;
+	};
+
+	SECTION("in optimized scripts")
+	{
+		auto &script = LoadScript("#strict 3\n" + body, true);
+		CHECK(!hasJumpToJump(GetCode(script, "f")));
+		CHECK(script.Call("f", C4AulParSet{C4VInt(2)})._getInt() == 1);
+		CHECK(script.Call("f", C4AulParSet{C4VInt(1)})._getInt() == 2);
+		CHECK(script.Call("f", C4AulParSet{C4VInt(0)})._getInt() == 3);
+	}
+
+	SECTION("below the strictness threshold")
+	{
+		auto &script = LoadScript("#strict 2\n" + body, true, C4AulScriptStrict::STRICT3);
+		CHECK(hasJumpToJump(GetCode(script, "f")));
+
+		auto &nonstrict = LoadScript("#strict 2\nfunc f() { return 2 * 3; }", true, C4AulScriptStrict::STRICT3);
+		CHECK(GetCode(nonstrict, "f") == Code{{AB_INT, 2}, {AB_INT_OP, 3}, {AB_Mul, 0}, {AB_RETURN, 0}, {AB_EOFN, 0}});
+	}
+}
+
+TEST_CASE("Optimized scripts compute the same results", "[C4AulParse]")
+{
+	const std::string source{
+		"#strict 3\n"
+		"func f(a, b) {\n"
+		"  var r = 0;\n"
+		"  for (var i = 0; i < 10; ++i) {\n"
+		"    if (i % 3 == 0) continue;\n"
+		"    r += i * (2 + 3) - (a << 2) / (1 + 1);\n"
+		"    while (true) { if (r > 100 || b) break; r += 7 * 6; }\n"
+		"    if (r > 1000 && !b) break;\n"
+		"  }\n"
+		"  return [r, -(8 >> 1), 1 / 0, b ?? 5 * 5];\n"
+		"}\n"};
+
+	for (const auto &[a, b] : {std::pair{0, 0}, std::pair{3, 0}, std::pair{-7, 1}, std::pair{100, 0}})
+	{
+		INFO("a = " << a << ", b = " << b);
+		const C4AulParSet pars{C4VInt(a), b ? C4VInt(b) : C4Value{}};
+
+		auto &optimized = LoadScript(source, true);
+		const C4Value optimizedResult{optimized.Call("f", pars)};
+		auto &unoptimized = LoadScript(source, false);
+		const C4Value unoptimizedResult{unoptimized.Call("f", pars)};
+
+		CHECK(optimizedResult == unoptimizedResult);
+	}
+}
@@ -0,0 +1,245 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "C4TestEngine.h"
+
+#include <C4Components.h>
+#include <C4Def.h>
+#include <C4DefPreload.h>
+#include <C4Group.h>
+#include <C4ThreadPool.h>
+#include <StdNoGfx.h>
+#include <StdPNG.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	const std::filesystem::path &TempDirectory()
+	{
+		static const struct Directory
+		{
+			std::filesystem::path Path{std::filesystem::temp_directory_path() / std::format("C4DefTest-{:08x}", std::random_device{}())};
+			Directory() { std::filesystem::create_directories(Path); }
+			~Directory() { std::filesystem::remove_all(Path); }
+		} directory;
+		return directory.Path;
+	}
+
+	void WriteFile(const std::filesystem::path &path, const std::string &contents)
+	{
+		std::ofstream{path, std::ios::binary} << contents;
+	}
+
+	// a picture that compresses about as well as drawn graphics: flat areas with some noise
+	void WritePNG(const std::filesystem::path &path, const std::uint32_t iWdt, const std::uint32_t iHgt, const std::uint32_t iSeed)
+	{
+		std::minstd_rand random{iSeed};
+		std::vector<std::uint32_t> pixels(iWdt * iHgt);
+		for (std::uint32_t y = 0; y < iHgt; ++y)
+			for (std::uint32_t x = 0; x < iWdt; ++x)
+				pixels[y * iWdt + x] = ((x / 8 + y / 8) % 3 ? 0xff000000 : 0) | (iSeed * 0x9e3779b9 + (x / 4) * 0x10204 + (random() & 0x0f0f0f));
+		CPNGFile{path.string(), iWdt, iHgt, true}.Encode(pixels.data());
+	}
+
+	C4ID TestID(const int32_t i)
+	{
+		return C4Id(std::format("T{:03}", i).c_str());
+	}
+
+	struct TestGroupOptions
+	{
+		int32_t iCount;
+		std::uint32_t iWdt, iHgt;
+		int32_t iBroken{-1}; // definition whose graphics don't decode
+		int32_t iDuplicate{-1}; // definition that has the ID of the first one
+	};
+
+	// a packed group of definitions with owner colored graphics, a portrait, names and a script each, like Objects.c4d
+	std::string CreateTestGroup(const char *const szName, const TestGroupOptions &options)
+	{
+		const std::filesystem::path folder{TempDirectory() / std::format("{}.folder", szName)};
+		const std::filesystem::path packed{TempDirectory() / std::format("{}.c4d", szName)};
+		if (std::filesystem::exists(packed)) return packed.string();
+
+		for (int32_t i = 0; i < options.iCount; ++i)
+		{
+			const std::filesystem::path def{folder / std::format("Def{:03}.c4d", i)};
+			std::filesystem::create_directories(def);
+			const C4ID id{i == options.iDuplicate ? TestID(0) : TestID(i)};
+			WriteFile(def / C4CFN_DefCore, std::format("[DefCore]\nid={}\nVersion=4,9,10,7\nCategory=C4D_Object\nWidth={}\nHeight={}\nOffset=-{},-{}\nColorByOwner=1\n",
+				C4IdText(id), options.iWdt / 2, options.iHgt, options.iWdt / 4, options.iHgt / 2));
+			WriteFile(def / "Names.txt", std::format("DE:Objekt {}\nUS:Object {}\n", i, i));
+			WriteFile(def / "Script.c", std::format("#strict 2\nfunc Number() {{ return {}; }}\n", i));
+			if (i == options.iBroken)
+				WriteFile(def / C4CFN_DefGraphicsPNG, "not a PNG file");
+			else
+				WritePNG(def / C4CFN_DefGraphicsPNG, options.iWdt, options.iHgt, i);
+			WritePNG(def / C4CFN_ClrByOwnerPNG, options.iWdt, options.iHgt, i + 1000);
+			WritePNG(def / "Portrait1.png", 64, 64, i + 2000);
+		}
+
+		// packing resorts the definition groups by the list the engine sets up at startup
+		C4Group_SetSortList(C4CFN_FLS);
+		REQUIRE(C4Group_PackDirectoryTo(folder.string().c_str(), packed.string().c_str()));
+		std::filesystem::remove_all(folder);
+		return packed.string();
+	}
+
+	// texture upload does nothing without a renderer, but surfaces are created like in a game
+	void InitGraphics()
+	{
+		static const std::unique_ptr<CStdNoGfx> graphics{[]
+		{
+			auto graphics = std::make_unique<CStdNoGfx>();
+			lpDDraw = graphics.get();
+			return graphics;
+		}()};
+	}
+
+	// worker threads like in a game; C4DefList decodes on the loading thread without them
+	class C4TestThreadPool
+	{
+	public:
+		C4TestThreadPool() { C4ThreadPool::Global = std::make_shared<C4ThreadPool>(4, 4); }
+		~C4TestThreadPool() { C4ThreadPool::Global.reset(); }
+	};
+
+	// load without reading ahead: C4DefList::Load only decodes on worker threads when loading a group by name
+	int32_t LoadSerial(C4DefList &defs, const std::string &group)
+	{
+		C4Group hGroup;
+		REQUIRE(hGroup.Open(group.c_str()));
+		return defs.Load(hGroup, C4D_Load_RX, "US", nullptr, true, true);
+	}
+
+	int32_t LoadDecoding(C4DefList &defs, const std::string &group)
+	{
+		return defs.Load(group.c_str(), C4D_Load_RX, "US", nullptr, true);
+	}
+
+	std::size_t CountDefs(C4DefList &defs)
+	{
+		std::size_t iCount{0};
+		for ([[maybe_unused]] const auto &def : defs) ++iCount;
+		return iCount;
+	}
+
+	void CheckSameDefs(C4DefList &defs, C4DefList &reference, const int32_t iCount)
+	{
+		REQUIRE(CountDefs(defs) == CountDefs(reference));
+		for (int32_t i = 0; i < iCount; ++i)
+		{
+			C4Def *const pRef{reference.ID2Def(TestID(i))};
+			C4Def *const pDef{defs.ID2Def(TestID(i))};
+			INFO("definition " << i);
+			REQUIRE(!pRef == !pDef);
+			if (!pDef) continue;
+			CHECK(SEqual(pDef->Filename, pRef->Filename));
+			CHECK(SEqual(pDef->GetName(), pRef->GetName()));
+			REQUIRE(pDef->Graphics.Bitmap);
+			CHECK(pDef->Graphics.Bitmap->Wdt == pRef->Graphics.Bitmap->Wdt);
+			CHECK(pDef->Graphics.Bitmap->Hgt == pRef->Graphics.Bitmap->Hgt);
+			CHECK(!pDef->Graphics.BitmapClr == !pRef->Graphics.BitmapClr);
+			CHECK(pDef->PortraitCount == pRef->PortraitCount);
+			REQUIRE(pDef->Portraits);
+			CHECK(pDef->Portraits->Bitmap->Wdt == 64);
+			CHECK(pDef->TopFace.Wdt == pRef->TopFace.Wdt);
+			CHECK(pDef->SolidMask.Wdt == pRef->SolidMask.Wdt);
+		}
+	}
+}
+
+TEST_CASE("Definitions decoded on worker threads are loaded like the serially loaded ones", "[C4Def]")
+{
+	InitGraphics();
+	C4TestEngine::ResetScriptEngine();
+	C4TestThreadPool threadPool;
+
+	SECTION("more definitions than are decoded ahead")
+	{
+		const int32_t iCount{static_cast<int32_t>(C4DefPreloader::MaxDecodeAhead) * 2 + 5};
+		const std::string group{CreateTestGroup("Many", {iCount, 32, 24})};
+		C4DefList reference, defs;
+		CHECK(LoadSerial(reference, group) == iCount);
+		CHECK(LoadDecoding(defs, group) == iCount);
+		CheckSameDefs(defs, reference, iCount);
+		CHECK(std::string{defs.ID2Def(TestID(7))->GetName()} == "Object 7");
+	}
+
+	SECTION("a definition whose graphics don't decode is left out")
+	{
+		const std::string group{CreateTestGroup("Broken", {20, 32, 24, 11})};
+		C4DefList reference, defs;
+		LoadSerial(reference, group);
+		LoadDecoding(defs, group);
+		CHECK(!reference.ID2Def(TestID(11)));
+		CheckSameDefs(defs, reference, 20);
+	}
+
+	SECTION("a later definition overloads one that is still decoding")
+	{
+		const std::string group{CreateTestGroup("Overload", {20, 32, 24, -1, 3})};
+		C4DefList reference, defs;
+		LoadSerial(reference, group);
+		LoadDecoding(defs, group);
+		REQUIRE(defs.ID2Def(TestID(0)));
+		CHECK(std::string{defs.ID2Def(TestID(0))->GetName()} == "Object 3");
+		CheckSameDefs(defs, reference, 20);
+	}
+
+	SECTION("without worker threads")
+	{
+		const std::string group{CreateTestGroup("Many", {static_cast<int32_t>(C4DefPreloader::MaxDecodeAhead) * 2 + 5, 32, 24})};
+		C4ThreadPool::Global.reset();
+		C4DefList reference, defs;
+		LoadSerial(reference, group);
+		LoadDecoding(defs, group);
+		CheckSameDefs(defs, reference, static_cast<int32_t>(C4DefPreloader::MaxDecodeAhead) * 2 + 5);
+	}
+}
+
+TEST_CASE("Loading a group of definitions", "[.][benchmark][C4Def]")
+{
+	InitGraphics();
+	C4TestEngine::ResetScriptEngine();
+	C4TestThreadPool threadPool;
+
+	// about the number of definitions and the image sizes of Objects.c4d
+	const std::string group{CreateTestGroup("Objects", {300, 256, 160})};
+
+	BENCHMARK("serial")
+	{
+		C4DefList defs;
+		return LoadSerial(defs, group);
+	};
+
+	BENCHMARK("decoding on worker threads")
+	{
+		C4DefList defs;
+		return LoadDecoding(defs, group);
+	};
+}
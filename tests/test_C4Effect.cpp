@@ -0,0 +1,161 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "C4TestEngine.h"
+
+#include <C4Effects.h>
+#include <C4Game.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+	constexpr std::string_view EffectScript{
+		"#strict 2\n"
+		"static Frame, KillNumber, Timers;\n"
+		"global func FxTestTimer(object target, int number, int time) { Timers[GetLength(Timers)] = [Frame, number, time]; if (number == KillNumber && time >= 40) return -1; }\n"
+		"func Start() { Timers = []; }\n"
+		"func SetFrame(int frame, int kill) { Frame = frame; KillNumber = kill; }\n"
+		"func GetTimers() { return Timers; }\n"
+		"func Add(int timer) { return AddEffect(\"Test\", 0, 1, timer); }\n"
+		"func Time(int number) { return GetEffect(0, 0, number, 6); }\n"
+		"func Change(int number, int timer) { return ChangeEffect(0, 0, number, \"Test\", timer); }\n"
+		"func Remove(int number) { return RemoveEffect(0, 0, number, true); }\n"};
+
+	using TimerCall = std::array<int32_t, 3>; // frame, effect number and time of a timer call
+
+	// the effect timing as it was before effect lists skipped executions: every effect counts its time up in every execution
+	struct C4SimulatedEffect
+	{
+		int32_t iNumber, iIntervall, iTime{0};
+		bool fDead{false};
+	};
+
+	// global effects of a test, cleared again at the end
+	class C4TestEffects
+	{
+	public:
+		C4TestEffects() : Script{C4TestEngine::LoadScript(EffectScript)} { Script.Call("Start"); }
+
+		~C4TestEffects()
+		{
+			delete Game.pGlobalEffects; Game.pGlobalEffects = nullptr;
+			Game.GlobalEffectSchedule = {};
+		}
+
+		int32_t Add(const int32_t iIntervall)
+		{
+			const int32_t iNumber{Script.Call("Add", C4AulParSet{C4VInt(iIntervall)}).getInt()};
+			Simulated.push_back({iNumber, iIntervall});
+			return iNumber;
+		}
+
+		void Change(const int32_t iNumber, const int32_t iIntervall)
+		{
+			REQUIRE(Script.Call("Change", C4AulParSet{C4VInt(iNumber), C4VInt(iIntervall)}).getBool());
+			C4SimulatedEffect &effect{Get(iNumber)};
+			effect.iIntervall = iIntervall; effect.iTime = 0;
+		}
+
+		void Remove(const int32_t iNumber)
+		{
+			REQUIRE(Script.Call("Remove", C4AulParSet{C4VInt(iNumber)}).getBool());
+			Get(iNumber).fDead = true;
+		}
+
+		void CheckTime(const int32_t iNumber)
+		{
+			INFO("effect " << iNumber);
+			CHECK(Script.Call("Time", C4AulParSet{C4VInt(iNumber)}).getInt() == Get(iNumber).iTime);
+		}
+
+		// one frame; the timer of effect iKillNumber asks to be removed once its time reached 40
+		void Execute(const int32_t iFrame, const int32_t iKillNumber)
+		{
+			Script.Call("SetFrame", C4AulParSet{C4VInt(iFrame), C4VInt(iKillNumber)});
+			if (Game.pGlobalEffects) Game.pGlobalEffects->Execute(nullptr);
+			for (C4SimulatedEffect &effect : Simulated)
+			{
+				if (effect.fDead) continue;
+				++effect.iTime;
+				if (effect.iIntervall && !(effect.iTime % effect.iIntervall))
+				{
+					Expected.push_back({iFrame, effect.iNumber, effect.iTime});
+					if (effect.iNumber == iKillNumber && effect.iTime >= 40) effect.fDead = true;
+				}
+			}
+		}
+
+		std::vector<TimerCall> GetTimers()
+		{
+			std::vector<TimerCall> result;
+			C4Value timers{Script.Call("GetTimers")};
+			C4ValueArray *const pTimers{timers.getArray()};
+			REQUIRE(pTimers);
+			for (int32_t i = 0; i < pTimers->GetSize(); ++i)
+			{
+				C4ValueArray *const pCall{(*pTimers)[i].getArray()};
+				result.push_back({(*pCall)[0].getInt(), (*pCall)[1].getInt(), (*pCall)[2].getInt()});
+			}
+			return result;
+		}
+
+		std::vector<TimerCall> Expected;
+
+	private:
+		C4TestScript &Script;
+		std::vector<C4SimulatedEffect> Simulated;
+
+		C4SimulatedEffect &Get(const int32_t iNumber)
+		{
+			return *std::find_if(Simulated.begin(), Simulated.end(), [iNumber](const C4SimulatedEffect &effect) { return effect.iNumber == iNumber; });
+		}
+	};
+}
+
+TEST_CASE("Effect timers are called in the same frames as without skipping", "[C4Effect]")
+{
+	C4TestEffects effects;
+	const int32_t iFirst{effects.Add(3)}, iSecond{effects.Add(7)}, iUntimed{effects.Add(0)};
+	int32_t iLater{0};
+
+	for (int32_t iFrame = 0; iFrame < 200; ++iFrame)
+	{
+		switch (iFrame)
+		{
+		case 13: effects.CheckTime(iFirst); effects.CheckTime(iSecond); effects.CheckTime(iUntimed); break;
+		case 20: effects.Change(iFirst, 5); break;
+		case 25: iLater = effects.Add(4); break;
+		case 31: effects.CheckTime(iLater); effects.CheckTime(iFirst); break;
+		case 60: effects.Remove(iUntimed); break;
+		case 77: effects.Change(iLater, 11); effects.CheckTime(iLater); break;
+		case 150: effects.CheckTime(iFirst); effects.CheckTime(iLater); break;
+		}
+		effects.Execute(iFrame, iSecond);
+	}
+
+	// effects of the same priority may be called in any order within a frame
+	std::vector<TimerCall> timers{effects.GetTimers()};
+	std::sort(timers.begin(), timers.end());
+	std::sort(effects.Expected.begin(), effects.Expected.end());
+	CHECK(timers == effects.Expected);
+}
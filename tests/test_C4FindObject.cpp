@@ -0,0 +1,149 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "C4TestEngine.h"
+
+#include <C4Def.h>
+#include <C4FindObject.h>
+#include <C4Game.h>
+#include <C4Object.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <string_view>
+
+namespace
+{
+	constexpr C4ID TestIDs[]{C4Id("TSTA"), C4Id("TSTB")};
+
+	C4Def &GetTestDef(const std::size_t iIndex)
+	{
+		if (C4Def *const pDef{Game.Defs.ID2Def(TestIDs[iIndex])}) return *pDef;
+		auto *const pDef = new C4Def;
+		pDef->id = TestIDs[iIndex];
+		Game.Defs.Add(pDef, false);
+		return *pDef;
+	}
+
+	// a grid of objects in Game.Objects, alternating between the test definitions; deleted again at the end of the test
+	class C4TestObjects
+	{
+	public:
+		C4TestObjects()
+		{
+			Game.Objects.Init(200, 200);
+			for (int32_t i = 0; i < 100; ++i)
+			{
+				auto *const pObj = new C4Object;
+				pObj->Def = &GetTestDef(i % 2);
+				pObj->id = pObj->Def->id;
+				pObj->Def->Count++;
+				pObj->Status = C4OS_NORMAL;
+				pObj->Category = C4D_Object;
+				pObj->Number = i + 1;
+				pObj->x = (i % 10) * 20; pObj->y = (i / 10) * 20;
+				pObj->Shape.x = pObj->Shape.y = -5;
+				pObj->Shape.Wdt = pObj->Shape.Hgt = 10;
+				pObj->OCF = OCF_All;
+				Game.Objects.Add(pObj);
+			}
+		}
+
+		~C4TestObjects()
+		{
+			Game.Objects.DeleteObjects();
+			Game.Objects.Sectors.Clear();
+			for (std::size_t i = 0; i < std::size(TestIDs); ++i) GetTestDef(i).Count = 0;
+			Game.FindObjectPlans.Clear();
+		}
+
+		// objects of the definition in a rectangle, as counted by a scan of the list
+		static int32_t Count(const C4ID id, const int32_t iX, const int32_t iY, const int32_t iWdt, const int32_t iHgt)
+		{
+			int32_t iCount{0};
+			for (C4ObjectLink *cLnk = Game.Objects.First; cLnk; cLnk = cLnk->Next)
+				if ((id == C4ID_None || cLnk->Obj->id == id) && Inside<int32_t>(cLnk->Obj->x - iX, 0, iWdt - 1) && Inside<int32_t>(cLnk->Obj->y - iY, 0, iHgt - 1))
+					++iCount;
+			return iCount;
+		}
+	};
+
+	// Find_ID and the other criteria functions are defined in System.c4g, so the scripts build the criteria themselves
+	constexpr std::string_view SearchScript{
+		"#strict 2\n"
+		"static Calls;\n"
+		"global func Counted() { ++Calls; return true; }\n"
+		"func CountInRect(def, x, y) { return ObjectCount2([C4FO_ID, def], [C4FO_InRect, x, y, 50, 50]); }\n"
+		"func FindInRect(def, x, y) { return FindObjects([C4FO_ID, def], [C4FO_InRect, x, y, 50, 50]); }\n"
+		"func CountCalls(def) { Calls = 0; var n = ObjectCount2([C4FO_Func, \"Counted\"], [C4FO_ID, def]); return [n, Calls]; }\n"
+		"func CountCallsOr(def) { Calls = 0; var n = ObjectCount2([C4FO_Or, [C4FO_Func, \"Counted\"], [C4FO_ID, def]]); return [n, Calls]; }\n"};
+
+	C4Value Call(C4TestScript &script, const char *const szFunc, const C4ID id, const int32_t iX = 0, const int32_t iY = 0)
+	{
+		return script.Call(szFunc, C4AulParSet{C4VID(id), C4VInt(iX), C4VInt(iY)});
+	}
+}
+
+TEST_CASE("Searches of a call site follow its parameters", "[C4FindObject]")
+{
+	C4TestObjects objects;
+	auto &script = C4TestEngine::LoadScript(SearchScript);
+
+	// the same site is called with changing parameters and again with earlier ones
+	for (int i = 0; i < 50; ++i)
+	{
+		const C4ID id{TestIDs[i % 2]};
+		const int32_t iX{(i * 37) % 150}, iY{(i * 53) % 150};
+		INFO("call " << i);
+		const int32_t iExpected{C4TestObjects::Count(id, iX, iY, 50, 50)};
+		CHECK(Call(script, "CountInRect", id, iX, iY).getInt() == iExpected);
+
+		C4Value found{Call(script, "FindInRect", id, iX, iY)};
+		C4ValueArray *const pFound{found.getArray()};
+		REQUIRE(pFound);
+		CHECK(pFound->GetSize() == iExpected);
+		for (int32_t j = 0; j < pFound->GetSize(); ++j)
+			CHECK((*pFound)[j].getObj()->id == id);
+	}
+
+	// cached conditions belong to the old code after relinking
+	Game.ScriptEngine.ReLink(&Game.Defs);
+	CHECK(Call(script, "CountInRect", TestIDs[0], 0, 0).getInt() == C4TestObjects::Count(TestIDs[0], 0, 0, 50, 50));
+}
+
+TEST_CASE("Script callbacks of searches are checked last", "[C4FindObject]")
+{
+	C4TestObjects objects;
+	auto &script = C4TestEngine::LoadScript(SearchScript);
+
+	for (int i = 0; i < 2; ++i)
+	{
+		// the function is only called for objects that passed the cheaper ID check
+		C4Value result{Call(script, "CountCalls", TestIDs[0])};
+		C4ValueArray *const pResult{result.getArray()};
+		REQUIRE(pResult);
+		CHECK((*pResult)[0].getInt() == 50);
+		CHECK((*pResult)[1].getInt() == 50);
+
+		// alternatives only need the function if the ID doesn't match
+		C4Value resultOr{Call(script, "CountCallsOr", TestIDs[0])};
+		C4ValueArray *const pResultOr{resultOr.getArray()};
+		REQUIRE(pResultOr);
+		CHECK((*pResultOr)[0].getInt() == 100);
+		CHECK((*pResultOr)[1].getInt() == 50);
+	}
+}
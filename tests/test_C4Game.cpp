@@ -0,0 +1,352 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "C4TestEngine.h"
+
+#include <C4Def.h>
+#include <C4Game.h>
+#include <C4GameObjects.h>
+#include <C4Object.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr C4ID TestIDs[]{C4Id("TSTA"), C4Id("TSTB"), C4Id("TSTC")};
+	constexpr int32_t LandscapeWdt{200}, LandscapeHgt{200};
+
+	// definitions with a few actions; the last one has two actions of the same name
+	C4Def &GetTestDef(const std::size_t iIndex)
+	{
+		if (C4Def *const pDef{Game.Defs.ID2Def(TestIDs[iIndex])}) return *pDef;
+		auto *const pDef = new C4Def;
+		pDef->id = TestIDs[iIndex];
+		constexpr const char *ActionNames[]{"Walk", "Jump", "Walk"};
+		pDef->ActNum = iIndex == 2 ? 3 : 2;
+		pDef->ActMap = new C4ActionDef[pDef->ActNum];
+		for (int32_t i = 0; i < pDef->ActNum; ++i)
+			SCopy(ActionNames[i], pDef->ActMap[i].Name, C4D_MaxIDLen);
+		Game.Defs.Add(pDef, false);
+		return *pDef;
+	}
+
+	bool ScanMatch(C4Object *const cObj, const C4ID id, const uint32_t ocf, const char *const szAction, C4Object *const pActionTarget, C4Object *const pExclude, C4Object *const pContainer, const int32_t iOwner)
+	{
+		const bool bFindActIdle = SEqual(szAction, "Idle") || SEqual(szAction, "ActIdle");
+		return cObj->Status
+			&& ((id == C4ID_None) || (cObj->Def->id == id))
+			&& (cObj->OCF & ocf)
+			&& (cObj != pExclude)
+			&& (!szAction || !szAction[0] || (bFindActIdle && cObj->Action.Act <= ActIdle) || ((cObj->Action.Act > ActIdle) && SEqual(szAction, cObj->Def->ActMap[cObj->Action.Act].Name)))
+			&& (!pActionTarget || ((cObj->Action.Act > ActIdle) && ((cObj->Action.Target == pActionTarget) || (cObj->Action.Target2 == pActionTarget))))
+			&& (!pContainer || (cObj->Contained == pContainer) || ((reinterpret_cast<std::intptr_t>(pContainer) == NO_CONTAINER) && !cObj->Contained) || ((reinterpret_cast<std::intptr_t>(pContainer) == ANY_CONTAINER) && cObj->Contained))
+			&& ((iOwner == ANY_OWNER) || (cObj->Owner == iOwner));
+	}
+
+	// what FindObject returned before the objects were indexed: a scan of the whole list
+	C4Object *ScanFindObject(const C4ID id, const int32_t iX, const int32_t iY, const int32_t iWdt, const int32_t iHgt, const uint32_t ocf, const char *const szAction, C4Object *const pActionTarget, C4Object *const pExclude, C4Object *const pContainer, const int32_t iOwner, C4Object *pFindNext)
+	{
+		C4Object *pClosest = nullptr;
+		int32_t iClosest = 0, iDistance, iFartherThan = -1;
+		C4Object *pFindNextCpy = pFindNext;
+
+		if (id != C4ID_None)
+		{
+			C4Def *const pDef{Game.Defs.ID2Def(id)};
+			if (!pDef || !pDef->Count) return nullptr;
+		}
+
+		// Finding next closest: find closest but further away than last closest
+		if (pFindNext && (iWdt == -1) && (iHgt == -1))
+		{
+			iFartherThan = (pFindNext->x - iX) * (pFindNext->x - iX) + (pFindNext->y - iY) * (pFindNext->y - iY);
+			pFindNext = nullptr;
+		}
+
+		for (C4ObjectLink *cLnk = Game.Objects.First; cLnk; cLnk = cLnk->Next)
+		{
+			C4Object *const cObj{cLnk->Obj};
+			if (!pFindNext && ScanMatch(cObj, id, ocf, szAction, pActionTarget, pExclude, pContainer, iOwner))
+			{
+				// Full range
+				if ((iX == 0) && (iY == 0) && (iWdt == 0) && (iHgt == 0))
+					return cObj;
+				// Point
+				if ((iWdt == 0) && (iHgt == 0))
+				{
+					if (Inside<int32_t>(iX - (cObj->x + cObj->Shape.x), 0, cObj->Shape.Wdt - 1) && Inside<int32_t>(iY - (cObj->y + cObj->Shape.y), 0, cObj->Shape.Hgt - 1))
+						return cObj;
+					continue;
+				}
+				// Closest
+				if ((iWdt == -1) && (iHgt == -1))
+				{
+					iDistance = (cObj->x - iX) * (cObj->x - iX) + (cObj->y - iY) * (cObj->y - iY);
+					// same distance?
+					if ((iDistance == iFartherThan) && !pFindNextCpy)
+						return cObj;
+					// nearer than/first closest?
+					if (!pClosest || (iDistance < iClosest))
+						if (iDistance > iFartherThan)
+						{
+							pClosest = cObj; iClosest = iDistance;
+						}
+				}
+				// Range
+				else if (Inside<int32_t>(cObj->x - iX, 0, iWdt - 1) && Inside<int32_t>(cObj->y - iY, 0, iHgt - 1))
+					return cObj;
+			}
+
+			// Find next mark reached
+			if (cObj == pFindNextCpy) pFindNext = pFindNextCpy = nullptr;
+		}
+
+		return pClosest;
+	}
+
+	// what ObjectCount returned before the objects were indexed
+	int32_t ScanObjectCount(const C4ID id, const int32_t x, const int32_t y, const int32_t wdt, const int32_t hgt, const uint32_t ocf, const char *const szAction, C4Object *const pActionTarget, C4Object *const pExclude, C4Object *const pContainer, const int32_t iOwner)
+	{
+		if (id != C4ID_None)
+		{
+			C4Def *const pDef{Game.Defs.ID2Def(id)};
+			if (!pDef || !pDef->Count) return 0;
+			if (!x && !y && !wdt && !hgt && ocf == OCF_All && !szAction && !pActionTarget && !pExclude && !pContainer && iOwner == ANY_OWNER)
+				return pDef->Count;
+		}
+
+		int32_t iResult = 0;
+		for (C4ObjectLink *cLnk = Game.Objects.First; cLnk; cLnk = cLnk->Next)
+		{
+			C4Object *const cObj{cLnk->Obj};
+			if (!ScanMatch(cObj, id, ocf, szAction, pActionTarget, pExclude, pContainer, iOwner)) continue;
+			if (!x && !y && !wdt && !hgt)
+				++iResult;
+			else if (!wdt && !hgt)
+			{
+				if (Inside<int32_t>(x - (cObj->x + cObj->Shape.x), 0, cObj->Shape.Wdt - 1) && Inside<int32_t>(y - (cObj->y + cObj->Shape.y), 0, cObj->Shape.Hgt - 1))
+					++iResult;
+			}
+			else if (Inside<int32_t>(cObj->x - x, 0, wdt - 1) && Inside<int32_t>(cObj->y - y, 0, hgt - 1))
+				++iResult;
+		}
+		return iResult;
+	}
+
+	// objects with random properties in Game.Objects, deleted again at the end of the test
+	class C4TestObjects
+	{
+	public:
+		C4TestObjects()
+		{
+			C4TestEngine::ResetScriptEngine();
+			Game.Objects.Init(LandscapeWdt, LandscapeHgt);
+		}
+
+		~C4TestObjects()
+		{
+			for (C4Object *const pObj : Objects) pObj->Contained = nullptr;
+			Game.Objects.DeleteObjects();
+			Game.Objects.Sectors.Clear();
+			for (std::size_t i = 0; i < std::size(TestIDs); ++i) GetTestDef(i).Count = 0;
+		}
+
+		void Create(const int32_t iCount)
+		{
+			for (int32_t i = 0; i < iCount; ++i)
+			{
+				auto *const pObj = new C4Object;
+				pObj->Def = &GetTestDef(Pick(std::size(TestIDs)));
+				pObj->id = pObj->Def->id;
+				pObj->Def->Count++;
+				pObj->Status = C4OS_NORMAL;
+				pObj->Category = RandomCategory();
+				pObj->Number = ++LastNumber;
+				// coarse positions, so that many objects share a distance to the search points
+				pObj->x = static_cast<int32_t>(Pick(20)) * 10; pObj->y = static_cast<int32_t>(Pick(20)) * 10;
+				pObj->Shape.x = pObj->Shape.y = -5;
+				pObj->Shape.Wdt = pObj->Shape.Hgt = 10 + static_cast<int32_t>(Pick(3)) * 5;
+				pObj->OCF = OCF_Grab << Pick(3);
+				pObj->Owner = static_cast<int32_t>(Pick(3)) - 1;
+				Game.Objects.Add(pObj);
+				Objects.push_back(pObj);
+			}
+			// actions and containers refer to other objects
+			for (C4Object *const pObj : Objects)
+			{
+				pObj->Action.Act = static_cast<int32_t>(Pick(pObj->Def->ActNum + 1)) - 1;
+				pObj->Action.Target = Pick(2) ? RandomObject() : nullptr;
+				pObj->Contained = Pick(4) ? nullptr : RandomObject();
+			}
+		}
+
+		std::size_t Pick(const std::size_t iCount)
+		{
+			return std::uniform_int_distribution<std::size_t>{0, iCount - 1}(Random);
+		}
+
+		C4Object *RandomObject()
+		{
+			return Objects[Pick(Objects.size())];
+		}
+
+		int32_t RandomCategory()
+		{
+			constexpr int32_t Categories[]{C4D_Structure, C4D_Vehicle, C4D_Living, C4D_Object};
+			return Categories[Pick(std::size(Categories))];
+		}
+
+		// compare the results of a random search with a scan of the whole list, following FindNext as scripts do
+		void CheckRandomSearch()
+		{
+			const C4ID id{Pick(2) ? C4ID_None : TestIDs[Pick(std::size(TestIDs))]};
+			const int32_t iX{static_cast<int32_t>(Pick(20)) * 10}, iY{static_cast<int32_t>(Pick(20)) * 10};
+			int32_t x{0}, y{0}, wdt{0}, hgt{0};
+			switch (Pick(4))
+			{
+			case 0: break; // everywhere
+			case 1: x = iX; y = iY; break; // point
+			case 2: x = iX; y = iY; wdt = hgt = -1; break; // closest
+			case 3: x = iX - 30; y = iY - 30; wdt = 1 + static_cast<int32_t>(Pick(80)); hgt = 1 + static_cast<int32_t>(Pick(80)); break; // rectangle
+			}
+			const uint32_t ocf{Pick(2) ? OCF_All : static_cast<uint32_t>(OCF_Grab << Pick(3))};
+			constexpr const char *Actions[]{nullptr, "", "Idle", "Walk", "Jump"};
+			const char *const szAction{Pick(2) ? nullptr : Actions[Pick(std::size(Actions))]};
+			C4Object *const pActionTarget{Pick(6) ? nullptr : RandomObject()};
+			C4Object *const pExclude{Pick(4) ? nullptr : RandomObject()};
+			C4Object *pContainer{nullptr};
+			switch (Pick(6))
+			{
+			case 0: pContainer = RandomObject(); break;
+			case 1: pContainer = reinterpret_cast<C4Object *>(NO_CONTAINER); break;
+			case 2: pContainer = reinterpret_cast<C4Object *>(ANY_CONTAINER); break;
+			}
+			const int32_t iOwner{Pick(2) ? ANY_OWNER : static_cast<int32_t>(Pick(3)) - 1};
+
+			INFO("id " << C4IdText(id) << ", area " << x << ", " << y << ", " << wdt << ", " << hgt << ", ocf " << ocf << ", action " << (szAction ? szAction : "none")
+				<< ", action target " << !!pActionTarget << ", exclude " << !!pExclude << ", container " << pContainer << ", owner " << iOwner);
+
+			CHECK(Game.ObjectCount(id, x, y, wdt, hgt, ocf, szAction, pActionTarget, pExclude, pContainer, iOwner)
+				== ScanObjectCount(id, x, y, wdt, hgt, ocf, szAction, pActionTarget, pExclude, pContainer, iOwner));
+
+			// an object that does not match may be passed as well
+			C4Object *pFindNext{Pick(5) ? nullptr : RandomObject()};
+			for (int32_t iStep = 0; iStep < 30; ++iStep)
+			{
+				INFO("step " << iStep << ", find next " << (pFindNext ? pFindNext->Number : 0));
+				C4Object *const pExpected{ScanFindObject(id, x, y, wdt, hgt, ocf, szAction, pActionTarget, pExclude, pContainer, iOwner, pFindNext)};
+				C4Object *const pFound{Game.FindObject(id, x, y, wdt, hgt, ocf, szAction, pActionTarget, pExclude, pContainer, iOwner, pFindNext)};
+				REQUIRE(pFound == pExpected);
+				if (!pFound) break;
+				pFindNext = pFound;
+			}
+		}
+
+		std::vector<C4Object *> Objects;
+		int32_t LastNumber{0};
+		std::mt19937 Random{42};
+	};
+}
+
+TEST_CASE("FindObject and ObjectCount find what a scan of the whole list finds", "[C4Game]")
+{
+	C4TestObjects objects;
+	objects.Create(300);
+	for (int i = 0; i < 500; ++i)
+		objects.CheckRandomSearch();
+}
+
+TEST_CASE("The legacy search functions follow changes of the objects", "[C4Game]")
+{
+	C4TestObjects objects;
+	objects.Create(300);
+
+	SECTION("moved objects")
+	{
+		for (int i = 0; i < 200; ++i)
+		{
+			C4Object *const pObj{objects.RandomObject()};
+			pObj->x = static_cast<int32_t>(objects.Pick(20)) * 10; pObj->y = static_cast<int32_t>(objects.Pick(20)) * 10;
+			Game.Objects.UpdatePos(pObj);
+			objects.CheckRandomSearch();
+		}
+	}
+
+	SECTION("removed and added objects")
+	{
+		for (int i = 0; i < 100; ++i)
+		{
+			C4Object *const pObj{objects.RandomObject()};
+			Game.Objects.Remove(pObj);
+			pObj->Category = objects.RandomCategory();
+			Game.Objects.Add(pObj);
+			objects.CheckRandomSearch();
+		}
+	}
+
+	SECTION("changed definitions")
+	{
+		for (int i = 0; i < 100; ++i)
+		{
+			C4Object *const pObj{objects.RandomObject()};
+			// ChangeDef would move the object out of its container
+			pObj->Contained = nullptr;
+			REQUIRE(pObj->ChangeDef(TestIDs[objects.Pick(std::size(TestIDs))]));
+			objects.CheckRandomSearch();
+			Game.Objects.ResortUnsorted();
+			objects.CheckRandomSearch();
+		}
+	}
+
+	SECTION("changed categories")
+	{
+		for (int i = 0; i < 100; ++i)
+		{
+			objects.RandomObject()->SetCategory(objects.RandomCategory());
+			// the list is resorted only once per frame, so searches see the old order first
+			objects.CheckRandomSearch();
+			Game.Objects.ResortUnsorted();
+			objects.CheckRandomSearch();
+		}
+	}
+
+	SECTION("resorted objects")
+	{
+		// sort by number within each category like ResortObjects
+		for (C4Object *const pObj : objects.Objects)
+			pObj->Number = static_cast<int32_t>(objects.Pick(1000)) + 1;
+		Game.Objects.UpdateNumberIndex();
+		C4TestScript &script{C4TestEngine::LoadScript("#strict 2\nfunc Order(object a, object b) { return ObjectNumber(a) - ObjectNumber(b); }")};
+		auto *const pResort = new C4ObjResort;
+		// resorting a category that no object has runs past the end of the list, so only the created ones are given
+		pResort->Category = C4D_Structure | C4D_Vehicle | C4D_Living | C4D_Object;
+		pResort->OrderFunc = script.GetSFunc("Order");
+		REQUIRE(pResort->OrderFunc);
+		pResort->Next = Game.Objects.ResortProc;
+		Game.Objects.ResortProc = pResort;
+		Game.Objects.ExecuteResorts();
+
+		for (C4ObjectLink *cLnk = Game.Objects.First; cLnk && cLnk->Next; cLnk = cLnk->Next)
+			if (cLnk->Obj->Category == cLnk->Next->Obj->Category)
+				CHECK(cLnk->Obj->Number <= cLnk->Next->Obj->Number);
+		for (int i = 0; i < 500; ++i)
+			objects.CheckRandomSearch();
+	}
+}
@@ -0,0 +1,401 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "C4TestEngine.h"
+
+#include <C4Components.h>
+#include <C4Def.h>
+#include <C4Game.h>
+#include <C4GameObjects.h>
+#include <C4Group.h>
+#include <C4Object.h>
+#include <StdCompiler.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	constexpr C4ID TestID{C4Id("TEST")};
+
+	constexpr const char *ActiveObjects{
+		"[Object]\n"
+		"id=TEST\n"
+		"Number=1\n"
+		"Name=First\n"
+		"Category=16\n"
+		"X=10\n"
+		"Y=20\n"
+		"Locals=2;i5,i-3\n"
+		"Effects=Test(1,100,5,10,0,0)[2;i5,i7],Other(2,50,0,0,0,0)\n"
+		"\n"
+		"[Object]\n"
+		"id=TEST\n"
+		"Number=2\n"
+		"Category=16\n"
+		"X=30\n"
+		"Y=40\n"
+		"Energy=50\n"
+	};
+
+	constexpr const char *InactiveObjects{
+		"[Object]\n"
+		"id=TEST\n"
+		"Number=3\n"
+		"Status=2\n"
+		"Category=16\n"
+		"Locals=1;i42\n"
+	};
+
+	void AddTestDef()
+	{
+		if (Game.Defs.ID2Def(TestID)) return;
+		auto *const pDef = new C4Def;
+		pDef->id = TestID;
+		Game.Defs.Add(pDef, false);
+	}
+
+	std::string TempPath(const char *const szName)
+	{
+		return (std::filesystem::temp_directory_path() / szName).string();
+	}
+
+	// what ObjectPointer returned before the lists had a number index
+	C4Object *ScanObjectPointer(const C4ObjectList &list, const int32_t iNumber)
+	{
+		for (C4ObjectLink *cLnk = list.First; cLnk; cLnk = cLnk->Next)
+			if (cLnk->Obj->Number == iNumber)
+				return cLnk->Obj;
+		return nullptr;
+	}
+
+	void CheckNumberIndex(C4ObjectList &list, const int32_t iMaxNumber)
+	{
+		for (int32_t iNumber = 0; iNumber <= iMaxNumber + 1; ++iNumber)
+		{
+			INFO("number " << iNumber);
+			C4Object *const pObj{ScanObjectPointer(list, iNumber)};
+			// the index of the list itself; C4GameObjects would fall back to its inactive objects
+			CHECK(list.C4ObjectList::ObjectPointer(iNumber) == pObj);
+			if (pObj) CHECK(list.ObjectNumber(pObj) == iNumber);
+		}
+	}
+
+	// numbered objects in one text, like an Objects.txt of a scenario
+	std::string MakeObjectsText(const int32_t iCount, const int32_t iFirstNumber, const bool fInactive)
+	{
+		std::string text;
+		for (int32_t i = 0; i < iCount; ++i)
+			text += std::format("[Object]\nid=TEST\nNumber={}\n{}Category=16\nX={}\nY={}\n\n", iFirstNumber + i, fInactive ? "Status=2\n" : "", i % 100, i / 100);
+		return text;
+	}
+
+	// objects in Game.Objects and its inactive list, deleted again at the end of the test
+	class C4TestObjects
+	{
+	public:
+		C4TestObjects()
+		{
+			C4TestEngine::ResetScriptEngine();
+			AddTestDef();
+			Game.Objects.Init(100, 100);
+		}
+
+		~C4TestObjects()
+		{
+			Game.Objects.DeleteObjects();
+			Game.Objects.InactiveObjects.DeleteObjects();
+			Game.Objects.Sectors.Clear();
+		}
+
+		// compile like C4GameObjects::Load; inactive objects are sorted out afterwards there as well
+		template<class CompT, class BufT>
+		void Compile(C4ObjectList &list, const BufT &buf)
+		{
+			CompileFromBuf<CompT>(mkParAdapt(list, false), buf);
+			list.Denumerate();
+		}
+
+		// sort out inactive objects like C4GameObjects::Load, then put the others into the sectors
+		void FinishLoading()
+		{
+			std::vector<C4Object *> inactive;
+			for (C4ObjectLink *pLnk = Game.Objects.First; pLnk; pLnk = pLnk->Next)
+				if (pLnk->Obj->Status == C4OS_INACTIVE)
+					inactive.push_back(pLnk->Obj);
+			for (C4Object *const pObj : inactive)
+			{
+				Game.Objects.C4ObjectList::Remove(pObj);
+				Game.Objects.InactiveObjects.Add(pObj, C4ObjectList::stNone);
+			}
+			for (C4ObjectLink *pLnk = Game.Objects.First; pLnk; pLnk = pLnk->Next)
+				Game.Objects.UpdatePos(pLnk->Obj);
+		}
+
+		std::string SaveText()
+		{
+			const std::string path{TempPath("ObjectsTest.txt")};
+			REQUIRE(Game.Objects.Save(path.c_str(), true, true, false));
+			StdStrBuf text;
+			REQUIRE(text.LoadFromFile(path.c_str()));
+			std::filesystem::remove(path);
+			return text.getData();
+		}
+
+		StdBuf SaveBinary()
+		{
+			const std::string path{TempPath("ObjectsTest.c4b")};
+			REQUIRE(Game.Objects.Save(path.c_str(), true, true, true));
+			StdBuf data;
+			REQUIRE(data.LoadFromFile(path.c_str()));
+			std::filesystem::remove(path);
+			return data;
+		}
+
+		void Clear()
+		{
+			Game.Objects.DeleteObjects();
+			Game.Objects.InactiveObjects.DeleteObjects();
+		}
+	};
+
+	void CheckObjects()
+	{
+		REQUIRE(Game.Objects.ObjectCount() == 2);
+		REQUIRE(Game.Objects.InactiveObjects.ObjectCount() == 1);
+
+		C4Object *const pFirst{Game.Objects.ObjectPointer(1)};
+		REQUIRE(pFirst);
+		CHECK(pFirst->GetName() == std::string{"First"});
+		CHECK(pFirst->x == 10);
+		CHECK(pFirst->y == 20);
+		REQUIRE(pFirst->Local.GetSize() == 2);
+		CHECK(pFirst->Local[0] == C4VInt(5));
+		CHECK(pFirst->Local[1] == C4VInt(-3));
+
+		C4Effect *const pEffect{pFirst->pEffects};
+		REQUIRE(pEffect);
+		CHECK(std::strcmp(pEffect->Name, "Test") == 0);
+		CHECK(pEffect->iPriority == 100);
+		CHECK(pEffect->iIntervall == 10);
+		REQUIRE(pEffect->EffectVars.GetSize() == 2);
+		CHECK(pEffect->EffectVars[1] == C4VInt(7));
+		REQUIRE(pEffect->pNext);
+		CHECK(std::strcmp(pEffect->pNext->Name, "Other") == 0);
+		CHECK(!pEffect->pNext->pNext);
+
+		C4Object *const pSecond{Game.Objects.ObjectPointer(2)};
+		REQUIRE(pSecond);
+		CHECK(pSecond->Energy == 50);
+		CHECK(!pSecond->pEffects);
+
+		C4Object *const pInactive{Game.Objects.InactiveObjects.ObjectPointer(3)};
+		REQUIRE(pInactive);
+		CHECK(pInactive->Status == C4OS_INACTIVE);
+		REQUIRE(pInactive->Local.GetSize() == 1);
+		CHECK(pInactive->Local[0] == C4VInt(42));
+	}
+}
+
+TEST_CASE("Saved objects read back the same from both formats", "[C4GameObjects]")
+{
+	C4TestObjects objects;
+	objects.Compile<StdCompilerINIRead>(Game.Objects, StdStrBuf{ActiveObjects});
+	objects.Compile<StdCompilerINIRead>(Game.Objects.InactiveObjects, StdStrBuf{InactiveObjects});
+	objects.FinishLoading();
+	CheckObjects();
+
+	const std::string text{objects.SaveText()};
+	const StdBuf binary{objects.SaveBinary()};
+
+	SECTION("text")
+	{
+		objects.Clear();
+		objects.Compile<StdCompilerINIRead>(Game.Objects, StdStrBuf{text.c_str()});
+		objects.FinishLoading();
+		CheckObjects();
+		CHECK(objects.SaveText() == text);
+	}
+
+	SECTION("binary")
+	{
+		objects.Clear();
+		// both lists are in one name tree, like the concatenated text
+		objects.Compile<StdCompilerNamedBinRead>(Game.Objects, binary);
+		objects.FinishLoading();
+		CheckObjects();
+		CHECK(objects.SaveText() == text);
+		CHECK(objects.SaveBinary() == binary);
+	}
+
+	SECTION("damaged binary")
+	{
+		objects.Clear();
+		// a savegame that was cut off must not load partially
+		StdBuf truncated{binary.getData(), binary.getSize() / 2, true};
+		CHECK_THROWS_AS(objects.Compile<StdCompilerNamedBinRead>(Game.Objects, truncated), StdCompiler::Exception);
+	}
+}
+
+TEST_CASE("Lookups by number follow the list order", "[C4GameObjects]")
+{
+	// deleted objects check that they are not in the sectors of Game.Objects
+	C4TestObjects game;
+	C4Def &def{*Game.Defs.ID2Def(TestID)};
+	C4ObjectList list;
+	list.EnableNumberIndex();
+
+	// few numbers for many objects, so that most numbers are shared by several objects
+	constexpr int32_t MaxNumber{8};
+	std::vector<std::unique_ptr<C4Object>> objects;
+	std::mt19937 random{42};
+	const auto create = [&]
+	{
+		auto &pObj = objects.emplace_back(std::make_unique<C4Object>());
+		pObj->Def = &def;
+		pObj->Status = C4OS_NORMAL;
+		pObj->Category = std::uniform_int_distribution<int32_t>{0, 1}(random) ? C4D_Object : C4D_Structure;
+		pObj->Number = std::uniform_int_distribution<int32_t>{1, MaxNumber}(random);
+		return pObj.get();
+	};
+	const auto listed = [&]
+	{
+		std::vector<C4Object *> result;
+		for (C4ObjectLink *cLnk = list.First; cLnk; cLnk = cLnk->Next) result.push_back(cLnk->Obj);
+		return result;
+	};
+
+	for (int i = 0; i < 500; ++i)
+	{
+		const auto current = listed();
+		switch (current.size() < 10 ? 0 : std::uniform_int_distribution<int>{0, 5}(random))
+		{
+		case 0: case 1:
+		{
+			// at the end, sorted by category into the middle or at the front; objects out of the category order are marked like in the engine
+			constexpr C4ObjectList::SortType sortTypes[]{C4ObjectList::stNone, C4ObjectList::stMain, C4ObjectList::stReverse};
+			const C4ObjectList::SortType eSort{sortTypes[std::uniform_int_distribution<int>{0, 2}(random)]};
+			C4Object *const pObj{create()};
+			pObj->Unsorted = eSort != C4ObjectList::stMain;
+			list.Add(pObj, eSort);
+			break;
+		}
+		case 2:
+			list.Remove(current[std::uniform_int_distribution<std::size_t>{0, current.size() - 1}(random)]);
+			break;
+		case 3:
+		{
+			// renumbered directly and removed before the index was updated
+			C4Object *const pObj{current[std::uniform_int_distribution<std::size_t>{0, current.size() - 1}(random)]};
+			pObj->Number = std::uniform_int_distribution<int32_t>{1, MaxNumber}(random);
+			list.Remove(pObj);
+			break;
+		}
+		case 4:
+		{
+			C4ObjectLink *const pLnk1{list.GetLink(current[std::uniform_int_distribution<std::size_t>{0, current.size() - 1}(random)])};
+			C4ObjectLink *const pLnk2{list.GetLink(current[std::uniform_int_distribution<std::size_t>{0, current.size() - 1}(random)])};
+			// swapping keeps the category order
+			if (pLnk1 != pLnk2 && pLnk1->Obj->Category == pLnk2->Obj->Category && pLnk1->Obj->Unsorted == pLnk2->Obj->Unsorted)
+				list.SwapLinkObjects(pLnk1, pLnk2);
+			break;
+		}
+		case 5:
+		{
+			C4Object *const pObj{current[std::uniform_int_distribution<std::size_t>{0, current.size() - 1}(random)]};
+			pObj->Number = std::uniform_int_distribution<int32_t>{1, MaxNumber}(random);
+			list.UpdateNumberIndex();
+			break;
+		}
+		}
+		CheckNumberIndex(list, MaxNumber);
+	}
+	list.Clear();
+	CHECK(!list.ObjectPointer(1));
+}
+
+namespace
+{
+	// a scenario folder with the given objects, loaded by C4GameObjects::Load while inactive objects of the same numbers are kept
+	class C4TestScenario
+	{
+	public:
+		C4TestScenario(const int32_t iCount)
+			: Path{std::filesystem::temp_directory_path() / std::format("C4GameObjectsTest-{:08x}.c4s", std::random_device{}())}, Count{iCount}
+		{
+			std::filesystem::create_directories(Path);
+			std::ofstream{Path / C4CFN_ScenarioObjects} << MakeObjectsText(iCount, 1, false);
+		}
+
+		~C4TestScenario() { std::filesystem::remove_all(Path); }
+
+		void Load(C4TestObjects &objects)
+		{
+			objects.Compile<StdCompilerINIRead>(Game.Objects.InactiveObjects, StdStrBuf{MakeObjectsText(Count, 1, true).c_str()});
+			C4Group group;
+			REQUIRE(group.Open(Path.string().c_str()));
+			REQUIRE(Game.Objects.Load(group, true) == Count);
+		}
+
+	private:
+		std::filesystem::path Path;
+		int32_t Count;
+	};
+}
+
+TEST_CASE("Loading renumbers kept inactive objects with colliding numbers", "[C4GameObjects]")
+{
+	C4TestObjects objects;
+	C4TestScenario scenario{50};
+	scenario.Load(objects);
+
+	REQUIRE(Game.Objects.InactiveObjects.ObjectCount() == 50);
+	for (C4ObjectLink *cLnk = Game.Objects.InactiveObjects.First; cLnk; cLnk = cLnk->Next)
+	{
+		CHECK(cLnk->Obj->Number > 50);
+		CHECK(!Game.Objects.C4ObjectList::ObjectPointer(cLnk->Obj->Number));
+		CHECK(Game.Objects.InactiveObjects.ObjectPointer(cLnk->Obj->Number) == cLnk->Obj);
+	}
+	CheckNumberIndex(Game.Objects, 100);
+	CheckNumberIndex(Game.Objects.InactiveObjects, 100);
+}
+
+TEST_CASE("Loading many objects", "[.][benchmark][C4GameObjects]")
+{
+	// the collision check with the inactive objects and the line numbers of missing values were quadratic in the number of objects
+	C4TestObjects objects;
+	for (const int32_t iCount : {1000, 5000})
+	{
+		C4TestScenario scenario{iCount};
+		BENCHMARK(std::format("{} objects", iCount))
+		{
+			scenario.Load(objects);
+			const int32_t iLoaded{Game.Objects.ObjectCount()};
+			objects.Clear();
+			return iLoaded;
+		};
+	}
+}
@@ -0,0 +1,300 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4Group.h>
+#include <C4GroupCache.h>
+#include <StdGzCompressedFile.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	// deterministic data that compresses somewhat, so deflate produces many blocks of varying size
+	std::vector<std::uint8_t> MakeData(const std::size_t size, std::uint32_t seed)
+	{
+		std::vector<std::uint8_t> data(size);
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			seed = seed * 1103515245 + 12345;
+			data[i] = static_cast<std::uint8_t>((seed >> 16) % 16 + (i / 4096) % 8);
+		}
+		return data;
+	}
+
+	// in a directory of its own for each run, so that concurrent runs of the tests don't share their files
+	std::string TempPath(const char *const szName)
+	{
+		static const struct TempDirectory
+		{
+			std::filesystem::path Path{std::filesystem::temp_directory_path() / std::format("C4GroupTest-{:08x}", std::random_device{}())};
+			TempDirectory() { std::filesystem::create_directories(Path); }
+			~TempDirectory() { std::filesystem::remove_all(Path); }
+		} directory;
+		return (directory.Path / szName).string();
+	}
+
+	// removes the file again when it goes out of scope
+	class C4TestFile
+	{
+	public:
+		explicit C4TestFile(const char *const szName) : Path{TempPath(szName)} { std::filesystem::remove(Path); }
+		~C4TestFile() { std::filesystem::remove(Path); }
+		C4TestFile(const C4TestFile &) = delete;
+		C4TestFile &operator=(const C4TestFile &) = delete;
+
+		const char *c_str() const { return Path.c_str(); }
+
+	private:
+		std::string Path;
+	};
+
+	// reading at an offset the way it was done before seeking: rewind and inflate everything in front of it
+	std::vector<std::uint8_t> ReadByRewind(StdGzCompressedFile::Read &file, const std::size_t offset, const std::size_t size)
+	{
+		file.Rewind();
+		std::vector<std::uint8_t> skipped(offset);
+		file.ReadData(skipped.data(), offset);
+		std::vector<std::uint8_t> result(size);
+		result.resize(file.ReadData(result.data(), size));
+		return result;
+	}
+
+	std::vector<std::uint8_t> ReadBySeek(StdGzCompressedFile::Read &file, const std::size_t offset, const std::size_t size)
+	{
+		file.Seek(offset);
+		std::vector<std::uint8_t> result(size);
+		result.resize(file.ReadData(result.data(), size));
+		return result;
+	}
+
+	constexpr std::size_t PackedSize{5 * 1024 * 1024 + 12345};
+
+	const char *PackedFile()
+	{
+		static const C4TestFile file{"Seek.bin"};
+		[[maybe_unused]] static const bool fWritten{[]
+		{
+			const auto data = MakeData(PackedSize, 1);
+			StdGzCompressedFile::Write write{file.c_str()};
+			write.WriteData(data.data(), data.size());
+			return true;
+		}()};
+		return file.c_str();
+	}
+
+	// packed group with the given entries; the contents of entry i are MakeData(size, seed + i)
+	void CreateGroup(const char *const szPath, const std::size_t iEntries, const std::size_t iSize, const std::uint32_t seed, const std::vector<std::pair<const char *, const char *>> &children = {})
+	{
+		// the group reads the buffers when it is closed
+		std::vector<std::vector<std::uint8_t>> contents;
+		for (std::size_t i = 0; i < iEntries; ++i)
+			contents.push_back(MakeData(iSize + i * 1000, seed + static_cast<std::uint32_t>(i)));
+
+		C4Group group;
+		REQUIRE(group.Open(szPath, true));
+		for (std::size_t i = 0; i < iEntries; ++i)
+			REQUIRE(group.Add(std::format("Entry{}.bin", i).c_str(), contents[i].data(), contents[i].size()));
+		for (const auto &[szChildPath, szChildName] : children)
+			REQUIRE(group.Add(szChildPath, szChildName));
+		REQUIRE(group.Close());
+	}
+
+	void CheckEntry(C4Group &group, const std::size_t i, const std::size_t iSize, const std::uint32_t seed)
+	{
+		INFO(group.GetName() << ": entry " << i);
+		StdBuf buf;
+		REQUIRE(group.LoadEntry(std::format("Entry{}.bin", i).c_str(), buf));
+		const auto data = MakeData(iSize + i * 1000, seed + static_cast<std::uint32_t>(i));
+		REQUIRE(buf.getSize() == data.size());
+		CHECK(std::equal(data.begin(), data.end(), static_cast<const std::uint8_t *>(buf.getData())));
+	}
+
+	constexpr std::array Offsets{std::size_t{0}, std::size_t{17}, std::size_t{1024 * 1024 - 3}, std::size_t{4 * 1024 * 1024 + 5}, std::size_t{2 * 1024 * 1024}, std::size_t{3}, PackedSize - 100};
+}
+
+TEST_CASE("Seeking in a packed file reads the same data as rewinding", "[C4Group]")
+{
+	const auto data = MakeData(PackedSize, 1);
+	StdGzCompressedFile::Read file{PackedFile()};
+
+	SECTION("before the checkpoints exist")
+	{
+		const auto result = ReadBySeek(file, 3 * 1024 * 1024, 1000);
+		CHECK(result == std::vector<std::uint8_t>(data.begin() + 3 * 1024 * 1024, data.begin() + 3 * 1024 * 1024 + 1000));
+	}
+
+	SECTION("after a full pass created the checkpoints")
+	{
+		std::vector<std::uint8_t> all(PackedSize);
+		REQUIRE(file.ReadData(all.data(), all.size()) == PackedSize);
+		REQUIRE(all == data);
+
+		// forwards, backwards and across checkpoints
+		StdGzCompressedFile::Read reference{PackedFile()};
+		for (const std::size_t offset : Offsets)
+		{
+			INFO("offset " << offset);
+			const auto bySeek = ReadBySeek(file, offset, 70000);
+			CHECK(bySeek == ReadByRewind(reference, offset, 70000));
+			CHECK(bySeek == std::vector<std::uint8_t>(data.begin() + offset, data.begin() + std::min(offset + 70000, PackedSize)));
+			CHECK(file.Position() == offset + bySeek.size());
+		}
+	}
+}
+
+TEST_CASE("Entries of a packed group can be read in any order", "[C4Group]")
+{
+	constexpr std::size_t EntrySize{1536 * 1024};
+	const C4TestFile file{"Flat.c4g"};
+	CreateGroup(file.c_str(), 4, EntrySize, 2);
+
+	C4Group group;
+	REQUIRE(group.Open(file.c_str()));
+	for (const std::size_t i : {3, 1, 2, 0, 3})
+		CheckEntry(group, i, EntrySize, 2);
+	group.Close();
+}
+
+TEST_CASE("Entries of nested child groups can be read in any order", "[C4Group]")
+{
+	// the child groups seek through their mothers to absolute positions in the outermost file
+	constexpr std::size_t EntrySize{700 * 1024};
+	const C4TestFile inner{"Inner.c4g"}, middle{"Middle.c4g"}, outer{"Outer.c4g"};
+	CreateGroup(inner.c_str(), 4, EntrySize, 30);
+	CreateGroup(middle.c_str(), 3, EntrySize, 20, {{inner.c_str(), "Inner.c4g"}});
+	CreateGroup(outer.c_str(), 3, EntrySize, 10, {{middle.c_str(), "Middle.c4g"}});
+
+	C4Group outerGroup, middleGroup, innerGroup;
+	REQUIRE(outerGroup.Open(outer.c_str()));
+	REQUIRE(middleGroup.OpenAsChild(&outerGroup, "Middle.c4g"));
+	REQUIRE(innerGroup.OpenAsChild(&middleGroup, "Inner.c4g"));
+	for (const std::size_t i : {3, 0, 2, 1, 3, 0})
+		CheckEntry(innerGroup, i, EntrySize, 30);
+	for (const std::size_t i : {2, 0, 1})
+		CheckEntry(middleGroup, i, EntrySize, 20);
+	CheckEntry(innerGroup, 1, EntrySize, 30);
+	innerGroup.Close();
+	middleGroup.Close();
+	CheckEntry(outerGroup, 2, EntrySize, 10);
+	CheckEntry(outerGroup, 0, EntrySize, 10);
+	outerGroup.Close();
+}
+
+TEST_CASE("Several processes create the same group cache image at once", "[C4Group]")
+{
+	const C4TestFile file{"Cached.c4g"};
+	CreateGroup(file.c_str(), 3, 400 * 1024, 40);
+	std::vector<std::uint8_t> inflated(4 * 1024 * 1024);
+	{
+		StdGzCompressedFile::Read group{file.c_str()};
+		inflated.resize(group.ReadData(inflated.data(), inflated.size()));
+	}
+	REQUIRE(inflated.size() >= C4GroupCache::MinGroupSize);
+
+	// each cache stands for a process that starts at the same time as the others
+	const std::string cachePath{TempPath("Cache")};
+	std::array<C4GroupCache, 4> caches;
+	std::array<std::shared_ptr<const StdMappedFile>, 4> images;
+	{
+		std::vector<std::jthread> threads;
+		for (std::size_t i = 0; i < caches.size(); ++i)
+			threads.emplace_back([&, i]
+			{
+				caches[i].Init(cachePath.c_str(), 64 * 1024 * 1024);
+				images[i] = caches[i].Get(file.c_str());
+			});
+	}
+
+	for (const auto &image : images)
+	{
+		REQUIRE(image);
+		CHECK(std::equal(inflated.begin(), inflated.end(), image->GetData(), image->GetData() + image->GetSize()));
+	}
+	// no temporary files are left behind
+	CHECK(std::distance(std::filesystem::directory_iterator{cachePath}, std::filesystem::directory_iterator{}) == 1);
+}
+
+TEST_CASE("Random access in a packed file", "[.][benchmark][C4Group]")
+{
+	StdGzCompressedFile::Read file{PackedFile()};
+	std::vector<std::uint8_t> all(PackedSize);
+	file.ReadData(all.data(), all.size());
+
+	BENCHMARK("seek")
+	{
+		std::size_t sum{0};
+		for (const std::size_t offset : Offsets) sum += ReadBySeek(file, offset, 4096).size();
+		return sum;
+	};
+
+	BENCHMARK("rewind")
+	{
+		std::size_t sum{0};
+		for (const std::size_t offset : Offsets) sum += ReadByRewind(file, offset, 4096).size();
+		return sum;
+	};
+}
+
+TEST_CASE("Loading the stock system groups", "[.][benchmark][C4Group]")
+{
+	// the stock groups are folders in the source tree, so they are packed like for a release first
+	const C4TestFile system{"System.c4g"}, graphics{"Graphics.c4g"};
+	REQUIRE(C4Group_PackDirectoryTo(PLANET_PATH "/System.c4g", system.c_str()));
+	REQUIRE(C4Group_PackDirectoryTo(PLANET_PATH "/Graphics.c4g", graphics.c_str()));
+
+	// loads all entries; the engine loads entries by name, which is rarely the order in the group
+	const auto load = [](const char *const szPath, const bool fReverse)
+	{
+		C4Group group;
+		REQUIRE(group.Open(szPath));
+		std::vector<std::string> entries;
+		char szEntry[_MAX_FNAME + 1];
+		group.ResetSearch();
+		while (group.FindNextEntry("*", szEntry)) entries.emplace_back(szEntry);
+		if (fReverse) std::reverse(entries.begin(), entries.end());
+
+		std::size_t size{0};
+		for (const auto &entry : entries)
+		{
+			StdBuf buf;
+			REQUIRE(group.LoadEntry(entry.c_str(), buf));
+			size += buf.getSize();
+		}
+		return size;
+	};
+
+	BENCHMARK("in group order")
+	{
+		return load(system.c_str(), false) + load(graphics.c_str(), false);
+	};
+
+	BENCHMARK("in reverse order")
+	{
+		return load(system.c_str(), true) + load(graphics.c_str(), true);
+	};
+}
@@ -0,0 +1,284 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4Landscape.h>
+#include <C4Game.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// a DigFree call if iGrade is 0, a BlastFree call otherwise
+	struct C4LandscapeCall
+	{
+		int32_t x, y, iRad, iGrade;
+	};
+
+	// the calls of a round like they are recorded: diggers walking through the earth in small steps, now and then an explosion
+	std::vector<C4LandscapeCall> RecordDigging(const int32_t iWdt, const int32_t iHgt, const int32_t iCalls)
+	{
+		std::minstd_rand random{4};
+		struct Digger { int32_t x, y, dx, dy; };
+		std::vector<Digger> diggers;
+		for (int32_t i = 0; i < 8; ++i)
+			diggers.push_back({static_cast<int32_t>(random() % iWdt), iHgt / 2 + static_cast<int32_t>(random() % (iHgt / 2)), i % 2 ? 2 : -2, 1});
+
+		std::vector<C4LandscapeCall> calls;
+		for (int32_t i = 0; i < iCalls; ++i)
+		{
+			if (random() % 40 == 0)
+			{
+				calls.push_back({static_cast<int32_t>(random() % iWdt), static_cast<int32_t>(random() % iHgt), 10 + static_cast<int32_t>(random() % 20), 1 + static_cast<int32_t>(random() % 3)});
+				continue;
+			}
+			Digger &digger{diggers[i % diggers.size()]};
+			if (random() % 30 == 0) digger.dy = static_cast<int32_t>(random() % 3) - 1;
+			digger.x += digger.dx; digger.y += digger.dy;
+			if (digger.x < 0 || digger.x >= iWdt) { digger.dx = -digger.dx; digger.x += 2 * digger.dx; }
+			if (digger.y < iHgt / 3 || digger.y >= iHgt) { digger.dy = -digger.dy; digger.y += 2 * digger.dy; }
+			calls.push_back({digger.x, digger.y, 8, 0});
+		}
+		return calls;
+	}
+
+	// landscape of one material in two shades, only the second of which converts by temperature; no graphics
+	class C4TestLandscape : public C4Landscape
+	{
+	public:
+		C4TestLandscape(const int32_t iWdt, const int32_t iHgt)
+		{
+			// the material map is this landscape's for as long as it exists
+			REQUIRE(!Game.Material.Map);
+			Game.Material.Map = new C4Material[1];
+			Game.Material.Num = 1;
+			Game.Material.Map[0].MinHeightCount = 10;
+			Game.Material.Map[0].DigFree = 1;
+			Game.Material.Map[0].BlastFree = 1;
+
+			// Default() leaves this to the zero initialization of Game.Landscape
+			pInitial = nullptr;
+			Width = iWdt; Height = iHgt;
+			Surface8 = new CSurface8{iWdt, iHgt};
+			// there is no DDraw whose palette the surface could share
+			Surface8->pPal = nullptr;
+			for (int32_t i = 0; i < 256; ++i)
+			{
+				Pix2Mat[i] = i ? 0 : MNone;
+				Pix2Dens[i] = i ? 50 : 0;
+				Pix2Place[i] = 0;
+				Pix2TempConv[i] = i >= 128;
+			}
+			// hills of both shades
+			for (int32_t y = 0; y < Height; ++y)
+				for (int32_t x = 0; x < Width; ++x)
+					Surface8->SetPix(x, y, y > Height / 2 + (x * 7 % 50) ? (x / 40 % 2 ? 1 : 129) : 0);
+
+			PixCntPitch = (Height + 14) / 15;
+			PixCnt = new uint8_t[(Width + 16) / 17 * PixCntPitch];
+			TempConvCnt = new uint8_t[(Width + 16) / 17 * PixCntPitch];
+			UpdatePixCnt(C4Rect{0, 0, Width, Height});
+			ClearMatCount();
+			UpdateMatCnt(C4Rect{0, 0, Width, Height}, true);
+		}
+
+		~C4TestLandscape()
+		{
+			Game.Material.Clear();
+			Game.Material.Num = 0;
+		}
+
+		// draw straight to the surface like the drawing functions do, tracking the change
+		void DrawCircle(const int32_t iX, const int32_t iY, const int32_t iRad, const uint8_t byCol)
+		{
+			const C4Rect BoundingBox{iX - iRad, iY - iRad, 2 * iRad + 1, 2 * iRad + 1};
+			PrepareChange(BoundingBox);
+			Surface8->Circle(iX, iY, iRad, byCol);
+			UpdateChangedCnt();
+		}
+
+		// the same change, counted again like before the change tracking
+		void DrawCircleRecount(const int32_t iX, const int32_t iY, const int32_t iRad, const uint8_t byCol)
+		{
+			C4Rect BoundingBox{iX - iRad, iY - iRad, 2 * iRad + 1, 2 * iRad + 1};
+			UpdateMatCnt(BoundingBox, false);
+			Surface8->Circle(iX, iY, iRad, byCol);
+			UpdateMatCnt(BoundingBox, true);
+			UpdatePixCnt(BoundingBox);
+		}
+
+		struct Counts
+		{
+			std::vector<uint8_t> PixCnt, TempConvCnt;
+			std::vector<uint32_t> MatCount, EffectiveMatCount;
+
+			bool operator==(const Counts &) const = default;
+		};
+
+		Counts GetCounts() const
+		{
+			const std::size_t iCells = (Width + 16) / 17 * PixCntPitch;
+			return {
+				{PixCnt, PixCnt + iCells},
+				{TempConvCnt, TempConvCnt + iCells},
+				{MatCount, MatCount + C4MaxMaterial},
+				{EffectiveMatCount, EffectiveMatCount + C4MaxMaterial}
+			};
+		}
+
+		void SetCounts(const Counts &counts)
+		{
+			std::copy(counts.PixCnt.begin(), counts.PixCnt.end(), PixCnt);
+			std::copy(counts.TempConvCnt.begin(), counts.TempConvCnt.end(), TempConvCnt);
+			std::copy(counts.MatCount.begin(), counts.MatCount.end(), MatCount);
+			std::copy(counts.EffectiveMatCount.begin(), counts.EffectiveMatCount.end(), EffectiveMatCount);
+		}
+
+		Counts GetRecountedCounts()
+		{
+			const Counts counts{GetCounts()};
+			UpdatePixCnt(C4Rect{0, 0, Width, Height});
+			ClearMatCount();
+			UpdateMatCnt(C4Rect{0, 0, Width, Height}, true);
+			Counts recounted{GetCounts()};
+			// restore, so the incremental counts are checked again after the next change
+			SetCounts(counts);
+			return recounted;
+		}
+
+		struct Snapshot
+		{
+			std::vector<uint8_t> Pixels;
+			Counts LandscapeCounts;
+		};
+
+		Snapshot GetSnapshot() const
+		{
+			return {{Surface8->Bits, Surface8->Bits + Surface8->Pitch * Height}, GetCounts()};
+		}
+
+		void Restore(const Snapshot &snapshot)
+		{
+			std::copy(snapshot.Pixels.begin(), snapshot.Pixels.end(), Surface8->Bits);
+			SetCounts(snapshot.LandscapeCounts);
+			// there are no graphics to relight
+			Relights.clear();
+		}
+
+		// the real digging functions; Game.Landscape is empty, so ClearPix never finds tunnel background and clears to sky
+		void Replay(const std::vector<C4LandscapeCall> &calls)
+		{
+			for (const auto &call : calls)
+			{
+				if (call.iGrade)
+					BlastFree(call.x, call.y, call.iRad, call.iGrade, NO_OWNER);
+				else
+					DigFree(call.x, call.y, call.iRad);
+			}
+		}
+
+		// the same changes drawn as circles with change tracking
+		void ReplayAsCircles(const std::vector<C4LandscapeCall> &calls)
+		{
+			for (const auto &call : calls)
+				DrawCircle(call.x, call.y, call.iRad, 0);
+		}
+	};
+}
+
+TEST_CASE("Changed pixels keep the pixel and material counts exact", "[C4Landscape]")
+{
+	C4TestLandscape landscape{500, 300};
+	REQUIRE(landscape.GetCounts() == landscape.GetRecountedCounts());
+
+	struct Change { int32_t x, y, rad; uint8_t col; };
+	for (const auto &change : {
+		Change{100, 200, 20, 0}, // dig
+		Change{250, 150, 35, 1}, // fill
+		Change{255, 150, 30, 129}, // other shade over the fill
+		Change{0, 299, 12, 1}, // across the borders
+		Change{499, 0, 40, 0},
+		Change{300, 250, 5, 129},
+		Change{300, 250, 5, 129} // no change
+	})
+	{
+		INFO("circle at " << change.x << ", " << change.y);
+		landscape.DrawCircle(change.x, change.y, change.rad, change.col);
+		CHECK(landscape.GetCounts() == landscape.GetRecountedCounts());
+	}
+}
+
+TEST_CASE("Digging and blasting keep the pixel and material counts exact", "[C4Landscape]")
+{
+	C4TestLandscape landscape{500, 300};
+	const std::vector<C4LandscapeCall> calls{RecordDigging(500, 300, 400)};
+	const C4TestLandscape::Counts before{landscape.GetCounts()};
+
+	for (std::size_t i = 0; i < calls.size(); i += 50)
+	{
+		INFO("calls " << i << " to " << i + 49);
+		landscape.Replay({calls.begin() + i, calls.begin() + i + 50});
+		CHECK(landscape.GetCounts() == landscape.GetRecountedCounts());
+	}
+	CHECK(landscape.GetCounts().MatCount != before.MatCount);
+}
+
+TEST_CASE("Landscape changes", "[.][benchmark][C4Landscape]")
+{
+	C4TestLandscape landscape{2000, 1000};
+
+	BENCHMARK("count changed pixels")
+	{
+		landscape.DrawCircle(1000, 600, 30, 0);
+		landscape.DrawCircle(1000, 600, 30, 1);
+	};
+
+	BENCHMARK("recount changed rect")
+	{
+		landscape.DrawCircleRecount(1000, 600, 30, 0);
+		landscape.DrawCircleRecount(1000, 600, 30, 1);
+	};
+}
+
+TEST_CASE("Replaying digging", "[.][benchmark][C4Landscape]")
+{
+	C4TestLandscape landscape{2000, 1000};
+	const std::vector<C4LandscapeCall> calls{RecordDigging(2000, 1000, 2000)};
+	const C4TestLandscape::Snapshot snapshot{landscape.GetSnapshot()};
+
+	// every run starts from the same landscape; the restore alone is measured, too
+	BENCHMARK("restore only")
+	{
+		landscape.Restore(snapshot);
+	};
+
+	BENCHMARK("DigFree/BlastFree stream")
+	{
+		landscape.Restore(snapshot);
+		landscape.Replay(calls);
+	};
+
+	BENCHMARK("the same as drawn circles with change counting")
+	{
+		landscape.Restore(snapshot);
+		landscape.ReplayAsCircles(calls);
+	};
+}
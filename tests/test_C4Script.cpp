@@ -0,0 +1,401 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "C4TestEngine.h"
+
+#include <C4Def.h>
+#include <C4Game.h>
+#include <C4Landscape.h>
+#include <C4Object.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <format>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	C4AulFunc *GetEngineFunc(const char *const szName)
+	{
+		C4AulFunc *const pFunc{Game.ScriptEngine.GetFuncRecursive(szName)};
+		REQUIRE(pFunc);
+		return pFunc;
+	}
+
+	// calls the function via its fast path and via the generic conversion
+	std::pair<C4Value, C4Value> CallBothWays(C4AulFunc *const pFunc, const C4AulParSet &Pars)
+	{
+		REQUIRE(pFunc->FastCall);
+		C4AulContext context{};
+		C4Value fastResult;
+		REQUIRE(pFunc->FastCall(pFunc, &context, Pars.Par, fastResult));
+		return {fastResult, pFunc->Exec(&context, Pars.Par, true)};
+	}
+
+	// the engine functions scripts call most, as counted by the script profiler in a few melees and missions
+	constexpr std::array MostCalledFuncs{
+		"GetX", "GetY", "GetID", "GetOwner", "GetCon", "GetXDir", "GetYDir", "GetR", "GetAction", "GetCategory",
+		"GetOCF", "GetDir", "GetComDir", "GetActTime", "Contained", "GetAlive", "ObjectDistance", "Contents", "ContentsCount", "FindContents",
+		"SetXDir", "SetComDir", "Abs", "Min", "Max", "BoundBy", "Inside", "Distance", "GBackSolid", "GetMaterial"};
+
+	// the members of Game.Landscape which the test fills in
+	struct C4LandscapeMembers : C4Landscape
+	{
+		static constexpr CSurface8 *C4Landscape::*Surface{&C4LandscapeMembers::Surface8};
+		static constexpr int32_t (C4Landscape::*Mat)[256]{&C4LandscapeMembers::Pix2Mat};
+		static constexpr int32_t (C4Landscape::*Dens)[256]{&C4LandscapeMembers::Pix2Dens};
+	};
+
+	// Game.Landscape filled in place: the lower half is solid, the rest is sky
+	class C4TestLandscape
+	{
+	public:
+		C4TestLandscape(const int32_t iWdt, const int32_t iHgt)
+		{
+			C4Landscape &landscape{Game.Landscape};
+			landscape.Width = iWdt; landscape.Height = iHgt;
+			CSurface8 *const pSurface{landscape.*C4LandscapeMembers::Surface = new CSurface8{iWdt, iHgt}};
+			// there is no DDraw whose palette the surface could share
+			pSurface->pPal = nullptr;
+			for (int32_t i = 0; i < 256; ++i)
+			{
+				(landscape.*C4LandscapeMembers::Mat)[i] = i ? 0 : MNone;
+				(landscape.*C4LandscapeMembers::Dens)[i] = i ? C4M_Solid : 0;
+			}
+			for (int32_t y = iHgt / 2; y < iHgt; ++y)
+				for (int32_t x = 0; x < iWdt; ++x)
+					pSurface->SetPix(x, y, 1);
+		}
+
+		~C4TestLandscape()
+		{
+			C4Landscape &landscape{Game.Landscape};
+			delete (landscape.*C4LandscapeMembers::Surface);
+			landscape.*C4LandscapeMembers::Surface = nullptr;
+			landscape.Width = landscape.Height = 0;
+		}
+	};
+
+	// a definition with an object that contains another one, and a third object elsewhere; not in Game.Objects
+	class C4TestObjects
+	{
+	public:
+		C4TestObjects() : Def{new C4Def}
+		{
+			Def->id = C4Id("TSTA");
+			Def->Category = C4D_Object;
+			Game.Defs.Add(Def, false);
+
+			Obj = Create(100, 40, 0);
+			Item = Create(100, 40, 0);
+			Other = Create(130, 90, 1);
+			Obj->Category = C4D_Living;
+			Obj->xdir = itofix(3); Obj->ydir = itofix(-2); Obj->r = 45;
+			Obj->Action.Dir = DIR_Right; Obj->Action.ComDir = COMD_Left; Obj->Action.Time = 12;
+			Obj->SetAlive(true);
+			Obj->OCF = OCF_Alive | OCF_Grab;
+			Obj->Contents.Add(Item, C4ObjectList::stNone);
+			Item->Contained = Obj;
+		}
+
+		~C4TestObjects()
+		{
+			Obj->Contents.Clear();
+			delete Obj; delete Item; delete Other;
+			Game.Defs.Remove(Def);
+		}
+
+		// values of each parameter type to combine; nil stands for the context object where a function takes an object
+		std::vector<C4Value> GetPars(const C4V_Type type) const
+		{
+			switch (type)
+			{
+			case C4V_Int: return {C4Value{}, C4VInt(0), C4VInt(1), C4VInt(-7), C4VInt(25), C4VInt(100)};
+			case C4V_Bool: return {C4Value{}, C4VBool(true), C4VBool(false)};
+			case C4V_C4ID: return {C4Value{}, C4VID(Def->id), C4VID(C4Id("NONE"))};
+			case C4V_C4Object: return {C4Value{}, C4VObj(Obj), C4VObj(Item), C4VObj(Other)};
+			case C4V_String: return {C4Value{}, C4VString("Idle")};
+			default: FAIL("no fast path for parameters of type " << GetC4VName(type)); return {};
+			}
+		}
+
+		std::array<C4Object *, 3> GetContexts() const { return {nullptr, Obj, Other}; }
+
+		C4Def *Def;
+		C4Object *Obj, *Item, *Other;
+
+	private:
+		C4Object *Create(const int32_t iX, const int32_t iY, const int32_t iOwner)
+		{
+			auto *const pObj = new C4Object;
+			pObj->Def = Def;
+			pObj->id = Def->id;
+			pObj->Status = C4OS_NORMAL;
+			pObj->Category = Def->Category;
+			pObj->x = iX; pObj->y = iY;
+			pObj->Owner = pObj->Controller = iOwner;
+			return pObj;
+		}
+	};
+
+	// the result of a call or whether it threw
+	struct CallResult
+	{
+		C4Value Value;
+		bool Error{false};
+
+		bool operator==(const CallResult &other) const { return Value.GetType() == other.Value.GetType() && Value == other.Value && Error == other.Error; }
+	};
+
+	std::pair<CallResult, CallResult> CallBothWays(C4AulFunc *const pFunc, C4Object *const pContext, const C4AulParSet &Pars)
+	{
+		REQUIRE(pFunc->FastCall);
+		C4AulContext context{};
+		context.Obj = pContext;
+		context.Def = pContext ? pContext->Def : nullptr;
+
+		CallResult fast, generic;
+		try
+		{
+			REQUIRE(pFunc->FastCall(pFunc, &context, Pars.Par, fast.Value));
+		}
+		catch (const C4AulError &)
+		{
+			fast.Error = true;
+		}
+		try
+		{
+			generic.Value = pFunc->Exec(&context, Pars.Par, true);
+		}
+		catch (const C4AulError &)
+		{
+			generic.Error = true;
+		}
+		return {fast, generic};
+	}
+
+	std::string ParsString(C4AulFunc *const pFunc, const C4AulParSet &Pars)
+	{
+		std::string result{std::format("{}(", pFunc->Name)};
+		for (int i = 0; i < pFunc->GetParCount(); ++i)
+			result += std::format("{}{}", i ? ", " : "", Pars[i].GetDataString());
+		return result + ")";
+	}
+
+	// a parameter set of each function for the benchmarks
+	C4AulParSet TypicalPars(C4AulFunc *const pFunc, const C4TestObjects &objects)
+	{
+		C4AulParSet pars;
+		for (int i = 0; i < pFunc->GetParCount(); ++i)
+		{
+			const auto values = objects.GetPars(pFunc->GetParType()[i]);
+			// the first non-nil value: an object, a positive number, the test definition
+			pars[i] = values[1];
+		}
+		return pars;
+	}
+
+	std::vector<C4AulParSet> IntPars()
+	{
+		return {
+			C4AulParSet{C4VInt(0), C4VInt(0), C4VInt(0), C4VInt(0), C4VInt(1)},
+			C4AulParSet{C4VInt(-17), C4VInt(4), C4VInt(12), C4VInt(-3), C4VInt(10)},
+			C4AulParSet{C4VInt(360), C4VInt(-100), C4VInt(50), C4VInt(7), C4VInt(100)},
+			C4AulParSet{C4Value{}, C4VInt(9), C4Value{}, C4VInt(2), C4Value{}}
+		};
+	}
+}
+
+TEST_CASE("Engine functions return the same on the fast path", "[C4Script]")
+{
+	C4TestEngine::ResetScriptEngine();
+
+	for (const char *const szName : {"Abs", "Min", "Max", "Sin", "Cos", "Sqrt", "BoundBy", "Inside", "Distance", "Angle"})
+	{
+		C4AulFunc *const pFunc{GetEngineFunc(szName)};
+		for (const auto &pars : IntPars())
+		{
+			INFO(szName << "(" << pars[0].GetDataString() << ", " << pars[1].GetDataString() << ", " << pars[2].GetDataString() << ", ...)");
+			const auto [fastResult, result] = CallBothWays(pFunc, pars);
+			CHECK(fastResult.GetType() == result.GetType());
+			CHECK(fastResult == result);
+		}
+	}
+
+	SECTION("string parameters")
+	{
+		const C4Value hello{C4VString("Hello")}, world{C4VString("World")};
+		for (const auto &pars : {C4AulParSet{hello, hello}, C4AulParSet{hello, world}, C4AulParSet{hello, C4Value{}}})
+		{
+			const auto [fastResult, result] = CallBothWays(GetEngineFunc("SEqual"), pars);
+			CHECK(fastResult == result);
+		}
+
+		// optional results are converted like any other
+		for (const auto &pars : {C4AulParSet{hello, C4VInt(1)}, C4AulParSet{hello, C4VInt(10)}})
+		{
+			const auto [fastResult, result] = CallBothWays(GetEngineFunc("GetChar"), pars);
+			CHECK(fastResult.GetType() == result.GetType());
+			CHECK(fastResult == result);
+		}
+	}
+}
+
+TEST_CASE("The most called engine functions return the same on the fast path", "[C4Script]")
+{
+	C4TestEngine::ResetScriptEngine();
+	C4TestLandscape landscape{200, 200};
+	C4TestObjects objects;
+	std::minstd_rand random{19};
+
+	for (const char *const szName : MostCalledFuncs)
+	{
+		C4AulFunc *const pFunc{GetEngineFunc(szName)};
+		std::vector<std::vector<C4Value>> values;
+		for (int i = 0; i < pFunc->GetParCount(); ++i)
+			values.push_back(objects.GetPars(pFunc->GetParType()[i]));
+
+		// nil for all parameters, then random combinations, each in every context
+		for (int iCall = 0; iCall < 40; ++iCall)
+		{
+			C4AulParSet pars;
+			for (std::size_t i = 0; i < values.size(); ++i)
+				if (iCall) pars[i] = values[i][random() % values[i].size()];
+			for (C4Object *const pContext : objects.GetContexts())
+			{
+				INFO(ParsString(pFunc, pars) << " in the context of " << (pContext ? pContext->GetName() : "nothing") << (pContext == objects.Other ? " (other)" : ""));
+				const auto [fast, generic] = CallBothWays(pFunc, pContext, pars);
+				CHECK(fast.Error == generic.Error);
+				CHECK(fast == generic);
+			}
+		}
+	}
+
+	// the fixture is seen by the functions
+	CHECK(CallBothWays(GetEngineFunc("GetX"), objects.Obj, C4AulParSet{}).first.Value.getInt() == 100);
+	CHECK(CallBothWays(GetEngineFunc("Contents"), nullptr, C4AulParSet{C4VInt(0), C4VObj(objects.Obj)}).first.Value.getObj() == objects.Item);
+	CHECK(CallBothWays(GetEngineFunc("GetAlive"), objects.Obj, C4AulParSet{}).first.Value.getBool());
+
+	// the context object decides about the results of functions with only coordinates
+	const auto gbackSolid = [](C4Object *const pContext, const int32_t iY)
+	{
+		return CallBothWays(GetEngineFunc("GBackSolid"), pContext, C4AulParSet{C4VInt(0), C4VInt(iY)});
+	};
+	CHECK(gbackSolid(objects.Obj, 0).first.Value.getBool() == false);
+	CHECK(gbackSolid(objects.Obj, 70).first.Value.getBool() == true);
+	CHECK(gbackSolid(objects.Other, 20).first.Value.getBool() == true);
+	CHECK(gbackSolid(objects.Other, 20).second.Value.getBool() == true);
+}
+
+TEST_CASE("Parameters of other types take the generic conversion", "[C4Script]")
+{
+	C4TestEngine::ResetScriptEngine();
+	C4AulContext context{};
+	C4Value result;
+
+	C4AulFunc *const pAbs{GetEngineFunc("Abs")};
+	CHECK(!pAbs->FastCall(pAbs, &context, C4AulParSet{C4VBool(true)}.Par, result));
+	CHECK(!pAbs->FastCall(pAbs, &context, C4AulParSet{C4VString("1")}.Par, result));
+
+	C4AulFunc *const pSEqual{GetEngineFunc("SEqual")};
+	CHECK(!pSEqual->FastCall(pSEqual, &context, C4AulParSet{C4VInt(1), C4VString("1")}.Par, result));
+
+	// scripts still get the converted results
+	auto &script = C4TestEngine::LoadScript(
+		"#strict 3\n"
+		"func f(a) { return [Abs(a), Max(a, 3), BoundBy(a, nil, 2), Inside(a, 0, 1)]; }\n");
+	for (C4Value par : {C4VInt(-5), C4VBool(true), C4Value{}})
+	{
+		INFO("a = " << par.GetDataString());
+		C4Value value{script.Call("f", C4AulParSet{par})};
+		const C4ValueInt a{par.getInt()};
+		C4ValueArray *const pResult{value.getArray()};
+		REQUIRE(pResult);
+		CHECK(pResult->GetItem(0).getInt() == (a < 0 ? -a : a));
+		CHECK(pResult->GetItem(1).getInt() == (a > 3 ? a : 3));
+		CHECK(pResult->GetItem(2).getInt() == (a < 0 ? 0 : a > 2 ? 2 : a));
+		CHECK(pResult->GetItem(3).getBool() == (a >= 0 && a <= 1));
+	}
+}
+
+TEST_CASE("Engine function calls", "[.][benchmark][C4Script]")
+{
+	C4TestEngine::ResetScriptEngine();
+	C4AulFunc *const pFunc{GetEngineFunc("BoundBy")};
+	C4AulContext context{};
+	const C4AulParSet pars{C4VInt(7), C4VInt(0), C4VInt(5)};
+
+	BENCHMARK("fast path")
+	{
+		C4Value result;
+		pFunc->FastCall(pFunc, &context, pars.Par, result);
+		return result;
+	};
+
+	BENCHMARK("generic conversion")
+	{
+		return pFunc->Exec(&context, pars.Par, true);
+	};
+
+	auto &script = C4TestEngine::LoadScript("#strict 2\nfunc f() { var r; for (var i = 0; i < 1000; ++i) r += BoundBy(Abs(i - 500), 0, Max(i, 100)); return r; }");
+	BENCHMARK("script loop")
+	{
+		return script.Call("f");
+	};
+}
+
+TEST_CASE("Calls of the most called engine functions", "[.][benchmark][C4Script]")
+{
+	C4TestEngine::ResetScriptEngine();
+	C4TestLandscape landscape{200, 200};
+	C4TestObjects objects;
+	C4AulContext context{};
+	context.Obj = objects.Obj;
+	context.Def = objects.Def;
+
+	for (const char *const szName : MostCalledFuncs)
+	{
+		C4AulFunc *const pFunc{GetEngineFunc(szName)};
+		const C4AulParSet pars{TypicalPars(pFunc, objects)};
+
+		BENCHMARK(std::format("{} fast path", szName))
+		{
+			C4Value result;
+			pFunc->FastCall(pFunc, &context, pars.Par, result);
+			return result;
+		};
+
+		BENCHMARK(std::format("{} generic conversion", szName))
+		{
+			return pFunc->Exec(&context, pars.Par, true);
+		};
+	}
+
+	// object functions in the context of the calling object, like in a timer call
+	auto &script = C4TestEngine::LoadScript(
+		"#strict 2\n"
+		"func f() { var r; for (var i = 0; i < 1000; ++i) { if (!GBackSolid(0, i % 100)) r += GetX() + GetY(); r += GetCon() * GetDir() + ContentsCount(); } return r; }");
+	C4AulScriptFunc *const pFunc{script.GetSFunc("f")};
+	BENCHMARK("script loop with object context")
+	{
+		return pFunc->Exec(objects.Obj, C4AulParSet{}, true);
+	};
+}
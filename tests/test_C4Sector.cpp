@@ -0,0 +1,222 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4Sector.h>
+#include <C4Def.h>
+#include <C4Game.h>
+#include <C4Object.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+	constexpr int32_t LandscapeWdt{1000}, LandscapeHgt{600};
+
+	// objects in Game.Objects, which keeps the sectors up to date; removed again at the end of the test
+	class C4TestObjects
+	{
+	public:
+		C4TestObjects() { Game.Objects.Init(LandscapeWdt, LandscapeHgt); }
+
+		~C4TestObjects()
+		{
+			for (C4Object *const pObj : Objects)
+			{
+				Game.Objects.Remove(pObj);
+				delete pObj;
+			}
+			Game.Objects.Sectors.Clear();
+		}
+
+		C4Object *Create(const int32_t iX, const int32_t iY, const int32_t iSize)
+		{
+			auto *const pObj = new C4Object;
+			pObj->Def = &Def;
+			pObj->Status = C4OS_NORMAL;
+			pObj->Category = C4D_Object;
+			pObj->Number = static_cast<int32_t>(Objects.size()) + 1;
+			pObj->x = iX; pObj->y = iY;
+			pObj->Shape.x = pObj->Shape.y = -iSize / 2;
+			pObj->Shape.Wdt = pObj->Shape.Hgt = iSize;
+			Game.Objects.Add(pObj);
+			Objects.push_back(pObj);
+			return pObj;
+		}
+
+		void Move(C4Object *const pObj, const int32_t iX, const int32_t iY)
+		{
+			pObj->x = iX; pObj->y = iY;
+			Game.Objects.UpdatePos(pObj);
+		}
+
+		void Delete(C4Object *const pObj)
+		{
+			Game.Objects.Remove(pObj);
+			std::erase(Objects, pObj);
+			delete pObj;
+		}
+
+		std::vector<C4Object *> Objects;
+
+	private:
+		// object lists only take objects with a definition
+		C4Def Def;
+	};
+
+	std::vector<C4Object *> ListObjects(const C4ObjectList &list)
+	{
+		std::vector<C4Object *> result;
+		for (C4ObjectLink *pLnk = list.First; pLnk; pLnk = pLnk->Next)
+			result.push_back(pLnk->Obj);
+		return result;
+	}
+
+	// the flat indices must always match the lists they were copied from
+	void CheckIndices()
+	{
+		C4LSectors &sectors = Game.Objects.Sectors;
+		for (int32_t i = 0; i <= sectors.Size; ++i)
+		{
+			C4LSector &sector = i < sectors.Size ? sectors.Sectors[i] : sectors.SectorOut;
+			INFO("sector " << sector.x << ", " << sector.y);
+			CHECK(sector.GetObjectIndex() == ListObjects(sector.Objects));
+			CHECK(sector.GetObjectShapeIndex() == ListObjects(sector.ObjectShapes));
+		}
+	}
+
+	// what the area queries of FindObject see
+	std::size_t CountInArea(C4Rect rect)
+	{
+		std::size_t iCount{0};
+		C4LArea area{&Game.Objects.Sectors, rect};
+		for (C4LSector *pSct = area.First(); pSct; pSct = area.Next(pSct))
+			for (C4Object *const pObj : pSct->GetObjectIndex())
+				if (pObj->Status && rect.Contains(pObj->x, pObj->y))
+					++iCount;
+		return iCount;
+	}
+
+	// the same query over the object lists of the sectors, like before the flat indices
+	std::size_t CountInAreaLists(C4Rect rect)
+	{
+		std::size_t iCount{0};
+		C4LArea area{&Game.Objects.Sectors, rect};
+		C4LSector *pSct;
+		for (C4ObjectList *pObjs = area.FirstObjects(&pSct); pObjs; pObjs = area.NextObjects(pObjs, &pSct))
+			for (C4ObjectLink *pLnk = pObjs->First; pLnk; pLnk = pLnk->Next)
+				if (pLnk->Obj->Status && rect.Contains(pLnk->Obj->x, pLnk->Obj->y))
+					++iCount;
+		return iCount;
+	}
+}
+
+TEST_CASE("Sector indices follow their object lists", "[C4Sector]")
+{
+	C4TestObjects objects;
+	for (int32_t i = 0; i < 200; ++i)
+		objects.Create(i * 37 % LandscapeWdt, i * 53 % LandscapeHgt, 5 + i % 120);
+	CheckIndices();
+	CHECK(CountInArea(C4Rect{0, 0, LandscapeWdt, LandscapeHgt}) == 200);
+	CHECK(CountInArea(C4Rect{100, 100, 300, 200}) == CountInAreaLists(C4Rect{100, 100, 300, 200}));
+
+	SECTION("after moving")
+	{
+		for (std::size_t i = 0; i < objects.Objects.size(); i += 3)
+			objects.Move(objects.Objects[i], objects.Objects[i]->x + 120, objects.Objects[i]->y - 70);
+		// some of them are outside now
+		objects.Move(objects.Objects[1], -100, -100);
+		CheckIndices();
+	}
+
+	SECTION("after removing")
+	{
+		for (std::size_t i = 0; i < 50; ++i)
+			objects.Delete(objects.Objects[i * 3]);
+		CheckIndices();
+		CHECK(CountInArea(C4Rect{0, 0, LandscapeWdt, LandscapeHgt}) == 150);
+	}
+
+	SECTION("queried while changing")
+	{
+		// queries in between changes rebuild the indices more than once
+		for (int32_t i = 0; i < 20; ++i)
+		{
+			objects.Create(500 + i, 300, 10);
+			CountInArea(C4Rect{450, 250, 100, 100});
+			objects.Move(objects.Objects[i], 500 - i, 300);
+			CheckIndices();
+		}
+	}
+}
+
+TEST_CASE("Sector changes and queries", "[.][benchmark][C4Sector]")
+{
+	C4TestObjects objects;
+	for (int32_t i = 0; i < 2000; ++i)
+		objects.Create(i * 37 % LandscapeWdt, i * 53 % LandscapeHgt, 10);
+
+	int32_t iFrame{0};
+	BENCHMARK("move objects")
+	{
+		++iFrame;
+		for (std::size_t i = 0; i < objects.Objects.size(); i += 10)
+			objects.Move(objects.Objects[i], (objects.Objects[i]->x + 23 * iFrame) % LandscapeWdt, objects.Objects[i]->y);
+	};
+
+	BENCHMARK("query areas")
+	{
+		std::size_t iCount{0};
+		for (int32_t x = 0; x < LandscapeWdt; x += 100)
+			iCount += CountInArea(C4Rect{x, 200, 150, 150});
+		return iCount;
+	};
+
+	BENCHMARK("query areas by NextObjects")
+	{
+		std::size_t iCount{0};
+		for (int32_t x = 0; x < LandscapeWdt; x += 100)
+			iCount += CountInAreaLists(C4Rect{x, 200, 150, 150});
+		return iCount;
+	};
+
+	BENCHMARK("move and query")
+	{
+		++iFrame;
+		std::size_t iCount{0};
+		for (std::size_t i = 0; i < objects.Objects.size(); i += 100)
+		{
+			objects.Move(objects.Objects[i], (objects.Objects[i]->x + 23 * iFrame) % LandscapeWdt, objects.Objects[i]->y);
+			iCount += CountInArea(C4Rect{objects.Objects[i]->x - 50, objects.Objects[i]->y - 50, 100, 100});
+		}
+		return iCount;
+	};
+
+	BENCHMARK("move and query by NextObjects")
+	{
+		++iFrame;
+		std::size_t iCount{0};
+		for (std::size_t i = 0; i < objects.Objects.size(); i += 100)
+		{
+			objects.Move(objects.Objects[i], (objects.Objects[i]->x + 23 * iFrame) % LandscapeWdt, objects.Objects[i]->y);
+			iCount += CountInAreaLists(C4Rect{objects.Objects[i]->x - 50, objects.Objects[i]->y - 50, 100, 100});
+		}
+		return iCount;
+	};
+}
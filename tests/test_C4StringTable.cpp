@@ -0,0 +1,92 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "C4TestEngine.h"
+
+#include <C4Game.h>
+#include <C4StringTable.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string_view>
+
+namespace
+{
+	// strings of the table with the given contents; interning keeps this at most one
+	int CountStrings(const std::string_view contents)
+	{
+		int iCount{0};
+		for (C4String *pString = Game.ScriptEngine.Strings.First; pString; pString = pString->Next)
+			if (pString->GetView() == contents)
+				++iCount;
+		return iCount;
+	}
+
+	C4String *GetString(C4TestScript &script, const char *const szFunc)
+	{
+		return script.Call(szFunc).getStr();
+	}
+}
+
+TEST_CASE("Strings of the same contents are the same string", "[C4StringTable]")
+{
+	C4TestEngine::ResetScriptEngine();
+	C4StringTable &strings{Game.ScriptEngine.Strings};
+
+	C4Value first{C4VString("C4StringTableTest")}, second{C4VString(StdStrBuf{"C4StringTableTest"})};
+	CHECK(first._getStr() == second._getStr());
+	CHECK(strings.FindString("C4StringTableTest") == first._getStr());
+	CHECK(first._getStr() != C4VString("C4StringTableTest2")._getStr());
+	CHECK(CountStrings("C4StringTableTest") == 1);
+
+	// literals of different scripts and strings made at runtime
+	auto &script = C4TestEngine::LoadScript(
+		"#strict 2\n"
+		"func Literal() { return \"abc\"; }\n"
+		"func Joined() { return Format(\"%s%s\", \"ab\", \"c\"); }\n"
+		"func Compare(a) { return a == \"abc\"; }\n");
+	CHECK(GetString(script, "Literal") == GetString(script, "Joined"));
+	CHECK(script.Call("Compare", C4AulParSet{C4VString("abc")}).getBool());
+	CHECK(!script.Call("Compare", C4AulParSet{C4VString("abd")}).getBool());
+	CHECK(CountStrings("abc") == 1);
+}
+
+TEST_CASE("Strings stay interned across relinking", "[C4StringTable]")
+{
+	auto &script = C4TestEngine::LoadScript(
+		"#strict 2\n"
+		"func Literal() { return \"abc\"; }\n"
+		"func Compare(a) { return a == \"abc\"; }\n");
+	auto *const pOther = new C4TestScript{"#strict 2\nfunc Other() { return \"only in the other script\"; }", "Other.c"};
+	Game.ScriptEngine.ReLink(&Game.Defs);
+
+	// a value that outlives the code it came from
+	const C4Value held{script.Call("Literal")};
+	C4String *const pHeld{held._getStr()};
+	REQUIRE(Game.ScriptEngine.Strings.FindString("only in the other script"));
+
+	delete pOther;
+	Game.ScriptEngine.ReLink(&Game.Defs);
+
+	// the new code uses the string that is still around instead of a second one
+	CHECK(GetString(script, "Literal") == pHeld);
+	CHECK(script.Call("Compare", C4AulParSet{held}).getBool());
+	CHECK(CountStrings("abc") == 1);
+	CHECK(pHeld->Hold);
+
+	// strings that no code and no value refers to anymore are gone
+	CHECK(!Game.ScriptEngine.Strings.FindString("only in the other script"));
+}
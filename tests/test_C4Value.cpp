@@ -0,0 +1,288 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "C4TestEngine.h"
+
+#include <C4Game.h>
+#include <C4ValueList.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <string_view>
+#include <utility>
+#include <vector>
+
+TEST_CASE("Plain values are copied", "[C4Value]")
+{
+	C4Value source{C4VInt(42)};
+	C4Value copy{source};
+	CHECK(copy.GetType() == C4V_Int);
+	CHECK(copy._getInt() == 42);
+
+	copy.SetInt(7);
+	CHECK(source._getInt() == 42);
+
+	C4Value assigned;
+	assigned = C4VBool(true);
+	CHECK(assigned.GetType() == C4V_Bool);
+	CHECK(assigned._getBool());
+
+	// moving a plain value leaves nil behind
+	C4Value moved{std::move(source)};
+	CHECK(moved._getInt() == 42);
+	CHECK(source.GetType() == C4V_Any);
+
+	assigned.Set0();
+	CHECK(assigned.GetType() == C4V_Any);
+	CHECK(!assigned);
+}
+
+TEST_CASE("String values count their references", "[C4Value]")
+{
+	C4Value source{C4VString("C4ValueTest")};
+	C4String *const pString{source._getStr()};
+	REQUIRE(pString);
+	REQUIRE(pString->iRefCnt == 1);
+
+	SECTION("copies add a reference")
+	{
+		C4Value copy{source};
+		CHECK(copy._getStr() == pString);
+		CHECK(pString->iRefCnt == 2);
+
+		copy.Set0();
+		CHECK(pString->iRefCnt == 1);
+	}
+
+	SECTION("moves take over the reference")
+	{
+		C4Value moved{std::move(source)};
+		CHECK(moved._getStr() == pString);
+		CHECK(source.GetType() == C4V_Any);
+		CHECK(pString->iRefCnt == 1);
+
+		C4Value assigned{C4VInt(1)};
+		assigned = std::move(moved);
+		CHECK(assigned._getStr() == pString);
+		CHECK(moved.GetType() == C4V_Any);
+		CHECK(pString->iRefCnt == 1);
+
+		C4Value set;
+		set.Set(std::move(assigned));
+		CHECK(set._getStr() == pString);
+		CHECK(assigned.GetType() == C4V_Any);
+		CHECK(pString->iRefCnt == 1);
+
+		// put it back for the final check
+		source = std::move(set);
+	}
+
+	SECTION("overwriting drops the reference of the old value")
+	{
+		C4Value other{C4VString("C4ValueTestOther")};
+		C4String *const pOther{other._getStr()};
+		REQUIRE(pOther->iRefCnt == 1);
+
+		C4Value copy{source};
+		REQUIRE(pString->iRefCnt == 2);
+		copy = std::move(other);
+		CHECK(copy._getStr() == pOther);
+		CHECK(pOther->iRefCnt == 1);
+		CHECK(pString->iRefCnt == 1);
+	}
+
+	CHECK(source._getStr() == pString);
+	CHECK(pString->iRefCnt == 1);
+}
+
+TEST_CASE("Array values share their array", "[C4Value]")
+{
+	C4Value source{C4VArray(new C4ValueArray{2})};
+	C4ValueArray *const pArray{source._getArray()};
+	(*pArray)[0] = C4VInt(1);
+
+	C4Value copy{source};
+	CHECK(copy._getArray() == pArray);
+
+	C4Value moved{std::move(copy)};
+	CHECK(moved._getArray() == pArray);
+	CHECK(copy.GetType() == C4V_Any);
+	CHECK(moved._getArray()->GetItem(0)._getInt() == 1);
+}
+
+TEST_CASE("References keep their semantics", "[C4Value]")
+{
+	C4Value target{C4VInt(1)};
+	C4Value ref{C4VRef(&target)};
+	REQUIRE(ref.IsRef());
+	CHECK(ref.GetType() == C4V_Int);
+
+	SECTION("assignments through a reference change the target")
+	{
+		ref = C4VInt(2);
+		CHECK(ref.IsRef());
+		CHECK(target._getInt() == 2);
+
+		ref = C4VString("C4ValueTestRef");
+		CHECK(target.GetType() == C4V_String);
+	}
+
+	SECTION("moving from a reference copies the referenced value")
+	{
+		C4Value value;
+		value = std::move(ref);
+		CHECK(!value.IsRef());
+		CHECK(value._getInt() == 1);
+		CHECK(ref.IsRef());
+	}
+
+	SECTION("a referenced value is copied instead of moved")
+	{
+		target = C4VString("C4ValueTestTarget");
+		C4String *const pString{target._getStr()};
+		C4Value moved{std::move(target)};
+		CHECK(moved._getStr() == pString);
+		CHECK(target._getStr() == pString);
+		CHECK(ref.GetType() == C4V_String);
+		CHECK(pString->iRefCnt == 2);
+	}
+
+	SECTION("a destroyed target leaves its references with a copy")
+	{
+		auto *const pTarget = new C4Value{C4VInt(3)};
+		C4Value local{C4VRef(pTarget)};
+		delete pTarget;
+		CHECK(!local.IsRef());
+		CHECK(local._getInt() == 3);
+	}
+}
+
+TEST_CASE("Scripts see the same values through copies and references", "[C4Value]")
+{
+	auto &script = C4TestEngine::LoadScript(
+		"#strict 2\n"
+		"func Build(int n) { var a = []; for (var i = 0; i < n; ++i) a[i] = i * i; return a; }\n"
+		"func Inc(&x) { ++x; }\n"
+		"func Copy() { var a = Build(5); var b = a; b[0] = 99; return [a[0], b[0], GetLength(b)]; }\n"
+		"func RefToElement() { var a = Build(3); Inc(a[2]); var b = a; Inc(b[2]); return [a[2], b[2]]; }\n"
+		"func RefToLocal() { var x = 1; var y = x; Inc(x); Inc(x); return [x, y]; }\n"
+		"func Nested() { var a = [[1, 2], \"s\", 3]; var b = a; b[0][1] = 7; return [a[0][1], b[0][1], b[1], GetLength(a)]; }\n"
+		"func Grow() { var a = []; a[9] = 1; return [GetLength(a), a[5], a[9]]; }\n"
+		"func Sum() { var r = 0; for (var x in Build(10)) r += x; return r; }\n");
+
+	const auto call = [&script](const char *const szFunc)
+	{
+		C4Value result{script.Call(szFunc)};
+		C4ValueArray *const pResult{result.getArray()};
+		REQUIRE(pResult);
+		std::vector<C4Value> values;
+		for (int32_t i = 0; i < pResult->GetSize(); ++i) values.push_back((*pResult)[i]);
+		return values;
+	};
+
+	// a copy of an array is changed on its own
+	CHECK(call("Copy") == std::vector{C4VInt(0), C4VInt(99), C4VInt(5)});
+	// references to elements and locals change what they refer to
+	CHECK(call("RefToElement") == std::vector{C4VInt(5), C4VInt(6)});
+	CHECK(call("RefToLocal") == std::vector{C4VInt(3), C4VInt(1)});
+
+	std::vector<C4Value> nested{call("Nested")};
+	REQUIRE(nested.size() == 4);
+	CHECK(nested[0] == C4VInt(2));
+	CHECK(nested[1] == C4VInt(7));
+	CHECK(nested[2].getStr());
+	CHECK(std::string_view{nested[2].getStr()->Data.getData()} == "s");
+	CHECK(nested[3] == C4VInt(3));
+
+	std::vector<C4Value> grown{call("Grow")};
+	REQUIRE(grown.size() == 3);
+	CHECK(grown[0] == C4VInt(10));
+	CHECK(grown[1].GetType() == C4V_Any);
+	CHECK(grown[2] == C4VInt(1));
+
+	CHECK(script.Call("Sum").getInt() == 285);
+}
+
+TEST_CASE("C4Value copies and moves", "[.][benchmark][C4Value]")
+{
+	std::vector<C4Value> ints(1000, C4VInt(5));
+	std::vector<C4Value> strings(1000, C4VString("C4ValueBenchmark"));
+
+	BENCHMARK("copy ints")
+	{
+		std::vector<C4Value> copy{ints};
+		return copy.size();
+	};
+
+	BENCHMARK("copy strings")
+	{
+		std::vector<C4Value> copy{strings};
+		return copy.size();
+	};
+
+	BENCHMARK("move strings")
+	{
+		std::vector<C4Value> copy{strings};
+		std::vector<C4Value> moved;
+		moved.reserve(copy.size());
+		for (auto &value : copy) moved.emplace_back(std::move(value));
+		return moved.size();
+	};
+}
+
+TEST_CASE("Array-heavy scripts", "[.][benchmark][C4Value]")
+{
+	auto &script = C4TestEngine::LoadScript(
+		"#strict 2\n"
+		"func Build() { var a = []; for (var i = 0; i < 1000; ++i) a[i] = i; return a; }\n"
+		"func BuildStrings() { var a = []; for (var i = 0; i < 1000; ++i) a[i] = \"C4ValueBenchmark\"; return a; }\n"
+		"func Copy(array a) { var r = 0; for (var i = 0; i < 100; ++i) { var b = a; b[0] = i; r += b[0]; } return r; }\n"
+		"func Index(array a) { var r = 0; for (var i = 0; i < GetLength(a); ++i) r += a[i]; return r; }\n"
+		"func Iterate(array a) { var r = 0; for (var x in a) r += x; return r; }\n");
+	const C4Value ints{script.Call("Build")}, strings{script.Call("BuildStrings")};
+
+	BENCHMARK("build")
+	{
+		return script.Call("Build");
+	};
+
+	BENCHMARK("build strings")
+	{
+		return script.Call("BuildStrings");
+	};
+
+	// every assignment to the copy copies the whole array
+	BENCHMARK("copy")
+	{
+		return script.Call("Copy", C4AulParSet{ints});
+	};
+
+	BENCHMARK("copy strings")
+	{
+		return script.Call("Copy", C4AulParSet{strings});
+	};
+
+	BENCHMARK("index")
+	{
+		return script.Call("Index", C4AulParSet{ints});
+	};
+
+	BENCHMARK("iterate")
+	{
+		return script.Call("Iterate", C4AulParSet{ints});
+	};
+}
@@ -0,0 +1,159 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "C4TestEngine.h"
+
+#include <C4ValueHash.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+namespace
+{
+	std::vector<C4ValueInt> Keys(C4ValueHash &map)
+	{
+		std::vector<C4ValueInt> keys;
+		for (auto it = map.begin(); !it.IsEnd(); ++it)
+			keys.push_back((*it).first._getInt());
+		return keys;
+	}
+}
+
+TEST_CASE("Maps iterate in insertion order", "[C4ValueHash]")
+{
+	C4ValueHash map;
+	std::vector<C4ValueInt> expected;
+	for (C4ValueInt i = 0; i < 100; ++i)
+	{
+		const C4ValueInt key{(i * 7919) % 1000};
+		map[C4VInt(key)] = C4VInt(i);
+		expected.push_back(key);
+	}
+	CHECK(map.size() == 100);
+	CHECK(Keys(map) == expected);
+
+	// setting a value to nil removes its entry
+	const C4ValueInt removed{expected[10]};
+	map[C4VInt(removed)].Set0();
+	expected.erase(expected.begin() + 10);
+	CHECK(!map.contains(C4VInt(removed)));
+	CHECK(map.size() == 99);
+	CHECK(Keys(map) == expected);
+
+	// assigning to an existing key keeps its position
+	map[C4VInt(expected[0])] = C4VInt(-1);
+	CHECK(Keys(map) == expected);
+}
+
+TEST_CASE("Map iterators survive compaction", "[C4ValueHash]")
+{
+	C4ValueHash map;
+	for (C4ValueInt i = 0; i < 64; ++i)
+		map[C4VInt(i)] = C4VInt(i);
+
+	std::vector<C4ValueInt> visited;
+	C4ValueInt next{1000};
+	for (auto it = map.begin(); !it.IsEnd(); ++it)
+	{
+		const C4ValueInt key{(*it).first._getInt()};
+		visited.push_back(key);
+		if (key < 64)
+		{
+			// remove the following entry and add enough new ones to grow and compact the entries
+			if (key % 2 == 0) map[C4VInt(key + 1)].Set0();
+			for (int i = 0; i < 8 && next < 1100; ++i)
+				map[C4VInt(next++)] = C4VInt(0);
+		}
+	}
+
+	std::vector<C4ValueInt> expected;
+	for (C4ValueInt i = 0; i < 64; i += 2) expected.push_back(i);
+	for (C4ValueInt i = 1000; i < 1100; ++i) expected.push_back(i);
+	CHECK(visited == expected);
+
+	// an iterator resumed from its sequence number continues where it was
+	auto it = map.begin();
+	++it; ++it;
+	const C4ValueHash::Iterator resumed{&map, it.GetSeq()};
+	CHECK(resumed == it);
+	map[C4VInt(0)].Set0();
+	map[C4VInt(2)].Set0();
+	for (C4ValueInt i = 2000; i < 2300; ++i)
+		map[C4VInt(i)] = C4VInt(0);
+	C4ValueHash::Iterator afterCompaction{&map, it.GetSeq()};
+	CHECK((*afterCompaction).first._getInt() == 4);
+}
+
+TEST_CASE("Leaving foreach over a map early", "[C4ValueHash]")
+{
+	auto &script = C4TestEngine::LoadScript(
+		"#strict 3\n"
+		"func Find(m, value) { for (var key, val in m) if (val == value) return key; return nil; }\n"
+		"func CountUntil(m, value) { var n = 0; for (var key, val in m) { if (val == value) break; ++n; } return n; }\n"
+		"func f() {\n"
+		"  var m = {};\n"
+		"  for (var i = 0; i < 50; ++i) m[i * 3] = i;\n"
+		"  var sum = 0;\n"
+		"  for (var i = 0; i < 200; ++i) sum += Find(m, i % 50) + CountUntil(m, i % 50);\n"
+		"  for (var key, val in m) { m[key] = nil; m[key + 1000] = val; if (key >= 1000) break; }\n"
+		"  return [sum, GetLength(m)];\n"
+		"}\n");
+
+	C4Value result{script.Call("f")};
+	C4ValueArray *const pResult{result.getArray()};
+	REQUIRE(pResult);
+	// Find returns 3 * v and CountUntil v for v = i % 50, each value four times
+	CHECK(pResult->GetItem(0).getInt() == 4 * (3 + 1) * (49 * 50 / 2));
+	CHECK(pResult->GetItem(1).getInt() == 50);
+}
+
+TEST_CASE("Map operations", "[.][benchmark][C4ValueHash]")
+{
+	BENCHMARK("insert")
+	{
+		C4ValueHash map;
+		for (C4ValueInt i = 0; i < 1000; ++i) map[C4VInt(i)] = C4VInt(i);
+		return map.size();
+	};
+
+	C4ValueHash map;
+	for (C4ValueInt i = 0; i < 1000; ++i) map[C4VInt(i * 13)] = C4VInt(i);
+
+	BENCHMARK("lookup")
+	{
+		std::size_t iFound{0};
+		for (C4ValueInt i = 0; i < 1000; ++i) iFound += map.contains(C4VInt(i));
+		return iFound;
+	};
+
+	BENCHMARK("iterate")
+	{
+		C4ValueInt sum{0};
+		for (auto it = map.begin(); !it.IsEnd(); ++it) sum += (*it).second._getInt();
+		return sum;
+	};
+
+	auto &script = C4TestEngine::LoadScript(
+		"#strict 3\n"
+		"func f(m) { var sum = 0; for (var key, val in m) { sum += val; if (key > 6000) break; } return sum; }\n");
+	const C4Value scriptMap{C4VMap(new C4ValueHash{map})};
+	BENCHMARK("foreach with break")
+	{
+		return script.Call("f", C4AulParSet{scriptMap});
+	};
+}
@@ -0,0 +1,269 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <StdCompiler.h>
+#include <StdAdaptors.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct Item
+	{
+		std::int32_t Value{0};
+		std::string Text;
+
+		void CompileFunc(StdCompiler *pComp)
+		{
+			pComp->Value(mkNamingAdapt(Value, "Value", 0));
+			pComp->Value(mkNamingAdapt(Text, "Text", std::string{}));
+		}
+
+		bool operator==(const Item &) const = default;
+	};
+
+	struct Data
+	{
+		std::int32_t Int{7};
+		std::uint32_t UInt{8};
+		std::int64_t Big{9};
+		bool Flag{false};
+		std::string Name{"Default"};
+		std::vector<std::int32_t> List;
+		std::vector<Item> Items;
+
+		void CompileFunc(StdCompiler *pComp)
+		{
+			pComp->Value(mkNamingAdapt(Int, "Int", 7));
+			pComp->Value(mkNamingAdapt(UInt, "UInt", 8u));
+			pComp->Value(mkNamingAdapt(Big, "Big", std::int64_t{9}));
+			pComp->Value(mkNamingAdapt(Flag, "Flag", false));
+			pComp->Value(mkNamingAdapt(Name, "Name", std::string{"Default"}));
+			pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(List), "List", std::vector<std::int32_t>{}));
+			// several sections of the same name, like the objects in Objects.txt
+			std::int32_t iItemCnt{static_cast<std::int32_t>(Items.size())};
+			pComp->Value(mkNamingCountAdapt(iItemCnt, "Item"));
+			if (pComp->isCompiler()) Items.resize(iItemCnt);
+			for (auto &item : Items)
+				pComp->Value(mkNamingAdapt(item, "Item"));
+		}
+
+		bool operator==(const Data &) const = default;
+	};
+
+	// a later version of Data with names the reader doesn't know
+	struct ExtendedData : Data
+	{
+		std::int32_t Extra{0};
+		Item ExtraItem;
+
+		void CompileFunc(StdCompiler *pComp)
+		{
+			pComp->Value(mkNamingAdapt(Extra, "Extra", 0));
+			pComp->Value(mkNamingAdapt(ExtraItem, "ExtraSection"));
+			Data::CompileFunc(pComp);
+			pComp->Value(mkNamingAdapt(Extra, "ExtraAfter", 0));
+		}
+	};
+
+	// an earlier version of Data which lacks most names
+	struct ReducedData
+	{
+		std::int32_t Int{0};
+
+		void CompileFunc(StdCompiler *pComp)
+		{
+			pComp->Value(mkNamingAdapt(Int, "Int", 0));
+		}
+	};
+
+	Data MakeData()
+	{
+		Data data;
+		data.Int = -123456;
+		data.UInt = 4000000000u;
+		data.Big = -(std::int64_t{1} << 40);
+		data.Flag = true;
+		data.Name = "Objects \"quoted\"\nand escaped \\";
+		data.List = {1, -2, 3, 0, 2147483647};
+		// sections without any values are left out like in INI files, so every item has one
+		data.Items = {{1, "first"}, {0, "second"}, {-5, ""}};
+		return data;
+	}
+
+	// values must be inside a section, like in INI files
+	template<class T>
+	StdBuf Write(T data)
+	{
+		return DecompileToBuf<StdCompilerNamedBinWrite>(mkNamingAdapt(data, "Data"));
+	}
+
+	void ReadInto(Data &data, const StdBuf &buf)
+	{
+		CompileFromBuf<StdCompilerNamedBinRead>(mkNamingAdapt(data, "Data"), buf);
+	}
+
+	Data Read(const StdBuf &buf)
+	{
+		Data data;
+		ReadInto(data, buf);
+		return data;
+	}
+
+	std::string WriteINI(Data data)
+	{
+		return DecompileToBuf<StdCompilerINIWrite>(mkNamingAdapt(data, "Data"));
+	}
+
+	// an item whose value must be given
+	struct RequiredItem
+	{
+		std::int32_t Value{0};
+		std::string Text;
+
+		void CompileFunc(StdCompiler *pComp)
+		{
+			pComp->Value(mkNamingAdapt(Value, "Value"));
+			pComp->Value(mkNamingAdapt(Text, "Text", std::string{}));
+		}
+	};
+}
+
+TEST_CASE("INI errors name the line after many missing values", "[StdCompiler]")
+{
+	// every missing text asks for its position, so the lines are counted on from the previous one
+	std::string text;
+	constexpr int ItemCount{200};
+	for (int i = 0; i < ItemCount; ++i)
+		text += std::format("[Item]\nValue={}\n", i == ItemCount - 1 ? "x" : std::to_string(i));
+	struct
+	{
+		std::vector<RequiredItem> Items = std::vector<RequiredItem>(ItemCount);
+
+		void CompileFunc(StdCompiler *pComp)
+		{
+			for (auto &item : Items)
+				pComp->Value(mkNamingAdapt(item, "Item"));
+		}
+	} items;
+
+	try
+	{
+		CompileFromBuf<StdCompilerINIRead>(items, StdStrBuf{text.c_str()});
+		FAIL("no error");
+	}
+	catch (const StdCompiler::Exception &e)
+	{
+		// lines are counted from zero
+		CHECK(e.Pos == std::format("line {}", ItemCount * 2 - 1));
+	}
+}
+
+TEST_CASE("Named binary data reads back like INI data", "[StdCompiler]")
+{
+	const Data data{MakeData()};
+
+	const Data binary{Read(Write(data))};
+	CHECK(binary == data);
+
+	const std::string ini{WriteINI(data)};
+	Data fromIni;
+	CompileFromBuf<StdCompilerINIRead>(mkNamingAdapt(fromIni, "Data"), StdStrBuf{ini.c_str(), ini.size()});
+	CHECK(fromIni == binary);
+	CHECK(WriteINI(binary) == ini);
+
+	SECTION("defaults and empty lists")
+	{
+		const Data empty;
+		CHECK(Read(Write(empty)) == empty);
+	}
+}
+
+TEST_CASE("Named binary data skips unknown names and defaults missing ones", "[StdCompiler]")
+{
+	SECTION("unknown names")
+	{
+		ExtendedData extended;
+		static_cast<Data &>(extended) = MakeData();
+		extended.Extra = 42;
+		extended.ExtraItem = {3, "unknown"};
+		CHECK(Read(Write(extended)) == MakeData());
+	}
+
+	SECTION("missing names")
+	{
+		const ReducedData reduced{5};
+		Data expected;
+		expected.Int = 5;
+
+		Data data{MakeData()};
+		ReadInto(data, Write(reduced));
+		CHECK(data == expected);
+	}
+}
+
+TEST_CASE("Named binary data rejects damaged input", "[StdCompiler]")
+{
+	const StdBuf buf{Write(MakeData())};
+	const auto *const pData = static_cast<const std::uint8_t *>(buf.getData());
+
+	SECTION("truncated")
+	{
+		for (std::size_t size = 0; size < buf.getSize(); ++size)
+		{
+			INFO("size " << size << " of " << buf.getSize());
+			const StdBuf truncated{pData, size, true};
+			CHECK_THROWS_AS(Read(truncated), StdCompiler::Exception);
+		}
+	}
+
+	SECTION("wrong magic")
+	{
+		StdBuf corrupt{pData, buf.getSize(), true};
+		static_cast<std::uint8_t *>(corrupt.getMData())[0] ^= 0xff;
+		CHECK_THROWS_AS(Read(corrupt), StdCompiler::Exception);
+	}
+
+	SECTION("newer version")
+	{
+		StdBuf corrupt{pData, buf.getSize(), true};
+		static_cast<std::uint8_t *>(corrupt.getMData())[4] = StdCompilerNamedBinWrite::FormatVersion + 1;
+		CHECK_THROWS_AS(Read(corrupt), StdCompiler::Exception);
+	}
+
+	SECTION("damaged bytes")
+	{
+		// sizes and tokens are checked, so every damaged byte either fails to read or changes a value
+		for (std::size_t i = 0; i < buf.getSize(); ++i)
+		{
+			INFO("byte " << i);
+			StdBuf corrupt{pData, buf.getSize(), true};
+			static_cast<std::uint8_t *>(corrupt.getMData())[i] ^= 0x5a;
+			try
+			{
+				Read(corrupt);
+			}
+			catch (const StdCompiler::Exception &)
+			{
+			}
+		}
+	}
+}